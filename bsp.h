@@ -4,12 +4,41 @@
 // 引入公共定义（错误码、日志级别、版本信息等）
 #include "bsp/common/bsp_common.h"
 
+// 单线程事件循环（驱动异步接口）
+#include "bsp/common/event_loop.h"
+
+// 批量 I/O（io_uring / POSIX）
+#include "bsp/common/io_ring.h"
+
+// 库内线程属性（实时调度、绑核、线程名、锁内存）
+#include "bsp/common/thread_attr.h"
+
+// 定长块池 / 对象池与单调区域分配（事件、样本记录和批量读取缓冲区不走堆）
+#include "bsp/common/pool.h"
+
 // 引入各硬件模块接口声明
 #include "bsp/driver/led/led.h"
 #include "bsp/driver/key/key.h"
+#include "bsp/driver/key/input_discovery.h"
 #include "bsp/driver/ap3216c/ap3216c.h"
 #include "bsp/driver/dht11/dht11.h"
 
+// 传感器读数 -> 物理单位（定点 / 浮点，带校准）
+#include "bsp/driver/sensor_units.h"
+
+// 板级设备管理
+#include "bsp/board/board.h"
+
+// 派生量流水线（露点、体感温度、平滑照度等）
+#include "bsp/pipeline/pipeline.h"
+#include "bsp/pipeline/health.h"
+
+// 按读数变化自适应的采样速率与按订阅启停的采样线程
+#include "bsp/pipeline/sampler.h"
+
+// 共享内存样本发布/订阅（一个守护进程占用硬件，其他进程只读共享内存）
+#include "bsp/ipc/shm_ring.h"
+
 // 后续版本将包含以下模块：
 // #include "bsp/driver/beep/beep.h"
 // #include "bsp/driver/camera/camera.h"
@@ -4,4 +4,14 @@ file(GLOB_RECURSE SOURCE_FILES "*.cpp" "*.h" "*.c" "*.hpp")
 add_custom_target(format
     COMMAND clang-format-15 -i ${SOURCE_FILES}
     COMMENT "Formatting code with clang-format"
-)
\ No newline at end of file
+)
+
+# 嵌入式配置（BSP_EMBEDDED=ON）：组成 libbsp 的库以 -fno-exceptions 编译
+# 用法：bsp_apply_profile(<target>)，命令行工具和测试程序仍使用异常
+function(bsp_apply_profile target)
+    if(BSP_EMBEDDED)
+        target_compile_options(${target} PRIVATE -fno-exceptions)
+        # 关闭 spdlog 头文件中的 try/catch
+        target_compile_definitions(${target} PRIVATE SPDLOG_NO_EXCEPTIONS)
+    endif()
+endfunction()
@@ -0,0 +1,404 @@
+#include "board.h"
+#include "../common/thread_pool.h"
+#include "../common/trace.h"
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace bsp
+{
+
+using Clock = std::chrono::steady_clock;
+
+BoardConfig BoardConfig::fromTable(const DeviceTable &table)
+{
+    BoardConfig config;
+    config.initThreads = table.initThreads();
+    config.devices.reserve(table.size());
+    for (std::size_t i = 0; i < table.size(); ++i)
+    {
+        const DeviceEntry &entry = table.entry(static_cast<DeviceHandle>(i));
+        DeviceConfig dev(entry.type, entry.name, entry.initTimeoutMs);
+        dev.path = entry.path;
+        config.devices.push_back(dev);
+    }
+    return config;
+}
+
+// 单个设备槽位：设备对象 + 初始化状态（done/timedOut/result/finishTime 受 Impl::mutex 保护）
+struct Board::Slot
+{
+    DeviceConfig config;
+    std::string path;
+    std::unique_ptr<Led> led;
+    std::unique_ptr<Key> key;
+    std::unique_ptr<AP3216C> ap3216c;
+    std::unique_ptr<DHT11> dht11;
+
+    bool done;
+    bool timedOut;           // Board::init() 已判定超时，之后完成的结果不再写回 result
+    std::atomic<bool> ready; // 只在 init() 中写入一次，访问接口无锁读取
+    ErrorCode result;
+    Clock::time_point finishTime;
+
+    explicit Slot(const DeviceConfig &config)
+        : config(config), path(config.path.empty() ? "/dev/" + config.name : config.path), done(false),
+          timedOut(false), ready(false), result(ErrorCode::DevNotReady)
+    {
+    }
+
+    // 设备对象直接使用已确定的路径构造，不再各自拼接
+    DeviceEntry entry() const
+    {
+        return makeDeviceEntry(config.type, config.name.c_str(), path.c_str(), config.initTimeoutMs);
+    }
+
+    ErrorCode initDevice()
+    {
+        switch (config.type)
+        {
+        case DeviceType::Led:
+            return led->init();
+        case DeviceType::Key:
+            return key->init();
+        case DeviceType::AP3216C:
+            return ap3216c->init();
+        case DeviceType::DHT11:
+            return dht11->init();
+        case DeviceType::Custom:
+            return config.customInit ? config.customInit() : ErrorCode::InvalidParam;
+        default:
+            return ErrorCode::Unsupported;
+        }
+    }
+
+    /**
+     * @brief 超时后才返回的 init()：设备不会再进入就绪集合，释放设备对象以关闭已打开的 fd
+     *
+     * 在线程池线程中调用；槽位未就绪，访问接口不会触碰设备指针
+     */
+    void discardLate(ErrorCode ret)
+    {
+        spdlog::warn("board: {} {} finished init after timeout ({}), closing", deviceTypeToString(config.type),
+                     config.name, errorMessage(ret));
+        led.reset();
+        key.reset();
+        ap3216c.reset();
+        dht11.reset();
+    }
+};
+
+struct Board::Impl
+{
+    std::mutex mutex;
+    std::condition_variable cond;
+    // 线程池放在最后，保证析构时先回收线程再销毁 mutex/cond
+    std::unique_ptr<ThreadPool> pool;
+};
+
+Board::Board(const BoardConfig &config) : startup(0), impl(new Impl)
+{
+    slots.reserve(config.devices.size());
+    for (const auto &dev : config.devices)
+    {
+        std::unique_ptr<Slot> slot(new Slot(dev));
+        const DeviceEntry entry = slot->entry();
+        switch (dev.type)
+        {
+        case DeviceType::Led:
+            slot->led.reset(new Led(entry));
+            break;
+        case DeviceType::Key:
+            slot->key.reset(new Key(entry));
+            break;
+        case DeviceType::AP3216C:
+            slot->ap3216c.reset(new AP3216C(entry));
+            break;
+        case DeviceType::DHT11:
+            slot->dht11.reset(new DHT11(entry));
+            break;
+        default:
+            break;
+        }
+        slots.push_back(std::move(slot));
+    }
+
+    std::size_t threads = config.initThreads > 0 ? config.initThreads : slots.size();
+    impl->pool.reset(new ThreadPool(threads, config.threadAttr));
+}
+
+Board::Board(const DeviceTable &table) : Board(BoardConfig::fromTable(table))
+{
+}
+
+Board::~Board()
+{
+    // 先回收线程池（等待超时设备的 init() 返回），再释放设备
+    impl.reset();
+}
+
+ErrorCode Board::init()
+{
+    if (!reports.empty())
+    {
+        spdlog::warn("Board already initialized");
+        for (const auto &report : reports)
+        {
+            if (report.result != ErrorCode::Ok)
+            {
+                return report.result;
+            }
+        }
+        return ErrorCode::Ok;
+    }
+
+    BSP_TRACE_SCOPE("Board::init");
+    const Clock::time_point start = Clock::now();
+
+    // 工作线程创建失败时不投递任何设备，之后可以再次调用 init()
+    ErrorCode poolResult = impl->pool->init();
+    if (poolResult != ErrorCode::Ok)
+    {
+        spdlog::error("board: start init threads failed: {}", errorMessage(poolResult));
+        return poolResult;
+    }
+
+    for (auto &slotPtr : slots)
+    {
+        Slot *slot = slotPtr.get();
+        Impl *state = impl.get();
+        impl->pool->submit([slot, state] {
+            ErrorCode ret = slot->initDevice();
+            bool late;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                late = slot->timedOut;
+                if (!late)
+                {
+                    slot->done = true;
+                    slot->result = ret;
+                    slot->finishTime = Clock::now();
+                }
+            }
+            if (late)
+            {
+                // 报告保持 Timeout，设备不进入就绪集合
+                slot->discardLate(ret);
+                return;
+            }
+            state->cond.notify_all();
+        });
+    }
+
+    // 等待所有设备完成或超时
+    std::vector<bool> settled(slots.size(), false);
+    std::vector<Clock::time_point> settleTime(slots.size(), start);
+    std::size_t remaining = slots.size();
+    {
+        std::unique_lock<std::mutex> lock(impl->mutex);
+        while (remaining > 0)
+        {
+            const Clock::time_point now = Clock::now();
+            bool hasDeadline = false;
+            Clock::time_point nearest = Clock::time_point::max();
+
+            for (std::size_t i = 0; i < slots.size(); ++i)
+            {
+                if (settled[i])
+                {
+                    continue;
+                }
+
+                Slot &slot = *slots[i];
+                if (slot.done)
+                {
+                    slot.ready = (slot.result == ErrorCode::Ok);
+                    settled[i] = true;
+                    settleTime[i] = slot.finishTime;
+                    --remaining;
+                    continue;
+                }
+
+                if (slot.config.initTimeoutMs > 0)
+                {
+                    Clock::time_point deadline = start + std::chrono::milliseconds(slot.config.initTimeoutMs);
+                    if (now >= deadline)
+                    {
+                        slot.timedOut = true;
+                        slot.result = ErrorCode::Timeout;
+                        settled[i] = true;
+                        settleTime[i] = now;
+                        --remaining;
+                        continue;
+                    }
+                    hasDeadline = true;
+                    if (deadline < nearest)
+                    {
+                        nearest = deadline;
+                    }
+                }
+            }
+
+            if (remaining == 0)
+            {
+                break;
+            }
+
+            if (hasDeadline)
+            {
+                impl->cond.wait_until(lock, nearest);
+            }
+            else
+            {
+                impl->cond.wait(lock);
+            }
+        }
+
+        reports.reserve(slots.size());
+        for (std::size_t i = 0; i < slots.size(); ++i)
+        {
+            const Slot &slot = *slots[i];
+            DeviceInitReport report;
+            report.name = slot.config.name;
+            report.type = slot.config.type;
+            report.result = slot.result;
+            report.latency = std::chrono::duration_cast<std::chrono::microseconds>(settleTime[i] - start);
+            reports.push_back(report);
+        }
+    }
+
+    startup = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+
+    ErrorCode firstError = ErrorCode::Ok;
+    for (const auto &report : reports)
+    {
+        if (report.result == ErrorCode::Ok)
+        {
+            spdlog::info("board: {} {} ready in {} us", deviceTypeToString(report.type), report.name,
+                         report.latency.count());
+        }
+        else
+        {
+            spdlog::error("board: {} {} failed after {} us: {}", deviceTypeToString(report.type), report.name,
+                          report.latency.count(), errorMessage(report.result));
+            if (firstError == ErrorCode::Ok)
+            {
+                firstError = report.result;
+            }
+        }
+    }
+    spdlog::info("board: {} devices initialized in {} us", slots.size(), startup.count());
+
+    return firstError;
+}
+
+const std::vector<DeviceInitReport> &Board::initReport() const
+{
+    return reports;
+}
+
+std::chrono::microseconds Board::startupTime() const
+{
+    return startup;
+}
+
+std::vector<std::string> Board::readyDevices() const
+{
+    std::vector<std::string> names;
+    for (const auto &slot : slots)
+    {
+        if (slot->ready)
+        {
+            names.push_back(slot->config.name);
+        }
+    }
+    return names;
+}
+
+bool Board::isReady(const std::string &name) const
+{
+    return isReady(handle(name));
+}
+
+bool Board::isReady(DeviceHandle handle) const
+{
+    return handle < slots.size() && slots[handle]->ready;
+}
+
+DeviceHandle Board::handle(const std::string &name) const
+{
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        if (slots[i]->config.name == name)
+        {
+            return static_cast<DeviceHandle>(i);
+        }
+    }
+    return INVALID_DEVICE_HANDLE;
+}
+
+const Board::Slot *Board::findReady(const std::string &name, DeviceType type) const
+{
+    return readySlot(handle(name), type);
+}
+
+const Board::Slot *Board::readySlot(DeviceHandle handle, DeviceType type) const
+{
+    if (handle >= slots.size())
+    {
+        return nullptr;
+    }
+    const Slot *slot = slots[handle].get();
+    return (slot->config.type == type && slot->ready) ? slot : nullptr;
+}
+
+Led *Board::led(const std::string &name)
+{
+    const Slot *slot = findReady(name, DeviceType::Led);
+    return slot ? slot->led.get() : nullptr;
+}
+
+Key *Board::key(const std::string &name)
+{
+    const Slot *slot = findReady(name, DeviceType::Key);
+    return slot ? slot->key.get() : nullptr;
+}
+
+AP3216C *Board::ap3216c(const std::string &name)
+{
+    const Slot *slot = findReady(name, DeviceType::AP3216C);
+    return slot ? slot->ap3216c.get() : nullptr;
+}
+
+DHT11 *Board::dht11(const std::string &name)
+{
+    const Slot *slot = findReady(name, DeviceType::DHT11);
+    return slot ? slot->dht11.get() : nullptr;
+}
+
+Led *Board::led(DeviceHandle handle)
+{
+    const Slot *slot = readySlot(handle, DeviceType::Led);
+    return slot ? slot->led.get() : nullptr;
+}
+
+Key *Board::key(DeviceHandle handle)
+{
+    const Slot *slot = readySlot(handle, DeviceType::Key);
+    return slot ? slot->key.get() : nullptr;
+}
+
+AP3216C *Board::ap3216c(DeviceHandle handle)
+{
+    const Slot *slot = readySlot(handle, DeviceType::AP3216C);
+    return slot ? slot->ap3216c.get() : nullptr;
+}
+
+DHT11 *Board::dht11(DeviceHandle handle)
+{
+    const Slot *slot = readySlot(handle, DeviceType::DHT11);
+    return slot ? slot->dht11.get() : nullptr;
+}
+
+} // namespace bsp
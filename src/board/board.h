@@ -0,0 +1,171 @@
+#ifndef BSP_BOARD_H
+#define BSP_BOARD_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common/bsp_common.h"
+#include "../common/device_table.h"
+#include "../common/thread_attr.h"
+#include "../driver/led/led.h"
+#include "../driver/key/key.h"
+#include "../driver/ap3216c/ap3216c.h"
+#include "../driver/dht11/dht11.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 单个设备的声明
+ */
+struct DeviceConfig
+{
+    DeviceType type;
+    std::string name;                       // 设备名，板内唯一
+    std::string path;                       // 设备节点路径，为空时使用 /dev/<name>
+    int initTimeoutMs;                      // 初始化超时(ms)，从 Board::init() 调用起计时，<=0 不限时
+    std::function<ErrorCode()> customInit;  // 仅 DeviceType::Custom 使用
+
+    DeviceConfig(DeviceType type, const std::string &name, int initTimeoutMs = 0)
+        : type(type), name(name), initTimeoutMs(initTimeoutMs)
+    {
+    }
+};
+
+/**
+ * @brief 整板设备配置
+ */
+struct BoardConfig
+{
+    std::vector<DeviceConfig> devices;
+    std::size_t initThreads; // 初始化线程数，0 表示每个设备一个线程
+    ThreadAttr threadAttr;   // 初始化线程属性（线程名后追加序号，默认 bsp-pool-<序号>；应用失败只记录警告）
+
+    BoardConfig() : initThreads(0)
+    {
+    }
+
+    /**
+     * @brief 由板级设备表生成配置，设备顺序与表中句柄一致
+     */
+    static BoardConfig fromTable(const DeviceTable &table);
+};
+
+/**
+ * @brief 单个设备的初始化结果
+ */
+struct DeviceInitReport
+{
+    std::string name;
+    DeviceType type;
+    ErrorCode result;                  // Timeout 表示超过 initTimeoutMs 仍未完成
+    std::chrono::microseconds latency; // 从投递到完成（或判定超时）的耗时
+};
+
+/**
+ * @brief 板级设备门面
+ *
+ * 根据 BoardConfig 创建全部设备，并在线程池上并行调用各设备的 init()，
+ * 统计每个设备的初始化耗时与失败原因，对外提供已就绪设备的访问接口。
+ * 超时的设备不会进入就绪集合，其 init() 在后台线程中继续执行直到返回，返回后立即释放
+ * 设备对象（关闭已打开的设备节点），报告中仍为 Timeout；Board 析构时会等待这些线程结束。
+ *
+ * 设备句柄即设备在配置中的声明下标（由 DeviceTable 构造时与表中句柄一致），
+ * 热路径上应使用句柄版本的访问接口，避免按名字做字符串比较。
+ */
+class Board
+{
+public:
+    /**
+     * @brief 构造函数，仅创建设备对象，不打开设备节点
+     * @param config 整板设备配置
+     */
+    explicit Board(const BoardConfig &config);
+
+    /**
+     * @brief 由板级设备表构造，等价于 Board(BoardConfig::fromTable(table))
+     * @param table 已加载的板级设备表
+     */
+    explicit Board(const DeviceTable &table);
+
+    /**
+     * @brief 析构函数，等待所有初始化任务结束后释放设备
+     */
+    ~Board();
+
+    // 禁止拷贝和移动（初始化任务持有设备指针）
+    Board(const Board &) = delete;
+    Board &operator=(const Board &) = delete;
+
+    /**
+     * @brief 并行初始化所有设备，阻塞直到全部完成或超时
+     * @return ErrorCode::Ok 全部成功；线程池的工作线程创建失败时返回其错误码（不初始化任何设备）；
+     *         否则返回第一个失败设备（按声明顺序）的错误码
+     */
+    ErrorCode init();
+
+    /**
+     * @brief 获取各设备的初始化报告（按声明顺序）
+     */
+    const std::vector<DeviceInitReport> &initReport() const;
+
+    /**
+     * @brief 获取整板初始化总耗时
+     */
+    std::chrono::microseconds startupTime() const;
+
+    /**
+     * @brief 获取已就绪设备名列表（按声明顺序）
+     */
+    std::vector<std::string> readyDevices() const;
+
+    /**
+     * @brief 检查指定设备是否已就绪
+     */
+    bool isReady(const std::string &name) const;
+    bool isReady(DeviceHandle handle) const;
+
+    /**
+     * @brief 按设备名查找句柄
+     * @return 设备句柄，不存在时返回 INVALID_DEVICE_HANDLE
+     */
+    DeviceHandle handle(const std::string &name) const;
+
+    /**
+     * @brief 按设备名获取已就绪的设备
+     * @return 设备指针；设备不存在、类型不符或未就绪时返回 nullptr
+     */
+    Led *led(const std::string &name);
+    Key *key(const std::string &name);
+    AP3216C *ap3216c(const std::string &name);
+    DHT11 *dht11(const std::string &name);
+
+    /**
+     * @brief 按句柄获取已就绪的设备（O(1) 下标访问）
+     * @return 设备指针；句柄越界、类型不符或未就绪时返回 nullptr
+     */
+    Led *led(DeviceHandle handle);
+    Key *key(DeviceHandle handle);
+    AP3216C *ap3216c(DeviceHandle handle);
+    DHT11 *dht11(DeviceHandle handle);
+
+private:
+    struct Slot;
+
+    const Slot *findReady(const std::string &name, DeviceType type) const;
+    const Slot *readySlot(DeviceHandle handle, DeviceType type) const;
+
+    // 声明顺序决定析构顺序：impl（含线程池）先于设备槽位析构
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<DeviceInitReport> reports;
+    std::chrono::microseconds startup;
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace bsp
+
+#endif // BSP_BOARD_H
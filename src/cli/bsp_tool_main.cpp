@@ -1,79 +1,39 @@
-#include "../common/bsp_common.h"
-#include "../driver/led/led.h"
-#include "../driver/ap3216c/ap3216c.h"
-#include "cli_parser.h"
+#include "cli_registry.h"
+#include "cli_session.h"
 #include <spdlog/spdlog.h>
 #include <cstdio>
-#include <cstdlib>
 
 int main(int argc, char *argv[])
 {
     using namespace bsp;
 
-    // 解析命令行参数
-    Command cmd = CliParser::parse(argc, argv);
-
-    // 处理命令
-    switch (cmd.type)
-    {
-    case CommandType::Help:
-        CliParser::printHelp();
-        return 0;
-
-    case CommandType::Version:
-        CliParser::printVersion();
-        return 0;
-
-    case CommandType::LedSet:
+    // 解析命令行参数（各命令模块在静态初始化阶段已注册到 CommandRegistry）
+    StrRef tokens[CommandRegistry::MAX_TOKENS];
+    std::size_t count = 0;
+    for (int i = 1; i < argc && count < CommandRegistry::MAX_TOKENS; ++i)
     {
-        Led led(cmd.led_args.dev_name);
-        ErrorCode ret = led.init();
-        if (ret != ErrorCode::Ok)
-        {
-            spdlog::error("Failed to init LED {}: {}", cmd.led_args.dev_name, errorToString(ret));
-            return 1;
-        }
-
-        ret = led.setState(cmd.led_args.state);
-        if (ret != ErrorCode::Ok)
-        {
-            spdlog::error("Failed to set LED state: {}", errorToString(ret));
-            return 1;
-        }
-
-        spdlog::info("LED {} set to {}", cmd.led_args.dev_name, cmd.led_args.state ? "on" : "off");
-        return 0;
+        tokens[count++] = StrRef(argv[i]);
     }
 
-    case CommandType::AP3216CRead:
+    ParsedArgs args;
+    if (CommandRegistry::parse(tokens, count, args) != ErrorCode::Ok)
     {
-        AP3216C sensor(cmd.ap3216c_args.dev_name);
-        ErrorCode ret = sensor.init();
-        if (ret != ErrorCode::Ok)
+        spdlog::error("{}", args.error());
+        // 参数错误只打印该子命令的用法，未知命令打印完整帮助
+        if (args.spec() != nullptr)
         {
-            spdlog::error("Failed to init AP3216C {}: {}", cmd.ap3216c_args.dev_name, errorToString(ret));
-            return 1;
+            std::printf("Usage:\n");
+            CommandRegistry::printUsage(*args.spec());
         }
-
-        AP3216CData data;
-        ret = sensor.readData(data);
-        if (ret != ErrorCode::Ok)
+        else
         {
-            spdlog::error("Failed to read AP3216C data: {}", errorToString(ret));
-            return 1;
+            std::string help = "help";
+            CliSession().executeLine(help);
         }
-
-        spdlog::info("AP3216C Sensor Data:");
-        spdlog::info("  IR (Infrared):  {}", data.ir);
-        spdlog::info("  ALS (Light):    {}", data.als);
-        spdlog::info("  PS (Proximity): {}", data.ps);
-        return 0;
-    }
-
-    case CommandType::Unknown:
-    default:
-        spdlog::error("Unknown command");
-        CliParser::printHelp();
         return 1;
     }
+
+    // 处理命令（run/shell 在同一会话中逐行执行，设备在命令之间保持打开）
+    CliSession session;
+    return session.execute(args);
 }
@@ -0,0 +1,518 @@
+#include "cli_registry.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace bsp
+{
+
+namespace
+{
+
+const CommandSpec *commands[CommandRegistry::MAX_COMMANDS];
+std::size_t commandCount = 0;
+
+// 帮助信息中说明文字的起始列
+constexpr int HELP_COLUMN = 33;
+
+bool isOption(const ArgSpec &arg)
+{
+    return arg.name[0] == '-';
+}
+
+// 把 token 复制到以 '\0' 结尾的栈缓冲区，供 strtol/strtod 使用
+bool copyToken(StrRef token, char (&buf)[64])
+{
+    if (token.size == 0 || token.size >= sizeof(buf))
+    {
+        return false;
+    }
+    std::memcpy(buf, token.data, token.size);
+    buf[token.size] = '\0';
+    return true;
+}
+
+bool parseLong(StrRef token, long &value)
+{
+    char buf[64];
+    if (!copyToken(token, buf))
+    {
+        return false;
+    }
+    char *end = nullptr;
+    value = std::strtol(buf, &end, 10);
+    return *end == '\0' && value >= 0;
+}
+
+bool parseDouble(StrRef token, double &value)
+{
+    char buf[64];
+    if (!copyToken(token, buf))
+    {
+        return false;
+    }
+    char *end = nullptr;
+    value = std::strtod(buf, &end);
+    return end != buf && *end == '\0' && value >= 0.0;
+}
+
+bool parseDuration(StrRef token, long &us)
+{
+    char buf[64];
+    if (!copyToken(token, buf))
+    {
+        return false;
+    }
+    char *end = nullptr;
+    double value = std::strtod(buf, &end);
+    if (end == buf || value < 0.0)
+    {
+        return false;
+    }
+
+    double scale = 1000.0;
+    if (std::strcmp(end, "us") == 0)
+    {
+        scale = 1.0;
+    }
+    else if (std::strcmp(end, "s") == 0)
+    {
+        scale = 1000000.0;
+    }
+    else if (*end != '\0' && std::strcmp(end, "ms") != 0)
+    {
+        return false;
+    }
+    us = static_cast<long>(value * scale);
+    return true;
+}
+
+bool validate(const ArgSpec &arg, StrRef value)
+{
+    long l;
+    double d;
+    switch (arg.kind)
+    {
+    case ArgKind::Choice:
+        return matchAlternatives(arg.choices, value);
+    case ArgKind::Int:
+        return parseLong(value, l);
+    case ArgKind::Double:
+        return parseDouble(value, d);
+    case ArgKind::Duration:
+        return parseDuration(value, l);
+    case ArgKind::Word:
+    case ArgKind::Flag:
+    default:
+        return true;
+    }
+}
+
+// 候选列表中的第一项，如 "--keep-going|-k" -> "--keep-going"
+StrRef primaryName(const char *alternatives)
+{
+    const char *bar = std::strchr(alternatives, '|');
+    return StrRef(alternatives, bar ? static_cast<std::size_t>(bar - alternatives) : std::strlen(alternatives));
+}
+
+void setError(char (&text)[96], const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+void setError(char (&text)[96], const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+}
+
+// 参数的占位说明，如 <dev_name>、[prom|json]、--rate <rate>
+int formatArg(char *buf, std::size_t len, const ArgSpec &arg)
+{
+    StrRef name = primaryName(arg.name);
+    if (isOption(arg))
+    {
+        if (arg.kind == ArgKind::Flag)
+        {
+            return std::snprintf(buf, len, "[%s]", arg.name);
+        }
+        StrRef stem = name;
+        while (stem.size > 0 && stem.data[0] == '-')
+        {
+            ++stem.data;
+            --stem.size;
+        }
+        if (arg.kind == ArgKind::Choice)
+        {
+            return std::snprintf(buf, len, "[%.*s <%s>]", static_cast<int>(name.size), name.data, arg.choices);
+        }
+        return std::snprintf(buf, len, "[%.*s <%.*s>]", static_cast<int>(name.size), name.data,
+                             static_cast<int>(stem.size), stem.data);
+    }
+
+    const char *label = (arg.kind == ArgKind::Choice) ? arg.choices : arg.name;
+    return std::snprintf(buf, len, arg.defaultValue ? "[%s]" : "<%s>", label);
+}
+
+// 累加 snprintf 的返回值（未截断时的长度）并收敛到缓冲区末尾，之后的 size - n 不会回绕
+void advance(int &n, int written, std::size_t size)
+{
+    if (written > 0)
+    {
+        n += written;
+    }
+    if (n > static_cast<int>(size) - 1)
+    {
+        n = static_cast<int>(size) - 1;
+    }
+}
+
+void printCommand(const CommandSpec &spec)
+{
+    char usage[256];
+    int n = 0;
+
+    // 单级命令列出全部别名（如 "-h, --help"），两级命令只显示主名称
+    if (spec.verb == nullptr)
+    {
+        for (const char *p = spec.group; *p != '\0'; ++p)
+        {
+            if (*p == '|')
+            {
+                advance(n, std::snprintf(usage + n, sizeof(usage) - n, ", "), sizeof(usage));
+            }
+            else if (n < static_cast<int>(sizeof(usage)) - 1)
+            {
+                usage[n++] = *p;
+                usage[n] = '\0';
+            }
+        }
+    }
+    else
+    {
+        StrRef group = primaryName(spec.group);
+        StrRef verb = primaryName(spec.verb);
+        advance(n,
+                std::snprintf(usage, sizeof(usage), "%.*s %.*s", static_cast<int>(group.size), group.data,
+                              static_cast<int>(verb.size), verb.data),
+                sizeof(usage));
+    }
+
+    // 位置参数写在用法行中，选项另起一行说明
+    bool hasOptions = false;
+    for (std::size_t i = 0; i < spec.argCount && n < static_cast<int>(sizeof(usage)) - 1; ++i)
+    {
+        if (isOption(spec.args[i]))
+        {
+            hasOptions = true;
+            continue;
+        }
+        usage[n++] = ' ';
+        usage[n] = '\0';
+        advance(n, formatArg(usage + n, sizeof(usage) - n, spec.args[i]), sizeof(usage));
+    }
+    if (hasOptions && n < static_cast<int>(sizeof(usage)) - 12)
+    {
+        advance(n, std::snprintf(usage + n, sizeof(usage) - n, " [options]"), sizeof(usage));
+    }
+
+    if (n + 2 < HELP_COLUMN)
+    {
+        std::printf("  %-*s%s\n", HELP_COLUMN - 2, usage, spec.help);
+    }
+    else
+    {
+        std::printf("  %s\n%*s%s\n", usage, HELP_COLUMN, "", spec.help);
+    }
+
+    for (std::size_t i = 0; i < spec.argCount; ++i)
+    {
+        const ArgSpec &arg = spec.args[i];
+        if (!isOption(arg))
+        {
+            continue;
+        }
+        char option[64];
+        formatArg(option, sizeof(option), arg);
+        // 去掉外层方括号
+        std::size_t len = std::strlen(option);
+        option[len - 1] = '\0';
+        std::printf("%*s%-22s %s", HELP_COLUMN, "", option + 1, arg.help);
+        if (arg.defaultValue && arg.kind != ArgKind::Flag)
+        {
+            std::printf(" (default %s)", arg.defaultValue);
+        }
+        std::printf("\n");
+    }
+
+    if (spec.example)
+    {
+        std::printf("%*sExample: %s\n", HELP_COLUMN, "", spec.example);
+    }
+}
+
+} // namespace
+
+bool matchAlternatives(const char *alternatives, StrRef token)
+{
+    const char *p = alternatives;
+    while (true)
+    {
+        const char *bar = std::strchr(p, '|');
+        std::size_t len = bar ? static_cast<std::size_t>(bar - p) : std::strlen(p);
+        if (len == token.size && std::memcmp(p, token.data, len) == 0)
+        {
+            return true;
+        }
+        if (bar == nullptr)
+        {
+            return false;
+        }
+        p = bar + 1;
+    }
+}
+
+constexpr std::size_t ParsedArgs::MAX_ARGS;
+constexpr std::size_t CommandRegistry::MAX_COMMANDS;
+constexpr std::size_t CommandRegistry::MAX_TOKENS;
+
+ParsedArgs::ParsedArgs() : command(nullptr)
+{
+    for (std::size_t i = 0; i < MAX_ARGS; ++i)
+    {
+        present[i] = false;
+    }
+    errorText[0] = '\0';
+}
+
+long ParsedArgs::toLong(std::size_t index) const
+{
+    long value = 0;
+    parseLong(values[index], value);
+    return value;
+}
+
+double ParsedArgs::toDouble(std::size_t index) const
+{
+    double value = 0.0;
+    parseDouble(values[index], value);
+    return value;
+}
+
+long ParsedArgs::durationUs(std::size_t index) const
+{
+    long value = 0;
+    parseDuration(values[index], value);
+    return value;
+}
+
+bool CommandRegistry::add(const CommandSpec *specs, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (commandCount >= MAX_COMMANDS || specs[i].argCount > ParsedArgs::MAX_ARGS)
+        {
+            return false;
+        }
+        commands[commandCount++] = &specs[i];
+    }
+    return true;
+}
+
+std::size_t CommandRegistry::size()
+{
+    return commandCount;
+}
+
+const CommandSpec &CommandRegistry::at(std::size_t index)
+{
+    return *commands[index];
+}
+
+ErrorCode CommandRegistry::parse(const StrRef *tokens, std::size_t count, ParsedArgs &out)
+{
+    out.command = nullptr;
+    out.errorText[0] = '\0';
+    if (count == 0)
+    {
+        setError(out.errorText, "no command");
+        return ErrorCode::InvalidParam;
+    }
+
+    // 查找子命令
+    const CommandSpec *spec = nullptr;
+    bool groupKnown = false;
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < commandCount && spec == nullptr; ++i)
+    {
+        const CommandSpec &candidate = *commands[i];
+        if (!matchAlternatives(candidate.group, tokens[0]))
+        {
+            continue;
+        }
+        groupKnown = true;
+        if (candidate.verb == nullptr)
+        {
+            spec = &candidate;
+            next = 1;
+        }
+        else if (count >= 2 && matchAlternatives(candidate.verb, tokens[1]))
+        {
+            spec = &candidate;
+            next = 2;
+        }
+    }
+    if (spec == nullptr)
+    {
+        if (groupKnown && count >= 2)
+        {
+            setError(out.errorText, "unknown subcommand '%.*s %.*s'", static_cast<int>(tokens[0].size),
+                     tokens[0].data, static_cast<int>(tokens[1].size), tokens[1].data);
+        }
+        else if (groupKnown)
+        {
+            setError(out.errorText, "missing subcommand for '%.*s'", static_cast<int>(tokens[0].size),
+                     tokens[0].data);
+        }
+        else
+        {
+            setError(out.errorText, "unknown command '%.*s'", static_cast<int>(tokens[0].size), tokens[0].data);
+        }
+        return ErrorCode::InvalidParam;
+    }
+
+    out.command = spec;
+    for (std::size_t i = 0; i < spec->argCount; ++i)
+    {
+        out.present[i] = false;
+        out.values[i] = spec->args[i].defaultValue ? StrRef(spec->args[i].defaultValue) : StrRef();
+    }
+
+    // 依次匹配选项和位置参数
+    std::size_t positional = 0;
+    for (std::size_t t = next; t < count; ++t)
+    {
+        StrRef token = tokens[t];
+        std::size_t index = spec->argCount;
+
+        if (token.size > 1 && token.data[0] == '-')
+        {
+            for (std::size_t i = 0; i < spec->argCount; ++i)
+            {
+                if (isOption(spec->args[i]) && matchAlternatives(spec->args[i].name, token))
+                {
+                    index = i;
+                    break;
+                }
+            }
+            if (index == spec->argCount)
+            {
+                setError(out.errorText, "unknown option '%.*s'", static_cast<int>(token.size), token.data);
+                return ErrorCode::InvalidParam;
+            }
+            if (spec->args[index].kind == ArgKind::Flag)
+            {
+                out.present[index] = true;
+                out.values[index] = StrRef("1");
+                continue;
+            }
+            if (t + 1 >= count)
+            {
+                setError(out.errorText, "option '%.*s' needs a value", static_cast<int>(token.size), token.data);
+                return ErrorCode::InvalidParam;
+            }
+            token = tokens[++t];
+        }
+        else
+        {
+            while (positional < spec->argCount && isOption(spec->args[positional]))
+            {
+                ++positional;
+            }
+            if (positional == spec->argCount)
+            {
+                setError(out.errorText, "unexpected argument '%.*s'", static_cast<int>(token.size), token.data);
+                return ErrorCode::InvalidParam;
+            }
+            index = positional++;
+        }
+
+        if (!validate(spec->args[index], token))
+        {
+            setError(out.errorText, "invalid value '%.*s' for %s", static_cast<int>(token.size), token.data,
+                     spec->args[index].name);
+            return ErrorCode::InvalidParam;
+        }
+        out.present[index] = true;
+        out.values[index] = token;
+    }
+
+    for (std::size_t i = 0; i < spec->argCount; ++i)
+    {
+        if (!isOption(spec->args[i]) && spec->args[i].defaultValue == nullptr && !out.present[i])
+        {
+            setError(out.errorText, "missing argument <%s>", spec->args[i].name);
+            return ErrorCode::InvalidParam;
+        }
+    }
+    return ErrorCode::Ok;
+}
+
+std::size_t CommandRegistry::splitLine(char *line, StrRef *tokens, std::size_t maxTokens)
+{
+    std::size_t count = 0;
+    char *p = line;
+    while (*p != '\0')
+    {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+        {
+            ++p;
+        }
+        if (*p == '\0' || *p == '#')
+        {
+            break;
+        }
+
+        char *start = p;
+        while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+        {
+            ++p;
+        }
+        if (count < maxTokens)
+        {
+            tokens[count++] = StrRef(start, static_cast<std::size_t>(p - start));
+        }
+        if (*p != '\0')
+        {
+            *p++ = '\0';
+        }
+    }
+    return count;
+}
+
+void CommandRegistry::printUsage(const CommandSpec &spec)
+{
+    printCommand(spec);
+}
+
+void CommandRegistry::printHelp()
+{
+    // 按命令组名排序输出（插入排序保持同组内的注册顺序）
+    const CommandSpec *sorted[MAX_COMMANDS];
+    for (std::size_t i = 0; i < commandCount; ++i)
+    {
+        std::size_t j = i;
+        while (j > 0 && std::strcmp(sorted[j - 1]->group, commands[i]->group) > 0)
+        {
+            sorted[j] = sorted[j - 1];
+            --j;
+        }
+        sorted[j] = commands[i];
+    }
+
+    for (std::size_t i = 0; i < commandCount; ++i)
+    {
+        printCommand(*sorted[i]);
+    }
+}
+
+} // namespace bsp
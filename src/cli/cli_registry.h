@@ -0,0 +1,229 @@
+#ifndef CLI_REGISTRY_H
+#define CLI_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "../common/bsp_common.h"
+
+namespace bsp
+{
+
+class CliSession;
+class ParsedArgs;
+
+/**
+ * @brief 只读字符串引用（C++11 下 std::string_view 的最小替代）
+ *
+ * 不持有内存。由命令行/脚本切分得到的引用都指向以 '\0' 结尾的原始缓冲区。
+ */
+struct StrRef
+{
+    const char *data;
+    std::size_t size;
+
+    constexpr StrRef() : data(""), size(0)
+    {
+    }
+
+    constexpr StrRef(const char *text, std::size_t len) : data(text), size(len)
+    {
+    }
+
+    StrRef(const char *text) : data(text ? text : ""), size(text ? std::strlen(text) : 0)
+    {
+    }
+
+    bool empty() const
+    {
+        return size == 0;
+    }
+
+    bool operator==(StrRef other) const
+    {
+        return size == other.size && std::memcmp(data, other.data, size) == 0;
+    }
+
+    bool operator!=(StrRef other) const
+    {
+        return !(*this == other);
+    }
+
+    std::string str() const
+    {
+        return std::string(data, size);
+    }
+};
+
+/**
+ * @brief 判断 token 是否匹配 "a|b|c" 形式的候选列表中的任意一项
+ */
+bool matchAlternatives(const char *alternatives, StrRef token);
+
+// 参数类型
+enum class ArgKind : uint8_t
+{
+    Word,     // 任意字符串
+    Choice,   // 取值必须是 choices 中的一项
+    Int,      // 非负整数
+    Double,   // 非负浮点数
+    Duration, // 时长："10ms"、"500us"、"2s"，不带单位按毫秒
+    Flag      // 无值开关（仅用于 --option）
+};
+
+/**
+ * @brief 参数描述
+ *
+ * name 以 '-' 开头的是选项（可写成 "--keep-going|-k"），其余为按顺序出现的位置参数。
+ * defaultValue 为 nullptr 的位置参数是必填参数。
+ */
+struct ArgSpec
+{
+    const char *name;
+    ArgKind kind;
+    const char *choices;      // Choice 的候选值 "on|off"
+    const char *defaultValue; // 缺省值，nullptr 表示无
+    const char *help;
+};
+
+// 参数表的长度，用于填写 CommandSpec::argCount
+template <std::size_t N> constexpr std::size_t argCount(const ArgSpec (&)[N])
+{
+    return N;
+}
+
+using CommandHandler = int (*)(CliSession &session, const ParsedArgs &args);
+
+/**
+ * @brief 子命令描述，由各命令模块以常量表的形式注册
+ *
+ * group 和 verb 都支持 "a|b" 形式的别名；verb 为 nullptr 表示单级命令（如 metrics）。
+ */
+struct CommandSpec
+{
+    const char *group;
+    const char *verb;
+    const ArgSpec *args;
+    std::size_t argCount;
+    CommandHandler handler;
+    const char *help;
+    const char *example; // 可为 nullptr
+};
+
+/**
+ * @brief 解析结果：按 ArgSpec 下标保存参数值的引用，不分配内存
+ */
+class ParsedArgs
+{
+public:
+    static constexpr std::size_t MAX_ARGS = 12;
+
+    ParsedArgs();
+
+    const CommandSpec *spec() const
+    {
+        return command;
+    }
+
+    // 参数是否在命令行中出现
+    bool has(std::size_t index) const
+    {
+        return present[index];
+    }
+
+    // 参数值（未出现时为缺省值，无缺省值时为空）
+    StrRef get(std::size_t index) const
+    {
+        return values[index];
+    }
+
+    std::string str(std::size_t index) const
+    {
+        return values[index].str();
+    }
+
+    bool is(std::size_t index, const char *value) const
+    {
+        return values[index] == StrRef(value);
+    }
+
+    long toLong(std::size_t index) const;
+    double toDouble(std::size_t index) const;
+    long durationUs(std::size_t index) const;
+
+    // 解析失败时的错误描述
+    const char *error() const
+    {
+        return errorText;
+    }
+
+private:
+    friend class CommandRegistry;
+
+    const CommandSpec *command;
+    StrRef values[MAX_ARGS];
+    bool present[MAX_ARGS];
+    char errorText[96];
+};
+
+/**
+ * @brief 子命令注册表
+ *
+ * 注册表是固定大小的指针数组，各命令模块在静态初始化阶段通过 CommandRegistrar
+ * 注册自己的常量表；查找与参数解析过程均不分配内存。
+ */
+class CommandRegistry
+{
+public:
+    static constexpr std::size_t MAX_COMMANDS = 64;
+    static constexpr std::size_t MAX_TOKENS = 32;
+
+    /**
+     * @brief 注册一组子命令（超过容量时忽略并返回 false）
+     */
+    static bool add(const CommandSpec *specs, std::size_t count);
+
+    /**
+     * @brief 按 token 序列查找子命令并解析参数
+     * @param tokens 命令 token（不含程序名）
+     * @param count token 个数
+     * @param out 解析结果；失败时 out.error() 给出原因
+     * @return ErrorCode::Ok 成功；InvalidParam 未知命令或参数错误
+     */
+    static ErrorCode parse(const StrRef *tokens, std::size_t count, ParsedArgs &out);
+
+    /**
+     * @brief 原地切分一行文本（空白分隔，# 之后为注释），分隔符被改写为 '\0'
+     * @return token 个数（超过 maxTokens 的部分被忽略）
+     */
+    static std::size_t splitLine(char *line, StrRef *tokens, std::size_t maxTokens);
+
+    /**
+     * @brief 打印所有子命令的用法
+     */
+    static void printHelp();
+
+    /**
+     * @brief 打印单个子命令的用法
+     */
+    static void printUsage(const CommandSpec &spec);
+
+    static std::size_t size();
+    static const CommandSpec &at(std::size_t index);
+};
+
+/**
+ * @brief 静态注册辅助：在命令模块中定义一个全局对象即可完成注册
+ */
+struct CommandRegistrar
+{
+    template <std::size_t N> explicit CommandRegistrar(const CommandSpec (&specs)[N])
+    {
+        CommandRegistry::add(specs, N);
+    }
+};
+
+} // namespace bsp
+
+#endif // CLI_REGISTRY_H
@@ -0,0 +1,94 @@
+#include "cli_session.h"
+#include <cstdio>
+#include <unistd.h>
+
+namespace bsp
+{
+
+CliSession::CliSession() : scriptDepth(0), quit(false)
+{
+}
+
+CliSession::~CliSession()
+{
+    // 按打开的逆序关闭设备
+    while (!devices.empty())
+    {
+        devices.pop_back();
+    }
+}
+
+int CliSession::execute(const ParsedArgs &args)
+{
+    return args.spec()->handler(*this, args);
+}
+
+int CliSession::executeLine(std::string &line)
+{
+    StrRef tokens[CommandRegistry::MAX_TOKENS];
+    std::size_t count = CommandRegistry::splitLine(&line[0], tokens, CommandRegistry::MAX_TOKENS);
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    ParsedArgs args;
+    if (CommandRegistry::parse(tokens, count, args) != ErrorCode::Ok)
+    {
+        spdlog::error("{}", args.error());
+        return 1;
+    }
+    return execute(args);
+}
+
+int CliSession::runScript(std::istream &in, bool interactive, bool keepGoing)
+{
+    const bool prompt = interactive && isatty(STDIN_FILENO);
+    ++scriptDepth;
+    quit = false;
+
+    int result = 0;
+    long lineNo = 0;
+    std::string line;
+    std::string original;
+    while (!quit)
+    {
+        if (prompt)
+        {
+            std::fputs("bsp> ", stdout);
+            std::fflush(stdout);
+        }
+        if (!std::getline(in, line))
+        {
+            break;
+        }
+        ++lineNo;
+
+        if (!interactive)
+        {
+            original = line; // 切分会改写 line，保留原文用于报错
+        }
+        if (executeLine(line) != 0)
+        {
+            result = 1;
+            if (!interactive)
+            {
+                spdlog::error("line {}: command failed: {}", lineNo, original);
+                if (!keepGoing)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (prompt && !quit)
+    {
+        std::fputs("\n", stdout);
+    }
+    quit = false;
+    --scriptDepth;
+    return interactive ? 0 : result;
+}
+
+} // namespace bsp
@@ -0,0 +1,126 @@
+#ifndef CLI_SESSION_H
+#define CLI_SESSION_H
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "cli_registry.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 命令执行会话
+ *
+ * 单条命令和脚本/交互模式共用同一套执行逻辑。会话内按设备名缓存已打开的设备，
+ * 同一脚本中对同一设备的多条命令只打开一次，会话结束时统一关闭。
+ */
+class CliSession
+{
+public:
+    CliSession();
+    ~CliSession();
+
+    CliSession(const CliSession &) = delete;
+    CliSession &operator=(const CliSession &) = delete;
+
+    /**
+     * @brief 执行一条已解析的命令
+     * @return 进程退出码（0 成功）
+     */
+    int execute(const ParsedArgs &args);
+
+    /**
+     * @brief 原地切分、解析并执行一行文本命令（# 之后为注释）
+     * @param line 命令行文本，会被改写
+     * @return 退出码；空行和注释返回 0
+     */
+    int executeLine(std::string &line);
+
+    /**
+     * @brief 逐行执行命令流
+     * @param in 输入流（脚本文件或标准输入）
+     * @param interactive 交互模式：打印提示符，出错后继续
+     * @param keepGoing 非交互模式下出错后是否继续
+     * @return 全部成功返回 0，否则返回 1
+     */
+    int runScript(std::istream &in, bool interactive, bool keepGoing);
+
+    // 是否正在执行脚本（脚本中禁止嵌套 run/shell）
+    bool inScript() const
+    {
+        return scriptDepth > 0;
+    }
+
+    // 结束交互模式（exit/quit）
+    void requestQuit()
+    {
+        quit = true;
+    }
+
+    /**
+     * @brief 按设备名获取已打开的设备，首次使用时创建并 init()
+     * @return 设备指针；初始化失败返回 nullptr
+     */
+    template <typename Device> Device *device(StrRef name)
+    {
+        for (auto &cached : devices)
+        {
+            if (cached->type == typeTag<Device>() && StrRef(cached->name.c_str(), cached->name.size()) == name)
+            {
+                return &static_cast<Holder<Device> *>(cached.get())->device;
+            }
+        }
+
+        std::unique_ptr<Holder<Device>> holder(new Holder<Device>(name.str()));
+        ErrorCode ret = holder->device.init();
+        if (ret != ErrorCode::Ok)
+        {
+            spdlog::error("Failed to init {}: {}", holder->name, errorToString(ret));
+            return nullptr;
+        }
+        Device *raw = &holder->device;
+        devices.push_back(std::move(holder));
+        return raw;
+    }
+
+private:
+    // 类型擦除的设备缓存项，新增驱动无需修改会话
+    struct CachedDevice
+    {
+        CachedDevice(const void *type, const std::string &name) : type(type), name(name)
+        {
+        }
+        virtual ~CachedDevice()
+        {
+        }
+
+        const void *type;
+        std::string name;
+    };
+
+    template <typename Device> struct Holder : CachedDevice
+    {
+        explicit Holder(const std::string &name) : CachedDevice(typeTag<Device>(), name), device(name)
+        {
+        }
+
+        Device device;
+    };
+
+    template <typename Device> static const void *typeTag()
+    {
+        static const char tag = 0;
+        return &tag;
+    }
+
+    std::vector<std::unique_ptr<CachedDevice>> devices;
+    int scriptDepth;
+    bool quit;
+};
+
+} // namespace bsp
+
+#endif // CLI_SESSION_H
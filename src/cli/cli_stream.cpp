@@ -0,0 +1,555 @@
+#include "cli_stream.h"
+#include "../common/metrics.h"
+#include "../common/trace.h"
+#include "../driver/ap3216c/ap3216c.h"
+#include "../driver/dht11/dht11.h"
+#include "../driver/key/key.h"
+#include "../driver/led/led.h"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+namespace bsp
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// 输出缓冲区大小（样本先攒在 stdio 缓冲中，减少 write 系统调用）
+constexpr std::size_t OUTPUT_BUFFER_SIZE = 64 * 1024;
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void onStopSignal(int)
+{
+    stopRequested = 1;
+}
+
+// 命令执行期间 Ctrl-C / SIGTERM 只置标志；不设置 SA_RESTART，使睡眠立即被打断。
+// run/shell 会在同一进程中连续执行多条命令：进入时清除上一条命令留下的标志，退出时恢复原来的处理方式
+class StopSignalScope
+{
+public:
+    StopSignalScope()
+    {
+        stopRequested = 0;
+        struct sigaction sa;
+        std::memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = onStopSignal;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGINT, &sa, &previousInt);
+        sigaction(SIGTERM, &sa, &previousTerm);
+    }
+
+    ~StopSignalScope()
+    {
+        sigaction(SIGINT, &previousInt, nullptr);
+        sigaction(SIGTERM, &previousTerm, nullptr);
+    }
+
+    StopSignalScope(const StopSignalScope &) = delete;
+    StopSignalScope &operator=(const StopSignalScope &) = delete;
+
+private:
+    struct sigaction previousInt;
+    struct sigaction previousTerm;
+};
+
+uint64_t toNs(Clock::duration d)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+
+// 按绝对时间睡眠（steady_clock 即 CLOCK_MONOTONIC），不会随采样耗时累积漂移
+void sleepUntil(Clock::time_point deadline)
+{
+    uint64_t ns = toNs(deadline.time_since_epoch());
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000ULL);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000ULL);
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+}
+
+// 样本输出：stdout 或文件，带大缓冲区
+class SampleWriter
+{
+public:
+    SampleWriter() : file(nullptr), owned(false), buffer(OUTPUT_BUFFER_SIZE)
+    {
+    }
+
+    ~SampleWriter()
+    {
+        close();
+    }
+
+    bool open(const std::string &path, bool text)
+    {
+        if (path.empty())
+        {
+            file = stdout;
+            // 终端上交互查看文本输出时按行刷新
+            int mode = (text && isatty(STDOUT_FILENO)) ? _IOLBF : _IOFBF;
+            std::setvbuf(file, buffer.data(), mode, buffer.size());
+            return true;
+        }
+
+        file = std::fopen(path.c_str(), text ? "w" : "wb");
+        if (file == nullptr)
+        {
+            spdlog::error("open {} failed: {}", path, std::strerror(errno));
+            return false;
+        }
+        owned = true;
+        std::setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+        return true;
+    }
+
+    void write(const void *data, std::size_t len)
+    {
+        std::fwrite(data, 1, len, file);
+    }
+
+    // 关闭并返回是否全部写入成功
+    bool close()
+    {
+        if (file == nullptr)
+        {
+            return true;
+        }
+        bool ok = std::fflush(file) == 0 && !std::ferror(file);
+        if (owned)
+        {
+            ok = (std::fclose(file) == 0) && ok;
+        }
+        else
+        {
+            std::setvbuf(file, nullptr, _IOLBF, 0);
+        }
+        file = nullptr;
+        owned = false;
+        return ok;
+    }
+
+private:
+    FILE *file;
+    bool owned;
+    std::vector<char> buffer;
+};
+
+struct RunStats
+{
+    uint64_t ok;
+    uint64_t errors;
+    uint64_t overruns; // 采样耗时超过周期、错过下一个采样点的次数
+    LatencyHistogram latency;
+    Clock::duration elapsed;
+
+    RunStats() : ok(0), errors(0), overruns(0), elapsed(Clock::duration::zero())
+    {
+    }
+};
+
+/**
+ * @brief 采样主循环
+ * @param rate 采样率(Hz)，0 表示不限速
+ * @param count 读取次数，0 表示直到收到停止信号
+ * @param readFn 执行一次读取，返回 ErrorCode（只统计它的耗时）
+ * @param emitFn 读取成功后输出样本，参数为相对开始的时间(ns)
+ */
+template <typename ReadFn, typename EmitFn> RunStats runLoop(double rate, long count, ReadFn readFn, EmitFn emitFn)
+{
+    RunStats stats;
+    const bool paced = rate > 0.0 && rate < 1e9;
+    const Clock::duration period =
+        paced ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate))
+              : Clock::duration::zero();
+
+    const Clock::time_point start = Clock::now();
+    Clock::time_point next = start;
+    uint64_t done = 0;
+
+    while (!stopRequested && (count == 0 || done < static_cast<uint64_t>(count)))
+    {
+        if (paced)
+        {
+            sleepUntil(next);
+            if (stopRequested)
+            {
+                break;
+            }
+        }
+
+        const Clock::time_point t0 = Clock::now();
+        ErrorCode ret = readFn();
+        const Clock::time_point t1 = Clock::now();
+        stats.latency.record(toNs(t1 - t0));
+        ++done;
+
+        if (ret == ErrorCode::Ok)
+        {
+            ++stats.ok;
+            emitFn(toNs(t0 - start));
+        }
+        else
+        {
+            ++stats.errors;
+        }
+
+        if (paced)
+        {
+            next += period;
+            // 落后超过一个周期时不补采，从当前时刻重新对齐，避免突发
+            if (t1 > next)
+            {
+                ++stats.overruns;
+                next = t1;
+            }
+        }
+    }
+
+    stats.elapsed = Clock::now() - start;
+    return stats;
+}
+
+void printSummary(const std::string &title, double rate, const RunStats &stats)
+{
+    const double seconds = std::chrono::duration<double>(stats.elapsed).count();
+    const uint64_t total = stats.ok + stats.errors;
+    const LatencyHistogram &h = stats.latency;
+
+    std::fprintf(stderr, "[%s] %llu ops (%llu ok, %llu errors) in %.3f s\n", title.c_str(),
+                 static_cast<unsigned long long>(total), static_cast<unsigned long long>(stats.ok),
+                 static_cast<unsigned long long>(stats.errors), seconds);
+    std::fprintf(stderr, "  throughput: %.2f ops/s", seconds > 0.0 ? static_cast<double>(total) / seconds : 0.0);
+    if (rate > 0.0)
+    {
+        std::fprintf(stderr, " (target %.2f Hz, %llu overruns)", rate, static_cast<unsigned long long>(stats.overruns));
+    }
+    std::fprintf(stderr, "\n");
+    if (h.count > 0)
+    {
+        std::fprintf(stderr,
+                     "  latency(us): min %.1f  mean %.1f  p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+                     h.minNs / 1000.0, h.mean() / 1000.0, h.valueAtQuantile(0.5) / 1000.0,
+                     h.valueAtQuantile(0.9) / 1000.0, h.valueAtQuantile(0.99) / 1000.0,
+                     h.valueAtQuantile(0.999) / 1000.0, h.maxNs / 1000.0);
+    }
+}
+
+// 按设备名（/dev/<name>）或显式节点路径创建并初始化设备
+template <typename Device>
+std::unique_ptr<Device> openDevice(DeviceType type, const std::string &name, const std::string &path)
+{
+    std::unique_ptr<Device> device;
+    if (path.empty())
+    {
+        device.reset(new Device(name));
+    }
+    else
+    {
+        device.reset(new Device(makeDeviceEntry(type, name.c_str(), path.c_str())));
+    }
+
+    ErrorCode ret = device->init();
+    if (ret != ErrorCode::Ok)
+    {
+        spdlog::error("Failed to init {} {}: {}", deviceTypeToString(type), name, errorToString(ret));
+        device.reset();
+    }
+    return device;
+}
+
+// 追踪会话：路径非空时构造即开启追踪，finish() 或析构时关闭并导出，
+// 打开设备失败等提前返回的路径也会关闭追踪，不影响 run/shell 中之后的命令
+class TraceSession
+{
+public:
+    explicit TraceSession(const std::string &tracePath) : path(tracePath), active(!tracePath.empty())
+    {
+        if (active)
+        {
+            Trace::enable();
+        }
+    }
+
+    ~TraceSession()
+    {
+        finish();
+    }
+
+    TraceSession(const TraceSession &) = delete;
+    TraceSession &operator=(const TraceSession &) = delete;
+
+    void finish()
+    {
+        if (!active)
+        {
+            return;
+        }
+        active = false;
+        Trace::disable();
+        ErrorCode ret = Trace::dump(path);
+        if (ret != ErrorCode::Ok)
+        {
+            spdlog::error("Failed to write trace {}: {}", path, errorToString(ret));
+        }
+        else
+        {
+            spdlog::info("trace written to {}", path);
+        }
+    }
+
+private:
+    std::string path;
+    bool active;
+};
+
+// 以 CSV 或二进制记录输出一个样本
+void emitSample(SampleWriter &out, StreamFormat format, uint64_t ts, const AP3216CData &data)
+{
+    if (format == StreamFormat::Binary)
+    {
+        AP3216CRecord record = {ts, data.ir, data.als, data.ps, 0};
+        out.write(&record, sizeof(record));
+        return;
+    }
+    char line[64];
+    int n = std::snprintf(line, sizeof(line), "%llu,%u,%u,%u\n", static_cast<unsigned long long>(ts), data.ir,
+                          data.als, data.ps);
+    out.write(line, static_cast<std::size_t>(n));
+}
+
+void emitSample(SampleWriter &out, StreamFormat format, uint64_t ts, const DHT11Data &data)
+{
+    if (format == StreamFormat::Binary)
+    {
+        DHT11Record record = {ts, data.humidity_int, data.humidity_decimal, data.temperature_int,
+                              data.temperature_decimal, 0};
+        out.write(&record, sizeof(record));
+        return;
+    }
+    char line[64];
+    int n = std::snprintf(line, sizeof(line), "%llu,%u.%u,%u.%u\n", static_cast<unsigned long long>(ts),
+                          data.humidity_int, data.humidity_decimal, data.temperature_int, data.temperature_decimal);
+    out.write(line, static_cast<std::size_t>(n));
+}
+
+template <typename Sensor, typename Data>
+int streamSensor(const StreamCommandArgs &args, DeviceType type, const char *csvHeader)
+{
+    SampleWriter out;
+    if (!out.open(args.output, args.format == StreamFormat::Csv))
+    {
+        return 1;
+    }
+
+    TraceSession trace(args.trace_path);
+    std::unique_ptr<Sensor> sensor = openDevice<Sensor>(type, args.dev_name, args.dev_path);
+    if (!sensor)
+    {
+        return 1;
+    }
+
+    if (args.format == StreamFormat::Csv)
+    {
+        out.write(csvHeader, std::strlen(csvHeader));
+    }
+
+    Data data;
+    RunStats stats = runLoop(
+        args.rate, args.count, [&]() { return sensor->readData(data); },
+        [&](uint64_t ts) { emitSample(out, args.format, ts, data); });
+
+    bool written = out.close();
+    trace.finish();
+    printSummary(args.device + " stream", args.rate, stats);
+
+    if (!written)
+    {
+        spdlog::error("Failed to write samples to {}", args.output.empty() ? "stdout" : args.output);
+        return 1;
+    }
+    return stats.errors == 0 ? 0 : 1;
+}
+
+template <typename Sensor, typename Data> int benchSensor(const StreamCommandArgs &args, DeviceType type)
+{
+    TraceSession trace(args.trace_path);
+    std::unique_ptr<Sensor> sensor = openDevice<Sensor>(type, args.dev_name, args.dev_path);
+    if (!sensor)
+    {
+        return 1;
+    }
+
+    Data data;
+    RunStats stats = runLoop(
+        args.rate, args.count, [&]() { return sensor->readData(data); }, [](uint64_t) {});
+
+    trace.finish();
+    printSummary("bench " + args.device, args.rate, stats);
+    return stats.errors == 0 ? 0 : 1;
+}
+
+int benchLed(const StreamCommandArgs &args)
+{
+    TraceSession trace(args.trace_path);
+    std::unique_ptr<Led> led = openDevice<Led>(DeviceType::Led, args.dev_name, args.dev_path);
+    if (!led)
+    {
+        return 1;
+    }
+
+    bool on = false;
+    RunStats stats = runLoop(
+        args.rate, args.count, [&]() { on = !on; return led->setState(on); }, [](uint64_t) {});
+    led->setState(false);
+
+    trace.finish();
+    printSummary("bench led", args.rate, stats);
+    return stats.errors == 0 ? 0 : 1;
+}
+
+} // namespace
+
+StreamCommandArgs streamArgsFrom(const ParsedArgs &args, const char *device)
+{
+    StreamCommandArgs out;
+    out.device = device;
+    out.dev_name = args.str(STREAM_DEV_NAME);
+    out.dev_path = args.str(STREAM_PATH);
+    out.rate = args.toDouble(STREAM_RATE);
+    out.count = args.toLong(STREAM_COUNT);
+    out.trace_path = args.str(STREAM_TRACE);
+    out.format = StreamFormat::Csv;
+    // bench 参数表没有 --format / --output
+    if (args.spec()->argCount > STREAM_OUTPUT)
+    {
+        out.format = args.is(STREAM_FORMAT, "bin") ? StreamFormat::Binary : StreamFormat::Csv;
+        out.output = args.str(STREAM_OUTPUT);
+    }
+    return out;
+}
+
+int runSensorStream(const StreamCommandArgs &args)
+{
+    StopSignalScope stopScope;
+
+    if (args.device == "ap3216c")
+    {
+        return streamSensor<AP3216C, AP3216CData>(args, DeviceType::AP3216C, "timestamp_ns,ir,als,ps\n");
+    }
+    if (args.device == "dht11")
+    {
+        return streamSensor<DHT11, DHT11Data>(args, DeviceType::DHT11, "timestamp_ns,humidity,temperature\n");
+    }
+
+    spdlog::error("stream not supported for {}", args.device);
+    return 1;
+}
+
+int runBench(const StreamCommandArgs &args)
+{
+    StopSignalScope stopScope;
+
+    if (args.device == "ap3216c")
+    {
+        return benchSensor<AP3216C, AP3216CData>(args, DeviceType::AP3216C);
+    }
+    if (args.device == "dht11")
+    {
+        return benchSensor<DHT11, DHT11Data>(args, DeviceType::DHT11);
+    }
+    if (args.device == "led")
+    {
+        return benchLed(args);
+    }
+
+    spdlog::error("bench not supported for {}", args.device);
+    return 1;
+}
+
+int runKeyWatch(const KeyWatchCommandArgs &args)
+{
+    StopSignalScope stopScope;
+
+    std::unique_ptr<Key> key = openDevice<Key>(DeviceType::Key, args.dev_name, args.dev_path);
+    if (!key)
+    {
+        return 1;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    long events = 0;
+    long byValue[3] = {0, 0, 0}; // 释放 / 按下 / 长按
+    const Clock::time_point start = Clock::now();
+
+    std::printf("timestamp_ns,code,value\n");
+    std::fflush(stdout);
+
+    key->setCallback([&](int code, int value) {
+        uint64_t ts = toNs(Clock::now() - start);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (args.count != 0 && events >= args.count)
+            {
+                return;
+            }
+            ++events;
+            if (value >= 0 && value <= 2)
+            {
+                ++byValue[value];
+            }
+        }
+        std::printf("%llu,%d,%d\n", static_cast<unsigned long long>(ts), code, value);
+        std::fflush(stdout);
+        cond.notify_one();
+    });
+
+    ErrorCode ret = key->start();
+    if (ret != ErrorCode::Ok)
+    {
+        spdlog::error("Failed to start key {}: {}", args.dev_name, errorToString(ret));
+        return 1;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopRequested && (args.count == 0 || events < args.count))
+        {
+            // 信号处理函数不能通知条件变量，定期检查停止标志
+            cond.wait_for(lock, std::chrono::milliseconds(100));
+        }
+    }
+    key->stop();
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::fprintf(stderr, "[key watch] %ld events (%ld press, %ld release, %ld long) in %.3f s, %.2f events/s\n", events,
+                 byValue[1], byValue[0], byValue[2], seconds, seconds > 0.0 ? events / seconds : 0.0);
+
+    if (Metrics::enabled())
+    {
+        MetricsSnapshot snapshot = Metrics::snapshot();
+        const LatencyHistogram &h = snapshot[MetricOp::KeyDispatch].latency;
+        if (h.count > 0)
+        {
+            std::fprintf(stderr, "  callback latency(us): p50 %.1f  p99 %.1f  max %.1f\n",
+                         h.valueAtQuantile(0.5) / 1000.0, h.valueAtQuantile(0.99) / 1000.0, h.maxNs / 1000.0);
+        }
+    }
+    return 0;
+}
+
+} // namespace bsp
@@ -0,0 +1,124 @@
+#ifndef CLI_STREAM_H
+#define CLI_STREAM_H
+
+#include <cstdint>
+#include <string>
+#include "cli_registry.h"
+
+namespace bsp
+{
+
+// 采样输出格式
+enum class StreamFormat
+{
+    Csv,   // 文本，每行一个样本
+    Binary // 定长二进制记录（本机字节序）
+};
+
+// stream / bench 命令参数
+struct StreamCommandArgs
+{
+    std::string device;     // 设备类型：ap3216c / dht11 / led（led 仅用于 bench）
+    std::string dev_name;   // 设备名
+    std::string dev_path;   // 设备节点，空表示 /dev/<dev_name>
+    double rate;            // 采样率(Hz)，0 表示尽可能快
+    long count;             // 采样次数，0 表示直到 Ctrl-C
+    StreamFormat format;    // 输出格式
+    std::string output;     // 输出文件，空表示 stdout
+    std::string trace_path; // 非空时开启事件追踪并在结束时导出
+};
+
+// key watch 命令参数
+struct KeyWatchCommandArgs
+{
+    std::string dev_name; // 设备名
+    std::string dev_path; // 设备节点，空表示 /dev/<dev_name>
+    long count;           // 事件数，0 表示直到 Ctrl-C
+};
+
+// stream / bench 参数表中各参数的下标（BSP_STREAM_ARGS / BSP_BENCH_ARGS 按此顺序展开）
+enum StreamArgIndex
+{
+    STREAM_DEV_NAME,
+    STREAM_RATE,
+    STREAM_COUNT,
+    STREAM_PATH,
+    STREAM_TRACE,
+    STREAM_FORMAT,
+    STREAM_OUTPUT
+};
+
+// 通用 bench 参数表
+#define BSP_BENCH_ARGS(defaultName)                                                                          \
+    {"dev_name", ::bsp::ArgKind::Word, nullptr, defaultName, "Device name"},                                 \
+        {"--rate", ::bsp::ArgKind::Double, nullptr, "0", "Operations per second, 0 = as fast as possible"},  \
+        {"--count", ::bsp::ArgKind::Int, nullptr, "10000", "Number of operations"},                          \
+        {"--path", ::bsp::ArgKind::Word, nullptr, nullptr, "Device node instead of /dev/<dev_name>"},        \
+        {"--trace", ::bsp::ArgKind::Word, nullptr, nullptr, "Write a Chrome trace of the run"}
+
+// 通用 stream 参数表
+#define BSP_STREAM_ARGS(defaultName)                                                                         \
+    {"dev_name", ::bsp::ArgKind::Word, nullptr, defaultName, "Device name"},                                 \
+        {"--rate", ::bsp::ArgKind::Double, nullptr, "10", "Sample rate in Hz, 0 = as fast as possible"},     \
+        {"--count", ::bsp::ArgKind::Int, nullptr, "0", "Number of samples, 0 = until Ctrl-C"},               \
+        {"--path", ::bsp::ArgKind::Word, nullptr, nullptr, "Device node instead of /dev/<dev_name>"},        \
+        {"--trace", ::bsp::ArgKind::Word, nullptr, nullptr, "Write a Chrome trace of the run"},              \
+        {"--format", ::bsp::ArgKind::Choice, "csv|bin", "csv", "Output format"},                             \
+        {"--output", ::bsp::ArgKind::Word, nullptr, nullptr, "Write samples to a file instead of stdout"}
+
+/**
+ * @brief 从按 BSP_STREAM_ARGS / BSP_BENCH_ARGS 定义的解析结果构造参数
+ * @param args 解析结果
+ * @param device 设备类型名
+ */
+StreamCommandArgs streamArgsFrom(const ParsedArgs &args, const char *device);
+
+/**
+ * @brief ap3216c stream --format bin 的输出记录（16 字节，本机字节序）
+ */
+struct AP3216CRecord
+{
+    uint64_t timestamp_ns; // 相对采样开始的时间
+    uint16_t ir;
+    uint16_t als;
+    uint16_t ps;
+    uint16_t reserved;
+};
+
+/**
+ * @brief dht11 stream --format bin 的输出记录（16 字节，本机字节序）
+ */
+struct DHT11Record
+{
+    uint64_t timestamp_ns; // 相对采样开始的时间
+    uint8_t humidity_int;
+    uint8_t humidity_decimal;
+    uint8_t temperature_int;
+    uint8_t temperature_decimal;
+    uint32_t reserved;
+};
+
+/**
+ * @brief 连续采样：设备只打开一次，按固定速率读取并写出样本，结束时向 stderr 打印吞吐与延迟分位数
+ * @param args 命令参数
+ * @return 进程退出码
+ */
+int runSensorStream(const StreamCommandArgs &args);
+
+/**
+ * @brief 基准测试：不输出样本，只统计吞吐与延迟分位数
+ * @param args 命令参数
+ * @return 进程退出码
+ */
+int runBench(const StreamCommandArgs &args);
+
+/**
+ * @brief 监听按键事件并以 CSV 输出（timestamp_ns,code,value）
+ * @param args 命令参数
+ * @return 进程退出码
+ */
+int runKeyWatch(const KeyWatchCommandArgs &args);
+
+} // namespace bsp
+
+#endif // CLI_STREAM_H
@@ -0,0 +1,67 @@
+// AP3216C 命令：ap3216c read / ap3216c stream / bench ap3216c
+#include "cli_registry.h"
+#include "cli_session.h"
+#include "cli_stream.h"
+#include "../driver/ap3216c/ap3216c.h"
+#include "../driver/sensor_units.h"
+
+namespace bsp
+{
+
+namespace
+{
+
+int readHandler(CliSession &session, const ParsedArgs &args)
+{
+    AP3216C *sensor = session.device<AP3216C>(args.get(0));
+    if (sensor == nullptr)
+    {
+        return 1;
+    }
+
+    AP3216CData data;
+    ErrorCode ret = sensor->readData(data);
+    if (ret != ErrorCode::Ok)
+    {
+        spdlog::error("Failed to read AP3216C data: {}", errorToString(ret));
+        return 1;
+    }
+
+    spdlog::info("AP3216C Sensor Data:");
+    spdlog::info("  IR (Infrared):  {}", data.ir);
+    spdlog::info("  ALS (Light):    {} ({:.2f} lx)", data.als, AP3216CConverter().toFloat(data).lux);
+    spdlog::info("  PS (Proximity): {}", data.ps);
+    return 0;
+}
+
+int streamHandler(CliSession &, const ParsedArgs &args)
+{
+    return runSensorStream(streamArgsFrom(args, "ap3216c"));
+}
+
+int benchHandler(CliSession &, const ParsedArgs &args)
+{
+    return runBench(streamArgsFrom(args, "ap3216c"));
+}
+
+const ArgSpec readArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, "ap3216c", "Device name"},
+};
+
+const ArgSpec streamArgs[] = {BSP_STREAM_ARGS("ap3216c")};
+const ArgSpec benchArgs[] = {BSP_BENCH_ARGS("ap3216c")};
+
+const CommandSpec ap3216cCommands[] = {
+    {"ap3216c", "read", readArgs, argCount(readArgs), readHandler, "Read AP3216C sensor data",
+     "bsp_tool ap3216c read ap3216c"},
+    {"ap3216c", "stream", streamArgs, argCount(streamArgs), streamHandler,
+     "Sample continuously with the device kept open", "bsp_tool ap3216c stream --rate 100 --count 1000"},
+    {"bench", "ap3216c", benchArgs, argCount(benchArgs), benchHandler,
+     "Measure AP3216C read throughput and latency percentiles", "bsp_tool bench ap3216c --count 50000"},
+};
+
+CommandRegistrar registrar(ap3216cCommands);
+
+} // namespace
+
+} // namespace bsp
@@ -0,0 +1,146 @@
+// 通用命令：help / version / metrics / sleep / run / shell / exit
+#include "cli_registry.h"
+#include "cli_session.h"
+#include "../common/metrics_export.h"
+#include "../common/metrics_server.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace bsp
+{
+
+namespace
+{
+
+int helpHandler(CliSession &, const ParsedArgs &)
+{
+    std::printf("bsp_tool - BSP Hardware Test Tool\n");
+    std::printf("Version: %d.%d.%d\n\n", VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH);
+    std::printf("Usage: bsp_tool <command> [options]\n\n");
+    std::printf("Commands:\n");
+    CommandRegistry::printHelp();
+    std::printf("\n");
+    return 0;
+}
+
+int versionHandler(CliSession &, const ParsedArgs &)
+{
+    std::printf("bsp_tool version %d.%d.%d\n", VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH);
+    return 0;
+}
+
+enum
+{
+    METRICS_FORMAT,
+    METRICS_SOCKET
+};
+
+int metricsHandler(CliSession &, const ParsedArgs &args)
+{
+    MetricsFormat format = args.is(METRICS_FORMAT, "json") ? MetricsFormat::Json : MetricsFormat::Prometheus;
+    if (!args.has(METRICS_SOCKET))
+    {
+        // 未指定套接字时输出本进程的统计
+        std::fputs(exportMetrics(format).c_str(), stdout);
+        return 0;
+    }
+
+    std::string socketPath = args.str(METRICS_SOCKET);
+    std::string text;
+    ErrorCode ret = fetchMetrics(socketPath, format, text);
+    if (ret != ErrorCode::Ok)
+    {
+        spdlog::error("Failed to fetch metrics from {}: {}", socketPath, errorToString(ret));
+        return 1;
+    }
+    std::fputs(text.c_str(), stdout);
+    return 0;
+}
+
+int sleepHandler(CliSession &, const ParsedArgs &args)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(args.durationUs(0)));
+    return 0;
+}
+
+enum
+{
+    RUN_SCRIPT,
+    RUN_KEEP_GOING
+};
+
+int runHandler(CliSession &session, const ParsedArgs &args)
+{
+    if (session.inScript())
+    {
+        spdlog::error("run cannot be nested in a script");
+        return 1;
+    }
+
+    const bool keepGoing = args.has(RUN_KEEP_GOING);
+    if (args.is(RUN_SCRIPT, "-"))
+    {
+        return session.runScript(std::cin, false, keepGoing);
+    }
+
+    std::string path = args.str(RUN_SCRIPT);
+    std::ifstream file(path.c_str());
+    if (!file)
+    {
+        spdlog::error("open script {} failed", path);
+        return 1;
+    }
+    return session.runScript(file, false, keepGoing);
+}
+
+int shellHandler(CliSession &session, const ParsedArgs &)
+{
+    if (session.inScript())
+    {
+        spdlog::error("shell cannot be nested in a script");
+        return 1;
+    }
+    return session.runScript(std::cin, true, true);
+}
+
+int exitHandler(CliSession &session, const ParsedArgs &)
+{
+    session.requestQuit();
+    return 0;
+}
+
+const ArgSpec metricsArgs[] = {
+    {"format", ArgKind::Choice, "prom|json", "prom", "Output format"},
+    {"--socket", ArgKind::Word, nullptr, nullptr, "Fetch from the MetricsServer on this Unix socket"},
+};
+
+const ArgSpec sleepArgs[] = {
+    {"duration", ArgKind::Duration, nullptr, nullptr, "Time to sleep, e.g. 10ms, 500us, 1s"},
+};
+
+const ArgSpec runArgs[] = {
+    {"script", ArgKind::Word, nullptr, "-", "Script file, - for stdin"},
+    {"--keep-going|-k", ArgKind::Flag, nullptr, nullptr, "Continue after a failed command"},
+};
+
+const CommandSpec builtinCommands[] = {
+    {"help|-h|--help", nullptr, nullptr, 0, helpHandler, "Show this help message", nullptr},
+    {"version|-v|--version", nullptr, nullptr, 0, versionHandler, "Show version information", nullptr},
+    {"metrics", nullptr, metricsArgs, argCount(metricsArgs), metricsHandler, "Print driver metrics (Prometheus text or JSON)",
+     "bsp_tool metrics json --socket /run/bsp.sock"},
+    {"sleep", nullptr, sleepArgs, argCount(sleepArgs), sleepHandler, "Pause a script (default unit ms)", nullptr},
+    {"run", nullptr, runArgs, argCount(runArgs), runHandler,
+     "Run commands from a script file or stdin in one process",
+     "printf 'led set led0 on\\nsleep 10ms\\n' | bsp_tool run"},
+    {"shell", nullptr, nullptr, 0, shellHandler, "Interactive prompt (same commands as run)", nullptr},
+    {"exit|quit", nullptr, nullptr, 0, exitHandler, "Leave the interactive prompt", nullptr},
+};
+
+CommandRegistrar registrar(builtinCommands);
+
+} // namespace
+
+} // namespace bsp
@@ -0,0 +1,67 @@
+// DHT11 命令：dht11 read / dht11 stream / bench dht11
+#include "cli_registry.h"
+#include "cli_session.h"
+#include "cli_stream.h"
+#include "../driver/dht11/dht11.h"
+#include "../driver/sensor_units.h"
+
+namespace bsp
+{
+
+namespace
+{
+
+int readHandler(CliSession &session, const ParsedArgs &args)
+{
+    DHT11 *sensor = session.device<DHT11>(args.get(0));
+    if (sensor == nullptr)
+    {
+        return 1;
+    }
+
+    DHT11Data data;
+    ErrorCode ret = sensor->readData(data);
+    if (ret != ErrorCode::Ok)
+    {
+        spdlog::error("Failed to read DHT11 data: {}", errorToString(ret));
+        return 1;
+    }
+
+    DHT11ReadingF reading = DHT11Converter().toFloat(data);
+    spdlog::info("DHT11 Sensor Data:");
+    spdlog::info("  Humidity:    {:.1f} %RH", reading.humidity);
+    spdlog::info("  Temperature: {:.1f} C", reading.temperature);
+    return 0;
+}
+
+int streamHandler(CliSession &, const ParsedArgs &args)
+{
+    return runSensorStream(streamArgsFrom(args, "dht11"));
+}
+
+int benchHandler(CliSession &, const ParsedArgs &args)
+{
+    return runBench(streamArgsFrom(args, "dht11"));
+}
+
+const ArgSpec readArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, "dht11", "Device name"},
+};
+
+const ArgSpec streamArgs[] = {BSP_STREAM_ARGS("dht11")};
+const ArgSpec benchArgs[] = {BSP_BENCH_ARGS("dht11")};
+
+const CommandSpec dht11Commands[] = {
+    {"dht11", "read", readArgs, argCount(readArgs), readHandler, "Read DHT11 temperature and humidity",
+     "bsp_tool dht11 read dht11"},
+    {"dht11", "stream", streamArgs, argCount(streamArgs), streamHandler,
+     "Sample continuously with the device kept open", "bsp_tool dht11 stream --rate 1 --format bin --output t.bin"},
+    {"bench", "dht11", benchArgs, argCount(benchArgs), benchHandler,
+     "Measure DHT11 read throughput and latency percentiles", nullptr},
+};
+
+CommandRegistrar registrar(dht11Commands);
+
+} // namespace
+
+} // namespace bsp
@@ -0,0 +1,43 @@
+// 按键命令：key watch
+#include "cli_registry.h"
+#include "cli_session.h"
+#include "cli_stream.h"
+
+namespace bsp
+{
+
+namespace
+{
+
+enum
+{
+    WATCH_DEV_NAME,
+    WATCH_COUNT,
+    WATCH_PATH
+};
+
+int watchHandler(CliSession &, const ParsedArgs &args)
+{
+    KeyWatchCommandArgs watch;
+    watch.dev_name = args.str(WATCH_DEV_NAME);
+    watch.dev_path = args.str(WATCH_PATH);
+    watch.count = args.toLong(WATCH_COUNT);
+    return runKeyWatch(watch);
+}
+
+const ArgSpec watchArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, "input/event2", "Device name"},
+    {"--count", ArgKind::Int, nullptr, "0", "Number of events, 0 = until Ctrl-C"},
+    {"--path", ArgKind::Word, nullptr, nullptr, "Device node instead of /dev/<dev_name>"},
+};
+
+const CommandSpec keyCommands[] = {
+    {"key", "watch", watchArgs, argCount(watchArgs), watchHandler, "Print key events as CSV (timestamp_ns,code,value)",
+     "bsp_tool key watch --count 10"},
+};
+
+CommandRegistrar registrar(keyCommands);
+
+} // namespace
+
+} // namespace bsp
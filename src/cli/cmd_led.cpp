@@ -0,0 +1,97 @@
+// LED 命令：led set / bench led
+#include "cli_registry.h"
+#include "cli_session.h"
+#include "cli_stream.h"
+#include "../driver/led/led.h"
+
+namespace bsp
+{
+
+namespace
+{
+
+enum
+{
+    SET_DEV_NAME,
+    SET_STATE
+};
+
+enum
+{
+    BLINK_DEV_NAME,
+    BLINK_ON,
+    BLINK_OFF
+};
+
+int setHandler(CliSession &session, const ParsedArgs &args)
+{
+    Led *led = session.device<Led>(args.get(SET_DEV_NAME));
+    if (led == nullptr)
+    {
+        return 1;
+    }
+
+    const bool on = args.is(SET_STATE, "on");
+    ErrorCode ret = led->setState(on);
+    if (ret != ErrorCode::Ok)
+    {
+        spdlog::error("Failed to set LED state: {}", errorToString(ret));
+        return 1;
+    }
+
+    spdlog::info("LED {} set to {}", led->getDeviceName().c_str(), on ? "on" : "off");
+    return 0;
+}
+
+int blinkHandler(CliSession &session, const ParsedArgs &args)
+{
+    Led *led = session.device<Led>(args.get(BLINK_DEV_NAME));
+    if (led == nullptr)
+    {
+        return 1;
+    }
+
+    unsigned onMs = static_cast<unsigned>(args.durationUs(BLINK_ON) / 1000);
+    unsigned offMs = static_cast<unsigned>(args.durationUs(BLINK_OFF) / 1000);
+    ErrorCode ret = led->blink(onMs, offMs);
+    if (ret != ErrorCode::Ok)
+    {
+        spdlog::error("Failed to blink LED: {}", errorToString(ret));
+        return 1;
+    }
+
+    spdlog::info("LED {} blinking {}/{} ms (kernel timer trigger)", led->getDeviceName().c_str(), onMs,
+                 offMs);
+    return 0;
+}
+
+int benchHandler(CliSession &, const ParsedArgs &args)
+{
+    return runBench(streamArgsFrom(args, "led"));
+}
+
+const ArgSpec setArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, nullptr, "Device name"},
+    {"state", ArgKind::Choice, "on|off", nullptr, "LED state"},
+};
+
+const ArgSpec blinkArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, nullptr, "Device name (sysfs LED class device)"},
+    {"on", ArgKind::Duration, nullptr, nullptr, "On time, e.g. 100ms"},
+    {"off", ArgKind::Duration, nullptr, nullptr, "Off time, e.g. 900ms"},
+};
+
+const ArgSpec benchArgs[] = {BSP_BENCH_ARGS("led")};
+
+const CommandSpec ledCommands[] = {
+    {"led", "set", setArgs, argCount(setArgs), setHandler, "Set LED state", "bsp_tool led set led0 on"},
+    {"led", "blink", blinkArgs, argCount(blinkArgs), blinkHandler, "Blink LED in the kernel (stop with led set)",
+     "bsp_tool led blink green:status 100ms 900ms"},
+    {"bench", "led", benchArgs, argCount(benchArgs), benchHandler, "Measure LED toggle throughput and latency percentiles", nullptr},
+};
+
+CommandRegistrar registrar(ledCommands);
+
+} // namespace
+
+} // namespace bsp
@@ -4,6 +4,12 @@
 #include <cstdint>
 #include <string>
 
+// 编译期开关：嵌入式配置（由 CMake 选项 BSP_EMBEDDED 控制），库以 -fno-exceptions 编译，
+// 驱动的设备名/路径存放在实例内的定长字符串中
+#ifndef BSP_EMBEDDED
+#define BSP_EMBEDDED 0
+#endif
+
 namespace bsp
 {
 
@@ -16,12 +22,20 @@ enum class ErrorCode
     DevIo = -3,        // 设备读写/控制失败（write/read/ioctl 出错）
     DevNotReady = -4,  // 设备未初始化或未就绪
     MemAlloc = -5,     // 内存分配失败
-    Unsupported = -6   // 不支持的操作（如非法分辨率配置）
+    Unsupported = -6,  // 不支持的操作（如非法分辨率配置）
+    Timeout = -7,      // 操作超时（如设备初始化超过时限、读取超过期限）
+    Cancelled = -8     // 操作被取消（如阻塞读取期间调用了 cancel()）
 };
 
+// 错误码个数（错误码取值为 0 ~ -(ERROR_CODE_COUNT - 1)，新增错误码时同步修改）
+constexpr int ERROR_CODE_COUNT = 9;
+
 // 错误码转字符串
 std::string errorToString(ErrorCode err);
 
+// 错误码的说明文字（静态字符串，不申请内存；库内日志使用）
+const char *errorMessage(ErrorCode err);
+
 // 版本信息
 constexpr int VERSION_MAJOR = 1;
 constexpr int VERSION_MINOR = 0;
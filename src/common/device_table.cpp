@@ -0,0 +1,346 @@
+#include "device_table.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace bsp
+{
+
+const char *deviceTypeToString(DeviceType type)
+{
+    switch (type)
+    {
+    case DeviceType::Led:
+        return "led";
+    case DeviceType::Key:
+        return "key";
+    case DeviceType::AP3216C:
+        return "ap3216c";
+    case DeviceType::DHT11:
+        return "dht11";
+    case DeviceType::Custom:
+        return "custom";
+    default:
+        return "unknown";
+    }
+}
+
+DeviceEntry makeDeviceEntry(DeviceType type, const char *name, const char *path, int initTimeoutMs)
+{
+    DeviceEntry entry;
+    entry.type = type;
+    entry.name = name;
+    entry.path = path;
+    entry.initTimeoutMs = initTimeoutMs;
+    return entry;
+}
+
+namespace
+{
+
+// 解析过程中的临时设备描述
+struct PendingDevice
+{
+    std::string name;
+    std::string path;
+    bool hasType;
+    DeviceType type;
+    int initTimeoutMs;
+    int line;
+};
+
+std::string trim(const std::string &s)
+{
+    const char *ws = " \t\r\n";
+    std::size_t begin = s.find_first_not_of(ws);
+    if (begin == std::string::npos)
+    {
+        return std::string();
+    }
+    std::size_t end = s.find_last_not_of(ws);
+    return s.substr(begin, end - begin + 1);
+}
+
+// 并行初始化线程数上限（远大于板上的设备数，只用于拒绝明显写错的值）
+const long MAX_INIT_THREADS = 1024;
+
+// 去掉行内注释：行首或空白之后的 '#'/';' 起到行尾，值中间的（如 path = /dev/by-id/foo;1）保留
+std::string stripComment(const std::string &s)
+{
+    std::size_t pos = s.find_first_of("#;");
+    for (; pos != std::string::npos; pos = s.find_first_of("#;", pos + 1))
+    {
+        if (pos == 0 || s[pos - 1] == ' ' || s[pos - 1] == '\t')
+        {
+            return s.substr(0, pos);
+        }
+    }
+    return s;
+}
+
+bool parseType(const std::string &value, DeviceType &type)
+{
+    static const DeviceType types[] = {DeviceType::Led, DeviceType::Key, DeviceType::AP3216C, DeviceType::DHT11};
+    for (DeviceType t : types)
+    {
+        if (value == deviceTypeToString(t))
+        {
+            type = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 解析 [minValue, maxValue] 范围内的十进制整数，溢出或越界时返回 false
+bool parseInt(const std::string &value, long minValue, long maxValue, long &out)
+{
+    if (value.empty())
+    {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    out = std::strtol(value.c_str(), &end, 10);
+    return *end == '\0' && errno != ERANGE && out >= minValue && out <= maxValue;
+}
+
+} // namespace
+
+DeviceTable::DeviceTable() : boardInitThreads(0)
+{
+}
+
+DeviceTable::DeviceTable(DeviceTable &&other) noexcept
+    : stringPool(std::move(other.stringPool)), entries(std::move(other.entries)),
+      nameIndex(std::move(other.nameIndex)), boardInitThreads(other.boardInitThreads)
+{
+    other.clear();
+}
+
+DeviceTable &DeviceTable::operator=(DeviceTable &&other) noexcept
+{
+    if (this != &other)
+    {
+        stringPool = std::move(other.stringPool);
+        entries = std::move(other.entries);
+        nameIndex = std::move(other.nameIndex);
+        boardInitThreads = other.boardInitThreads;
+        other.clear();
+    }
+    return *this;
+}
+
+void DeviceTable::clear()
+{
+    stringPool.clear();
+    entries.clear();
+    nameIndex.clear();
+    boardInitThreads = 0;
+}
+
+ErrorCode DeviceTable::load(const std::string &filePath, DeviceTable &table)
+{
+    std::ifstream file(filePath.c_str());
+    if (!file)
+    {
+        spdlog::error("open board description {} failed", filePath);
+        table.clear();
+        return ErrorCode::DevOpen;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parse(buffer.str(), table);
+}
+
+ErrorCode DeviceTable::parse(const std::string &text, DeviceTable &table)
+{
+    table.clear();
+
+    std::vector<PendingDevice> devices;
+    std::set<std::string> seenNames;
+    std::size_t initThreads = 0;
+    bool inBoardSection = false;
+    bool inDeviceSection = false;
+
+    std::istringstream input(text);
+    std::string raw;
+    int lineNo = 0;
+    while (std::getline(input, raw))
+    {
+        ++lineNo;
+        std::string line = trim(stripComment(raw));
+        if (line.empty())
+        {
+            continue;
+        }
+
+        // 节头：[board] 或 [设备名]
+        if (line[0] == '[')
+        {
+            if (line[line.size() - 1] != ']')
+            {
+                spdlog::error("board description line {}: unterminated section header", lineNo);
+                return ErrorCode::InvalidParam;
+            }
+            std::string section = trim(line.substr(1, line.size() - 2));
+            if (section.empty())
+            {
+                spdlog::error("board description line {}: empty section name", lineNo);
+                return ErrorCode::InvalidParam;
+            }
+
+            inBoardSection = (section == "board");
+            inDeviceSection = !inBoardSection;
+            if (inDeviceSection)
+            {
+                if (!seenNames.insert(section).second)
+                {
+                    spdlog::error("board description line {}: duplicate device {}", lineNo, section);
+                    return ErrorCode::InvalidParam;
+                }
+                PendingDevice dev;
+                dev.name = section;
+                dev.hasType = false;
+                dev.type = DeviceType::Custom;
+                dev.initTimeoutMs = 0;
+                dev.line = lineNo;
+                devices.push_back(dev);
+            }
+            continue;
+        }
+
+        std::size_t eq = line.find('=');
+        if (eq == std::string::npos)
+        {
+            spdlog::error("board description line {}: expected key = value", lineNo);
+            return ErrorCode::InvalidParam;
+        }
+        std::string key = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+        long number = 0;
+
+        if (inBoardSection)
+        {
+            if (key == "init_threads" && parseInt(value, 0, MAX_INIT_THREADS, number))
+            {
+                initThreads = static_cast<std::size_t>(number);
+                continue;
+            }
+        }
+        else if (inDeviceSection)
+        {
+            PendingDevice &dev = devices.back();
+            if (key == "type" && parseType(value, dev.type))
+            {
+                dev.hasType = true;
+                continue;
+            }
+            if (key == "path" && !value.empty())
+            {
+                dev.path = value;
+                continue;
+            }
+            if (key == "timeout_ms" && parseInt(value, INT_MIN, INT_MAX, number))
+            {
+                dev.initTimeoutMs = static_cast<int>(number);
+                continue;
+            }
+        }
+        else
+        {
+            spdlog::error("board description line {}: key {} outside of any section", lineNo, key);
+            return ErrorCode::InvalidParam;
+        }
+
+        spdlog::error("board description line {}: invalid entry {} = {}", lineNo, key, value);
+        return ErrorCode::InvalidParam;
+    }
+
+    if (devices.size() >= INVALID_DEVICE_HANDLE)
+    {
+        spdlog::error("board description: too many devices ({})", devices.size());
+        return ErrorCode::InvalidParam;
+    }
+
+    for (auto &dev : devices)
+    {
+        if (!dev.hasType)
+        {
+            spdlog::error("board description line {}: device {} has no type", dev.line, dev.name);
+            return ErrorCode::InvalidParam;
+        }
+        if (dev.path.empty())
+        {
+            dev.path = "/dev/" + dev.name;
+        }
+    }
+
+    // 字符串驻留：相同字符串在池中只保存一份，先记录偏移，池构建完成后再换算成指针
+    std::map<std::string, std::size_t> interned;
+    std::vector<char> pool;
+    auto intern = [&interned, &pool](const std::string &s) -> std::size_t {
+        auto it = interned.find(s);
+        if (it != interned.end())
+        {
+            return it->second;
+        }
+        std::size_t offset = pool.size();
+        pool.insert(pool.end(), s.begin(), s.end());
+        pool.push_back('\0');
+        interned[s] = offset;
+        return offset;
+    };
+
+    std::vector<std::pair<std::size_t, std::size_t>> offsets;
+    offsets.reserve(devices.size());
+    for (const auto &dev : devices)
+    {
+        std::size_t nameOffset = intern(dev.name);
+        std::size_t pathOffset = intern(dev.path);
+        offsets.push_back(std::make_pair(nameOffset, pathOffset));
+    }
+
+    table.stringPool.swap(pool);
+    table.entries.reserve(devices.size());
+    table.nameIndex.reserve(devices.size());
+    for (std::size_t i = 0; i < devices.size(); ++i)
+    {
+        DeviceEntry entry = makeDeviceEntry(devices[i].type, &table.stringPool[offsets[i].first],
+                                            &table.stringPool[offsets[i].second], devices[i].initTimeoutMs);
+        table.entries.push_back(entry);
+        table.nameIndex.push_back(std::make_pair(entry.name, static_cast<DeviceHandle>(i)));
+    }
+    std::sort(table.nameIndex.begin(), table.nameIndex.end(),
+              [](const std::pair<const char *, DeviceHandle> &a, const std::pair<const char *, DeviceHandle> &b) {
+                  return std::strcmp(a.first, b.first) < 0;
+              });
+    table.boardInitThreads = initThreads;
+
+    spdlog::info("board description: {} devices, {} bytes of strings", table.entries.size(),
+                 table.stringPool.size());
+    return ErrorCode::Ok;
+}
+
+DeviceHandle DeviceTable::find(const char *name) const
+{
+    auto it = std::lower_bound(nameIndex.begin(), nameIndex.end(), name,
+                               [](const std::pair<const char *, DeviceHandle> &item, const char *key) {
+                                   return std::strcmp(item.first, key) < 0;
+                               });
+    if (it != nameIndex.end() && std::strcmp(it->first, name) == 0)
+    {
+        return it->second;
+    }
+    return INVALID_DEVICE_HANDLE;
+}
+
+} // namespace bsp
@@ -0,0 +1,155 @@
+#ifndef BSP_DEVICE_TABLE_H
+#define BSP_DEVICE_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bsp_common.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 板级设备类型
+ */
+enum class DeviceType
+{
+    Led,
+    Key,
+    AP3216C,
+    DHT11,
+    Custom // 自定义设备，由 DeviceConfig::customInit 完成初始化（如测试用的模拟设备）
+};
+
+/**
+ * @brief 设备类型转字符串（与板级描述文件中的 type 取值一致）
+ */
+const char *deviceTypeToString(DeviceType type);
+
+/**
+ * @brief 设备句柄：设备在 DeviceTable 中的下标
+ *
+ * 热路径上用整数下标代替设备名字符串比较
+ */
+using DeviceHandle = uint16_t;
+constexpr DeviceHandle INVALID_DEVICE_HANDLE = 0xFFFF;
+
+/**
+ * @brief 设备表中的一项
+ *
+ * name/path 指向 DeviceTable 内部的字符串池，生命周期与所属 DeviceTable 相同
+ */
+struct DeviceEntry
+{
+    DeviceType type;
+    const char *name;  // 设备名，表内唯一
+    const char *path;  // 设备节点完整路径（已在解析时拼好，默认 /dev/<name>）
+    int initTimeoutMs; // 初始化超时(ms)，<=0 表示不限时
+};
+
+/**
+ * @brief 构造一个不属于任何 DeviceTable 的设备表项（如运行时发现的设备、测试用的模拟设备）
+ *
+ * 只保存 name/path 指针；设备对象构造时会复制这两个字符串，之后即可释放
+ */
+DeviceEntry makeDeviceEntry(DeviceType type, const char *name, const char *path, int initTimeoutMs = 0);
+
+/**
+ * @brief 不可变的板级设备表
+ *
+ * 启动时从板级描述文件（INI 格式）解析一次，之后只读。所有设备名和路径
+ * 存放在同一块字符串池中（相同字符串只存一份），按名字查找只在启动阶段
+ * 使用，运行时通过 DeviceHandle 直接下标访问。
+ *
+ * 描述文件格式：
+ * @code
+ * # 注释以 '#' 或 ';' 开头（行首或空白之后），值中间的 '#'/';' 属于值本身
+ * [board]
+ * init_threads = 4        ; 可选，并行初始化线程数（0 ~ 1024）
+ *
+ * [led0]                  ; 节名即设备名
+ * type = led              ; led | key | ap3216c | dht11
+ * path = /dev/led0        ; 可选，默认 /dev/<设备名>
+ * timeout_ms = 200        ; 可选，初始化超时（int 范围内，<= 0 不限时）
+ * @endcode
+ */
+class DeviceTable
+{
+public:
+    DeviceTable();
+
+    // 条目中的指针指向内部字符串池，禁止拷贝；移动不会改变池地址
+    DeviceTable(const DeviceTable &) = delete;
+    DeviceTable &operator=(const DeviceTable &) = delete;
+    DeviceTable(DeviceTable &&other) noexcept;
+    DeviceTable &operator=(DeviceTable &&other) noexcept;
+
+    /**
+     * @brief 从文件加载板级描述
+     * @param filePath 描述文件路径
+     * @param table 输出设备表（失败时保持为空）
+     * @return ErrorCode::Ok 成功；DevOpen 文件无法打开；InvalidParam 格式错误
+     */
+    static ErrorCode load(const std::string &filePath, DeviceTable &table);
+
+    /**
+     * @brief 从文本解析板级描述
+     * @param text 描述文本
+     * @param table 输出设备表（失败时保持为空）
+     * @return ErrorCode::Ok 成功；InvalidParam 格式错误
+     */
+    static ErrorCode parse(const std::string &text, DeviceTable &table);
+
+    /**
+     * @brief 设备数量
+     */
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+
+    /**
+     * @brief 按句柄访问设备项（不做越界检查）
+     */
+    const DeviceEntry &entry(DeviceHandle handle) const
+    {
+        return entries[handle];
+    }
+
+    const DeviceEntry &operator[](DeviceHandle handle) const
+    {
+        return entries[handle];
+    }
+
+    /**
+     * @brief 按设备名查找句柄（二分查找，建议只在启动阶段调用）
+     * @return 设备句柄，不存在时返回 INVALID_DEVICE_HANDLE
+     */
+    DeviceHandle find(const char *name) const;
+    DeviceHandle find(const std::string &name) const
+    {
+        return find(name.c_str());
+    }
+
+    /**
+     * @brief 描述文件中 [board] 节配置的初始化线程数（未配置为 0）
+     */
+    std::size_t initThreads() const
+    {
+        return boardInitThreads;
+    }
+
+private:
+    void clear();
+
+    std::vector<char> stringPool;
+    std::vector<DeviceEntry> entries;
+    std::vector<std::pair<const char *, DeviceHandle>> nameIndex; // 按名字排序
+    std::size_t boardInitThreads;
+};
+
+} // namespace bsp
+
+#endif // BSP_DEVICE_TABLE_H
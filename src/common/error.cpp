@@ -4,7 +4,7 @@
 namespace bsp
 {
 
-std::string errorToString(ErrorCode err)
+const char *errorMessage(ErrorCode err)
 {
     switch (err)
     {
@@ -22,9 +22,18 @@ std::string errorToString(ErrorCode err)
         return "Memory allocation failed";
     case ErrorCode::Unsupported:
         return "Unsupported operation";
+    case ErrorCode::Timeout:
+        return "Operation timed out";
+    case ErrorCode::Cancelled:
+        return "Operation cancelled";
     default:
         return "Unknown error";
     }
 }
 
+std::string errorToString(ErrorCode err)
+{
+    return errorMessage(err);
+}
+
 } // namespace bsp
@@ -0,0 +1,302 @@
+#include "event_loop.h"
+#include "trace.h"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace bsp
+{
+
+namespace
+{
+
+// 单轮 epoll_wait 最多取回的事件数
+constexpr int MAX_EVENTS = 64;
+
+} // namespace
+
+EventLoop::EventLoop() : epollFd(-1), wakeFd(-1), stopping(false), armedCount(0)
+{
+}
+
+EventLoop::~EventLoop()
+{
+    if (wakeFd >= 0)
+    {
+        close(wakeFd);
+    }
+    if (epollFd >= 0)
+    {
+        close(epollFd);
+    }
+}
+
+ErrorCode EventLoop::init()
+{
+    if (epollFd >= 0)
+    {
+        return ErrorCode::Ok;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0)
+    {
+        spdlog::error("epoll_create1 failed: {}", std::strerror(errno));
+        return ErrorCode::DevOpen;
+    }
+
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0)
+    {
+        spdlog::error("create event loop wake fd failed: {}", std::strerror(errno));
+        close(epollFd);
+        epollFd = -1;
+        return ErrorCode::DevOpen;
+    }
+
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeFd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev) < 0)
+    {
+        spdlog::error("register wake fd failed: {}", std::strerror(errno));
+        close(wakeFd);
+        close(epollFd);
+        wakeFd = -1;
+        epollFd = -1;
+        return ErrorCode::DevOpen;
+    }
+    return ErrorCode::Ok;
+}
+
+ErrorCode EventLoop::watchOnce(int fd, FdCallback callback)
+{
+    if (epollFd < 0)
+    {
+        return ErrorCode::DevNotReady;
+    }
+    if (fd < 0 || !callback)
+    {
+        return ErrorCode::InvalidParam;
+    }
+
+    Watch &watch = watches[fd];
+    if (watch.armed)
+    {
+        spdlog::error("fd {} already has a pending wait", fd);
+        return ErrorCode::InvalidParam;
+    }
+
+    if (watch.added && watch.pollable)
+    {
+        // 一次性事件触发后需要重新布防
+        epoll_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN | EPOLLONESHOT;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) < 0)
+        {
+            // 原来的文件已关闭（epoll 随之移除），fd 号被新打开的文件复用：按首次使用重新探测。
+            // 新文件不支持 poll 时内核先报告 EPERM 而不是 ENOENT
+            if (errno != ENOENT && errno != EPERM)
+            {
+                spdlog::error("epoll_ctl mod fd {} failed: {}", fd, std::strerror(errno));
+                return ErrorCode::InvalidParam;
+            }
+            watch.added = false;
+        }
+    }
+
+    if (!watch.added || !watch.pollable)
+    {
+        // 首次使用该 fd，或之前不支持 epoll（fd 号可能已被可 poll 的文件复用）：探测是否支持 epoll
+        epoll_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN | EPOLLONESHOT;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0)
+        {
+            watch.pollable = true;
+            watch.added = true;
+        }
+        else if (errno == EPERM)
+        {
+            watch.pollable = false;
+            watch.added = true;
+        }
+        else
+        {
+            spdlog::error("epoll_ctl add fd {} failed: {}", fd, std::strerror(errno));
+            watches.erase(fd);
+            return ErrorCode::InvalidParam;
+        }
+    }
+
+    watch.callback = std::move(callback);
+    watch.armed = true;
+    ++armedCount;
+
+    if (!watch.pollable)
+    {
+        // 不支持 poll 的 fd 视为始终可读
+        post([this, fd] {
+            auto it = watches.find(fd);
+            if (it == watches.end() || !it->second.armed)
+            {
+                return; // 已取消
+            }
+            FdCallback cb = std::move(it->second.callback);
+            it->second.armed = false;
+            --armedCount;
+            cb(EPOLLIN);
+        });
+    }
+    return ErrorCode::Ok;
+}
+
+void EventLoop::cancel(int fd)
+{
+    auto it = watches.find(fd);
+    if (it == watches.end())
+    {
+        return;
+    }
+    if (it->second.armed)
+    {
+        --armedCount;
+    }
+    if (it->second.pollable)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+    watches.erase(it);
+}
+
+void EventLoop::post(Task task)
+{
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        wasEmpty = posted.empty();
+        posted.push_back(std::move(task));
+    }
+    // 队列由空变为非空时才需要唤醒，避免每次投递都写 eventfd
+    if (wasEmpty)
+    {
+        wake();
+    }
+}
+
+void EventLoop::wake()
+{
+    uint64_t one = 1;
+    ssize_t n = write(wakeFd, &one, sizeof(one));
+    (void)n;
+}
+
+std::size_t EventLoop::runPosted()
+{
+    uint64_t value;
+    ssize_t n = read(wakeFd, &value, sizeof(value));
+    (void)n;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running.swap(posted);
+    }
+    std::size_t count = running.size();
+    for (auto &task : running)
+    {
+        BSP_TRACE_SCOPE("EventLoop::task");
+        task();
+    }
+    running.clear();
+    return count;
+}
+
+std::size_t EventLoop::runOnce(int timeoutMs)
+{
+    if (epollFd < 0)
+    {
+        return 0;
+    }
+
+    epoll_event events[MAX_EVENTS];
+    int n = epoll_wait(epollFd, events, MAX_EVENTS, timeoutMs);
+    if (n < 0)
+    {
+        if (errno != EINTR)
+        {
+            spdlog::error("epoll_wait failed: {}", std::strerror(errno));
+        }
+        return 0;
+    }
+    if (n > 0)
+    {
+        BSP_TRACE_INSTANT("EventLoop::wakeup");
+    }
+
+    std::size_t dispatched = 0;
+    bool wakeReady = false;
+    for (int i = 0; i < n; ++i)
+    {
+        int fd = events[i].data.fd;
+        if (fd == wakeFd)
+        {
+            wakeReady = true;
+            continue;
+        }
+
+        auto it = watches.find(fd);
+        if (it == watches.end() || !it->second.armed)
+        {
+            continue; // 已被同一轮中先执行的回调取消
+        }
+        // 先取出回调再调用，回调中可以对同一 fd 再次 watchOnce()
+        FdCallback cb = std::move(it->second.callback);
+        it->second.armed = false;
+        --armedCount;
+        {
+            BSP_TRACE_SCOPE("EventLoop::callback");
+            cb(events[i].events);
+        }
+        ++dispatched;
+    }
+
+    if (wakeReady)
+    {
+        dispatched += runPosted();
+    }
+    return dispatched;
+}
+
+void EventLoop::run()
+{
+    while (!stopping && pending() > 0)
+    {
+        runOnce(-1);
+    }
+    // 在退出时而不是进入时清除标志：run() 之前调用的 stop() 同样生效
+    stopping = false;
+}
+
+void EventLoop::stop()
+{
+    stopping = true;
+    if (wakeFd >= 0)
+    {
+        wake();
+    }
+}
+
+std::size_t EventLoop::pending() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return armedCount + posted.size();
+}
+
+} // namespace bsp
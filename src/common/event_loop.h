@@ -0,0 +1,118 @@
+#ifndef BSP_EVENT_LOOP_H
+#define BSP_EVENT_LOOP_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "bsp_common.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 基于 epoll 的单线程事件循环
+ *
+ * 驱动的异步接口（AP3216C::readAsync()、DHT11::readAsync()、Key::nextEvent()）把
+ * 设备 fd 以一次性（EPOLLONESHOT）方式挂到循环上，fd 可读时在循环线程中完成读取并
+ * 回调，一个线程即可服务所有设备。不支持 poll 的设备节点（epoll_ctl 返回 EPERM，
+ * 如普通文件或未实现 poll 的字符设备）退化为在下一轮循环中直接读取。
+ *
+ * watchOnce()/cancel() 只能在循环线程或 run() 之前调用；post()/stop() 线程安全。
+ *
+ * 循环不拥有 fd：关闭一个挂过等待的 fd 之前，应在循环线程中调用 cancel(fd)，否则
+ * 未触发的回调会一直保留（其中捕获的对象可能已析构）。已触发、无等待中回调的 fd 即使
+ * 未 cancel() 就被关闭，fd 号被复用时 watchOnce() 也会重新注册。
+ */
+class EventLoop
+{
+public:
+    using Task = std::function<void()>;
+    using FdCallback = std::function<void(uint32_t events)>;
+
+    EventLoop();
+
+    /**
+     * @brief 析构函数，丢弃尚未执行的任务和监视
+     */
+    ~EventLoop();
+
+    // 禁止拷贝和移动（回调中通常持有循环的引用）
+    EventLoop(const EventLoop &) = delete;
+    EventLoop &operator=(const EventLoop &) = delete;
+
+    /**
+     * @brief 创建 epoll 实例和唤醒 eventfd
+     * @return ErrorCode::Ok 成功；DevOpen 创建失败
+     */
+    ErrorCode init();
+
+    /**
+     * @brief 等待 fd 可读一次，就绪后在循环线程中调用回调（每个 fd 同时只能有一个等待）
+     * @param fd 文件描述符
+     * @param callback 就绪回调，参数为 epoll 事件位
+     * @return ErrorCode::Ok 成功；DevNotReady 循环未初始化；InvalidParam fd 无效或已有等待
+     */
+    ErrorCode watchOnce(int fd, FdCallback callback);
+
+    /**
+     * @brief 取消 fd 上的等待并从 epoll 中移除（关闭 fd 之前在循环线程中调用）
+     */
+    void cancel(int fd);
+
+    /**
+     * @brief 投递一个任务到循环线程执行（可在任意线程调用）
+     */
+    void post(Task task);
+
+    /**
+     * @brief 执行一轮循环
+     * @param timeoutMs 无事件时最长等待时间，-1 表示一直等待
+     * @return 本轮执行的回调和任务数
+     */
+    std::size_t runOnce(int timeoutMs);
+
+    /**
+     * @brief 持续运行直到 stop()，或没有任何等待中的 fd 和任务
+     */
+    void run();
+
+    /**
+     * @brief 请求 run() 返回（可在任意线程调用；run() 未运行时让下一次 run() 立即返回）
+     */
+    void stop();
+
+    /**
+     * @brief 等待中的 fd 数与待执行任务数之和
+     */
+    std::size_t pending() const;
+
+private:
+    struct Watch
+    {
+        FdCallback callback;
+        bool armed;    // 是否有等待中的回调
+        bool pollable; // false 表示 fd 不支持 epoll，每次等待都直接投递
+        bool added;    // 是否已加入 epoll
+    };
+
+    void wake();
+    std::size_t runPosted();
+
+    int epollFd;
+    int wakeFd;
+    std::atomic<bool> stopping;
+    std::unordered_map<int, Watch> watches;
+    std::size_t armedCount;
+
+    mutable std::mutex mutex;
+    std::vector<Task> posted; // 受 mutex 保护
+    std::vector<Task> running; // 循环线程本地，复用容量
+};
+
+} // namespace bsp
+
+#endif // BSP_EVENT_LOOP_H
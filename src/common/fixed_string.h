@@ -0,0 +1,194 @@
+#ifndef BSP_FIXED_STRING_H
+#define BSP_FIXED_STRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace bsp
+{
+
+/**
+ * @brief 定长内联字符串：最多 N 个字符，存放在对象内部，不访问堆
+ *
+ * 超出容量的部分被截断，truncated() 返回 true（之后 clear() 或重新赋值才会清除），
+ * 由调用方决定截断是否可以接受（如设备路径截断后不能再打开）。
+ * 接口取 std::string 的常用子集（c_str()、size()、+=、==），嵌入式配置下替换设备名/路径的
+ * std::string 时调用处不需要改动。打印到日志时使用 c_str()。
+ */
+template <std::size_t N> class FixedString
+{
+public:
+    static_assert(N > 0 && N < 65535, "FixedString capacity must be 1 ~ 65534");
+
+    FixedString() : len(0), overflow(false)
+    {
+        buf[0] = '\0';
+    }
+
+    FixedString(const char *s) : len(0), overflow(false)
+    {
+        buf[0] = '\0';
+        append(s);
+    }
+
+    FixedString(const std::string &s) : len(0), overflow(false)
+    {
+        buf[0] = '\0';
+        append(s.data(), s.size());
+    }
+
+    FixedString &operator=(const char *s)
+    {
+        clear();
+        return append(s);
+    }
+
+    FixedString &operator=(const std::string &s)
+    {
+        clear();
+        return append(s.data(), s.size());
+    }
+
+    /**
+     * @brief 替换为 s 的前 n 个字符
+     */
+    FixedString &assign(const char *s, std::size_t n)
+    {
+        clear();
+        return append(s, n);
+    }
+
+    FixedString &append(const char *s)
+    {
+        return s == nullptr ? *this : append(s, std::strlen(s));
+    }
+
+    FixedString &append(const char *s, std::size_t n)
+    {
+        std::size_t room = N - len;
+        if (n > room)
+        {
+            n = room;
+            overflow = true;
+        }
+        std::memcpy(buf + len, s, n);
+        len = static_cast<uint16_t>(len + n);
+        buf[len] = '\0';
+        return *this;
+    }
+
+    FixedString &operator+=(const char *s)
+    {
+        return append(s);
+    }
+
+    void clear()
+    {
+        len = 0;
+        overflow = false;
+        buf[0] = '\0';
+    }
+
+    const char *c_str() const
+    {
+        return buf;
+    }
+
+    const char *data() const
+    {
+        return buf;
+    }
+
+    std::size_t size() const
+    {
+        return len;
+    }
+
+    std::size_t length() const
+    {
+        return len;
+    }
+
+    bool empty() const
+    {
+        return len == 0;
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return N;
+    }
+
+    /**
+     * @brief 上次赋值/追加是否因超出容量被截断
+     */
+    bool truncated() const
+    {
+        return overflow;
+    }
+
+    /**
+     * @brief 转换为 std::string（会申请堆内存，只用于兼容旧的调用代码）
+     */
+    operator std::string() const
+    {
+        return std::string(buf, len);
+    }
+
+private:
+    char buf[N + 1];
+    uint16_t len;
+    bool overflow;
+};
+
+template <std::size_t N, std::size_t M> bool operator==(const FixedString<N> &a, const FixedString<M> &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+}
+
+template <std::size_t N> bool operator==(const FixedString<N> &a, const char *b)
+{
+    return b != nullptr && std::strcmp(a.c_str(), b) == 0;
+}
+
+template <std::size_t N> bool operator==(const char *a, const FixedString<N> &b)
+{
+    return b == a;
+}
+
+template <std::size_t N> bool operator==(const FixedString<N> &a, const std::string &b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+}
+
+template <std::size_t N> bool operator==(const std::string &a, const FixedString<N> &b)
+{
+    return b == a;
+}
+
+template <std::size_t N, typename T> bool operator!=(const FixedString<N> &a, const T &b)
+{
+    return !(a == b);
+}
+
+template <std::size_t N> bool operator!=(const char *a, const FixedString<N> &b)
+{
+    return !(b == a);
+}
+
+template <std::size_t N> bool operator!=(const std::string &a, const FixedString<N> &b)
+{
+    return !(b == a);
+}
+
+template <std::size_t N> std::ostream &operator<<(std::ostream &os, const FixedString<N> &s)
+{
+    return os.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+} // namespace bsp
+
+#endif // BSP_FIXED_STRING_H
@@ -0,0 +1,567 @@
+#include "io_ring.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if BSP_HAVE_IO_URING
+#include <linux/io_uring.h>
+#endif
+
+namespace bsp
+{
+
+constexpr unsigned IoRing::DEFAULT_ENTRIES;
+
+namespace
+{
+
+#if BSP_HAVE_IO_URING
+// 不依赖 liburing，直接使用系统调用
+int ioUringSetup(unsigned entries, io_uring_params *params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int fd, unsigned opcode, const void *arg, unsigned count)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+unsigned *ringField(void *ring, uint32_t offset)
+{
+    return reinterpret_cast<unsigned *>(static_cast<char *>(ring) + offset);
+}
+#endif
+
+} // namespace
+
+IoRing::IoRing()
+    : type(IoBackend::Posix), initialized(false), eventFd(-1), inFlightCount(0), ringFd(-1), sqEntries(0),
+      cqEntries(0), sqRing(nullptr), cqRing(nullptr), sqRingSize(0), cqRingSize(0), sqes(nullptr), sqesSize(0),
+      sqTail(nullptr), sqMask(nullptr), sqArray(nullptr), cqHead(nullptr), cqTail(nullptr), cqMask(nullptr),
+      cqes(nullptr)
+{
+    counters.ops = 0;
+    counters.syscalls = 0;
+}
+
+IoRing::~IoRing()
+{
+    teardownIoUring();
+    if (eventFd >= 0)
+    {
+        close(eventFd);
+    }
+}
+
+ErrorCode IoRing::init(unsigned entries, bool allowIoUring)
+{
+    if (initialized)
+    {
+        return ErrorCode::Ok;
+    }
+    if (entries == 0)
+    {
+        return ErrorCode::InvalidParam;
+    }
+
+    type = (allowIoUring && setupIoUring(entries)) ? IoBackend::IoUring : IoBackend::Posix;
+    queued.reserve(entries);
+    initialized = true;
+    spdlog::debug("I/O ring ready, backend {}", type == IoBackend::IoUring ? "io_uring" : "posix");
+    return ErrorCode::Ok;
+}
+
+IoBackend IoRing::backend() const
+{
+    return type;
+}
+
+bool IoRing::setupIoUring(unsigned entries)
+{
+#if BSP_HAVE_IO_URING
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    int fd = ioUringSetup(entries, &params);
+    if (fd < 0)
+    {
+        spdlog::debug("io_uring unavailable ({}), using posix backend", std::strerror(errno));
+        return false;
+    }
+    // 需要按当前位置读取字符设备/管道（内核 5.6 起支持，同时保证有 IORING_OP_READ）
+    if ((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+    {
+        spdlog::debug("io_uring lacks IORING_FEAT_RW_CUR_POS, using posix backend");
+        close(fd);
+        return false;
+    }
+
+    ringFd = fd;
+    sqEntries = params.sq_entries;
+    cqEntries = params.cq_entries;
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap && cqRingSize > sqRingSize)
+    {
+        sqRingSize = cqRingSize;
+    }
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+    {
+        sqRing = nullptr;
+        teardownIoUring();
+        return false;
+    }
+    if (singleMmap)
+    {
+        cqRing = sqRing;
+    }
+    else
+    {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd,
+                      IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+        {
+            cqRing = nullptr;
+            teardownIoUring();
+            return false;
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        sqes = nullptr;
+        teardownIoUring();
+        return false;
+    }
+
+    sqTail = ringField(sqRing, params.sq_off.tail);
+    sqMask = ringField(sqRing, params.sq_off.ring_mask);
+    sqArray = ringField(sqRing, params.sq_off.array);
+    cqHead = ringField(cqRing, params.cq_off.head);
+    cqTail = ringField(cqRing, params.cq_off.tail);
+    cqMask = ringField(cqRing, params.cq_off.ring_mask);
+    cqes = static_cast<char *>(cqRing) + params.cq_off.cqes;
+    return true;
+#else
+    (void)entries;
+    return false;
+#endif
+}
+
+void IoRing::teardownIoUring()
+{
+    if (sqes != nullptr)
+    {
+        munmap(sqes, sqesSize);
+        sqes = nullptr;
+    }
+    if (cqRing != nullptr && cqRing != sqRing)
+    {
+        munmap(cqRing, cqRingSize);
+    }
+    cqRing = nullptr;
+    if (sqRing != nullptr)
+    {
+        munmap(sqRing, sqRingSize);
+        sqRing = nullptr;
+    }
+    if (ringFd >= 0)
+    {
+        close(ringFd);
+        ringFd = -1;
+    }
+}
+
+ErrorCode IoRing::registerFiles(const int *fds, unsigned count)
+{
+    if (!initialized)
+    {
+        return ErrorCode::DevNotReady;
+    }
+    if (fds == nullptr || count == 0 || !fixedFiles.empty())
+    {
+        return ErrorCode::InvalidParam;
+    }
+#if BSP_HAVE_IO_URING
+    if (type == IoBackend::IoUring)
+    {
+        ++counters.syscalls;
+        if (ioUringRegister(ringFd, IORING_REGISTER_FILES, fds, count) < 0)
+        {
+            spdlog::error("io_uring register files failed: {}", std::strerror(errno));
+            return ErrorCode::DevIo;
+        }
+        fixedFiles.assign(fds, fds + count);
+    }
+#endif
+    return ErrorCode::Ok;
+}
+
+ErrorCode IoRing::registerBuffers(const iovec *buffers, unsigned count)
+{
+    if (!initialized)
+    {
+        return ErrorCode::DevNotReady;
+    }
+    if (buffers == nullptr || count == 0 || !fixedBuffers.empty())
+    {
+        return ErrorCode::InvalidParam;
+    }
+#if BSP_HAVE_IO_URING
+    if (type == IoBackend::IoUring)
+    {
+        ++counters.syscalls;
+        if (ioUringRegister(ringFd, IORING_REGISTER_BUFFERS, buffers, count) < 0)
+        {
+            // 常见原因是 RLIMIT_MEMLOCK 不足
+            spdlog::error("io_uring register buffers failed: {}", std::strerror(errno));
+            return ErrorCode::DevIo;
+        }
+        fixedBuffers.assign(buffers, buffers + count);
+    }
+#endif
+    return ErrorCode::Ok;
+}
+
+ErrorCode IoRing::queueRead(int fd, void *buf, unsigned len, int64_t offset, uint64_t userData)
+{
+    if (!initialized)
+    {
+        return ErrorCode::DevNotReady;
+    }
+    if (fd < 0 || buf == nullptr || len == 0)
+    {
+        return ErrorCode::InvalidParam;
+    }
+    PendingOp op = {false, fd, buf, len, offset, 0, userData};
+    queued.push_back(op);
+    return ErrorCode::Ok;
+}
+
+ErrorCode IoRing::queueIoctl(int fd, unsigned long request, uint64_t userData)
+{
+    if (!initialized)
+    {
+        return ErrorCode::DevNotReady;
+    }
+    if (fd < 0)
+    {
+        return ErrorCode::InvalidParam;
+    }
+    PendingOp op = {true, fd, nullptr, 0, -1, request, userData};
+    queued.push_back(op);
+    return ErrorCode::Ok;
+}
+
+int IoRing::fixedFileIndex(int fd) const
+{
+    for (std::size_t i = 0; i < fixedFiles.size(); ++i)
+    {
+        if (fixedFiles[i] == fd)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int IoRing::fixedBufferIndex(const void *buf, unsigned len) const
+{
+    const char *p = static_cast<const char *>(buf);
+    for (std::size_t i = 0; i < fixedBuffers.size(); ++i)
+    {
+        const char *base = static_cast<const char *>(fixedBuffers[i].iov_base);
+        if (p >= base && p + len <= base + fixedBuffers[i].iov_len)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void IoRing::runSync(const PendingOp &op)
+{
+    int result;
+    if (op.isIoctl)
+    {
+        result = ioctl(op.fd, op.request);
+    }
+    else if (op.offset < 0)
+    {
+        result = static_cast<int>(read(op.fd, op.buf, op.len));
+    }
+    else
+    {
+        result = static_cast<int>(pread(op.fd, op.buf, op.len, static_cast<off_t>(op.offset)));
+    }
+    ++counters.syscalls;
+
+    IoCompletion completion = {op.userData, result < 0 ? -errno : result};
+    syncCompleted.push_back(completion);
+    ++inFlightCount;
+}
+
+int IoRing::submit(unsigned waitFor)
+{
+    if (!initialized)
+    {
+        return -EINVAL;
+    }
+
+    int submitted = 0;
+    std::size_t syncBefore = syncCompleted.size();
+
+    if (type == IoBackend::Posix)
+    {
+        for (const PendingOp &op : queued)
+        {
+            runSync(op);
+            ++submitted;
+        }
+        queued.clear();
+        if (syncCompleted.size() > syncBefore)
+        {
+            notify();
+        }
+        return submitted;
+    }
+
+#if BSP_HAVE_IO_URING
+    io_uring_sqe *sqeArray = static_cast<io_uring_sqe *>(sqes);
+    std::size_t next = 0;
+    bool waited = false;
+    int enterError = 0;
+    while (next < queued.size() || (!waited && waitFor > 0))
+    {
+        // 尽量多地填入一批：不超过提交队列深度，且在途读取不超过完成队列容量（否则完成结果溢出）
+        unsigned uringInFlight = inFlightCount - static_cast<unsigned>(syncCompleted.size());
+        unsigned tail = *sqTail; // 只有本线程写 tail
+        unsigned batch = 0;
+        std::size_t batchStart = next;
+        while (next < queued.size() && batch < sqEntries && uringInFlight + batch < cqEntries)
+        {
+            const PendingOp &op = queued[next++];
+            if (op.isIoctl)
+            {
+                runSync(op);
+                ++submitted;
+                continue;
+            }
+
+            unsigned index = (tail + batch) & *sqMask;
+            io_uring_sqe *sqe = &sqeArray[index];
+            std::memset(sqe, 0, sizeof(*sqe));
+            int fileIndex = fixedFileIndex(op.fd);
+            int bufIndex = fixedBufferIndex(op.buf, op.len);
+            sqe->opcode = (bufIndex >= 0) ? IORING_OP_READ_FIXED : IORING_OP_READ;
+            sqe->fd = (fileIndex >= 0) ? fileIndex : op.fd;
+            if (fileIndex >= 0)
+            {
+                sqe->flags |= IOSQE_FIXED_FILE;
+            }
+            sqe->off = static_cast<uint64_t>(op.offset); // -1 表示当前文件位置
+            sqe->addr = reinterpret_cast<uint64_t>(op.buf);
+            sqe->len = op.len;
+            if (bufIndex >= 0)
+            {
+                sqe->buf_index = static_cast<uint16_t>(bufIndex);
+            }
+            sqe->user_data = op.userData;
+            sqArray[index] = index;
+            ++batch;
+        }
+        __atomic_store_n(sqTail, tail + batch, __ATOMIC_RELEASE);
+
+        bool full = next < queued.size() && batch < sqEntries;
+
+        // 最后一批时顺带等待完成（已同步完成的操作计入等待数，且最多等待全部在途读取）
+        unsigned minComplete = 0;
+        if ((next == queued.size() || full) && waitFor > 0)
+        {
+            unsigned cqReady = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE) - *cqHead;
+            unsigned ready = static_cast<unsigned>(syncCompleted.size()) + cqReady;
+            unsigned waitable = uringInFlight + batch - cqReady;
+            minComplete = (waitFor > ready) ? waitFor - ready : 0;
+            minComplete = (minComplete > waitable) ? waitable : minComplete;
+            waited = true;
+        }
+        if (batch == 0 && minComplete == 0)
+        {
+            if (full)
+            {
+                break; // 完成队列已满，剩余操作留待 reap() 之后再提交
+            }
+            continue;
+        }
+
+        int ret;
+        do
+        {
+            ++counters.syscalls;
+            ret = ioUringEnter(ringFd, batch, minComplete, minComplete > 0 ? IORING_ENTER_GETEVENTS : 0);
+        } while (ret < 0 && errno == EINTR && batch == 0);
+        int err = (ret < 0) ? errno : 0;
+        unsigned consumed = (ret < 0) ? 0 : static_cast<unsigned>(ret);
+        if (consumed < batch)
+        {
+            // 内核只在 io_uring_enter 中读取 tail（未启用 SQPOLL），未取走的 SQE 可以撤回：
+            // 回退 tail，对应的读取留在队列中待下次 submit()，不当作失败丢弃（缓冲区仍归调用方所有）
+            __atomic_store_n(sqTail, tail + consumed, __ATOMIC_RELEASE);
+            std::vector<PendingOp>::iterator pos = queued.begin() + static_cast<std::ptrdiff_t>(batchStart);
+            std::vector<PendingOp>::iterator end = queued.begin() + static_cast<std::ptrdiff_t>(next);
+            for (unsigned skipped = 0; skipped < consumed; ++pos)
+            {
+                skipped += pos->isIoctl ? 0 : 1;
+            }
+            next = static_cast<std::size_t>(pos - queued.begin());
+            // 已同步执行的 ioctl 不再保留
+            queued.erase(std::remove_if(pos, end, [](const PendingOp &op) { return op.isIoctl; }), end);
+        }
+        inFlightCount += consumed;
+        submitted += static_cast<int>(consumed);
+        if (ret < 0)
+        {
+            spdlog::error("io_uring_enter failed: {}", std::strerror(err));
+            enterError = err;
+            break;
+        }
+        if (full || consumed < batch)
+        {
+            break;
+        }
+    }
+    queued.erase(queued.begin(), queued.begin() + static_cast<std::ptrdiff_t>(next));
+    if (syncCompleted.size() > syncBefore)
+    {
+        notify();
+    }
+    // 之前的批次已进入内核时按成功返回，它们的结果仍需 reap()
+    return (submitted == 0 && enterError != 0) ? -enterError : submitted;
+#else
+    (void)waitFor;
+    return -ENOSYS;
+#endif
+}
+
+unsigned IoRing::reap(IoCompletion *out, unsigned max)
+{
+    unsigned count = 0;
+
+    // 先取同步执行的结果
+    std::size_t sync = syncCompleted.size() < max ? syncCompleted.size() : max;
+    for (std::size_t i = 0; i < sync; ++i)
+    {
+        out[count++] = syncCompleted[i];
+    }
+    syncCompleted.erase(syncCompleted.begin(), syncCompleted.begin() + static_cast<std::ptrdiff_t>(sync));
+
+#if BSP_HAVE_IO_URING
+    if (type == IoBackend::IoUring)
+    {
+        const io_uring_cqe *cqeArray = static_cast<const io_uring_cqe *>(cqes);
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail && count < max)
+        {
+            const io_uring_cqe &cqe = cqeArray[head & *cqMask];
+            out[count].userData = cqe.user_data;
+            out[count].result = cqe.res;
+            ++count;
+            ++head;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+#endif
+
+    if (count > 0 && eventFd >= 0)
+    {
+        // 清空通知计数，避免事件循环重复唤醒
+        uint64_t value;
+        ssize_t n = read(eventFd, &value, sizeof(value));
+        (void)n;
+    }
+
+    inFlightCount -= count;
+    counters.ops += count;
+    return count;
+}
+
+unsigned IoRing::inFlight() const
+{
+    return inFlightCount + static_cast<unsigned>(queued.size());
+}
+
+int IoRing::completionFd()
+{
+    if (eventFd >= 0 || !initialized)
+    {
+        return eventFd;
+    }
+
+    eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd < 0)
+    {
+        spdlog::error("create I/O ring completion fd failed: {}", std::strerror(errno));
+        return -1;
+    }
+#if BSP_HAVE_IO_URING
+    if (type == IoBackend::IoUring && ioUringRegister(ringFd, IORING_REGISTER_EVENTFD, &eventFd, 1) < 0)
+    {
+        spdlog::error("io_uring register eventfd failed: {}", std::strerror(errno));
+        close(eventFd);
+        eventFd = -1;
+    }
+#endif
+    // 创建之前已完成但未取回的结果同样需要通知
+    if (!syncCompleted.empty())
+    {
+        notify();
+    }
+    return eventFd;
+}
+
+void IoRing::notify()
+{
+    if (eventFd >= 0)
+    {
+        uint64_t one = 1;
+        ssize_t n = write(eventFd, &one, sizeof(one));
+        (void)n;
+    }
+}
+
+IoRingStats IoRing::stats() const
+{
+    return counters;
+}
+
+ErrorCode completionResult(const IoCompletion &completion, unsigned expected)
+{
+    if (completion.result < 0)
+    {
+        return ErrorCode::DevIo;
+    }
+    if (expected > 0 && static_cast<unsigned>(completion.result) != expected)
+    {
+        return ErrorCode::DevIo;
+    }
+    return ErrorCode::Ok;
+}
+
+} // namespace bsp
@@ -0,0 +1,196 @@
+#ifndef BSP_IO_RING_H
+#define BSP_IO_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <sys/uio.h>
+#include "bsp_common.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 批量 I/O 实际使用的后端
+ */
+enum class IoBackend
+{
+    Posix,  // 逐个同步 read()/pread()/ioctl()
+    IoUring // 一次 io_uring_enter 提交整批读取
+};
+
+/**
+ * @brief 一个已完成的操作
+ */
+struct IoCompletion
+{
+    uint64_t userData; // 提交时传入的标识
+    int result;        // 读取的字节数 / ioctl 返回值，失败时为 -errno
+};
+
+/**
+ * @brief IoRing 的系统调用统计
+ */
+struct IoRingStats
+{
+    uint64_t ops;      // 已完成的操作数
+    uint64_t syscalls; // 提交/等待/同步执行所用的系统调用数
+};
+
+/**
+ * @brief 批量 I/O 队列
+ *
+ * 先用 queueRead()/queueIoctl() 排入若干操作，再用 submit() 一次提交，用 reap() 取回完成结果。
+ * 运行时内核支持 io_uring（5.6 及以上）时，整批读取只需一次 io_uring_enter，并可注册
+ * 固定 fd 和缓冲区以省去每次操作的查找开销；否则退化为在 submit() 中逐个同步执行，
+ * 行为与 io_uring 一致（完成结果同样通过 reap() 取回）。
+ *
+ * io_uring 没有通用的 ioctl 操作，queueIoctl() 在两种后端下都在 submit() 时同步执行。
+ *
+ * completionFd() 在有新完成结果时变为可读，可挂到 EventLoop 上由调度线程取回结果。
+ * 非线程安全：同一个 IoRing 只能在一个线程中使用。
+ */
+class IoRing
+{
+public:
+    // 默认提交队列深度
+    static constexpr unsigned DEFAULT_ENTRIES = 64;
+
+    IoRing();
+
+    /**
+     * @brief 析构函数，释放队列（未取回的完成结果被丢弃）
+     */
+    ~IoRing();
+
+    // 禁止拷贝和移动（内核共享内存映射地址固定）
+    IoRing(const IoRing &) = delete;
+    IoRing &operator=(const IoRing &) = delete;
+
+    /**
+     * @brief 初始化队列
+     * @param entries 提交队列深度（io_uring 会向上取整为 2 的幂）
+     * @param allowIoUring false 时强制使用 POSIX 后端
+     * @return ErrorCode::Ok 成功（io_uring 不可用时同样成功，见 backend()）；InvalidParam 深度为 0
+     */
+    ErrorCode init(unsigned entries = DEFAULT_ENTRIES, bool allowIoUring = true);
+
+    IoBackend backend() const;
+
+    /**
+     * @brief 注册固定 fd（只能注册一次），之后对这些 fd 的读取使用固定文件表
+     * @return ErrorCode::Ok 成功（POSIX 后端下为空操作）；InvalidParam 参数无效或重复注册；DevIo 内核拒绝
+     */
+    ErrorCode registerFiles(const int *fds, unsigned count);
+
+    /**
+     * @brief 注册固定缓冲区（只能注册一次），目标完全落在某个缓冲区内的读取使用 READ_FIXED
+     * @return ErrorCode::Ok 成功（POSIX 后端下为空操作）；InvalidParam 参数无效或重复注册；DevIo 内核拒绝
+     */
+    ErrorCode registerBuffers(const iovec *buffers, unsigned count);
+
+    /**
+     * @brief 排入一次读取
+     * @param offset 文件偏移，-1 表示从当前位置读取（字符设备、管道）
+     * @return ErrorCode::Ok 成功；DevNotReady 未初始化；InvalidParam 参数无效
+     */
+    ErrorCode queueRead(int fd, void *buf, unsigned len, int64_t offset, uint64_t userData);
+
+    /**
+     * @brief 排入一次无参数 ioctl（如 LED_ON），submit() 时同步执行
+     * @return ErrorCode::Ok 成功；DevNotReady 未初始化；InvalidParam fd 无效
+     */
+    ErrorCode queueIoctl(int fd, unsigned long request, uint64_t userData);
+
+    /**
+     * @brief 提交已排入的操作
+     *
+     * io_uring 后端下在途读取数不超过完成队列容量（提交深度的 2 倍），超出部分留在队列中，
+     * reap() 之后再次 submit() 即可继续提交。io_uring_enter 失败或内核只接收了部分 SQE 时，
+     * 未被接收的读取同样留在队列中（inFlight() 仍计入），不会作为失败丢弃。
+     * @param waitFor 返回前至少等待的完成数（0 表示不等待，最多等待全部在途操作）
+     * @return 本次提交的操作数，一个也未能提交时为 -errno
+     */
+    int submit(unsigned waitFor = 0);
+
+    /**
+     * @brief 取回已完成的操作
+     * @param out 输出数组
+     * @param max 最多取回的个数
+     * @return 实际取回的个数
+     */
+    unsigned reap(IoCompletion *out, unsigned max);
+
+    /**
+     * @brief 已提交但尚未取回的操作数
+     */
+    unsigned inFlight() const;
+
+    /**
+     * @brief 有完成结果时可读的 eventfd（首次调用时创建，reap() 取回结果时清零）
+     * @return eventfd，未初始化或创建失败时为 -1
+     */
+    int completionFd();
+
+    IoRingStats stats() const;
+
+private:
+    struct PendingOp
+    {
+        bool isIoctl;
+        int fd;
+        void *buf;
+        unsigned len;
+        int64_t offset;
+        unsigned long request;
+        uint64_t userData;
+    };
+
+    bool setupIoUring(unsigned entries);
+    void teardownIoUring();
+    int fixedFileIndex(int fd) const;
+    int fixedBufferIndex(const void *buf, unsigned len) const;
+    void runSync(const PendingOp &op);
+    void notify();
+
+    IoBackend type;
+    bool initialized;
+    int eventFd;
+    unsigned inFlightCount;
+    IoRingStats counters;
+
+    std::vector<PendingOp> queued;           // 等待 submit() 的操作
+    std::vector<IoCompletion> syncCompleted; // 同步执行的操作结果
+    std::vector<int> fixedFiles;
+    std::vector<iovec> fixedBuffers;
+
+    // io_uring 共享内存
+    int ringFd;
+    unsigned sqEntries;
+    unsigned cqEntries;
+    void *sqRing;
+    void *cqRing;
+    std::size_t sqRingSize;
+    std::size_t cqRingSize;
+    void *sqes;
+    std::size_t sqesSize;
+    unsigned *sqTail;
+    unsigned *sqMask;
+    unsigned *sqArray;
+    unsigned *cqHead;
+    unsigned *cqTail;
+    unsigned *cqMask;
+    void *cqes;
+};
+
+/**
+ * @brief 把错误码形式的完成结果转换为 ErrorCode
+ * @param completion 完成结果
+ * @param expected 期望读取的字节数（ioctl 传 0）
+ * @return ErrorCode::Ok 成功；DevIo 失败或长度不符
+ */
+ErrorCode completionResult(const IoCompletion &completion, unsigned expected);
+
+} // namespace bsp
+
+#endif // BSP_IO_RING_H
@@ -0,0 +1,454 @@
+#include "metrics.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace bsp
+{
+
+constexpr int LatencyHistogram::SUB_BUCKET_BITS;
+constexpr int LatencyHistogram::MAX_VALUE_BITS;
+constexpr int LatencyHistogram::BUCKET_COUNT;
+
+const char *metricOpName(MetricOp op)
+{
+    switch (op)
+    {
+    case MetricOp::LedSetState:
+        return "led_set_state";
+    case MetricOp::AP3216CRead:
+        return "ap3216c_read";
+    case MetricOp::DHT11Read:
+        return "dht11_read";
+    case MetricOp::KeyDispatch:
+        return "key_dispatch";
+    default:
+        return "unknown";
+    }
+}
+
+// ============================================================================
+// LatencyHistogram / OpStats / MetricsSnapshot
+// ============================================================================
+
+uint64_t LatencyHistogram::bucketLowerBound(int index)
+{
+    if (index < (2 << SUB_BUCKET_BITS))
+    {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = (index >> SUB_BUCKET_BITS) - 1;
+    uint64_t sub = static_cast<uint64_t>(index & ((1 << SUB_BUCKET_BITS) - 1));
+    return (sub + (1ULL << SUB_BUCKET_BITS)) << shift;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < (2 << SUB_BUCKET_BITS))
+    {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = (index >> SUB_BUCKET_BITS) - 1;
+    return bucketLowerBound(index) + (1ULL << shift) - 1;
+}
+
+void LatencyHistogram::clear()
+{
+    std::memset(counts, 0, sizeof(counts));
+    count = 0;
+    sumNs = 0;
+    minNs = UINT64_MAX;
+    maxNs = 0;
+}
+
+void LatencyHistogram::record(uint64_t ns)
+{
+    counts[bucketIndex(ns)]++;
+    count++;
+    sumNs += ns;
+    if (ns < minNs)
+    {
+        minNs = ns;
+    }
+    if (ns > maxNs)
+    {
+        maxNs = ns;
+    }
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+    {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sumNs += other.sumNs;
+    if (other.minNs < minNs)
+    {
+        minNs = other.minNs;
+    }
+    if (other.maxNs > maxNs)
+    {
+        maxNs = other.maxNs;
+    }
+}
+
+uint64_t LatencyHistogram::valueAtQuantile(double q) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    if (q <= 0.0)
+    {
+        return minNs;
+    }
+
+    uint64_t target = static_cast<uint64_t>(q * static_cast<double>(count) + 0.5);
+    if (target == 0)
+    {
+        target = 1;
+    }
+    if (target >= count)
+    {
+        return maxNs;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += counts[i];
+        if (seen >= target)
+        {
+            // 桶上界可能超过实际最大值，取两者较小者
+            uint64_t upper = bucketUpperBound(i);
+            return upper < maxNs ? upper : maxNs;
+        }
+    }
+    return maxNs;
+}
+
+double LatencyHistogram::mean() const
+{
+    return count ? static_cast<double>(sumNs) / static_cast<double>(count) : 0.0;
+}
+
+void OpStats::clear()
+{
+    ops = 0;
+    std::memset(results, 0, sizeof(results));
+    latency.clear();
+}
+
+void OpStats::merge(const OpStats &other)
+{
+    ops += other.ops;
+    for (int i = 0; i < ERROR_CODE_COUNT; ++i)
+    {
+        results[i] += other.results[i];
+    }
+    latency.merge(other.latency);
+}
+
+void MetricsSnapshot::merge(const MetricsSnapshot &other)
+{
+    for (std::size_t i = 0; i < METRIC_OP_COUNT; ++i)
+    {
+        ops[i].merge(other.ops[i]);
+    }
+}
+
+// ============================================================================
+// Gauge
+// ============================================================================
+
+namespace
+{
+
+// Gauge 侵入式双向链表（有意泄漏，理由同下方 Registry）
+struct GaugeList
+{
+    std::mutex mutex;
+    Gauge *head = nullptr;
+
+    static GaugeList &instance()
+    {
+        static GaugeList *list = new GaugeList;
+        return *list;
+    }
+};
+
+} // namespace
+
+Gauge::Gauge(const char *name, const char *instance)
+    : gaugeName(name), gaugeInstance(instance), value(0), prev(nullptr), next(nullptr)
+{
+    GaugeList &list = GaugeList::instance();
+    std::lock_guard<std::mutex> lock(list.mutex);
+    next = list.head;
+    if (next)
+    {
+        next->prev = this;
+    }
+    list.head = this;
+}
+
+Gauge::~Gauge()
+{
+    GaugeList &list = GaugeList::instance();
+    std::lock_guard<std::mutex> lock(list.mutex);
+    if (prev)
+    {
+        prev->next = next;
+    }
+    else
+    {
+        list.head = next;
+    }
+    if (next)
+    {
+        next->prev = prev;
+    }
+}
+
+std::size_t Metrics::readGauges(GaugeSample *out, std::size_t capacity)
+{
+    GaugeList &list = GaugeList::instance();
+    std::lock_guard<std::mutex> lock(list.mutex);
+    std::size_t n = 0;
+    for (const Gauge *g = list.head; g != nullptr && n < capacity; g = g->next)
+    {
+        out[n].name = g->gaugeName;
+        out[n].instance = g->gaugeInstance;
+        out[n].value = g->get();
+        ++n;
+    }
+    return n;
+}
+
+#if BSP_ENABLE_METRICS
+
+// ============================================================================
+// 线程私有分片
+// ============================================================================
+
+namespace
+{
+
+using Counter = std::atomic<uint64_t>;
+
+// 单写者计数：只有所属线程写入，读线程 relaxed 读取，无需 lock 前缀的原子加
+inline void bump(Counter &counter, uint64_t delta = 1)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+inline uint64_t peek(const Counter &counter)
+{
+    return counter.load(std::memory_order_relaxed);
+}
+
+struct alignas(CACHE_LINE_SIZE) LiveOpStats
+{
+    Counter results[ERROR_CODE_COUNT];
+    Counter sumNs;
+    Counter minNs;
+    Counter maxNs;
+    Counter buckets[LatencyHistogram::BUCKET_COUNT];
+};
+
+// 每线程一块，按缓存行对齐，避免不同线程的分片发生伪共享
+struct alignas(CACHE_LINE_SIZE) ThreadShard
+{
+    LiveOpStats ops[METRIC_OP_COUNT];
+
+    ThreadShard()
+    {
+        for (auto &op : ops)
+        {
+            for (auto &c : op.results)
+            {
+                c.store(0, std::memory_order_relaxed);
+            }
+            op.sumNs.store(0, std::memory_order_relaxed);
+            op.minNs.store(UINT64_MAX, std::memory_order_relaxed);
+            op.maxNs.store(0, std::memory_order_relaxed);
+            for (auto &c : op.buckets)
+            {
+                c.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void readInto(MetricsSnapshot &snapshot) const
+    {
+        for (std::size_t i = 0; i < METRIC_OP_COUNT; ++i)
+        {
+            const LiveOpStats &live = ops[i];
+            OpStats stats;
+            for (int r = 0; r < ERROR_CODE_COUNT; ++r)
+            {
+                stats.results[r] = peek(live.results[r]);
+                stats.ops += stats.results[r];
+            }
+            for (int b = 0; b < LatencyHistogram::BUCKET_COUNT; ++b)
+            {
+                stats.latency.counts[b] = peek(live.buckets[b]);
+            }
+            stats.latency.count = stats.ops;
+            stats.latency.sumNs = peek(live.sumNs);
+            stats.latency.minNs = peek(live.minNs);
+            stats.latency.maxNs = peek(live.maxNs);
+            snapshot.ops[i].merge(stats);
+        }
+    }
+};
+
+// 全局分片注册表（有意泄漏，保证进程退出阶段线程析构时仍可用）
+class Registry
+{
+public:
+    static Registry &instance()
+    {
+        static Registry *registry = new Registry;
+        return *registry;
+    }
+
+    ThreadShard *acquire()
+    {
+        void *mem = nullptr;
+        if (posix_memalign(&mem, CACHE_LINE_SIZE, sizeof(ThreadShard)) != 0)
+        {
+            return nullptr;
+        }
+        ThreadShard *shard = new (mem) ThreadShard;
+        std::lock_guard<std::mutex> lock(mutex);
+        live.push_back(shard);
+        return shard;
+    }
+
+    void retire(ThreadShard *shard)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shard->readInto(retired);
+        for (auto it = live.begin(); it != live.end(); ++it)
+        {
+            if (*it == shard)
+            {
+                live.erase(it);
+                break;
+            }
+        }
+        shard->~ThreadShard();
+        std::free(shard);
+    }
+
+    MetricsSnapshot snapshot()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        MetricsSnapshot result = retired;
+        for (const ThreadShard *shard : live)
+        {
+            shard->readInto(result);
+        }
+        return result;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<ThreadShard *> live;
+    MetricsSnapshot retired; // 已退出线程的累计值
+};
+
+struct ShardHolder
+{
+    ThreadShard *shard;
+
+    ShardHolder() : shard(nullptr)
+    {
+    }
+
+    ~ShardHolder()
+    {
+        if (shard)
+        {
+            Registry::instance().retire(shard);
+        }
+    }
+};
+
+thread_local ShardHolder localShard;
+
+ThreadShard *currentShard()
+{
+    ThreadShard *shard = localShard.shard;
+    if (shard == nullptr)
+    {
+        shard = Registry::instance().acquire();
+        localShard.shard = shard;
+    }
+    return shard;
+}
+
+} // namespace
+
+void Metrics::record(MetricOp op, ErrorCode result, uint64_t ns)
+{
+    ThreadShard *shard = currentShard();
+    if (shard == nullptr)
+    {
+        return;
+    }
+
+    int resultIndex = -static_cast<int>(result);
+    if (resultIndex < 0 || resultIndex >= ERROR_CODE_COUNT)
+    {
+        resultIndex = -static_cast<int>(ErrorCode::DevIo);
+    }
+
+    LiveOpStats &stats = shard->ops[static_cast<std::size_t>(op)];
+    bump(stats.results[resultIndex]);
+    bump(stats.buckets[LatencyHistogram::bucketIndex(ns)]);
+    bump(stats.sumNs, ns);
+    if (ns < peek(stats.minNs))
+    {
+        stats.minNs.store(ns, std::memory_order_relaxed);
+    }
+    if (ns > peek(stats.maxNs))
+    {
+        stats.maxNs.store(ns, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::attachThread()
+{
+    currentShard();
+}
+
+MetricsSnapshot Metrics::snapshot()
+{
+    return Registry::instance().snapshot();
+}
+
+#else
+
+void Metrics::record(MetricOp, ErrorCode, uint64_t)
+{
+}
+
+void Metrics::attachThread()
+{
+}
+
+MetricsSnapshot Metrics::snapshot()
+{
+    return MetricsSnapshot();
+}
+
+#endif // BSP_ENABLE_METRICS
+
+} // namespace bsp
@@ -0,0 +1,297 @@
+#ifndef BSP_METRICS_H
+#define BSP_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "bsp_common.h"
+
+// 编译期开关：为 0 时驱动中的埋点全部编译为空操作（由 CMake 选项 BSP_ENABLE_METRICS 控制）
+#ifndef BSP_ENABLE_METRICS
+#define BSP_ENABLE_METRICS 1
+#endif
+
+namespace bsp
+{
+
+// 缓存行大小（Cortex-A7 为 64 字节）
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief 被统计的驱动操作
+ */
+enum class MetricOp : uint8_t
+{
+    LedSetState = 0, // Led::setState()
+    AP3216CRead,     // AP3216C::readData()
+    DHT11Read,       // DHT11::readData()
+    KeyDispatch,     // Key 回调分发
+    Count
+};
+
+constexpr std::size_t METRIC_OP_COUNT = static_cast<std::size_t>(MetricOp::Count);
+
+/**
+ * @brief 操作名（如 "led_set_state"），用于导出
+ */
+const char *metricOpName(MetricOp op);
+
+/**
+ * @brief HDR 风格的对数-线性延迟直方图（纳秒）
+ *
+ * 每个 2 的幂区间再等分为 8 个子桶，相对误差不超过 12.5%，
+ * 可表示到 2^40 ns（约 18 分钟），超出部分计入最后一个桶。
+ */
+struct LatencyHistogram
+{
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int MAX_VALUE_BITS = 40;
+    static constexpr int BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+    uint64_t counts[BUCKET_COUNT];
+    uint64_t count;
+    uint64_t sumNs;
+    uint64_t minNs;
+    uint64_t maxNs;
+
+    LatencyHistogram()
+    {
+        clear();
+    }
+
+    /**
+     * @brief 计算数值所在的桶下标
+     */
+    static int bucketIndex(uint64_t value)
+    {
+        const uint64_t maxValue = (1ULL << MAX_VALUE_BITS) - 1;
+        if (value > maxValue)
+        {
+            value = maxValue;
+        }
+        if (value < (2ULL << SUB_BUCKET_BITS))
+        {
+            return static_cast<int>(value);
+        }
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - SUB_BUCKET_BITS;
+        return ((shift + 1) << SUB_BUCKET_BITS) + static_cast<int>((value >> shift) - (1ULL << SUB_BUCKET_BITS));
+    }
+
+    /**
+     * @brief 桶所覆盖的数值范围 [lower, upper]
+     */
+    static uint64_t bucketLowerBound(int index);
+    static uint64_t bucketUpperBound(int index);
+
+    void clear();
+    void record(uint64_t ns);
+    void merge(const LatencyHistogram &other);
+
+    /**
+     * @brief 分位数对应的延迟（取所在桶的上界，q 取值 [0, 1]）
+     */
+    uint64_t valueAtQuantile(double q) const;
+
+    /**
+     * @brief 平均延迟（ns），无样本时为 0
+     */
+    double mean() const;
+};
+
+/**
+ * @brief 单个操作的统计快照
+ */
+struct OpStats
+{
+    uint64_t ops;                         // 总调用次数
+    uint64_t results[ERROR_CODE_COUNT];   // 按结果计数，下标为 -ErrorCode（0 为成功）
+    LatencyHistogram latency;
+
+    OpStats()
+    {
+        clear();
+    }
+
+    void clear();
+    void merge(const OpStats &other);
+
+    /**
+     * @brief 失败次数（非 ErrorCode::Ok 的调用）
+     */
+    uint64_t errors() const
+    {
+        return ops - results[0];
+    }
+};
+
+/**
+ * @brief 全部操作的统计快照，可与其它快照（如其它进程/时间段）合并
+ */
+struct MetricsSnapshot
+{
+    OpStats ops[METRIC_OP_COUNT];
+
+    const OpStats &operator[](MetricOp op) const
+    {
+        return ops[static_cast<std::size_t>(op)];
+    }
+
+    void merge(const MetricsSnapshot &other);
+};
+
+/**
+ * @brief 瞬时值指标（如队列深度）
+ *
+ * 构造时登记到全局列表，析构时注销，导出时以 bsp_<name>{instance="<instance>"} 形式输出，
+ * 同名同实例的多个 Gauge 导出时求和。name/instance 须为静态字符串（如字符串字面量）。
+ */
+class Gauge
+{
+public:
+    Gauge(const char *name, const char *instance);
+    ~Gauge();
+
+    Gauge(const Gauge &) = delete;
+    Gauge &operator=(const Gauge &) = delete;
+
+    void set(int64_t v)
+    {
+        value.store(v, std::memory_order_relaxed);
+    }
+
+    void add(int64_t delta)
+    {
+        value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    int64_t get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    const char *name() const
+    {
+        return gaugeName;
+    }
+
+    const char *instance() const
+    {
+        return gaugeInstance;
+    }
+
+private:
+    friend class Metrics;
+
+    const char *gaugeName;
+    const char *gaugeInstance;
+    std::atomic<int64_t> value;
+    Gauge *prev;
+    Gauge *next;
+};
+
+/**
+ * @brief Gauge 的一次读数
+ */
+struct GaugeSample
+{
+    const char *name;
+    const char *instance;
+    int64_t value;
+};
+
+/**
+ * @brief 驱动运行统计
+ *
+ * 每个线程首次记录时分配一块按缓存行对齐的私有分片，之后记录只写本线程分片
+ * （单写者 relaxed 原子操作，无锁、无总线锁前缀、无内存分配）。线程退出时分片
+ * 合并进全局累计值，snapshot() 汇总所有分片。
+ */
+class Metrics
+{
+public:
+    /**
+     * @brief 记录一次操作（通常通过 MetricsTimer 调用）
+     * @param op 操作
+     * @param result 操作结果
+     * @param ns 耗时（纳秒）
+     */
+    static void record(MetricOp op, ErrorCode result, uint64_t ns);
+
+    /**
+     * @brief 为当前线程预先分配分片（已分配时什么也不做）
+     *
+     * 驱动 init() 和库内工作线程启动时调用，使之后的首次 record() 不再访问堆
+     */
+    static void attachThread();
+
+    /**
+     * @brief 汇总当前所有线程的统计
+     */
+    static MetricsSnapshot snapshot();
+
+    /**
+     * @brief 读取当前所有 Gauge（不分配内存）
+     * @param out 输出数组
+     * @param capacity 数组容量
+     * @return 写入的个数（超出容量的部分被丢弃）
+     */
+    static std::size_t readGauges(GaugeSample *out, std::size_t capacity);
+
+    /**
+     * @brief 编译时是否启用了统计
+     */
+    static constexpr bool enabled()
+    {
+        return BSP_ENABLE_METRICS != 0;
+    }
+};
+
+#if BSP_ENABLE_METRICS
+
+/**
+ * @brief 操作计时器：构造时开始计时，finish() 时记录结果与耗时
+ *
+ * 用法：return timer.finish(ErrorCode::DevIo);
+ */
+class MetricsTimer
+{
+public:
+    explicit MetricsTimer(MetricOp op) : op(op), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ErrorCode finish(ErrorCode result)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Metrics::record(op, result,
+                        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        return result;
+    }
+
+private:
+    MetricOp op;
+    std::chrono::steady_clock::time_point start;
+};
+
+#else
+
+class MetricsTimer
+{
+public:
+    explicit MetricsTimer(MetricOp)
+    {
+    }
+
+    ErrorCode finish(ErrorCode result)
+    {
+        return result;
+    }
+};
+
+#endif // BSP_ENABLE_METRICS
+
+} // namespace bsp
+
+#endif // BSP_METRICS_H
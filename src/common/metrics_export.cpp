@@ -0,0 +1,226 @@
+#include "metrics_export.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace bsp
+{
+
+namespace
+{
+
+const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+const char *const QUANTILE_LABELS[] = {"0.5", "0.9", "0.99", "0.999"};
+const char *const QUANTILE_KEYS[] = {"p50", "p90", "p99", "p999"};
+constexpr std::size_t QUANTILE_COUNT = sizeof(QUANTILES) / sizeof(QUANTILES[0]);
+constexpr std::size_t MAX_GAUGES = 64;
+
+void appendf(std::string &out, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+void appendf(std::string &out, const char *fmt, ...)
+{
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    int n = std::vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n > 0)
+    {
+        out.append(buf, static_cast<std::size_t>(n) < sizeof(buf) ? static_cast<std::size_t>(n) : sizeof(buf) - 1);
+    }
+}
+
+double toSeconds(uint64_t ns)
+{
+    return static_cast<double>(ns) / 1e9;
+}
+
+// 读取 Gauge 并把同名同实例的读数合并
+std::size_t collectGauges(GaugeSample *gauges, std::size_t capacity)
+{
+    GaugeSample raw[MAX_GAUGES];
+    std::size_t rawCount = Metrics::readGauges(raw, MAX_GAUGES);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < rawCount; ++i)
+    {
+        bool merged = false;
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            if (std::strcmp(gauges[j].name, raw[i].name) == 0 &&
+                std::strcmp(gauges[j].instance, raw[i].instance) == 0)
+            {
+                gauges[j].value += raw[i].value;
+                merged = true;
+                break;
+            }
+        }
+        if (!merged && count < capacity)
+        {
+            gauges[count++] = raw[i];
+        }
+    }
+    return count;
+}
+
+ErrorCode resultCode(int index)
+{
+    return static_cast<ErrorCode>(-index);
+}
+
+} // namespace
+
+const char *errorCodeLabel(ErrorCode err)
+{
+    switch (err)
+    {
+    case ErrorCode::Ok:
+        return "ok";
+    case ErrorCode::InvalidParam:
+        return "invalid_param";
+    case ErrorCode::DevOpen:
+        return "dev_open";
+    case ErrorCode::DevIo:
+        return "dev_io";
+    case ErrorCode::DevNotReady:
+        return "dev_not_ready";
+    case ErrorCode::MemAlloc:
+        return "mem_alloc";
+    case ErrorCode::Unsupported:
+        return "unsupported";
+    case ErrorCode::Timeout:
+        return "timeout";
+    case ErrorCode::Cancelled:
+        return "cancelled";
+    default:
+        return "unknown";
+    }
+}
+
+std::string formatPrometheus(const MetricsSnapshot &snapshot)
+{
+    std::string out;
+    out.reserve(4096);
+
+    out += "# HELP bsp_driver_ops_total Driver operations by result.\n";
+    out += "# TYPE bsp_driver_ops_total counter\n";
+    for (std::size_t i = 0; i < METRIC_OP_COUNT; ++i)
+    {
+        const OpStats &stats = snapshot.ops[i];
+        const char *op = metricOpName(static_cast<MetricOp>(i));
+        for (int r = 0; r < ERROR_CODE_COUNT; ++r)
+        {
+            // 成功计数总是输出，错误计数只在出现过时输出
+            if (r == 0 || stats.results[r] != 0)
+            {
+                appendf(out, "bsp_driver_ops_total{op=\"%s\",result=\"%s\"} %llu\n", op,
+                        errorCodeLabel(resultCode(r)), static_cast<unsigned long long>(stats.results[r]));
+            }
+        }
+    }
+
+    out += "# HELP bsp_driver_latency_seconds Driver operation latency.\n";
+    out += "# TYPE bsp_driver_latency_seconds summary\n";
+    for (std::size_t i = 0; i < METRIC_OP_COUNT; ++i)
+    {
+        const LatencyHistogram &hist = snapshot.ops[i].latency;
+        const char *op = metricOpName(static_cast<MetricOp>(i));
+        for (std::size_t q = 0; q < QUANTILE_COUNT; ++q)
+        {
+            appendf(out, "bsp_driver_latency_seconds{op=\"%s\",quantile=\"%s\"} %.9f\n", op, QUANTILE_LABELS[q],
+                    toSeconds(hist.valueAtQuantile(QUANTILES[q])));
+        }
+        appendf(out, "bsp_driver_latency_seconds_sum{op=\"%s\"} %.9f\n", op, toSeconds(hist.sumNs));
+        appendf(out, "bsp_driver_latency_seconds_count{op=\"%s\"} %llu\n", op,
+                static_cast<unsigned long long>(hist.count));
+    }
+
+    out += "# HELP bsp_driver_latency_max_seconds Maximum driver operation latency.\n";
+    out += "# TYPE bsp_driver_latency_max_seconds gauge\n";
+    for (std::size_t i = 0; i < METRIC_OP_COUNT; ++i)
+    {
+        appendf(out, "bsp_driver_latency_max_seconds{op=\"%s\"} %.9f\n", metricOpName(static_cast<MetricOp>(i)),
+                toSeconds(snapshot.ops[i].latency.maxNs));
+    }
+
+    GaugeSample gauges[MAX_GAUGES];
+    std::size_t gaugeCount = collectGauges(gauges, MAX_GAUGES);
+    for (std::size_t i = 0; i < gaugeCount; ++i)
+    {
+        // 同名 Gauge 只输出一次 TYPE 行
+        bool typed = false;
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            if (std::strcmp(gauges[j].name, gauges[i].name) == 0)
+            {
+                typed = true;
+                break;
+            }
+        }
+        if (!typed)
+        {
+            appendf(out, "# TYPE bsp_%s gauge\n", gauges[i].name);
+        }
+        appendf(out, "bsp_%s{instance=\"%s\"} %lld\n", gauges[i].name, gauges[i].instance,
+                static_cast<long long>(gauges[i].value));
+    }
+
+    return out;
+}
+
+std::string formatJson(const MetricsSnapshot &snapshot)
+{
+    std::string out;
+    out.reserve(4096);
+
+    out += "{\"ops\":{";
+    for (std::size_t i = 0; i < METRIC_OP_COUNT; ++i)
+    {
+        const OpStats &stats = snapshot.ops[i];
+        const LatencyHistogram &hist = stats.latency;
+        appendf(out, "%s\"%s\":{\"ops\":%llu,\"errors\":%llu,\"results\":{", i ? "," : "",
+                metricOpName(static_cast<MetricOp>(i)), static_cast<unsigned long long>(stats.ops),
+                static_cast<unsigned long long>(stats.errors()));
+
+        bool first = true;
+        for (int r = 0; r < ERROR_CODE_COUNT; ++r)
+        {
+            if (r == 0 || stats.results[r] != 0)
+            {
+                appendf(out, "%s\"%s\":%llu", first ? "" : ",", errorCodeLabel(resultCode(r)),
+                        static_cast<unsigned long long>(stats.results[r]));
+                first = false;
+            }
+        }
+
+        appendf(out, "},\"latency_ns\":{\"count\":%llu,\"mean\":%.1f,\"min\":%llu,\"max\":%llu",
+                static_cast<unsigned long long>(hist.count), hist.mean(),
+                static_cast<unsigned long long>(hist.count ? hist.minNs : 0),
+                static_cast<unsigned long long>(hist.maxNs));
+        for (std::size_t q = 0; q < QUANTILE_COUNT; ++q)
+        {
+            appendf(out, ",\"%s\":%llu", QUANTILE_KEYS[q],
+                    static_cast<unsigned long long>(hist.valueAtQuantile(QUANTILES[q])));
+        }
+        out += "}}";
+    }
+    out += "},\"gauges\":[";
+
+    GaugeSample gauges[MAX_GAUGES];
+    std::size_t gaugeCount = collectGauges(gauges, MAX_GAUGES);
+    for (std::size_t i = 0; i < gaugeCount; ++i)
+    {
+        appendf(out, "%s{\"name\":\"%s\",\"instance\":\"%s\",\"value\":%lld}", i ? "," : "", gauges[i].name,
+                gauges[i].instance, static_cast<long long>(gauges[i].value));
+    }
+    out += "]}\n";
+
+    return out;
+}
+
+std::string exportMetrics(MetricsFormat format)
+{
+    MetricsSnapshot snapshot = Metrics::snapshot();
+    return format == MetricsFormat::Json ? formatJson(snapshot) : formatPrometheus(snapshot);
+}
+
+} // namespace bsp
@@ -0,0 +1,48 @@
+#ifndef BSP_METRICS_EXPORT_H
+#define BSP_METRICS_EXPORT_H
+
+#include <string>
+#include "bsp_common.h"
+#include "metrics.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 指标导出格式
+ */
+enum class MetricsFormat
+{
+    Prometheus, // Prometheus 文本格式（text/plain; version=0.0.4）
+    Json
+};
+
+/**
+ * @brief 错误码标签名（如 "dev_io"），用于导出
+ */
+const char *errorCodeLabel(ErrorCode err);
+
+/**
+ * @brief 将统计快照与当前 Gauge 序列化为 Prometheus 文本格式
+ *
+ * 输出包括：
+ * - bsp_driver_ops_total{op,result}        按结果分类的调用次数（counter）
+ * - bsp_driver_latency_seconds{op,quantile} 延迟分位数（summary，含 _sum/_count）
+ * - bsp_driver_latency_max_seconds{op}      最大延迟（gauge）
+ * - bsp_<gauge>{instance}                   Gauge 当前值（如 bsp_queue_depth）
+ */
+std::string formatPrometheus(const MetricsSnapshot &snapshot);
+
+/**
+ * @brief 将统计快照与当前 Gauge 序列化为 JSON
+ */
+std::string formatJson(const MetricsSnapshot &snapshot);
+
+/**
+ * @brief 按指定格式序列化当前进程的统计
+ */
+std::string exportMetrics(MetricsFormat format);
+
+} // namespace bsp
+
+#endif // BSP_METRICS_EXPORT_H
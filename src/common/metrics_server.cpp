@@ -0,0 +1,353 @@
+#include "metrics_server.h"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace bsp
+{
+
+namespace
+{
+
+// 单个请求最大长度及读取超时
+constexpr std::size_t MAX_REQUEST = 1024;
+constexpr int REQUEST_TIMEOUT_MS = 200;
+// 应答时单次 send() 的超时，客户端不读取时放弃该连接，避免卡住服务线程和 stop()
+constexpr int RESPONSE_TIMEOUT_MS = 1000;
+
+bool makeAddress(const std::string &path, sockaddr_un &addr)
+{
+    if (path.empty() || path.size() >= sizeof(addr.sun_path))
+    {
+        return false;
+    }
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool writeAll(int fd, const char *data, std::size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        len -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// 删除上次运行残留的套接字文件；路径上是其他类型的文件时拒绝，避免路径写错时误删
+bool removeStaleSocket(const std::string &path)
+{
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0)
+    {
+        return errno == ENOENT;
+    }
+    if (!S_ISSOCK(st.st_mode))
+    {
+        spdlog::error("metrics socket path {} exists and is not a socket", path);
+        return false;
+    }
+    return unlink(path.c_str()) == 0 || errno == ENOENT;
+}
+
+// 读取请求直到换行、对端关闭写端、达到上限或超时
+std::string readRequest(int fd)
+{
+    std::string request;
+    char buf[256];
+    while (request.size() < MAX_REQUEST && request.find('\n') == std::string::npos)
+    {
+        pollfd pfd = {fd, POLLIN, 0};
+        int ret = poll(&pfd, 1, REQUEST_TIMEOUT_MS);
+        if (ret <= 0)
+        {
+            break;
+        }
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0)
+        {
+            break;
+        }
+        request.append(buf, static_cast<std::size_t>(n));
+    }
+    return request;
+}
+
+} // namespace
+
+MetricsServer::MetricsServer() : listenFd(-1), wakeFd(-1), running(false)
+{
+}
+
+MetricsServer::~MetricsServer()
+{
+    stop();
+}
+
+ErrorCode MetricsServer::start(const std::string &socketPath)
+{
+    if (running)
+    {
+        spdlog::warn("metrics server already running on {}", path);
+        return ErrorCode::Ok;
+    }
+    if (validateThreadAttr(threadAttr) != ErrorCode::Ok)
+    {
+        return ErrorCode::InvalidParam;
+    }
+
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr))
+    {
+        spdlog::error("invalid metrics socket path {}", socketPath);
+        return ErrorCode::InvalidParam;
+    }
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        spdlog::error("create metrics socket failed: {}", std::strerror(errno));
+        return ErrorCode::DevOpen;
+    }
+
+    if (!removeStaleSocket(socketPath))
+    {
+        close(listenFd);
+        listenFd = -1;
+        return ErrorCode::DevOpen;
+    }
+    if (bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listenFd, 8) < 0)
+    {
+        spdlog::error("bind metrics socket {} failed: {}", socketPath, std::strerror(errno));
+        close(listenFd);
+        listenFd = -1;
+        return ErrorCode::DevOpen;
+    }
+
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0)
+    {
+        spdlog::error("create metrics wake fd failed: {}", std::strerror(errno));
+        close(listenFd);
+        listenFd = -1;
+        unlink(socketPath.c_str());
+        return ErrorCode::DevOpen;
+    }
+
+    path = socketPath;
+    running = true;
+    ErrorCode result = serveThread.start<MetricsServer, &MetricsServer::serveLoop>(this);
+    if (result != ErrorCode::Ok)
+    {
+        running = false;
+        spdlog::error("Failed to start metrics server");
+        stop();
+        return result;
+    }
+
+    result = applyThreadAttr(serveThread, threadAttr, "bsp-metrics");
+    if (result != ErrorCode::Ok)
+    {
+        stop();
+        return result;
+    }
+
+    spdlog::info("metrics server listening on {}", path);
+    return ErrorCode::Ok;
+}
+
+ErrorCode MetricsServer::stop()
+{
+    if (running)
+    {
+        running = false;
+        uint64_t one = 1;
+        ssize_t n = write(wakeFd, &one, sizeof(one));
+        (void)n;
+    }
+
+    if (serveThread.joinable())
+    {
+        serveThread.join();
+    }
+
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        listenFd = -1;
+        unlink(path.c_str());
+        spdlog::info("metrics server on {} stopped", path);
+    }
+    if (wakeFd >= 0)
+    {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+    return ErrorCode::Ok;
+}
+
+bool MetricsServer::isRunning() const
+{
+    return running;
+}
+
+void MetricsServer::setThreadAttr(const ThreadAttr &attr)
+{
+    threadAttr = attr;
+}
+
+void MetricsServer::serveLoop()
+{
+    prefaultStack(threadAttr.stackPrefaultBytes);
+    while (running)
+    {
+        pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        int ret = poll(fds, 2, -1);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            spdlog::error("metrics server poll failed: {}", std::strerror(errno));
+            break;
+        }
+        if (fds[1].revents != 0)
+        {
+            break;
+        }
+        if (fds[0].revents & POLLIN)
+        {
+            int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (clientFd >= 0)
+            {
+                timeval timeout = {RESPONSE_TIMEOUT_MS / 1000, (RESPONSE_TIMEOUT_MS % 1000) * 1000};
+                setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                handleClient(clientFd);
+                close(clientFd);
+            }
+        }
+    }
+}
+
+void MetricsServer::handleClient(int clientFd)
+{
+    std::string request = readRequest(clientFd);
+
+    bool http = request.compare(0, 4, "GET ") == 0;
+    MetricsFormat format = MetricsFormat::Prometheus;
+    if (http)
+    {
+        std::size_t end = request.find(' ', 4);
+        std::string target = request.substr(4, end == std::string::npos ? std::string::npos : end - 4);
+        if (target.find("json") != std::string::npos)
+        {
+            format = MetricsFormat::Json;
+        }
+    }
+    else if (request.compare(0, 4, "json") == 0)
+    {
+        format = MetricsFormat::Json;
+    }
+
+    std::string body = exportMetrics(format);
+    if (http)
+    {
+        std::string header = "HTTP/1.0 200 OK\r\nContent-Type: ";
+        header += (format == MetricsFormat::Json) ? "application/json" : "text/plain; version=0.0.4";
+        header += "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+        if (!writeAll(clientFd, header.data(), header.size()))
+        {
+            return;
+        }
+    }
+    writeAll(clientFd, body.data(), body.size());
+}
+
+ErrorCode fetchMetrics(const std::string &socketPath, MetricsFormat format, std::string &out, int timeoutMs)
+{
+    sockaddr_un addr;
+    if (!makeAddress(socketPath, addr))
+    {
+        return ErrorCode::InvalidParam;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return ErrorCode::DevOpen;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
+    {
+        spdlog::error("connect to {} failed: {}", socketPath, std::strerror(errno));
+        close(fd);
+        return ErrorCode::DevOpen;
+    }
+
+    const char *request = (format == MetricsFormat::Json) ? "json\n" : "prom\n";
+    if (!writeAll(fd, request, std::strlen(request)))
+    {
+        close(fd);
+        return ErrorCode::DevIo;
+    }
+    shutdown(fd, SHUT_WR);
+
+    out.clear();
+    char buf[4096];
+    ErrorCode result = ErrorCode::Ok;
+    while (true)
+    {
+        pollfd pfd = {fd, POLLIN, 0};
+        int ret = poll(&pfd, 1, timeoutMs);
+        if (ret == 0)
+        {
+            result = ErrorCode::Timeout;
+            break;
+        }
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            result = ErrorCode::DevIo;
+            break;
+        }
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n < 0)
+        {
+            result = ErrorCode::DevIo;
+            break;
+        }
+        if (n == 0)
+        {
+            break;
+        }
+        out.append(buf, static_cast<std::size_t>(n));
+    }
+
+    close(fd);
+    return result;
+}
+
+} // namespace bsp
@@ -0,0 +1,81 @@
+#ifndef BSP_METRICS_SERVER_H
+#define BSP_METRICS_SERVER_H
+
+#include <atomic>
+#include <string>
+#include "bsp_common.h"
+#include "metrics_export.h"
+#include "thread_attr.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 本地 Unix 域套接字指标应答器
+ *
+ * 后台线程监听 Unix 域套接字，每个连接应答一次后关闭。支持两种请求：
+ * - 单行文本命令 "prom" 或 "json"（空请求按 prom 处理），直接返回导出内容；
+ * - HTTP GET（如 curl --unix-socket <path> http://localhost/metrics），
+ *   路径包含 "json" 时返回 JSON，否则返回 Prometheus 文本。
+ * 读取请求和写出应答都有超时，不读取应答的客户端不会卡住服务线程和 stop()。
+ */
+class MetricsServer
+{
+public:
+    MetricsServer();
+
+    /**
+     * @brief 析构函数，自动停止服务并删除套接字文件
+     */
+    ~MetricsServer();
+
+    // 禁止拷贝和移动（服务线程持有 this 指针）
+    MetricsServer(const MetricsServer &) = delete;
+    MetricsServer &operator=(const MetricsServer &) = delete;
+
+    /**
+     * @brief 在指定路径上开始监听（已存在的同名套接字文件会被替换，其他类型的文件不会被删除）
+     * @param socketPath 套接字路径
+     * @return ErrorCode::Ok 成功；InvalidParam 路径过长；DevOpen 路径上已有非套接字文件或绑定/监听失败；
+     *         DevIo 线程创建失败
+     */
+    ErrorCode start(const std::string &socketPath);
+
+    /**
+     * @brief 停止服务
+     * @return ErrorCode::Ok
+     */
+    ErrorCode stop();
+
+    bool isRunning() const;
+
+    /**
+     * @brief 设置服务线程的属性（start() 之前调用）
+     */
+    void setThreadAttr(const ThreadAttr &attr);
+
+private:
+    void serveLoop();
+    void handleClient(int clientFd);
+
+    std::string path;
+    int listenFd;
+    int wakeFd;
+    std::atomic<bool> running;
+    Thread serveThread;
+    ThreadAttr threadAttr;
+};
+
+/**
+ * @brief 作为客户端从 MetricsServer 获取指标
+ * @param socketPath 套接字路径
+ * @param format 导出格式
+ * @param out 输出内容
+ * @param timeoutMs 超时时间(ms)
+ * @return ErrorCode::Ok 成功；DevOpen 连接失败；DevIo 读写失败；Timeout 超时
+ */
+ErrorCode fetchMetrics(const std::string &socketPath, MetricsFormat format, std::string &out, int timeoutMs = 1000);
+
+} // namespace bsp
+
+#endif // BSP_METRICS_SERVER_H
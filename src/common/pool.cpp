@@ -0,0 +1,205 @@
+#include "pool.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+
+namespace bsp
+{
+
+namespace
+{
+
+std::size_t alignUp(std::size_t value, std::size_t align)
+{
+    return (value + align - 1) & ~(align - 1);
+}
+
+bool isPowerOfTwo(std::size_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+} // namespace
+
+// ============================================================================
+// BlockPool
+// ============================================================================
+
+BlockPool::BlockPool(std::size_t blockSize, std::size_t blockCount, const char *name, std::size_t align)
+    : poolName(name), size(0), count(0), storage(nullptr), freeList(nullptr), inUse(0), peak(0), allocations(0),
+      failures(0), inUseGauge("pool_in_use", name)
+{
+    if (!isPowerOfTwo(align) || align > alignof(std::max_align_t))
+    {
+        spdlog::warn("pool {}: alignment {} not supported, using {}", name, align, alignof(std::max_align_t));
+        align = alignof(std::max_align_t);
+    }
+    // 空闲块里存放链表指针，块至少要放得下一个指针
+    size = alignUp(std::max(blockSize, sizeof(FreeBlock)), std::max(align, alignof(FreeBlock)));
+    if (blockCount == 0)
+    {
+        return;
+    }
+
+    storage = static_cast<char *>(::operator new(size * blockCount, std::nothrow));
+    if (storage == nullptr)
+    {
+        spdlog::error("pool {}: allocating {} x {} bytes failed", name, blockCount, size);
+        return;
+    }
+    count = blockCount;
+    // 按地址顺序串起空闲链表，先分配的块地址靠前
+    for (std::size_t i = count; i > 0; --i)
+    {
+        FreeBlock *block = reinterpret_cast<FreeBlock *>(storage + (i - 1) * size);
+        block->next = freeList;
+        freeList = block;
+    }
+}
+
+BlockPool::~BlockPool()
+{
+    if (inUse != 0)
+    {
+        spdlog::warn("pool {} destroyed with {} blocks in use", poolName, inUse);
+    }
+    inUseGauge.set(0);
+    ::operator delete(storage);
+}
+
+void *BlockPool::allocate()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    FreeBlock *block = freeList;
+    if (block == nullptr)
+    {
+        ++failures;
+        return nullptr;
+    }
+    freeList = block->next;
+    ++allocations;
+    peak = std::max(peak, ++inUse);
+    inUseGauge.add(1);
+    return block;
+}
+
+void BlockPool::deallocate(void *block)
+{
+    if (block == nullptr)
+    {
+        return;
+    }
+    if (!owns(block))
+    {
+        spdlog::error("pool {}: {} was not allocated from this pool", poolName, block);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    FreeBlock *free = static_cast<FreeBlock *>(block);
+    free->next = freeList;
+    freeList = free;
+    --inUse;
+    inUseGauge.add(-1);
+}
+
+bool BlockPool::owns(const void *p) const
+{
+    const char *c = static_cast<const char *>(p);
+    if (storage == nullptr || c < storage || c >= storage + size * count)
+    {
+        return false;
+    }
+    return static_cast<std::size_t>(c - storage) % size == 0;
+}
+
+PoolStats BlockPool::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    PoolStats s;
+    s.blockSize = size;
+    s.capacity = count;
+    s.inUse = inUse;
+    s.peak = peak;
+    s.allocations = allocations;
+    s.failures = failures;
+    return s;
+}
+
+// ============================================================================
+// Arena
+// ============================================================================
+
+Arena::Arena(std::size_t capacity)
+    : base(static_cast<char *>(::operator new(capacity, std::nothrow))), size(0), offset(0), owned(true), peak(0),
+      allocations(0), failures(0), resets(0)
+{
+    if (base == nullptr)
+    {
+        spdlog::error("arena: allocating {} bytes failed", capacity);
+        return;
+    }
+    size = capacity;
+}
+
+Arena::Arena(void *buffer, std::size_t capacity)
+    : base(static_cast<char *>(buffer)), size(buffer != nullptr ? capacity : 0), offset(0), owned(false), peak(0),
+      allocations(0), failures(0), resets(0)
+{
+}
+
+Arena::~Arena()
+{
+    if (owned)
+    {
+        ::operator delete(base);
+    }
+}
+
+void *Arena::allocate(std::size_t bytes, std::size_t align)
+{
+    if (!isPowerOfTwo(align))
+    {
+        ++failures;
+        return nullptr;
+    }
+    // 按实际地址对齐，调用方提供的缓冲区不一定按 max_align_t 对齐
+    uintptr_t current = reinterpret_cast<uintptr_t>(base) + offset;
+    std::size_t start = offset + (alignUp(current, align) - current);
+    if (base == nullptr || start > size || bytes > size - start)
+    {
+        ++failures;
+        return nullptr;
+    }
+    offset = start + bytes;
+    peak = std::max(peak, offset);
+    ++allocations;
+    return base + start;
+}
+
+void Arena::reset()
+{
+    offset = 0;
+    ++resets;
+}
+
+iovec Arena::region() const
+{
+    iovec v;
+    v.iov_base = base;
+    v.iov_len = size;
+    return v;
+}
+
+ArenaStats Arena::stats() const
+{
+    ArenaStats s;
+    s.capacity = size;
+    s.used = offset;
+    s.peak = peak;
+    s.allocations = allocations;
+    s.failures = failures;
+    s.resets = resets;
+    return s;
+}
+
+} // namespace bsp
@@ -0,0 +1,352 @@
+#ifndef BSP_POOL_H
+#define BSP_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sys/uio.h>
+#include <utility>
+#include "metrics.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 块池统计
+ */
+struct PoolStats
+{
+    std::size_t blockSize; // 实际块大小（按对齐向上取整）
+    std::size_t capacity;  // 块数
+    std::size_t inUse;     // 当前已分配的块数
+    std::size_t peak;      // inUse 的历史最大值
+    uint64_t allocations;  // 成功分配次数
+    uint64_t failures;     // 池耗尽导致的分配失败次数
+};
+
+/**
+ * @brief 固定大小块池
+ *
+ * 构造时一次性申请 blockCount 个块，之后 allocate()/deallocate() 只在空闲链表上取还，
+ * 不再访问堆，长期运行不产生碎片。池耗尽时 allocate() 返回 nullptr 并计入 failures，
+ * 由调用方决定丢弃还是降级。线程安全（事件线程分配、消费线程释放）。
+ *
+ * 已分配块数导出为 bsp_pool_in_use{instance="<name>"}。
+ */
+class BlockPool
+{
+public:
+    /**
+     * @param blockSize 每块字节数
+     * @param blockCount 块数
+     * @param name 导出指标的实例名，须为静态字符串
+     * @param align 块对齐，不超过 alignof(std::max_align_t)
+     */
+    BlockPool(std::size_t blockSize, std::size_t blockCount, const char *name = "pool",
+              std::size_t align = alignof(std::max_align_t));
+
+    /**
+     * @brief 析构时仍有未归还的块只记录警告（块内对象不会被析构）
+     */
+    ~BlockPool();
+
+    BlockPool(const BlockPool &) = delete;
+    BlockPool &operator=(const BlockPool &) = delete;
+
+    /**
+     * @brief 取一个块（内容未初始化）
+     * @return 块地址；池耗尽或构造时申请失败返回 nullptr
+     */
+    void *allocate();
+
+    /**
+     * @brief 归还由本池分配的块；nullptr 忽略，不属于本池的地址记录错误后忽略
+     */
+    void deallocate(void *block);
+
+    /**
+     * @brief 地址是否落在本池的某个块上
+     */
+    bool owns(const void *p) const;
+
+    std::size_t blockSize() const
+    {
+        return size;
+    }
+
+    std::size_t capacity() const
+    {
+        return count;
+    }
+
+    PoolStats stats() const;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    const char *poolName;
+    std::size_t size;
+    std::size_t count;
+    char *storage;
+    FreeBlock *freeList;
+
+    mutable std::mutex mutex; // 保护空闲链表与统计
+    std::size_t inUse;
+    std::size_t peak;
+    uint64_t allocations;
+    uint64_t failures;
+    Gauge inUseGauge;
+};
+
+/**
+ * @brief 定长对象池：在 BlockPool 的块上构造/析构 T
+ *
+ * 适合在线程间排队的事件、样本记录，例如：
+ *
+ *   bsp::ObjectPool<KeyRecord> records(64, "key_records");
+ *   auto r = records.make(code, value); // 池耗尽时为空指针
+ *   queue.push(std::move(r));           // 出队销毁时自动归还
+ */
+template <typename T> class ObjectPool
+{
+public:
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+    /**
+     * @brief make() 返回的智能指针的删除器：析构对象并把块还给池
+     */
+    class Deleter
+    {
+    public:
+        Deleter() : pool(nullptr)
+        {
+        }
+
+        explicit Deleter(ObjectPool *pool) : pool(pool)
+        {
+        }
+
+        void operator()(T *obj) const
+        {
+            if (pool != nullptr)
+            {
+                pool->destroy(obj);
+            }
+        }
+
+    private:
+        ObjectPool *pool;
+    };
+
+    using Ptr = std::unique_ptr<T, Deleter>;
+
+    explicit ObjectPool(std::size_t capacity, const char *name = "object_pool")
+        : blocks(sizeof(T), capacity, name, alignof(T))
+    {
+    }
+
+    /**
+     * @brief 在池中构造一个对象
+     * @return 对象指针；池耗尽返回 nullptr
+     */
+    template <typename... Args> T *create(Args &&...args)
+    {
+        void *mem = blocks.allocate();
+        if (mem == nullptr)
+        {
+            return nullptr;
+        }
+        return new (mem) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 析构对象并归还块（nullptr 忽略）
+     */
+    void destroy(T *obj)
+    {
+        if (obj == nullptr)
+        {
+            return;
+        }
+        obj->~T();
+        blocks.deallocate(obj);
+    }
+
+    /**
+     * @brief create() 的 RAII 版本，池耗尽时返回空指针
+     */
+    template <typename... Args> Ptr make(Args &&...args)
+    {
+        return Ptr(create(std::forward<Args>(args)...), Deleter(this));
+    }
+
+    std::size_t capacity() const
+    {
+        return blocks.capacity();
+    }
+
+    PoolStats stats() const
+    {
+        return blocks.stats();
+    }
+
+private:
+    BlockPool blocks;
+};
+
+/**
+ * @brief 区域统计
+ */
+struct ArenaStats
+{
+    std::size_t capacity; // 字节数
+    std::size_t used;     // 当前已用字节数（含对齐填充）
+    std::size_t peak;     // used 的历史最大值
+    uint64_t allocations; // 成功分配次数
+    uint64_t failures;    // 空间不足导致的分配失败次数
+    uint64_t resets;      // reset() 次数
+};
+
+/**
+ * @brief 单调区域分配器
+ *
+ * 分配只是移动一次偏移，不能单独释放，reset() 一次性回收全部空间；适合每批读取前 reset()、
+ * 批内按需切出目标缓冲区的场景。缓冲区可在构造时申请，也可由调用方提供（如静态数组）。
+ * region() 可直接交给 IoRing::registerBuffers()，批量读取走 READ_FIXED。
+ *
+ * 不是线程安全的：一个区域只由一个线程使用。
+ */
+class Arena
+{
+public:
+    /**
+     * @brief 构造时一次性申请 capacity 字节
+     */
+    explicit Arena(std::size_t capacity);
+
+    /**
+     * @brief 使用调用方提供的缓冲区（Arena 不负责释放）
+     */
+    Arena(void *buffer, std::size_t capacity);
+
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief 切出一段内存（内容未初始化）
+     * @param bytes 字节数
+     * @param align 对齐，须为 2 的幂
+     * @return 地址；空间不足或参数无效返回 nullptr
+     */
+    void *allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t));
+
+    /**
+     * @brief 切出 n 个 T 的数组（不构造，T 应为样本结构体这类平凡类型）
+     */
+    template <typename T> T *allocateArray(std::size_t n)
+    {
+        return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief 回收全部空间（之前切出的内存全部失效）
+     */
+    void reset();
+
+    std::size_t capacity() const
+    {
+        return size;
+    }
+
+    std::size_t used() const
+    {
+        return offset;
+    }
+
+    /**
+     * @brief 整个缓冲区（用于注册固定缓冲区）
+     */
+    iovec region() const;
+
+    ArenaStats stats() const;
+
+private:
+    char *base;
+    std::size_t size;
+    std::size_t offset;
+    bool owned;
+    std::size_t peak;
+    uint64_t allocations;
+    uint64_t failures;
+    uint64_t resets;
+};
+
+/**
+ * @brief 从 Arena 分配的 STL 分配器（deallocate 为空操作，空间随 Arena::reset() 回收）
+ *
+ *   bsp::Arena arena(4096);
+ *   std::vector<bsp::AP3216CData, bsp::ArenaAllocator<bsp::AP3216CData>> batch{
+ *       bsp::ArenaAllocator<bsp::AP3216CData>(arena)};
+ *   batch.reserve(64); // 空间不足时抛出 std::bad_alloc（-fno-exceptions 下终止进程）
+ */
+template <typename T> class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena &arena) : arena(&arena)
+    {
+    }
+
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.source())
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        T *p = arena->allocateArray<T>(n);
+        if (p == nullptr)
+        {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+            throw std::bad_alloc();
+#else
+            std::abort(); // -fno-exceptions：与 operator new 失败时的行为一致
+#endif
+        }
+        return p;
+    }
+
+    void deallocate(T *, std::size_t)
+    {
+    }
+
+    Arena *source() const
+    {
+        return arena;
+    }
+
+private:
+    Arena *arena;
+};
+
+template <typename T, typename U> bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b)
+{
+    return a.source() == b.source();
+}
+
+template <typename T, typename U> bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b)
+{
+    return a.source() != b.source();
+}
+
+} // namespace bsp
+
+#endif // BSP_POOL_H
@@ -0,0 +1,240 @@
+#include "thread_attr.h"
+#include <spdlog/spdlog.h>
+#include <alloca.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <malloc.h>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace bsp
+{
+
+namespace
+{
+
+int toNativePolicy(SchedPolicy policy)
+{
+    switch (policy)
+    {
+    case SchedPolicy::Fifo:
+        return SCHED_FIFO;
+    case SchedPolicy::RoundRobin:
+        return SCHED_RR;
+    default:
+        return SCHED_OTHER;
+    }
+}
+
+ErrorCode fromErrno(int err)
+{
+    switch (err)
+    {
+    case EINVAL:
+        return ErrorCode::InvalidParam;
+    case EPERM:
+        return ErrorCode::Unsupported;
+    default:
+        return ErrorCode::DevIo;
+    }
+}
+
+std::mutex lockMutex;
+bool memoryLocked = false;
+
+} // namespace
+
+ThreadAttr ThreadAttr::realtime(int priority, uint64_t cpuMask)
+{
+    ThreadAttr attr;
+    attr.policy = SchedPolicy::Fifo;
+    attr.priority = priority;
+    attr.cpuMask = cpuMask;
+    attr.lockMemory = true;
+    attr.stackPrefaultBytes = 64 * 1024;
+    return attr;
+}
+
+ErrorCode validateThreadAttr(const ThreadAttr &attr)
+{
+    if (attr.policy == SchedPolicy::Other)
+    {
+        if (attr.priority != 0)
+        {
+            spdlog::error("SCHED_OTHER thread priority must be 0, got {}", attr.priority);
+            return ErrorCode::InvalidParam;
+        }
+    }
+    else
+    {
+        int policy = toNativePolicy(attr.policy);
+        if (attr.priority < sched_get_priority_min(policy) || attr.priority > sched_get_priority_max(policy))
+        {
+            spdlog::error("real-time thread priority {} out of range", attr.priority);
+            return ErrorCode::InvalidParam;
+        }
+    }
+    if (CPU_SETSIZE < 64 && (attr.cpuMask >> CPU_SETSIZE) != 0)
+    {
+        return ErrorCode::InvalidParam;
+    }
+    return ErrorCode::Ok;
+}
+
+Thread::~Thread()
+{
+    if (started)
+    {
+        spdlog::critical("bsp::Thread destroyed while still joinable");
+        std::terminate();
+    }
+}
+
+ErrorCode Thread::startRoutine(void *(*routine)(void *), void *arg)
+{
+    if (started)
+    {
+        return ErrorCode::InvalidParam;
+    }
+    int err = pthread_create(&handle, nullptr, routine, arg);
+    if (err != 0)
+    {
+        spdlog::error("create thread failed: {}", std::strerror(err));
+        return err == EAGAIN ? ErrorCode::MemAlloc : fromErrno(err);
+    }
+    started = true;
+    return ErrorCode::Ok;
+}
+
+void Thread::join()
+{
+    if (!started)
+    {
+        return;
+    }
+    pthread_join(handle, nullptr);
+    started = false;
+}
+
+namespace
+{
+
+ErrorCode applyToHandle(pthread_t handle, const ThreadAttr &attr, const char *defaultName)
+{
+    ErrorCode result = validateThreadAttr(attr);
+    if (result != ErrorCode::Ok)
+    {
+        return result;
+    }
+
+    // 线程名只用于调试，失败不影响其他属性；内核限制 15 字符
+    char name[16];
+    std::snprintf(name, sizeof(name), "%s", attr.name.empty() ? defaultName : attr.name.c_str());
+    int err = pthread_setname_np(handle, name);
+    if (err != 0)
+    {
+        spdlog::warn("set thread name {} failed: {}", name, std::strerror(err));
+    }
+
+    if (attr.lockMemory)
+    {
+        result = lockProcessMemory();
+        if (result != ErrorCode::Ok)
+        {
+            return result;
+        }
+    }
+
+    if (attr.cpuMask != 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu)
+        {
+            if ((attr.cpuMask >> cpu) & 1u)
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        err = pthread_setaffinity_np(handle, sizeof(set), &set);
+        if (err != 0)
+        {
+            spdlog::error("set affinity 0x{:x} for {} failed: {}", attr.cpuMask, name, std::strerror(err));
+            return fromErrno(err);
+        }
+    }
+
+    // SCHED_OTHER 也显式设置一次，使线程不继承创建者的实时策略
+    sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = attr.priority;
+    err = pthread_setschedparam(handle, toNativePolicy(attr.policy), &param);
+    if (err != 0)
+    {
+        spdlog::error("set scheduling policy for {} failed: {}", name, std::strerror(err));
+        return fromErrno(err);
+    }
+    return ErrorCode::Ok;
+}
+
+} // namespace
+
+ErrorCode applyThreadAttr(std::thread &thread, const ThreadAttr &attr, const char *defaultName)
+{
+    if (!thread.joinable())
+    {
+        return ErrorCode::InvalidParam;
+    }
+    return applyToHandle(thread.native_handle(), attr, defaultName);
+}
+
+ErrorCode applyThreadAttr(Thread &thread, const ThreadAttr &attr, const char *defaultName)
+{
+    if (!thread.joinable())
+    {
+        return ErrorCode::InvalidParam;
+    }
+    return applyToHandle(thread.nativeHandle(), attr, defaultName);
+}
+
+ErrorCode lockProcessMemory()
+{
+    std::lock_guard<std::mutex> lock(lockMutex);
+    if (memoryLocked)
+    {
+        return ErrorCode::Ok;
+    }
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        spdlog::error("mlockall failed: {}", std::strerror(errno));
+        return ErrorCode::MemAlloc;
+    }
+    // 释放的堆内存留在进程内，大块分配也走堆，避免锁定后再次缺页
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+    memoryLocked = true;
+    spdlog::info("process memory locked");
+    return ErrorCode::Ok;
+}
+
+__attribute__((noinline)) void prefaultStack(std::size_t bytes)
+{
+    if (bytes == 0)
+    {
+        return;
+    }
+    long page = sysconf(_SC_PAGESIZE);
+    std::size_t step = page > 0 ? static_cast<std::size_t>(page) : 4096u;
+    volatile char *stack = static_cast<volatile char *>(alloca(bytes));
+    for (std::size_t i = 0; i < bytes; i += step)
+    {
+        stack[i] = 0;
+    }
+}
+
+} // namespace bsp
@@ -0,0 +1,145 @@
+#ifndef BSP_THREAD_ATTR_H
+#define BSP_THREAD_ATTR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include "bsp_common.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 线程调度策略
+ */
+enum class SchedPolicy
+{
+    Other,     // SCHED_OTHER（默认分时调度）
+    Fifo,      // SCHED_FIFO 实时调度
+    RoundRobin // SCHED_RR 实时调度（同优先级轮转）
+};
+
+/**
+ * @brief 库内线程属性（Key 事件线程、InputDiscovery 监视线程、线程池、指标服务线程）
+ *
+ * 默认值即原有行为：SCHED_OTHER、不绑核、不锁内存。实时优先级需要 CAP_SYS_NICE
+ * 或足够的 RLIMIT_RTPRIO，否则应用时返回 Unsupported。
+ */
+struct ThreadAttr
+{
+    SchedPolicy policy;
+    int priority;                   // Fifo/RoundRobin 取 1~99；Other 须为 0
+    uint64_t cpuMask;               // 第 n 位表示允许运行在 CPU n 上，0 表示不限制
+    std::string name;               // 线程名（内核限制 15 字符，超出截断），为空时使用模块默认名
+    bool lockMemory;                // 应用属性时（线程已启动）mlockall(MCL_CURRENT | MCL_FUTURE)（进程级，只执行一次）
+    std::size_t stackPrefaultBytes; // 线程开始运行时预先触碰的栈大小，避免运行中首次缺页，0 不预触碰
+
+    ThreadAttr()
+        : policy(SchedPolicy::Other), priority(0), cpuMask(0), lockMemory(false), stackPrefaultBytes(0)
+    {
+    }
+
+    /**
+     * @brief 常用的实时配置：SCHED_FIFO + 锁内存 + 预触碰 64 KiB 栈
+     */
+    static ThreadAttr realtime(int priority, uint64_t cpuMask = 0);
+};
+
+/**
+ * @brief 库内工作线程（Key 事件线程、InputDiscovery 监视线程、采样线程、指标服务线程）
+ *
+ * 直接用 pthread_create() 创建：失败时返回错误码而不是抛出 std::system_error，
+ * 在 -fno-exceptions 构建（BSP_EMBEDDED）下同样可以处理；创建时不在堆上保存可调用对象。
+ * 线程入口固定为对象的无参成员函数：
+ *
+ *   ErrorCode result = eventThread.start<Key, &Key::eventLoop>(this);
+ *
+ * 与 std::thread 一样，析构时线程仍可 join 视为编程错误，终止进程。
+ */
+class Thread
+{
+public:
+    Thread() : handle(), started(false)
+    {
+    }
+
+    ~Thread();
+
+    Thread(const Thread &) = delete;
+    Thread &operator=(const Thread &) = delete;
+
+    /**
+     * @brief 创建线程执行 (obj->*Run)()
+     * @return ErrorCode::Ok 成功；InvalidParam 线程已在运行；MemAlloc 资源不足（EAGAIN）；
+     *         Unsupported 无权限；DevIo 其他失败
+     */
+    template <typename C, void (C::*Run)()> ErrorCode start(C *obj)
+    {
+        return startRoutine(&invoke<C, Run>, obj);
+    }
+
+    bool joinable() const
+    {
+        return started;
+    }
+
+    /**
+     * @brief 等待线程结束（不可 join 时直接返回）
+     */
+    void join();
+
+    pthread_t nativeHandle() const
+    {
+        return handle;
+    }
+
+private:
+    template <typename C, void (C::*Run)()> static void *invoke(void *obj)
+    {
+        (static_cast<C *>(obj)->*Run)();
+        return nullptr;
+    }
+
+    ErrorCode startRoutine(void *(*routine)(void *), void *arg);
+
+    pthread_t handle;
+    bool started;
+};
+
+/**
+ * @brief 检查属性取值是否合法（不做系统调用）
+ * @return ErrorCode::Ok 合法；InvalidParam 优先级超出范围或 CPU 掩码超出 CPU_SETSIZE
+ */
+ErrorCode validateThreadAttr(const ThreadAttr &attr);
+
+/**
+ * @brief 对已创建的线程应用调度策略、CPU 亲和性和线程名，需要时锁定进程内存
+ * @param thread 目标线程（须 joinable）
+ * @param attr 线程属性
+ * @param defaultName attr.name 为空时使用的线程名
+ * @return ErrorCode::Ok 成功；InvalidParam 取值非法或掩码中没有在线 CPU；
+ *         Unsupported 权限不足（EPERM）；MemAlloc mlockall 失败；DevIo 其他失败
+ */
+ErrorCode applyThreadAttr(std::thread &thread, const ThreadAttr &attr, const char *defaultName);
+
+/**
+ * @brief 同上，用于 bsp::Thread
+ */
+ErrorCode applyThreadAttr(Thread &thread, const ThreadAttr &attr, const char *defaultName);
+
+/**
+ * @brief 锁定进程当前和以后映射的全部内存，并关闭 malloc 向系统归还内存（只执行一次）
+ * @return ErrorCode::Ok 成功或已锁定；MemAlloc 失败（RLIMIT_MEMLOCK 不足或无权限）
+ */
+ErrorCode lockProcessMemory();
+
+/**
+ * @brief 在当前线程中预先触碰 bytes 字节的栈，使这些页在实时路径之前完成缺页
+ */
+void prefaultStack(std::size_t bytes);
+
+} // namespace bsp
+
+#endif // BSP_THREAD_ATTR_H
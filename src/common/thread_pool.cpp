@@ -0,0 +1,109 @@
+#include "thread_pool.h"
+#include <spdlog/spdlog.h>
+#include <string>
+#include <utility>
+
+namespace bsp
+{
+
+ThreadPool::ThreadPool(std::size_t threadCount, const ThreadAttr &attr)
+    : threadCount(threadCount > 0 ? threadCount : 1), threadAttr(attr), stopping(false),
+      stackPrefaultBytes(attr.stackPrefaultBytes), queueDepth("queue_depth", "thread_pool")
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    stopWorkers();
+}
+
+ErrorCode ThreadPool::init()
+{
+    if (!workers.empty())
+    {
+        spdlog::warn("thread pool already initialized");
+        return ErrorCode::Ok;
+    }
+
+    workers.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        std::unique_ptr<Thread> worker(new Thread());
+        ErrorCode result = worker->start<ThreadPool, &ThreadPool::workerLoop>(this);
+        if (result != ErrorCode::Ok)
+        {
+            spdlog::error("Failed to start thread pool worker {} of {}", i, threadCount);
+            stopWorkers();
+            return result;
+        }
+        workers.push_back(std::move(worker));
+
+        ThreadAttr workerAttr = threadAttr;
+        workerAttr.name =
+            (threadAttr.name.empty() ? std::string("bsp-pool") : threadAttr.name) + "-" + std::to_string(i);
+        if (applyThreadAttr(*workers.back(), workerAttr, "bsp-pool") != ErrorCode::Ok)
+        {
+            spdlog::warn("thread pool worker {} runs with default attributes", i);
+        }
+    }
+    return ErrorCode::Ok;
+}
+
+void ThreadPool::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+
+    for (auto &worker : workers)
+    {
+        worker->join();
+    }
+    workers.clear();
+
+    // 允许 init() 失败后重试
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = false;
+}
+
+void ThreadPool::submit(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+        queueDepth.add(1);
+    }
+    cond.notify_one();
+}
+
+std::size_t ThreadPool::size() const
+{
+    return workers.size();
+}
+
+void ThreadPool::workerLoop()
+{
+    prefaultStack(stackPrefaultBytes);
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+            // 停止时仍需把已投递的任务执行完
+            if (tasks.empty())
+            {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            queueDepth.add(-1);
+        }
+        task();
+    }
+}
+
+} // namespace bsp
@@ -0,0 +1,82 @@
+#ifndef BSP_THREAD_POOL_H
+#define BSP_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "metrics.h"
+#include "thread_attr.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 固定大小的线程池
+ *
+ * 用于并行执行彼此独立的阻塞任务（如多个设备的 open 探测）。
+ * 构造后须调用 init() 创建工作线程；init() 之前投递的任务在线程启动后执行。
+ * 析构时等待队列中所有任务执行完毕后再回收线程。
+ */
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief 构造函数，只保存配置，不创建线程
+     * @param threadCount 工作线程数（为 0 时按 1 处理）
+     * @param attr 工作线程属性（线程名后追加序号；应用失败只记录警告，线程按默认属性运行）
+     */
+    explicit ThreadPool(std::size_t threadCount, const ThreadAttr &attr = ThreadAttr());
+
+    /**
+     * @brief 创建全部工作线程
+     *
+     * 任一线程创建失败时回收已创建的线程并返回错误，之后可以再次调用。
+     * @return ErrorCode::Ok 成功或已初始化；MemAlloc 资源不足（EAGAIN）；Unsupported 无权限；DevIo 其他失败
+     */
+    ErrorCode init();
+
+    /**
+     * @brief 析构函数，执行完剩余任务并回收所有线程（未初始化时丢弃已投递的任务）
+     */
+    ~ThreadPool();
+
+    // 禁止拷贝和移动（工作线程持有 this 指针）
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief 投递一个任务
+     * @param task 待执行任务
+     */
+    void submit(Task task);
+
+    /**
+     * @brief 获取工作线程数
+     * @return 已创建的线程数，init() 之前为 0
+     */
+    std::size_t size() const;
+
+private:
+    void workerLoop();
+    void stopWorkers();
+
+    std::size_t threadCount;
+    ThreadAttr threadAttr;
+    std::vector<std::unique_ptr<Thread>> workers;
+    std::deque<Task> tasks;
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool stopping;
+    std::size_t stackPrefaultBytes;
+    Gauge queueDepth; // 待执行任务数，导出为 bsp_queue_depth{instance="thread_pool"}
+};
+
+} // namespace bsp
+
+#endif // BSP_THREAD_POOL_H
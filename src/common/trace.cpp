@@ -0,0 +1,371 @@
+#include "trace.h"
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace bsp
+{
+
+namespace detail
+{
+std::atomic<bool> traceEnabled(false);
+} // namespace detail
+
+constexpr std::size_t Trace::DEFAULT_CAPACITY;
+
+namespace
+{
+
+// 每个事件的字段都是原子量，dump 线程可与写线程并发读取
+struct TraceEvent
+{
+    std::atomic<uint64_t> tsNs;
+    std::atomic<const char *> name;
+    std::atomic<char> phase; // 'B' / 'E' / 'i'
+};
+
+struct EventCopy
+{
+    uint64_t tsNs;
+    const char *name;
+    char phase;
+};
+
+uint64_t nowNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+std::size_t roundUpPow2(std::size_t n)
+{
+    std::size_t p = 64;
+    while (p < n)
+    {
+        p <<= 1;
+    }
+    return p;
+}
+
+// 单线程私有环形缓冲区：所属线程是唯一写者
+class ThreadBuffer
+{
+public:
+    explicit ThreadBuffer(std::size_t capacity)
+        : capacity(roundUpPow2(capacity)), events(new TraceEvent[this->capacity]), head(0), clearedAt(0),
+          alive(true), tid(static_cast<int>(syscall(SYS_gettid)))
+    {
+        for (std::size_t i = 0; i < this->capacity; ++i)
+        {
+            events[i].tsNs.store(0, std::memory_order_relaxed);
+            events[i].name.store(nullptr, std::memory_order_relaxed);
+            events[i].phase.store(0, std::memory_order_relaxed);
+        }
+        std::memset(threadName, 0, sizeof(threadName));
+        pthread_getname_np(pthread_self(), threadName, sizeof(threadName));
+    }
+
+    // 已退出线程的缓冲区转给调用线程：丢弃旧事件（head 保持单调，读者按 clearedAt 跳过）
+    void adopt()
+    {
+        clear();
+        tid = static_cast<int>(syscall(SYS_gettid));
+        std::memset(threadName, 0, sizeof(threadName));
+        pthread_getname_np(pthread_self(), threadName, sizeof(threadName));
+        alive.store(true, std::memory_order_relaxed);
+    }
+
+    void push(char phase, const char *name)
+    {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        // 与 snapshot() 中的 acquire fence 配对：读者若读到本次写入的槽位，必然能看到之前发布的 head
+        std::atomic_thread_fence(std::memory_order_release);
+        TraceEvent &e = events[h & (capacity - 1)];
+        e.tsNs.store(nowNs(), std::memory_order_relaxed);
+        e.name.store(name, std::memory_order_relaxed);
+        e.phase.store(phase, std::memory_order_relaxed);
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // 复制当前仍有效的事件；被写线程并发覆盖的槽位会被丢弃
+    void snapshot(std::vector<EventCopy> &out) const
+    {
+        uint64_t h1 = head.load(std::memory_order_acquire);
+        uint64_t start = h1 > capacity ? h1 - capacity : 0;
+        uint64_t cleared = clearedAt.load(std::memory_order_relaxed);
+        if (start < cleared)
+        {
+            start = cleared;
+        }
+
+        std::vector<EventCopy> copies;
+        copies.reserve(static_cast<std::size_t>(h1 - start));
+        for (uint64_t i = start; i < h1; ++i)
+        {
+            const TraceEvent &e = events[i & (capacity - 1)];
+            EventCopy c;
+            c.tsNs = e.tsNs.load(std::memory_order_relaxed);
+            c.name = e.name.load(std::memory_order_relaxed);
+            c.phase = e.phase.load(std::memory_order_relaxed);
+            copies.push_back(c);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t h2 = head.load(std::memory_order_relaxed);
+        // 写线程可能正在改写下标 h2 的槽位（即事件 h2 - capacity），保守地多丢一个
+        uint64_t validStart = (h2 + 1 > capacity) ? h2 + 1 - capacity : 0;
+        for (uint64_t i = start; i < h1; ++i)
+        {
+            if (i >= validStart)
+            {
+                out.push_back(copies[static_cast<std::size_t>(i - start)]);
+            }
+        }
+    }
+
+    void clear()
+    {
+        clearedAt.store(head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    const std::size_t capacity;
+    std::unique_ptr<TraceEvent[]> events;
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> clearedAt;
+    std::atomic<bool> alive;
+    int tid;
+    char threadName[16];
+};
+
+// 缓冲区注册表（有意泄漏，保证进程退出阶段线程析构时仍可用）
+class Registry
+{
+public:
+    static Registry &instance()
+    {
+        static Registry *registry = new Registry;
+        return *registry;
+    }
+
+    // 优先复用已退出线程的缓冲区（容量相同），线程反复重启时缓冲区数量不超过同时记录的线程数
+    ThreadBuffer *acquire()
+    {
+        const std::size_t wanted = roundUpPow2(capacity.load(std::memory_order_relaxed));
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (ThreadBuffer *buffer : buffers)
+            {
+                // acquire：与 release() 配对，原线程的最后一次写入对新线程可见
+                if (buffer->capacity == wanted && !buffer->alive.load(std::memory_order_acquire))
+                {
+                    buffer->adopt();
+                    return buffer;
+                }
+            }
+        }
+
+        ThreadBuffer *buffer = new ThreadBuffer(wanted);
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.push_back(buffer);
+        return buffer;
+    }
+
+    // 线程退出时只做标记，其事件保留到 clear() 或缓冲区被新线程复用
+    void release(ThreadBuffer *buffer)
+    {
+        buffer->alive.store(false, std::memory_order_release);
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return buffers.size();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<ThreadBuffer *> kept;
+        for (ThreadBuffer *buffer : buffers)
+        {
+            if (buffer->alive.load(std::memory_order_relaxed))
+            {
+                buffer->clear();
+                kept.push_back(buffer);
+            }
+            else
+            {
+                delete buffer;
+            }
+        }
+        buffers.swap(kept);
+    }
+
+    template <typename Fn> void forEach(Fn fn)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const ThreadBuffer *buffer : buffers)
+        {
+            fn(*buffer);
+        }
+    }
+
+    std::atomic<std::size_t> capacity{Trace::DEFAULT_CAPACITY};
+
+private:
+    std::mutex mutex;
+    std::vector<ThreadBuffer *> buffers;
+};
+
+struct BufferHolder
+{
+    ThreadBuffer *buffer;
+
+    BufferHolder() : buffer(nullptr)
+    {
+    }
+
+    ~BufferHolder()
+    {
+        if (buffer)
+        {
+            Registry::instance().release(buffer);
+        }
+    }
+};
+
+thread_local BufferHolder localBuffer;
+
+void record(char phase, const char *name)
+{
+    ThreadBuffer *buffer = localBuffer.buffer;
+    if (buffer == nullptr)
+    {
+        buffer = Registry::instance().acquire();
+        localBuffer.buffer = buffer;
+    }
+    buffer->push(phase, name);
+}
+
+void appendEvent(std::string &out, bool &first, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+void appendEvent(std::string &out, bool &first, const char *fmt, ...)
+{
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    int n = std::vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n <= 0)
+    {
+        return;
+    }
+    if (!first)
+    {
+        out += ",\n";
+    }
+    first = false;
+    out.append(buf, static_cast<std::size_t>(n) < sizeof(buf) ? static_cast<std::size_t>(n) : sizeof(buf) - 1);
+}
+
+} // namespace
+
+void Trace::enable(std::size_t capacityPerThread)
+{
+    Registry::instance().capacity.store(capacityPerThread, std::memory_order_relaxed);
+    detail::traceEnabled.store(true, std::memory_order_relaxed);
+}
+
+void Trace::disable()
+{
+    detail::traceEnabled.store(false, std::memory_order_relaxed);
+}
+
+void Trace::begin(const char *name)
+{
+    record('B', name);
+}
+
+void Trace::end(const char *name)
+{
+    record('E', name);
+}
+
+void Trace::instant(const char *name)
+{
+    record('i', name);
+}
+
+std::string Trace::toJson()
+{
+    const int pid = static_cast<int>(getpid());
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+    std::vector<EventCopy> events;
+
+    Registry::instance().forEach([&](const ThreadBuffer &buffer) {
+        appendEvent(out, first, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    pid, buffer.tid, buffer.threadName);
+
+        events.clear();
+        buffer.snapshot(events);
+        for (const EventCopy &e : events)
+        {
+            if (e.name == nullptr)
+            {
+                continue;
+            }
+            // Chrome trace 的时间单位为微秒
+            double tsUs = static_cast<double>(e.tsNs) / 1000.0;
+            if (e.phase == 'i')
+            {
+                appendEvent(out, first,
+                            "{\"name\":\"%s\",\"cat\":\"bsp\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d}",
+                            e.name, tsUs, pid, buffer.tid);
+            }
+            else
+            {
+                appendEvent(out, first,
+                            "{\"name\":\"%s\",\"cat\":\"bsp\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d}", e.name,
+                            e.phase, tsUs, pid, buffer.tid);
+            }
+        }
+    });
+
+    out += "\n]}\n";
+    return out;
+}
+
+ErrorCode Trace::dump(const std::string &path)
+{
+    std::string json = toJson();
+
+    FILE *file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+    {
+        return ErrorCode::DevOpen;
+    }
+    std::size_t written = std::fwrite(json.data(), 1, json.size(), file);
+    int closed = std::fclose(file);
+    return (written == json.size() && closed == 0) ? ErrorCode::Ok : ErrorCode::DevIo;
+}
+
+void Trace::clear()
+{
+    Registry::instance().clear();
+}
+
+std::size_t Trace::threadBufferCount()
+{
+    return Registry::instance().size();
+}
+
+} // namespace bsp
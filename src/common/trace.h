@@ -0,0 +1,134 @@
+#ifndef BSP_TRACE_H
+#define BSP_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include "bsp_common.h"
+
+namespace bsp
+{
+
+namespace detail
+{
+// 全局追踪开关，关闭时每个埋点只有一次 relaxed 读 + 一次分支
+extern std::atomic<bool> traceEnabled;
+} // namespace detail
+
+/**
+ * @brief 驱动操作事件追踪（Chrome trace / Perfetto 格式）
+ *
+ * 默认关闭。开启后每个线程在首次记录时分配一个私有环形缓冲区，埋点只写本线程
+ * 缓冲区（单生产者，无锁），写满后覆盖最旧的事件。线程退出后其事件仍可导出，
+ * 直到 clear() 或该缓冲区被之后首次记录的新线程复用。dump() 可在任意时刻把所有线程
+ * 的事件导出为 Chrome trace JSON，用 Perfetto (ui.perfetto.dev) 或 chrome://tracing 打开。
+ */
+class Trace
+{
+public:
+    // 每线程缓冲区默认容量（事件数，向上取整为 2 的幂）
+    static constexpr std::size_t DEFAULT_CAPACITY = 8192;
+
+    /**
+     * @brief 开启追踪
+     * @param capacityPerThread 之后新建的线程缓冲区容量（已有缓冲区不变）
+     */
+    static void enable(std::size_t capacityPerThread = DEFAULT_CAPACITY);
+
+    /**
+     * @brief 关闭追踪（已记录的事件保留，可继续 dump）
+     */
+    static void disable();
+
+    static bool isEnabled()
+    {
+        return detail::traceEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 记录区间开始/结束（通常通过 TraceScope 调用）
+     * @param name 事件名，须为静态字符串
+     */
+    static void begin(const char *name);
+    static void end(const char *name);
+
+    /**
+     * @brief 记录瞬时事件（如事件循环被唤醒）
+     * @param name 事件名，须为静态字符串
+     */
+    static void instant(const char *name);
+
+    /**
+     * @brief 导出所有线程的事件为 Chrome trace JSON
+     */
+    static std::string toJson();
+
+    /**
+     * @brief 导出到文件
+     * @param path 输出文件路径
+     * @return ErrorCode::Ok 成功；DevOpen 文件无法创建；DevIo 写入失败
+     */
+    static ErrorCode dump(const std::string &path);
+
+    /**
+     * @brief 清空所有已记录的事件并释放已退出线程的缓冲区
+     */
+    static void clear();
+
+    /**
+     * @brief 当前持有的线程缓冲区数量（含已退出、尚未复用的线程）
+     */
+    static std::size_t threadBufferCount();
+};
+
+/**
+ * @brief 区间追踪：构造时记录开始，析构时记录结束
+ *
+ * 只有构造时追踪已开启才会记录结束事件，保证 B/E 成对。
+ */
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name) : name(nullptr)
+    {
+        if (__builtin_expect(Trace::isEnabled(), 0))
+        {
+            this->name = name;
+            Trace::begin(name);
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (__builtin_expect(name != nullptr, 0))
+        {
+            Trace::end(name);
+        }
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *name;
+};
+
+#define BSP_TRACE_CONCAT_INNER(a, b) a##b
+#define BSP_TRACE_CONCAT(a, b)       BSP_TRACE_CONCAT_INNER(a, b)
+
+// 在当前作用域记录一个区间，如 BSP_TRACE_SCOPE("Led::setState");
+#define BSP_TRACE_SCOPE(name) ::bsp::TraceScope BSP_TRACE_CONCAT(bspTraceScope, __LINE__)(name)
+
+// 记录一个瞬时事件
+#define BSP_TRACE_INSTANT(name)                                                                              \
+    do                                                                                                       \
+    {                                                                                                        \
+        if (__builtin_expect(::bsp::Trace::isEnabled(), 0))                                                  \
+        {                                                                                                    \
+            ::bsp::Trace::instant(name);                                                                     \
+        }                                                                                                    \
+    } while (0)
+
+} // namespace bsp
+
+#endif // BSP_TRACE_H
@@ -1,117 +1,24 @@
 #include "ap3216c.h"
 #include <spdlog/spdlog.h>
-#include <cstdio>
-#include <cstring>
-#include <fcntl.h>
-#include <spdlog/spdlog.h>
-#include <unistd.h>
 
 namespace bsp
 {
 
-AP3216C::AP3216C(const std::string &devName)
-    : devName(devName), fd(-1), initialized(false)
-{
-    devPath = "/dev/" + devName;
-}
+constexpr int AP3216CTraits::OPEN_FLAGS;
+constexpr MetricOp AP3216CTraits::READ_OP;
 
-AP3216C::~AP3216C()
+AP3216C::AP3216C(const std::string &devName) : Sensor(devName)
 {
-    cleanup();
 }
 
-AP3216C::AP3216C(AP3216C &&other) noexcept
-    : devName(std::move(other.devName)), devPath(std::move(other.devPath)), fd(other.fd),
-      initialized(other.initialized)
+AP3216C::AP3216C(const DeviceEntry &entry) : Sensor(entry)
 {
-    other.fd = -1;
-    other.initialized = false;
 }
 
-AP3216C &AP3216C::operator=(AP3216C &&other) noexcept
+void AP3216C::onData(const AP3216CData &data) const
 {
-    if (this != &other)
-    {
-        cleanup();
-        devName = std::move(other.devName);
-        devPath = std::move(other.devPath);
-        fd = other.fd;
-        initialized = other.initialized;
-        other.fd = -1;
-        other.initialized = false;
-    }
-    return *this;
-}
-
-ErrorCode AP3216C::init()
-{
-    if (initialized)
-    {
-        spdlog::warn("Device {} already initialized", devName);
-        return ErrorCode::Ok;
-    }
-
-    // 打开设备节点
-    fd = open(devPath.c_str(), O_RDWR);
-    if (fd < 0)
-    {
-        spdlog::error("open {} failed", devPath);
-        return ErrorCode::DevOpen;
-    }
-
-    initialized = true;
-    spdlog::info("init {} success", devName);
-    return ErrorCode::Ok;
-}
-
-ErrorCode AP3216C::readData(AP3216CData &data)
-{
-    if (!initialized || fd < 0)
-    {
-        spdlog::error("{} not ready (not initialized)", devName);
-        return ErrorCode::DevNotReady;
-    }
-
-    // 读取3个 uint16_t 数据
-    uint16_t rawData[3] = {0};
-    ssize_t n = read(fd, rawData, sizeof(rawData));
-
-    if (n != sizeof(rawData))
-    {
-        spdlog::error("read size mismatch from {}: expected {}, got {}",
-                     devName, sizeof(rawData), n);
-        return ErrorCode::DevIo;
-    }
-
-    // 填充数据结构
-    data.ir = rawData[0];
-    data.als = rawData[1];
-    data.ps = rawData[2];
-
     spdlog::debug("Read from {} - IR: {}, ALS: {}, PS: {}",
-                  devName, data.ir, data.als, data.ps);
-
-    return ErrorCode::Ok;
-}
-
-bool AP3216C::isReady() const
-{
-    return initialized && fd >= 0;
-}
-
-std::string AP3216C::getDeviceName() const
-{
-    return devName;
-}
-
-void AP3216C::cleanup()
-{
-    if (fd >= 0)
-    {
-        close(fd);
-        fd = -1;
-    }
-    initialized = false;
+                  devName.c_str(), data.ir, data.als, data.ps);
 }
 
 } // namespace bsp
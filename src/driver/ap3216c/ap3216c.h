@@ -3,13 +3,16 @@
 
 #include <string>
 #include <cstdint>
-#include "../../common/bsp_common.h"
+#include <fcntl.h>
+#include "../device.h"
 
 namespace bsp
 {
 
 /**
  * @brief AP3216C 环境光传感器数据结构
+ *
+ * 与驱动一次 read() 输出的 3 个 uint16_t 顺序一致，可直接作为读取目标
  */
 struct AP3216CData
 {
@@ -18,12 +21,37 @@ struct AP3216CData
     uint16_t ps;   // 接近传感器数据（距离）
 };
 
+static_assert(sizeof(AP3216CData) == 6, "AP3216CData must match the driver read format");
+
+/**
+ * @brief AP3216C 设备特性
+ */
+struct AP3216CTraits
+{
+    using DataType = AP3216CData;
+    static constexpr int OPEN_FLAGS = O_RDWR;
+    static constexpr MetricOp READ_OP = MetricOp::AP3216CRead;
+    // 一次读取要经 I2C 依次读出 IR/ALS/PS 多个寄存器，两次读取交叠会拼出不属于同一次采样的数据
+    static constexpr bool SERIALIZE_READS = true;
+
+    static const char *initTraceName()
+    {
+        return "AP3216C::init";
+    }
+
+    static const char *readTraceName()
+    {
+        return "AP3216C::readData";
+    }
+};
+
 /**
  * @brief AP3216C 环境光传感器类
  *
- * 支持读取红外、环境光强度和距离传感器数据
+ * 支持读取红外、环境光强度和距离传感器数据。init()/readData()/readAsync()/queueRead()
+ * 等接口由 Sensor 基类提供
  */
-class AP3216C
+class AP3216C : public Sensor<AP3216C, AP3216CTraits>
 {
 public:
     /**
@@ -33,50 +61,19 @@ public:
     explicit AP3216C(const std::string &devName = "ap3216c");
 
     /**
-     * @brief 析构函数，自动释放资源
-     */
-    ~AP3216C();
-
-    // 禁止拷贝构造和赋值
-    AP3216C(const AP3216C &) = delete;
-    AP3216C &operator=(const AP3216C &) = delete;
-
-    // 允许移动构造和赋值
-    AP3216C(AP3216C &&other) noexcept;
-    AP3216C &operator=(AP3216C &&other) noexcept;
-
-    /**
-     * @brief 初始化 AP3216C 设备
-     * @return ErrorCode::Ok 成功，其他错误码失败
-     */
-    ErrorCode init();
-
-    /**
-     * @brief 读取一次传感器数据
-     * @param data 传感器数据结构体引用，用于存储读取的数据
-     * @return ErrorCode::Ok 成功，其他错误码失败
+     * @brief 从板级设备表项构造（直接使用表中已拼好的设备路径）
+     * @param entry 设备表项，如 table.entry(handle)
      */
-    ErrorCode readData(AP3216CData &data);
+    explicit AP3216C(const DeviceEntry &entry);
 
-    /**
-     * @brief 检查设备是否已初始化
-     * @return true 已初始化，false 未初始化
-     */
-    bool isReady() const;
-
-    /**
-     * @brief 获取设备名
-     * @return 设备名字符串
-     */
-    std::string getDeviceName() const;
+    // 允许移动构造和赋值（析构时自动关闭设备）
+    AP3216C(AP3216C &&other) noexcept = default;
+    AP3216C &operator=(AP3216C &&other) noexcept = default;
 
 private:
-    std::string devName;
-    std::string devPath;
-    int fd;
-    bool initialized;
+    friend class Sensor<AP3216C, AP3216CTraits>;
 
-    void cleanup();
+    void onData(const AP3216CData &data) const;
 };
 
 } // namespace bsp
@@ -0,0 +1,174 @@
+#ifndef BSP_ASYNC_H
+#define BSP_ASYNC_H
+
+// C++20 协程适配层：把驱动的回调式异步接口包装为 awaitable。
+// 库本身以 C++11 编译，本头文件只在使用方以 C++20 编译时生效，例如：
+//
+//   bsp::DetachedTask poll(bsp::EventLoop &loop, bsp::AP3216C &sensor)
+//   {
+//       for (;;)
+//       {
+//           auto r = co_await bsp::asyncRead(loop, sensor);
+//           if (r.error != bsp::ErrorCode::Ok) co_return;
+//           ...
+//       }
+//   }
+//
+// 协程在事件循环线程中恢复执行，协程存活期间设备和循环不能析构。
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+#include "../common/event_loop.h"
+#include "key/key.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 异步读取结果
+ */
+template <typename Data> struct ReadResult
+{
+    ErrorCode error;
+    Data data;
+};
+
+/**
+ * @brief 按键事件结果（value 为内核原始值）
+ */
+struct KeyEventResult
+{
+    ErrorCode error;
+    int code;
+    int value;
+};
+
+/**
+ * @brief 即发即弃的协程类型，协程体结束后自动销毁
+ */
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() noexcept
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void() noexcept
+        {
+        }
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+template <typename Source> class ReadAwaiter
+{
+public:
+    using Data = typename Source::DataType;
+
+    ReadAwaiter(EventLoop &loop, Source &device) : loop(loop), device(device), result{ErrorCode::Ok, Data{}}
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        ErrorCode error = device.readAsync(loop, [this, handle](ErrorCode e, const Data &data) {
+            result.error = e;
+            result.data = data;
+            handle.resume();
+        });
+        if (error != ErrorCode::Ok)
+        {
+            result.error = error;
+            return false; // 提交失败，不挂起
+        }
+        return true;
+    }
+
+    ReadResult<Data> await_resume() const noexcept
+    {
+        return result;
+    }
+
+private:
+    EventLoop &loop;
+    Source &device;
+    ReadResult<Data> result;
+};
+
+class KeyEventAwaiter
+{
+public:
+    KeyEventAwaiter(EventLoop &loop, Key &key) : loop(loop), key(key), result{ErrorCode::Ok, -1, -1}
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        ErrorCode error = key.nextEvent(loop, [this, handle](ErrorCode e, int code, int value) {
+            result = {e, code, value};
+            handle.resume();
+        });
+        if (error != ErrorCode::Ok)
+        {
+            result.error = error;
+            return false;
+        }
+        return true;
+    }
+
+    KeyEventResult await_resume() const noexcept
+    {
+        return result;
+    }
+
+private:
+    EventLoop &loop;
+    Key &key;
+    KeyEventResult result;
+};
+
+/**
+ * @brief co_await asyncRead(loop, sensor)：适用于提供 DataType 和 readAsync() 的传感器
+ */
+template <typename Source> ReadAwaiter<Source> asyncRead(EventLoop &loop, Source &device)
+{
+    return ReadAwaiter<Source>(loop, device);
+}
+
+/**
+ * @brief co_await nextEvent(loop, key)：等待下一个按键事件
+ */
+inline KeyEventAwaiter nextEvent(EventLoop &loop, Key &key)
+{
+    return KeyEventAwaiter(loop, key);
+}
+
+} // namespace bsp
+
+#endif // __cplusplus >= 202002L
+
+#endif // BSP_ASYNC_H
@@ -0,0 +1,629 @@
+#ifndef BSP_DEVICE_H
+#define BSP_DEVICE_H
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <mutex>
+#include <poll.h>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <sys/eventfd.h>
+#include <spdlog/spdlog.h>
+#include "../common/bsp_common.h"
+#include "../common/device_table.h"
+#include "../common/event_loop.h"
+#include "../common/fixed_string.h"
+#include "../common/io_ring.h"
+#include "../common/metrics.h"
+#include "../common/trace.h"
+
+// 嵌入式配置下设备名/设备路径的最大字符数（由 CMake 缓存变量 BSP_DEVICE_NAME_MAX/BSP_DEVICE_PATH_MAX 控制）
+#ifndef BSP_DEVICE_NAME_MAX
+#define BSP_DEVICE_NAME_MAX 31
+#endif
+#ifndef BSP_DEVICE_PATH_MAX
+#define BSP_DEVICE_PATH_MAX 63
+#endif
+
+namespace bsp
+{
+
+/**
+ * @brief 驱动保存的设备名/设备路径类型
+ *
+ * 默认配置为 std::string；嵌入式配置（BSP_EMBEDDED）为存放在驱动实例内的定长字符串，
+ * 构造之后不再访问堆。路径超出容量时 init() 返回 InvalidParam，设备名超出容量只截断。
+ */
+#if BSP_EMBEDDED
+using DeviceName = FixedString<BSP_DEVICE_NAME_MAX>;
+using DevicePath = FixedString<BSP_DEVICE_PATH_MAX>;
+#else
+using DeviceName = std::string;
+using DevicePath = std::string;
+#endif
+
+/**
+ * @brief 字符设备驱动公共基类（CRTP，无虚函数）
+ *
+ * 负责设备路径拼接、fd 所有权（移动语义、析构时关闭）、以 Traits::OPEN_FLAGS 打开设备和
+ * 就绪状态。Traits 需提供：
+ * - static constexpr int OPEN_FLAGS：open() 标志；
+ * - static const char *initTraceName()：init() 的追踪区间名。
+ *
+ * 派生类通过 Device<派生类, Traits> 继承，需要在 init() 打开设备后做额外配置时，
+ * 定义 ErrorCode onOpen()（基类版本什么也不做）。
+ *
+ * 每个已打开的设备带一个取消 eventfd：限时操作同时 poll() 设备 fd 和它，cancel() 可让
+ * 阻塞在其中的线程立即返回 Cancelled。驱动未实现 poll 的设备节点总是报告可读，此时期限
+ * 只约束等待就绪的阶段，不能打断驱动内部阻塞的 read()。
+ *
+ * 线程安全：init() 可在多个线程中同时调用（只打开一次）；就绪后 isReady()、读写、cancel()
+ * 等可在多个线程中并发调用，就绪检查是一次无锁的 acquire 读。析构、移动等生命周期操作
+ * 不能与其他调用并发。读取是否需要串行化由派生类按硬件决定（见 Sensor）。
+ */
+template <typename Derived, typename Traits> class Device
+{
+public:
+    // 禁止拷贝（fd 唯一所有）
+    Device(const Device &) = delete;
+    Device &operator=(const Device &) = delete;
+
+    /**
+     * @brief 打开设备节点
+     * @return ErrorCode::Ok 成功（已初始化时同样返回 Ok）；DevOpen 打开失败；
+     *         InvalidParam 设备路径超出 DevicePath 容量（仅嵌入式配置）；其他错误码见派生类 onOpen()
+     */
+    ErrorCode init()
+    {
+        BSP_TRACE_SCOPE(Traits::initTraceName());
+
+        std::lock_guard<std::mutex> lock(initMutex);
+        if (initialized.load(std::memory_order_relaxed))
+        {
+            spdlog::warn("Device {} already initialized", devName.c_str());
+            return ErrorCode::Ok;
+        }
+
+#if BSP_EMBEDDED
+        if (devPath.truncated())
+        {
+            spdlog::error("path of {} exceeds {} characters", devName.c_str(), DevicePath::capacity());
+            return ErrorCode::InvalidParam;
+        }
+#endif
+        fd = open(devPath.c_str(), Traits::OPEN_FLAGS);
+        if (fd < 0)
+        {
+            spdlog::error("open {} failed", devPath.c_str());
+            return ErrorCode::DevOpen;
+        }
+        cancelFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (cancelFd < 0)
+        {
+            spdlog::error("create cancel fd for {} failed: {}", devName.c_str(), std::strerror(errno));
+            cleanup();
+            return ErrorCode::DevIo;
+        }
+
+        ErrorCode result = static_cast<Derived *>(this)->onOpen();
+        if (result != ErrorCode::Ok)
+        {
+            cleanup();
+            return result;
+        }
+
+        // 调用线程的统计分片在这里分配，之后的读写不再访问堆
+        Metrics::attachThread();
+
+        // release：其他线程看到 initialized 为 true 时，fd 及 onOpen() 中的配置均已可见
+        initialized.store(true, std::memory_order_release);
+        spdlog::info("init {} success", devName.c_str());
+        return ErrorCode::Ok;
+    }
+
+    /**
+     * @brief 检查设备是否已初始化
+     */
+    bool isReady() const
+    {
+        return initialized.load(std::memory_order_acquire) && fd >= 0;
+    }
+
+    /**
+     * @brief 获取设备名
+     */
+    const DeviceName &getDeviceName() const
+    {
+        return devName;
+    }
+
+    /**
+     * @brief 获取设备文件描述符（用于 IoRing::registerFiles() 等），未初始化时为 -1
+     */
+    int getFd() const
+    {
+        return initialized.load(std::memory_order_acquire) ? fd : -1;
+    }
+
+    /**
+     * @brief 取消该设备上进行中和之后的限时操作（可在任意线程调用）
+     *
+     * 取消状态一直保持到 clearCancel()，期间 waitReadable()、readRaw(out, timeoutMs) 等
+     * 限时操作立即返回 Cancelled，用于关闭时让阻塞在读取中的线程及时退出
+     * @return ErrorCode::Ok 成功；DevNotReady 未初始化
+     */
+    ErrorCode cancel()
+    {
+        if (cancelFd < 0)
+        {
+            return ErrorCode::DevNotReady;
+        }
+        uint64_t one = 1;
+        ssize_t n = write(cancelFd, &one, sizeof(one));
+        (void)n;
+        return ErrorCode::Ok;
+    }
+
+    /**
+     * @brief 清除取消状态，恢复限时操作
+     */
+    void clearCancel()
+    {
+        if (cancelFd >= 0)
+        {
+            uint64_t pending;
+            ssize_t n = read(cancelFd, &pending, sizeof(pending));
+            (void)n;
+        }
+    }
+
+    /**
+     * @brief 是否处于取消状态
+     */
+    bool isCancelled() const
+    {
+        pollfd pfd = {cancelFd, POLLIN, 0};
+        return cancelFd >= 0 && poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN) != 0;
+    }
+
+    /**
+     * @brief 设置不带期限参数的读取（如 Sensor::readData(data)）使用的默认期限
+     * @param timeoutMs 期限(ms)；< 0（默认）表示直接阻塞 read()，不经过 poll()，也不能被 cancel() 打断
+     */
+    void setReadTimeout(int timeoutMs)
+    {
+        readTimeoutMs.store(timeoutMs, std::memory_order_relaxed);
+    }
+
+    int readTimeout() const
+    {
+        return readTimeoutMs.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 等待设备可读或被取消
+     * @param timeoutMs 期限(ms)；0 只检查一次；< 0 不限时（仍可被 cancel() 打断）
+     * @return ErrorCode::Ok 可读（含出错/挂断，由随后的 read() 报告具体错误）；Timeout 超过期限；
+     *         Cancelled 已取消；DevNotReady 未初始化；DevIo poll 失败
+     */
+    ErrorCode waitReadable(int timeoutMs)
+    {
+        if (__builtin_expect(!initialized.load(std::memory_order_acquire) || fd < 0, 0))
+        {
+            spdlog::error("{} not ready (not initialized)", devName.c_str());
+            return ErrorCode::DevNotReady;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs > 0 ? timeoutMs : 0);
+        for (;;)
+        {
+            int waitMs = timeoutMs;
+            if (timeoutMs > 0)
+            {
+                // 被信号打断后按剩余时间重新等待；向上取整，避免提前醒来后空转
+                long long leftUs =
+                    std::chrono::duration_cast<std::chrono::microseconds>(deadline - Clock::now()).count();
+                waitMs = leftUs > 0 ? static_cast<int>((leftUs + 999) / 1000) : 0;
+            }
+
+            pollfd fds[2] = {{cancelFd, POLLIN, 0}, {fd, POLLIN, 0}};
+            int ret = poll(fds, 2, waitMs);
+            if (ret < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                spdlog::error("poll {} failed: {}", devName.c_str(), std::strerror(errno));
+                return ErrorCode::DevIo;
+            }
+            // 取消优先于数据就绪：取消后不再读取
+            if (fds[0].revents != 0)
+            {
+                return ErrorCode::Cancelled;
+            }
+            if (fds[1].revents & POLLNVAL)
+            {
+                return ErrorCode::DevIo;
+            }
+            if (fds[1].revents != 0)
+            {
+                return ErrorCode::Ok;
+            }
+            if (timeoutMs >= 0 && Clock::now() >= deadline)
+            {
+                return ErrorCode::Timeout;
+            }
+        }
+    }
+
+    /**
+     * @brief 从设备读取一个完整的 T（不经过统计和追踪的快速路径）
+     * @param out 读取目标，须为平凡可复制类型且与驱动输出格式一致
+     * @return ErrorCode::Ok 成功；DevNotReady 未初始化；DevIo 读取失败或长度不符
+     */
+    template <typename T> ErrorCode readRaw(T &out)
+    {
+        if (__builtin_expect(!initialized.load(std::memory_order_acquire) || fd < 0, 0))
+        {
+            spdlog::error("{} not ready (not initialized)", devName.c_str());
+            return ErrorCode::DevNotReady;
+        }
+
+        ssize_t n = read(fd, &out, sizeof(T));
+        if (__builtin_expect(n != static_cast<ssize_t>(sizeof(T)), 0))
+        {
+            if (n < 0)
+            {
+                spdlog::error("read from {} failed: {}", devName.c_str(), std::strerror(errno));
+            }
+            else
+            {
+                spdlog::error("read size mismatch from {}: expected {}, got {}", devName.c_str(), sizeof(T),
+                              n);
+            }
+            return ErrorCode::DevIo;
+        }
+        return ErrorCode::Ok;
+    }
+
+    /**
+     * @brief 限时读取一个完整的 T：先 waitReadable(timeoutMs)，就绪后再 read()
+     * @return ErrorCode::Ok 成功；Timeout / Cancelled / DevNotReady 见 waitReadable()；DevIo 读取失败或长度不符
+     */
+    template <typename T> ErrorCode readRaw(T &out, int timeoutMs)
+    {
+        ErrorCode result = waitReadable(timeoutMs);
+        if (result != ErrorCode::Ok)
+        {
+            return result;
+        }
+        return readRaw(out);
+    }
+
+protected:
+    /**
+     * @brief 按设备名构造，设备路径为 /dev/<devName>
+     */
+    explicit Device(const std::string &devName)
+        : devName(devName), devPath("/dev/" + devName), fd(-1), cancelFd(-1), readTimeoutMs(-1), initialized(false)
+    {
+    }
+
+    /**
+     * @brief 从板级设备表项构造（直接使用表中已拼好的设备路径）
+     */
+    explicit Device(const DeviceEntry &entry)
+        : devName(entry.name), devPath(entry.path), fd(-1), cancelFd(-1), readTimeoutMs(-1), initialized(false)
+    {
+    }
+
+    // 非虚析构：不通过基类指针删除派生对象
+    ~Device()
+    {
+        cleanup();
+    }
+
+    Device(Device &&other) noexcept
+        : devName(std::move(other.devName)), devPath(std::move(other.devPath)), fd(other.fd),
+          cancelFd(other.cancelFd), readTimeoutMs(other.readTimeoutMs.load()), initialized(other.initialized.load())
+    {
+        other.fd = -1;
+        other.cancelFd = -1;
+        other.initialized = false;
+    }
+
+    Device &operator=(Device &&other) noexcept
+    {
+        if (this != &other)
+        {
+            cleanup();
+            devName = std::move(other.devName);
+            devPath = std::move(other.devPath);
+            fd = other.fd;
+            cancelFd = other.cancelFd;
+            readTimeoutMs = other.readTimeoutMs.load();
+            initialized = other.initialized.load();
+            other.fd = -1;
+            other.cancelFd = -1;
+            other.initialized = false;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief init() 打开设备之后的派生类钩子，返回非 Ok 时关闭设备
+     */
+    ErrorCode onOpen()
+    {
+        return ErrorCode::Ok;
+    }
+
+    /**
+     * @brief 关闭设备
+     */
+    void cleanup()
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+        if (cancelFd >= 0)
+        {
+            close(cancelFd);
+            cancelFd = -1;
+        }
+        initialized = false;
+    }
+
+    DeviceName devName;
+    DevicePath devPath;
+    int fd;                         // init() 中写入后由 initialized 的 release 发布，之后只读
+    int cancelFd;                   // cancel() 写入，限时操作与 fd 一起 poll()
+    std::atomic<int> readTimeoutMs; // 不带期限参数的读取使用的默认期限，< 0 不限时
+    std::atomic<bool> initialized;
+    std::mutex initMutex;           // 串行化并发的 init()，不用于读写路径
+};
+
+/**
+ * @brief 只读采样类传感器公共基类
+ *
+ * 在 Device 的基础上提供带统计和追踪的 readData()、事件循环异步读取 readAsync() 和
+ * 批量 I/O 读取 queueRead()。Traits 在 Device 的要求之外还需提供：
+ * - using DataType：数据结构体，内存布局须与驱动一次 read() 的输出一致；
+ * - static constexpr MetricOp READ_OP：readData() 的统计项；
+ * - static const char *readTraceName()：readData() 的追踪区间名；
+ * - static constexpr bool SERIALIZE_READS：硬件一次读取不能与另一次交叠（如多寄存器 I2C
+ *   读取、单总线时序）时为 true，readData() 在同一实例上串行执行；为 false 时完全无锁。
+ *
+ * 派生类可定义 void onData(const DataType &) const 输出调试日志（基类版本什么也不做）。
+ * readData() 可在多个线程中并发调用；readAsync()/queueRead() 的提交与完成处理由调用方
+ * 所在的单个线程负责。
+ */
+template <typename Derived, typename Traits> class Sensor : public Device<Derived, Traits>
+{
+public:
+    using DataType = typename Traits::DataType;
+    // 异步读取完成回调：错误码非 Ok 时数据内容无意义
+    using ReadCallback = std::function<void(ErrorCode error, const DataType &data)>;
+
+    /**
+     * @brief 读取一次传感器数据（期限为 setReadTimeout() 设置的默认值，默认不限时）
+     * @param data 传感器数据结构体引用，用于存储读取的数据
+     * @return ErrorCode::Ok 成功；DevNotReady 未初始化；DevIo 读取失败；设置了默认期限时另见 readData(data, timeoutMs)
+     */
+    ErrorCode readData(DataType &data)
+    {
+        int timeoutMs = this->readTimeoutMs.load(std::memory_order_relaxed);
+        if (timeoutMs >= 0)
+        {
+            return readData(data, timeoutMs);
+        }
+
+        BSP_TRACE_SCOPE(Traits::readTraceName());
+        MetricsTimer timer(Traits::READ_OP);
+
+        ReadGuard guard(*this, -1);
+        ErrorCode result = this->readRaw(data);
+        if (result == ErrorCode::Ok)
+        {
+            static_cast<const Derived *>(this)->onData(data);
+        }
+        return timer.finish(result);
+    }
+
+    /**
+     * @brief 限时读取一次传感器数据
+     * @param data 传感器数据结构体引用，用于存储读取的数据
+     * @param timeoutMs 等待数据就绪的期限(ms)；< 0 不限时，但可被 cancel() 打断
+     * @return ErrorCode::Ok 成功；Timeout 超过期限；Cancelled 已取消；DevNotReady 未初始化；DevIo 读取失败
+     */
+    ErrorCode readData(DataType &data, int timeoutMs)
+    {
+        BSP_TRACE_SCOPE(Traits::readTraceName());
+        MetricsTimer timer(Traits::READ_OP);
+
+        // 等待其他线程读完也计入期限
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        ReadGuard guard(*this, timeoutMs);
+        if (!guard.owns())
+        {
+            return timer.finish(ErrorCode::Timeout);
+        }
+        if (timeoutMs > 0 && Traits::SERIALIZE_READS)
+        {
+            long left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            timeoutMs = left > 0 ? static_cast<int>(left) : 0;
+        }
+        ErrorCode result = this->readRaw(data, timeoutMs);
+        if (result == ErrorCode::Ok)
+        {
+            static_cast<const Derived *>(this)->onData(data);
+        }
+        return timer.finish(result);
+    }
+
+    /**
+     * @brief 异步读取一次传感器数据
+     *
+     * 设备 fd 可读时在事件循环线程中调用 readData() 并回调；设备节点不支持 poll 时
+     * 在下一轮循环中直接读取。回调执行前设备不能析构或移动，且同一时刻只能有一个
+     * 未完成的异步读取（可在回调中发起下一次）。放弃未完成的读取并关闭设备时，先在循环
+     * 线程中调用 loop.cancel(getFd())（驱动不持有循环，析构时不会自动取消）。
+     * @param loop 已 init() 的事件循环
+     * @param callback 完成回调
+     * @return ErrorCode::Ok 已提交；DevNotReady 设备未初始化；其他错误码见 EventLoop::watchOnce()
+     */
+    ErrorCode readAsync(EventLoop &loop, ReadCallback callback)
+    {
+        if (!this->isReady())
+        {
+            spdlog::error("{} not ready (not initialized)", this->devName.c_str());
+            return ErrorCode::DevNotReady;
+        }
+
+        // 回调存在对象里，提交给循环的闭包只捕获 this，放得进 std::function 的内部存储，
+        // 每次提交不申请堆内存
+        ReadCallback previous = std::move(pendingRead);
+        pendingRead = std::move(callback);
+        ErrorCode result = loop.watchOnce(this->fd, [this](uint32_t) {
+            DataType data;
+            std::memset(&data, 0, sizeof(data));
+            ErrorCode error = readData(data);
+            // 先取出再调用，回调中可以发起下一次读取
+            ReadCallback done = std::move(pendingRead);
+            done(error, data);
+        });
+        if (result != ErrorCode::Ok)
+        {
+            // 提交失败（如已有未完成的读取）：原来的回调保持不变
+            pendingRead = std::move(previous);
+        }
+        return result;
+    }
+
+    /**
+     * @brief 把一次读取排入批量 I/O 队列（由 ring.submit() 统一提交）
+     *
+     * 数据直接读入 data；取回完成结果后用 completionResult(c, sizeof(DataType)) 检查。
+     * 完成前 data 必须保持有效。
+     * @param ring 已 init() 的批量 I/O 队列
+     * @param data 读取目标
+     * @param userData 完成结果中的标识
+     * @return ErrorCode::Ok 已排入；DevNotReady 设备未初始化
+     */
+    ErrorCode queueRead(IoRing &ring, DataType &data, uint64_t userData)
+    {
+        if (!this->isReady())
+        {
+            spdlog::error("{} not ready (not initialized)", this->devName.c_str());
+            return ErrorCode::DevNotReady;
+        }
+        return ring.queueRead(this->fd, &data, sizeof(data), -1, userData);
+    }
+
+protected:
+    explicit Sensor(const std::string &devName) : Device<Derived, Traits>(devName), readBusy(false)
+    {
+    }
+
+    explicit Sensor(const DeviceEntry &entry) : Device<Derived, Traits>(entry), readBusy(false)
+    {
+    }
+
+    ~Sensor() = default;
+
+    // 读锁不随对象移动，移动后各自持有新锁
+    Sensor(Sensor &&other) noexcept : Device<Derived, Traits>(std::move(other)), readBusy(false)
+    {
+    }
+
+    Sensor &operator=(Sensor &&other) noexcept
+    {
+        Device<Derived, Traits>::operator=(std::move(other));
+        return *this;
+    }
+
+    /**
+     * @brief 读取成功后的派生类钩子（如输出调试日志）
+     */
+    void onData(const DataType &) const
+    {
+    }
+
+private:
+    /**
+     * @brief 按 Traits::SERIALIZE_READS 持有读锁；不需要串行化时什么也不做
+     */
+    class ReadGuard
+    {
+    public:
+        /**
+         * @param timeoutMs 等锁期限(ms)，< 0 一直等待
+         */
+        ReadGuard(Sensor &sensor, int timeoutMs) : owner(nullptr)
+        {
+            if (!Traits::SERIALIZE_READS)
+            {
+                return;
+            }
+            // 锁只保护 readBusy，读取本身在锁外进行，等待中的线程按期限醒来
+            std::unique_lock<std::mutex> lock(sensor.readMutex);
+            auto idle = [&sensor] { return !sensor.readBusy; };
+            if (timeoutMs < 0)
+            {
+                sensor.readIdle.wait(lock, idle);
+            }
+            else if (!sensor.readIdle.wait_for(lock, std::chrono::milliseconds(timeoutMs), idle))
+            {
+                return;
+            }
+            sensor.readBusy = true;
+            owner = &sensor;
+        }
+
+        ~ReadGuard()
+        {
+            if (owner != nullptr)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(owner->readMutex);
+                    owner->readBusy = false;
+                }
+                owner->readIdle.notify_one();
+            }
+        }
+
+        bool owns() const
+        {
+            return !Traits::SERIALIZE_READS || owner != nullptr;
+        }
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+
+    private:
+        Sensor *owner;
+    };
+
+    ReadCallback pendingRead; // 未完成的 readAsync() 的回调
+
+    // 仅 SERIALIZE_READS 时使用：同一时刻只有一个线程在读
+    std::mutex readMutex;
+    std::condition_variable readIdle;
+    bool readBusy;
+};
+
+} // namespace bsp
+
+#endif // BSP_DEVICE_H
@@ -3,13 +3,16 @@
 
 #include <string>
 #include <cstdint>
-#include "../../common/bsp_common.h"
+#include <fcntl.h>
+#include "../device.h"
 
 namespace bsp
 {
 
 /**
  * @brief DHT11 温湿度传感器数据结构
+ *
+ * 与驱动一次 read() 输出的 4 个字节顺序一致，可直接作为读取目标
  */
 struct DHT11Data
 {
@@ -19,12 +22,36 @@ struct DHT11Data
     uint8_t temperature_decimal; // 温度小数部分（DHT11通常为0）
 };
 
+static_assert(sizeof(DHT11Data) == 4, "DHT11Data must match the driver read format");
+
+/**
+ * @brief DHT11 设备特性
+ */
+struct DHT11Traits
+{
+    using DataType = DHT11Data;
+    static constexpr int OPEN_FLAGS = O_RDONLY;
+    static constexpr MetricOp READ_OP = MetricOp::DHT11Read;
+    // 单总线按时序逐位采样，两次读取交叠会破坏时序
+    static constexpr bool SERIALIZE_READS = true;
+
+    static const char *initTraceName()
+    {
+        return "DHT11::init";
+    }
+
+    static const char *readTraceName()
+    {
+        return "DHT11::readData";
+    }
+};
+
 /**
  * @brief DHT11 温湿度传感器类
  *
- * 支持读取温度和湿度数据
+ * 支持读取温度和湿度数据。init()/readData()/readAsync()/queueRead() 等接口由 Sensor 基类提供
  */
-class DHT11
+class DHT11 : public Sensor<DHT11, DHT11Traits>
 {
 public:
     /**
@@ -34,53 +61,21 @@ public:
     explicit DHT11(const std::string &devName = "dht11");
 
     /**
-     * @brief 析构函数，自动释放资源
+     * @brief 从板级设备表项构造（直接使用表中已拼好的设备路径）
+     * @param entry 设备表项，如 table.entry(handle)
      */
-    ~DHT11();
-
-    // 禁止拷贝构造和赋值
-    DHT11(const DHT11 &) = delete;
-    DHT11 &operator=(const DHT11 &) = delete;
-
-    // 允许移动构造和赋值
-    DHT11(DHT11 &&other) noexcept;
-    DHT11 &operator=(DHT11 &&other) noexcept;
+    explicit DHT11(const DeviceEntry &entry);
 
-    /**
-     * @brief 初始化 DHT11 设备
-     * @return ErrorCode::Ok 成功，其他错误码失败
-     */
-    ErrorCode init();
-
-    /**
-     * @brief 读取一次传感器数据
-     * @param data 传感器数据结构体引用，用于存储读取的数据
-     * @return ErrorCode::Ok 成功，其他错误码失败
-     */
-    ErrorCode readData(DHT11Data &data);
-
-    /**
-     * @brief 检查设备是否已初始化
-     * @return true 已初始化，false 未初始化
-     */
-    bool isReady() const;
-
-    /**
-     * @brief 获取设备名
-     * @return 设备名字符串
-     */
-    std::string getDeviceName() const;
+    // 允许移动构造和赋值（析构时自动关闭设备）
+    DHT11(DHT11 &&other) noexcept = default;
+    DHT11 &operator=(DHT11 &&other) noexcept = default;
 
 private:
-    std::string devName;
-    std::string devPath;
-    int fd;
-    bool initialized;
+    friend class Sensor<DHT11, DHT11Traits>;
 
-    void cleanup();
+    void onData(const DHT11Data &data) const;
 };
 
 } // namespace bsp
 
 #endif // BSP_DHT11_H
-
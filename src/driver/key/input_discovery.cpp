@@ -0,0 +1,421 @@
+#include "input_discovery.h"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+
+namespace bsp
+{
+
+namespace
+{
+
+// 只处理 evdev 节点（eventN），忽略 mouseN/jsN 等旧接口
+bool isEventNode(const char *name)
+{
+    return std::strncmp(name, "event", 5) == 0;
+}
+
+} // namespace
+
+bool InputDeviceInfo::hasKey(int code) const
+{
+    if (code < 0 || static_cast<std::size_t>(code / 8) >= keys.size())
+    {
+        return false;
+    }
+    return (keys[code / 8] >> (code % 8)) & 1u;
+}
+
+InputDiscovery::InputDiscovery(const std::string &dir) : dir(dir), inotifyFd(-1), wakeFd(-1), running(false)
+{
+}
+
+InputDiscovery::~InputDiscovery()
+{
+    stop();
+}
+
+int InputDiscovery::addRule(const InputRule &rule)
+{
+    if (running)
+    {
+        spdlog::error("InputDiscovery: addRule() while running");
+        return -1;
+    }
+    rules.push_back(rule);
+    return static_cast<int>(rules.size()) - 1;
+}
+
+void InputDiscovery::setHotplugCallback(HotplugCallback cb)
+{
+    hotplugCallback = cb;
+}
+
+void InputDiscovery::setThreadAttr(const ThreadAttr &attr)
+{
+    threadAttr = attr;
+}
+
+ErrorCode InputDiscovery::start()
+{
+    if (running)
+    {
+        spdlog::warn("InputDiscovery on {} already running", dir);
+        return ErrorCode::Ok;
+    }
+    if (validateThreadAttr(threadAttr) != ErrorCode::Ok)
+    {
+        return ErrorCode::InvalidParam;
+    }
+
+    inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (inotifyFd < 0)
+    {
+        spdlog::error("inotify_init1 failed: {}", std::strerror(errno));
+        return ErrorCode::DevOpen;
+    }
+    // 先建立监视再扫描，扫描期间出现的节点不会漏掉（重复的由 tryAttach() 去重）
+    if (inotify_add_watch(inotifyFd, dir.c_str(), IN_CREATE | IN_ATTRIB | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM) < 0)
+    {
+        spdlog::error("watch {} failed: {}", dir, std::strerror(errno));
+        close(inotifyFd);
+        inotifyFd = -1;
+        return ErrorCode::DevOpen;
+    }
+
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0)
+    {
+        spdlog::error("create wake fd for InputDiscovery failed: {}", std::strerror(errno));
+        close(inotifyFd);
+        inotifyFd = -1;
+        return ErrorCode::DevIo;
+    }
+
+    scan();
+
+    running = true;
+    ErrorCode result = watchThread.start<InputDiscovery, &InputDiscovery::watchLoop>(this);
+    if (result != ErrorCode::Ok)
+    {
+        running = false;
+        close(wakeFd);
+        close(inotifyFd);
+        wakeFd = -1;
+        inotifyFd = -1;
+        detachAll();
+        spdlog::error("Failed to start InputDiscovery");
+        return result;
+    }
+
+    result = applyThreadAttr(watchThread, threadAttr, "bsp-input");
+    if (result != ErrorCode::Ok)
+    {
+        stop();
+        return result;
+    }
+
+    spdlog::info("InputDiscovery watching {} ({} rules, {} attached)", dir, rules.size(), attachedCount());
+    return ErrorCode::Ok;
+}
+
+ErrorCode InputDiscovery::stop()
+{
+    if (!running)
+    {
+        return ErrorCode::Ok;
+    }
+
+    running = false;
+    uint64_t one = 1;
+    ssize_t n = write(wakeFd, &one, sizeof(one));
+    (void)n;
+
+    if (watchThread.joinable())
+    {
+        watchThread.join();
+    }
+    close(wakeFd);
+    close(inotifyFd);
+    wakeFd = -1;
+    inotifyFd = -1;
+
+    detachAll();
+    spdlog::info("InputDiscovery on {} stopped", dir);
+    return ErrorCode::Ok;
+}
+
+bool InputDiscovery::isRunning() const
+{
+    return running;
+}
+
+std::vector<std::string> InputDiscovery::attached() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> nodes;
+    nodes.reserve(devices.size());
+    for (const auto &item : devices)
+    {
+        nodes.push_back(item.first);
+    }
+    return nodes;
+}
+
+std::size_t InputDiscovery::attachedCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return devices.size();
+}
+
+ErrorCode InputDiscovery::probe(const std::string &path, InputDeviceInfo &info)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return ErrorCode::DevOpen;
+    }
+
+    char name[256];
+    std::memset(name, 0, sizeof(name));
+    std::vector<uint8_t> keys((KEY_CNT + 7) / 8, 0);
+    bool evdev = ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name) >= 0 &&
+                 ioctl(fd, EVIOCGBIT(EV_KEY, keys.size()), keys.data()) >= 0;
+    close(fd);
+    if (!evdev)
+    {
+        return ErrorCode::Unsupported;
+    }
+
+    info.path = path;
+    info.name = name;
+    info.keys.swap(keys);
+    return ErrorCode::Ok;
+}
+
+bool InputDiscovery::matches(const InputDeviceInfo &info, const InputRule &rule)
+{
+    if (!rule.name.empty() && info.name.find(rule.name) == std::string::npos)
+    {
+        return false;
+    }
+    for (int code : rule.keys)
+    {
+        if (!info.hasKey(code))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void InputDiscovery::watchLoop()
+{
+    prefaultStack(threadAttr.stackPrefaultBytes);
+    spdlog::debug("InputDiscovery thread started for {}", dir);
+
+    while (running)
+    {
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        int ret = poll(fds, 2, -1);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            spdlog::error("poll inotify for {} failed: {}", dir, std::strerror(errno));
+            break;
+        }
+        if (fds[1].revents != 0)
+        {
+            break;
+        }
+        if (fds[0].revents != 0)
+        {
+            handleEvents();
+        }
+    }
+
+    spdlog::debug("InputDiscovery thread ended for {}", dir);
+}
+
+void InputDiscovery::handleEvents()
+{
+    alignas(struct inotify_event) char buffer[4096];
+    for (;;)
+    {
+        ssize_t n = read(inotifyFd, buffer, sizeof(buffer));
+        if (n <= 0)
+        {
+            if (n < 0 && errno != EAGAIN && errno != EINTR)
+            {
+                spdlog::error("read inotify for {} failed: {}", dir, std::strerror(errno));
+            }
+            return;
+        }
+
+        for (char *p = buffer; p < buffer + n;)
+        {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(p);
+            p += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // 事件丢失：以目录当前内容为准重新核对
+                spdlog::warn("inotify queue overflow on {}, rescanning", dir);
+                for (const std::string &node : attached())
+                {
+                    if (access(node.c_str(), F_OK) != 0)
+                    {
+                        detach(node);
+                    }
+                }
+                scan();
+                continue;
+            }
+            if (event->mask & IN_IGNORED)
+            {
+                spdlog::warn("{} is no longer watched", dir);
+                continue;
+            }
+            if (event->len == 0 || !isEventNode(event->name))
+            {
+                continue;
+            }
+
+            std::string node = dir + "/" + event->name;
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+            {
+                detach(node);
+            }
+            else
+            {
+                // IN_CREATE 时 udev 可能还没设好权限，打不开的节点等 IN_ATTRIB 再试
+                tryAttach(node);
+            }
+        }
+    }
+}
+
+void InputDiscovery::scan()
+{
+    DIR *d = opendir(dir.c_str());
+    if (d == nullptr)
+    {
+        spdlog::warn("scan {} failed: {}", dir, std::strerror(errno));
+        return;
+    }
+    while (struct dirent *entry = readdir(d))
+    {
+        if (isEventNode(entry->d_name))
+        {
+            tryAttach(dir + "/" + entry->d_name);
+        }
+    }
+    closedir(d);
+}
+
+void InputDiscovery::tryAttach(const std::string &node)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (devices.count(node) != 0)
+        {
+            return;
+        }
+    }
+
+    InputDeviceInfo info;
+    ErrorCode result = probe(node, info);
+    if (result != ErrorCode::Ok)
+    {
+        spdlog::debug("skip {}: {}", node, result == ErrorCode::DevOpen ? std::strerror(errno) : "not evdev");
+        return;
+    }
+
+    for (std::size_t i = 0; i < rules.size(); ++i)
+    {
+        const InputRule &rule = rules[i];
+        if (!matches(info, rule))
+        {
+            continue;
+        }
+
+        std::unique_ptr<Key> key(new Key(makeDeviceEntry(DeviceType::Key, info.name.c_str(), node.c_str())));
+        if (key->init() != ErrorCode::Ok)
+        {
+            return;
+        }
+        key->setCallback(rule.callback);
+        if (rule.setup)
+        {
+            rule.setup(*key);
+        }
+        if (key->start() != ErrorCode::Ok)
+        {
+            spdlog::warn("attach {} ({}) failed", node, info.name);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Attached &slot = devices[node];
+            slot.key = std::move(key);
+            slot.name = info.name;
+            slot.rule = static_cast<int>(i);
+        }
+        spdlog::info("attached {} ({}) by rule {}", node, info.name, i);
+
+        if (hotplugCallback)
+        {
+            InputHotplugEvent event = {true, node, info.name, static_cast<int>(i)};
+            hotplugCallback(event);
+        }
+        return;
+    }
+    spdlog::debug("{} ({}) matches no rule", node, info.name);
+}
+
+void InputDiscovery::detach(const std::string &node)
+{
+    Attached slot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = devices.find(node);
+        if (it == devices.end())
+        {
+            return;
+        }
+        slot = std::move(it->second);
+        devices.erase(it);
+    }
+
+    // 在锁外停止：Key::stop() 要等待事件线程中的回调返回
+    slot.key->stop();
+    slot.key.reset();
+    spdlog::info("detached {} ({})", node, slot.name);
+
+    if (hotplugCallback)
+    {
+        InputHotplugEvent event = {false, node, slot.name, slot.rule};
+        hotplugCallback(event);
+    }
+}
+
+void InputDiscovery::detachAll()
+{
+    for (const std::string &node : attached())
+    {
+        detach(node);
+    }
+}
+
+} // namespace bsp
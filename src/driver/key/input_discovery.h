@@ -0,0 +1,150 @@
+#ifndef BSP_INPUT_DISCOVERY_H
+#define BSP_INPUT_DISCOVERY_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "key.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 从 evdev 节点查询到的设备信息
+ */
+struct InputDeviceInfo
+{
+    std::string path;          // 设备节点，如 /dev/input/event3
+    std::string name;          // EVIOCGNAME
+    std::vector<uint8_t> keys; // EVIOCGBIT(EV_KEY) 位图，按键码 c 对应 keys[c / 8] 的第 c % 8 位
+
+    bool hasKey(int code) const;
+};
+
+/**
+ * @brief 输入设备匹配规则：按设备名和按键能力匹配，而不是按 eventN 编号
+ */
+struct InputRule
+{
+    std::string name;               // 设备名须包含的子串，空表示不限
+    std::vector<int> keys;          // 须全部支持的按键码，空表示不限
+    Key::KeyCallback callback;      // 挂接的 Key 的按键回调（在该 Key 的事件线程中执行）
+    std::function<void(Key &)> setup; // start() 之前的额外配置（消抖、独占、事件时钟等），可为空
+};
+
+/**
+ * @brief 热插拔通知
+ */
+struct InputHotplugEvent
+{
+    bool attached;    // true 挂接，false 移除
+    std::string path; // 设备节点
+    std::string name; // 设备名
+    int rule;         // 匹配到的规则下标（addRule() 的返回值）
+};
+
+/**
+ * @brief 输入设备热插拔发现
+ *
+ * 用 inotify 监视输入设备目录（默认 /dev/input），节点出现时读取设备名和按键能力，
+ * 与规则逐条匹配，命中第一条规则即创建 Key、按规则配置并 start()；节点删除时停止并
+ * 释放对应的 Key。udev 可能在创建节点之后才修改权限，因此属性变化（IN_ATTRIB）时会
+ * 重试尚未挂接的节点。发现线程阻塞在 poll() 上，没有设备变化时不占用 CPU。
+ *
+ * addRule()/setHotplugCallback() 须在 start() 之前调用；查询接口线程安全。
+ */
+class InputDiscovery
+{
+public:
+    using HotplugCallback = std::function<void(const InputHotplugEvent &event)>;
+
+    explicit InputDiscovery(const std::string &dir = "/dev/input");
+    ~InputDiscovery();
+
+    InputDiscovery(const InputDiscovery &) = delete;
+    InputDiscovery &operator=(const InputDiscovery &) = delete;
+
+    /**
+     * @brief 添加匹配规则
+     * @return 规则下标；运行中调用返回 -1
+     */
+    int addRule(const InputRule &rule);
+
+    /**
+     * @brief 设置热插拔通知回调（在发现线程中执行）
+     */
+    void setHotplugCallback(HotplugCallback cb);
+
+    /**
+     * @brief 设置监视线程的属性（start() 之前调用；挂接的 Key 的线程属性在 InputRule::setup 中设置）
+     */
+    void setThreadAttr(const ThreadAttr &attr);
+
+    /**
+     * @brief 开始监视：扫描目录中已有的节点，之后在发现线程中处理热插拔
+     * @return ErrorCode::Ok 成功；DevOpen 创建 inotify 或监视目录失败；DevIo 线程创建失败
+     */
+    ErrorCode start();
+
+    /**
+     * @brief 停止监视，并停止和释放所有已挂接的 Key
+     */
+    ErrorCode stop();
+
+    bool isRunning() const;
+
+    /**
+     * @brief 当前已挂接的设备节点
+     */
+    std::vector<std::string> attached() const;
+
+    std::size_t attachedCount() const;
+
+    /**
+     * @brief 查询一个节点的设备名和按键能力
+     * @return ErrorCode::Ok 成功；DevOpen 打开失败；Unsupported 不是 evdev 设备
+     */
+    static ErrorCode probe(const std::string &path, InputDeviceInfo &info);
+
+    /**
+     * @brief 设备是否满足规则（只比较 name 和 keys）
+     */
+    static bool matches(const InputDeviceInfo &info, const InputRule &rule);
+
+private:
+    struct Attached
+    {
+        std::unique_ptr<Key> key;
+        std::string name;
+        int rule;
+    };
+
+    void watchLoop();
+    void scan();
+    void handleEvents();
+    void tryAttach(const std::string &node);
+    void detach(const std::string &node);
+    void detachAll();
+
+    std::string dir;
+    std::vector<InputRule> rules;
+    HotplugCallback hotplugCallback;
+    ThreadAttr threadAttr;
+
+    int inotifyFd;
+    int wakeFd; // stop() 通过它唤醒阻塞在 poll() 中的发现线程
+    std::atomic<bool> running;
+    Thread watchThread;
+
+    mutable std::mutex mutex;                  // 保护 devices 的结构（发现线程写，查询接口读）
+    std::map<std::string, Attached> devices;   // 按节点路径索引
+};
+
+} // namespace bsp
+
+#endif // BSP_INPUT_DISCOVERY_H
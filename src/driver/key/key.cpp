@@ -1,38 +1,78 @@
 #include "key.h"
+#include "../../common/metrics.h"
+#include "../../common/trace.h"
 #include <spdlog/spdlog.h>
+#include <cerrno>
 #include <cstdio>
 #include <cstring>
 #include <fcntl.h>
 #include <iostream>
+#include <poll.h>
 #include <unistd.h>
+#include <vector>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 
 namespace bsp
 {
 
+constexpr int KeyTraits::OPEN_FLAGS;
+constexpr std::size_t Key::EVENT_BATCH;
+constexpr std::size_t Key::STATE_WORDS;
+
+namespace
+{
+
+// 当前线程正在派发回调的 Key（事件线程中有效），stop() 据此判断是否在回调中被调用
+thread_local const Key *dispatchingKey = nullptr;
+
+// 事件线程捕获的是源对象的 this，不能随对象转移：移动前先停止源对象
+Key &&stopForMove(Key &key)
+{
+    key.stop();
+    return std::move(key);
+}
+
+uint64_t clockNowUs(clockid_t clock)
+{
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000u + static_cast<uint64_t>(ts.tv_nsec) / 1000u;
+}
+
+} // namespace
+
 Key::Key(const std::string &devName)
-    : devName(devName), fd(-1), running(false), initialized(false),
-      lastKeyCode(-1), lastKeyPressed(false), longPressReported(false)
+    : Device(devName), wakeFd(-1), running(false), eventClock(CLOCK_REALTIME), requestedClock(CLOCK_REALTIME),
+      exclusive(false), grabbed(false), lastKeyCode(-1), lastKeyPressed(false), longPressReported(false)
 {
-    devPath = "/dev/" + devName;
+    for (std::size_t i = 0; i < STATE_WORDS; ++i)
+    {
+        pressedBits[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+Key::Key(const DeviceEntry &entry)
+    : Device(entry), wakeFd(-1), running(false), eventClock(CLOCK_REALTIME), requestedClock(CLOCK_REALTIME),
+      exclusive(false), grabbed(false), lastKeyCode(-1), lastKeyPressed(false), longPressReported(false)
+{
+    for (std::size_t i = 0; i < STATE_WORDS; ++i)
+    {
+        pressedBits[i].store(0, std::memory_order_relaxed);
+    }
 }
 
 Key::~Key()
 {
     stop();
-    cleanup();
 }
 
 Key::Key(Key &&other) noexcept
-    : devName(std::move(other.devName)), devPath(std::move(other.devPath)), fd(other.fd),
-      running(other.running.load()), initialized(other.initialized.load()),
-      callback(std::move(other.callback)), lastKeyCode(other.lastKeyCode),
-      lastKeyPressed(other.lastKeyPressed), lastPressTime(other.lastPressTime),
+    : Device(stopForMove(other)), wakeFd(-1), running(false), callback(std::move(other.callback)),
+      lastKeyCode(other.lastKeyCode), lastKeyPressed(other.lastKeyPressed), lastPressTime(other.lastPressTime),
       longPressReported(other.longPressReported)
 {
-    other.fd = -1;
-    other.running = false;
-    other.initialized = false;
+    copyState(other);
 }
 
 Key &Key::operator=(Key &&other) noexcept
@@ -40,95 +80,173 @@ Key &Key::operator=(Key &&other) noexcept
     if (this != &other)
     {
         stop();
-        cleanup();
-        devName = std::move(other.devName);
-        devPath = std::move(other.devPath);
-        fd = other.fd;
-        initialized = other.initialized.load();
-        running = other.running.load();
+        other.stop();
+        Device::operator=(std::move(other));
         callback = std::move(other.callback);
+        copyState(other);
         lastKeyCode = other.lastKeyCode;
         lastKeyPressed = other.lastKeyPressed;
         lastPressTime = other.lastPressTime;
         longPressReported = other.longPressReported;
-        other.fd = -1;
-        other.running = false;
-        other.initialized = false;
     }
     return *this;
 }
 
-ErrorCode Key::init()
+void Key::copyState(const Key &other)
 {
-    if (initialized)
-    {
-        spdlog::warn("Device {} already initialized", devName);
-        return ErrorCode::Ok;
-    }
-
-    // 打开设备节点
-    fd = open(devPath.c_str(), O_RDONLY);
-    if (fd < 0)
+    debouncer = other.debouncer;
+    eventClock = other.eventClock;
+    requestedClock = other.requestedClock;
+    exclusive = other.exclusive;
+    threadAttr = other.threadAttr;
+    grabbed = false; // 源对象 stop() 时已释放独占
+    for (std::size_t i = 0; i < STATE_WORDS; ++i)
     {
-        spdlog::error("open {} failed", devPath);
-        return ErrorCode::DevOpen;
+        pressedBits[i].store(other.pressedBits[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
     }
-
-    initialized = true;
-    spdlog::info("init {} success", devName);
-    return ErrorCode::Ok;
 }
 
 ErrorCode Key::start()
 {
-    if (!initialized || fd < 0)
+    if (!isReady())
     {
-        spdlog::error("{} not ready (not initialized)", devName);
+        spdlog::error("{} not ready (not initialized)", devName.c_str());
         return ErrorCode::DevNotReady;
     }
 
+    if (dispatchingKey == this)
+    {
+        spdlog::error("{} start() called from its own callback", devName.c_str());
+        return ErrorCode::Unsupported;
+    }
+
+    std::lock_guard<std::mutex> lock(controlMutex);
     if (running)
     {
-        spdlog::warn("Device {} already running", devName);
+        spdlog::warn("Device {} already running", devName.c_str());
         return ErrorCode::Ok;
     }
+    // 回调中 stop() 后留下的已退出线程
+    joinEventThread();
 
-    running = true;
-    try
+    if (validateThreadAttr(threadAttr) != ErrorCode::Ok)
     {
-        eventThread = std::thread(&Key::eventLoop, this);
-        spdlog::info("start {} success", devName);
-        return ErrorCode::Ok;
+        return ErrorCode::InvalidParam;
     }
-    catch (const std::exception &e)
+
+    // 切换时钟时内核会在缓冲区中插入 SYN_DROPPED，事件线程随后按内核状态校正
+    if (requestedClock != eventClock)
     {
-        running = false;
-        spdlog::error("Failed to start event loop: {}", e.what());
+        int clock = static_cast<int>(requestedClock);
+        if (ioctl(fd, EVIOCSCLOCKID, &clock) == 0)
+        {
+            eventClock = requestedClock;
+        }
+        else
+        {
+            spdlog::warn("{} does not support event clock {}: {}", devName.c_str(), clock,
+                         std::strerror(errno));
+        }
+    }
+
+    if (exclusive && !grabbed)
+    {
+        if (ioctl(fd, EVIOCGRAB, 1) != 0)
+        {
+            spdlog::error("grab {} failed: {}", devName.c_str(), std::strerror(errno));
+            return ErrorCode::DevIo;
+        }
+        grabbed = true;
+    }
+
+    // 启动前已按住的键：只更新状态，不派发事件
+    if (syncState(false) != ErrorCode::Ok)
+    {
+        spdlog::debug("{} key state unavailable, isPressed() starts empty", devName.c_str());
+    }
+
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0)
+    {
+        spdlog::error("create wake fd for {} failed: {}", devName.c_str(), std::strerror(errno));
+        releaseGrab();
         return ErrorCode::DevIo;
     }
+
+    running = true;
+    ErrorCode result = eventThread.start<Key, &Key::eventLoop>(this);
+    if (result != ErrorCode::Ok)
+    {
+        running = false;
+        close(wakeFd);
+        wakeFd = -1;
+        releaseGrab();
+        spdlog::error("Failed to start event loop for {}", devName.c_str());
+        return result;
+    }
+
+    result = applyThreadAttr(eventThread, threadAttr, "bsp-key");
+    if (result != ErrorCode::Ok)
+    {
+        spdlog::error("apply thread attributes for {} failed", devName.c_str());
+        joinEventThread();
+        return result;
+    }
+
+    spdlog::info("start {} success", devName.c_str());
+    return ErrorCode::Ok;
 }
 
 ErrorCode Key::stop()
 {
-    if (!running)
+    if (dispatchingKey == this)
     {
+        // 在回调中调用：事件线程不能等待自己，只通知它在回调返回后退出，
+        // 线程由之后的 stop()/start()/析构回收
+        running = false;
+        wakeEventThread();
         return ErrorCode::Ok;
     }
 
-    running = false;
+    std::lock_guard<std::mutex> lock(controlMutex);
+    return joinEventThread();
+}
 
-    if (eventThread.joinable())
+void Key::wakeEventThread()
+{
+    uint64_t one = 1;
+    ssize_t n = write(wakeFd, &one, sizeof(one));
+    (void)n;
+}
+
+ErrorCode Key::joinEventThread()
+{
+    if (!eventThread.joinable())
     {
-        eventThread.join();
+        return ErrorCode::Ok;
     }
 
-    spdlog::info("stop {} success", devName);
+    running = false;
+    wakeEventThread();
+    eventThread.join();
+    close(wakeFd);
+    wakeFd = -1;
+    releaseGrab();
+
+    spdlog::info("stop {} success", devName.c_str());
     return ErrorCode::Ok;
 }
 
-bool Key::isReady() const
+void Key::releaseGrab()
 {
-    return initialized && fd >= 0;
+    if (grabbed)
+    {
+        if (ioctl(fd, EVIOCGRAB, 0) != 0)
+        {
+            spdlog::warn("release grab on {} failed: {}", devName.c_str(), std::strerror(errno));
+        }
+        grabbed = false;
+    }
 }
 
 bool Key::isRunning() const
@@ -136,101 +254,401 @@ bool Key::isRunning() const
     return running;
 }
 
+bool Key::isPressed(int code) const
+{
+    if (code < 0 || code >= KEY_CNT)
+    {
+        return false;
+    }
+    return (pressedBits[code / 32].load(std::memory_order_relaxed) >> (code % 32)) & 1u;
+}
+
+void Key::setPressed(int code, bool pressed)
+{
+    if (code < 0 || code >= KEY_CNT)
+    {
+        return;
+    }
+    uint32_t bit = 1u << (code % 32);
+    if (pressed)
+    {
+        pressedBits[code / 32].fetch_or(bit, std::memory_order_relaxed);
+    }
+    else
+    {
+        pressedBits[code / 32].fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+ErrorCode Key::refreshState()
+{
+    if (!isReady())
+    {
+        return ErrorCode::DevNotReady;
+    }
+    return syncState(false);
+}
+
+ErrorCode Key::syncState(bool notify)
+{
+    uint8_t bytes[(KEY_CNT + 7) / 8];
+    std::memset(bytes, 0, sizeof(bytes));
+    if (ioctl(fd, EVIOCGKEY(sizeof(bytes)), bytes) < 0)
+    {
+        return ErrorCode::Unsupported;
+    }
+
+    // 逐键交给消抖器校正（也清掉时间窗内尚未确认的原始状态），SYN_DROPPED 后很少发生，不必只挑变化的键
+    std::lock_guard<std::mutex> lock(debounceMutex);
+    uint64_t now = clockNowUs(eventClock);
+    for (std::size_t word = 0; word < STATE_WORDS; ++word)
+    {
+        uint32_t bits = 0;
+        for (std::size_t b = 0; b < 4 && word * 4 + b < sizeof(bytes); ++b)
+        {
+            bits |= static_cast<uint32_t>(bytes[word * 4 + b]) << (8 * b);
+        }
+        for (std::size_t bit = 0; bit < 32 && word * 32 + bit < KEY_CNT; ++bit)
+        {
+            debouncer.resync(static_cast<int>(word * 32 + bit), (bits >> bit) & 1u, now, notify);
+        }
+        // notify 时由事件线程派发补发的事件时更新
+        if (!notify)
+        {
+            pressedBits[word].store(bits, std::memory_order_relaxed);
+        }
+    }
+    return ErrorCode::Ok;
+}
+
+void Key::setThreadAttr(const ThreadAttr &attr)
+{
+    threadAttr = attr;
+}
+
+void Key::setExclusive(bool exclusive)
+{
+    this->exclusive = exclusive;
+}
+
+void Key::setEventClock(clockid_t clock)
+{
+    requestedClock = clock;
+}
+
+clockid_t Key::getEventClock() const
+{
+    return eventClock;
+}
+
 void Key::setCallback(KeyCallback cb)
 {
     callback = cb;
 }
 
-std::string Key::getDeviceName() const
+void Key::setDebounce(const KeyDebounceConfig &config)
 {
-    return devName;
+    std::lock_guard<std::mutex> lock(debounceMutex);
+    debouncer.configure(config);
 }
 
-void Key::eventLoop()
+ErrorCode Key::setDebounceWindow(int code, uint32_t windowMs)
 {
-    struct input_event event;
+    std::lock_guard<std::mutex> lock(debounceMutex);
+    return debouncer.setWindow(code, windowMs) ? ErrorCode::Ok : ErrorCode::InvalidParam;
+}
 
-    spdlog::debug("Event loop started for {}", devName);
+KeyDebounceStats Key::debounceStats() const
+{
+    std::lock_guard<std::mutex> lock(debounceMutex);
+    return debouncer.stats();
+}
 
-    while (running)
+ErrorCode Key::nextEvent(EventLoop &loop, EventCallback cb)
+{
+    return armNextEvent(loop, cb);
+}
+
+ErrorCode Key::armNextEvent(EventLoop &loop, EventCallback &cb)
+{
+    if (!isReady())
     {
+        spdlog::error("{} not ready (not initialized)", devName.c_str());
+        return ErrorCode::DevNotReady;
+    }
+
+    if (running)
+    {
+        spdlog::error("{} event thread is running, nextEvent() unavailable", devName.c_str());
+        return ErrorCode::Unsupported;
+    }
+
+    // 回调存在对象里，闭包只捕获两个指针，放得进 std::function 的内部存储，每次等待不申请堆内存
+    EventCallback previous = std::move(pendingEvent);
+    pendingEvent = std::move(cb);
+    ErrorCode result = loop.watchOnce(fd, [this, &loop](uint32_t) {
+        // 先取出再调用，回调中可以再次 nextEvent()
+        EventCallback cb = std::move(pendingEvent);
+        struct input_event event;
         ssize_t n = read(fd, &event, sizeof(struct input_event));
+        BSP_TRACE_INSTANT("Key::wakeup");
 
-        if (n < 0)
+        // 就绪通知是假的（事件已被读走）或不是按键事件（同步/杂项事件不交给调用者），继续等待
+        if ((n < 0 && errno == EAGAIN) || (n == sizeof(struct input_event) && event.type != EV_KEY))
         {
-            if (running)
+            ErrorCode err = armNextEvent(loop, cb);
+            if (err != ErrorCode::Ok)
             {
-                spdlog::error("read from {} failed", devName);
+                cb(err, -1, -1);
             }
-            break;
+            return;
         }
 
         if (n != sizeof(struct input_event))
         {
-            spdlog::warn("read size mismatch from {}", devName);
+            spdlog::error("read from {} failed", devName.c_str());
+            cb(ErrorCode::DevIo, -1, -1);
+            return;
+        }
+
+        if (event.value != 2)
+        {
+            setPressed(event.code, event.value != 0);
+        }
+
+        BSP_TRACE_SCOPE("Key::callback");
+        MetricsTimer timer(MetricOp::KeyDispatch);
+        cb(ErrorCode::Ok, event.code, event.value);
+        timer.finish(ErrorCode::Ok);
+    });
+    if (result != ErrorCode::Ok)
+    {
+        // 提交失败（如已有等待）：回调留给调用方，原来等待中的回调保持不变
+        cb = std::move(pendingEvent);
+        pendingEvent = std::move(previous);
+    }
+    return result;
+}
+
+ErrorCode Key::readEvent(int &code, int &value, int timeoutMs)
+{
+    if (running)
+    {
+        spdlog::error("{} event thread is running, readEvent() unavailable", devName.c_str());
+        return ErrorCode::Unsupported;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs > 0 ? timeoutMs : 0);
+    for (;;)
+    {
+        // 同步/杂项事件不算数，期限按整个调用计算
+        int leftMs = timeoutMs;
+        if (timeoutMs > 0)
+        {
+            long long leftUs = std::chrono::duration_cast<std::chrono::microseconds>(deadline - Clock::now()).count();
+            leftMs = leftUs > 0 ? static_cast<int>((leftUs + 999) / 1000) : 0;
+        }
+        ErrorCode result = waitReadable(leftMs);
+        if (result != ErrorCode::Ok)
+        {
+            return result;
+        }
+
+        struct input_event event;
+        ssize_t n = read(fd, &event, sizeof(struct input_event));
+        if (n < 0 && (errno == EAGAIN || errno == EINTR))
+        {
+            continue;
+        }
+        if (n != sizeof(struct input_event))
+        {
+            spdlog::error("read from {} failed", devName.c_str());
+            return ErrorCode::DevIo;
+        }
+        if (event.type != EV_KEY)
+        {
             continue;
         }
 
-        // 只处理按键事件
-        if (event.type == EV_KEY)
+        if (event.value != 2)
         {
-            spdlog::debug("Event from {} - code: {}, value: {}", devName,
-                          event.code, event.value);
+            setPressed(event.code, event.value != 0);
+        }
+        code = event.code;
+        value = event.value;
+        return ErrorCode::Ok;
+    }
+}
 
-            // 按键按下时，记录按下信息
-            if (event.value == 1)
+int Key::debounceTimeoutMs()
+{
+    std::lock_guard<std::mutex> lock(debounceMutex);
+    uint64_t deadline = debouncer.nextDeadlineUs();
+    if (deadline == UINT64_MAX)
+    {
+        return -1;
+    }
+    uint64_t now = clockNowUs(eventClock);
+    if (deadline <= now)
+    {
+        return 0;
+    }
+    // 向上取整，避免在时间窗结束前被唤醒后空转
+    uint64_t ms = (deadline - now + 999) / 1000;
+    return ms > 1000 ? 1000 : static_cast<int>(ms);
+}
+
+void Key::eventLoop()
+{
+    struct input_event events[EVENT_BATCH];
+    std::vector<KeyLogicalEvent> logical;
+    logical.reserve(EVENT_BATCH);
+
+    prefaultStack(threadAttr.stackPrefaultBytes);
+    Metrics::attachThread();
+    dispatchingKey = this;
+    spdlog::debug("Event loop started for {}", devName.c_str());
+
+    while (running)
+    {
+        // 同时等待输入事件和 stop() 的唤醒，避免 stop() 阻塞到下一次按键；
+        // 有按键处于消抖时间窗内时在窗口结束时醒来确认最终状态
+        pollfd fds[2] = {{fd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        int ret = poll(fds, 2, debounceTimeoutMs());
+        if (ret < 0)
+        {
+            if (errno == EINTR)
             {
-                lastKeyCode = event.code;
-                lastKeyPressed = true;
-                lastPressTime = std::chrono::system_clock::now();
-                longPressReported = false;
-                // 报告按下事件
-                if (callback)
+                continue;
+            }
+            spdlog::error("poll {} failed: {}", devName.c_str(), std::strerror(errno));
+            break;
+        }
+        if (fds[1].revents != 0)
+        {
+            break;
+        }
+
+        std::size_t count = 0;
+        if (fds[0].revents != 0)
+        {
+            ssize_t n = read(fd, events, sizeof(events));
+            BSP_TRACE_INSTANT("Key::wakeup");
+
+            if (n < 0 && (errno == EAGAIN || errno == EINTR))
+            {
+                continue;
+            }
+            if (n < 0)
+            {
+                if (running)
                 {
-                    callback(event.code, 1);
+                    spdlog::error("read from {} failed", devName.c_str());
                 }
+                break;
+            }
+
+            if (n == 0 || n % static_cast<ssize_t>(sizeof(struct input_event)) != 0)
+            {
+                spdlog::warn("read size mismatch from {}", devName.c_str());
+                continue;
+            }
+            count = static_cast<std::size_t>(n) / sizeof(struct input_event);
+        }
+
+        // 消抖/合并后再派发，回调在锁外执行
+        {
+            std::unique_lock<std::mutex> lock(debounceMutex);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                debouncer.feed(events[i]);
             }
-            // 按键释放时，检查是否为长按
-            else if (event.value == 0)
+            if (debouncer.takeResync())
             {
-                lastKeyPressed = false;
-                if (lastKeyCode == event.code)
+                // SYN_DROPPED 期间丢失的按键变化按内核当前状态补发
+                lock.unlock();
+                if (syncState(true) != ErrorCode::Ok)
                 {
-                    auto now = std::chrono::system_clock::now();
-                    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastPressTime);
-
-                    // 如果按键按下时长超过阈值，报告为长按，否则报告为普通释放
-                    if (duration.count() >= LONG_PRESS_THRESHOLD_MS && !longPressReported)
-                    {
-                        // 长按，报告长按事件（值为2）
-                        if (callback)
-                        {
-                            callback(event.code, 2);
-                            spdlog::debug("Long press detected - code: {}, duration: {} ms",
-                                        event.code, duration.count());
-                        }
-                    }
-                    else if (!longPressReported && callback)
-                    {
-                        // 短按，报告释放事件（值为0）
-                        callback(event.code, 0);
-                    }
+                    spdlog::warn("{} dropped events, key state may be stale", devName.c_str());
                 }
+                lock.lock();
+            }
+            debouncer.expire(clockNowUs(eventClock));
+            KeyLogicalEvent event;
+            while (debouncer.pop(event))
+            {
+                logical.push_back(event);
+            }
+        }
+        for (const KeyLogicalEvent &event : logical)
+        {
+            if (!running)
+            {
+                break; // 回调中调用了 stop()，不再派发
+            }
+            spdlog::debug("Event from {} - code: {}, value: {}", devName.c_str(), event.code, event.value);
+            if (event.value != 2)
+            {
+                setPressed(event.code, event.value != 0);
             }
+            handleKey(event.code, event.value);
         }
+        logical.clear();
     }
 
-    spdlog::debug("Event loop ended for {}", devName);
+    spdlog::debug("Event loop ended for {}", devName.c_str());
 }
 
-void Key::cleanup()
+void Key::handleKey(int code, int value)
 {
-    if (fd >= 0)
+    // 按键按下时，记录按下信息
+    if (value == 1)
+    {
+        lastKeyCode = code;
+        lastKeyPressed = true;
+        lastPressTime = std::chrono::system_clock::now();
+        longPressReported = false;
+        // 报告按下事件
+        if (callback)
+        {
+            dispatch(code, 1);
+        }
+    }
+    // 按键释放时，检查是否为长按
+    else if (value == 0)
     {
-        close(fd);
-        fd = -1;
+        lastKeyPressed = false;
+        if (lastKeyCode == code)
+        {
+            auto now = std::chrono::system_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastPressTime);
+
+            // 如果按键按下时长超过阈值，报告为长按，否则报告为普通释放
+            if (duration.count() >= LONG_PRESS_THRESHOLD_MS && !longPressReported)
+            {
+                // 长按，报告长按事件（值为2）
+                if (callback)
+                {
+                    dispatch(code, 2);
+                    spdlog::debug("Long press detected - code: {}, duration: {} ms", code, duration.count());
+                }
+            }
+            else if (!longPressReported && callback)
+            {
+                // 短按，报告释放事件（值为0）
+                dispatch(code, 0);
+            }
+        }
     }
-    initialized = false;
+}
+
+void Key::dispatch(int code, int value)
+{
+    BSP_TRACE_SCOPE("Key::callback");
+    MetricsTimer timer(MetricOp::KeyDispatch);
+    callback(code, value);
+    timer.finish(ErrorCode::Ok);
 }
 
 } // namespace bsp
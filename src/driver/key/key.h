@@ -3,54 +3,180 @@
 
 #include <string>
 #include <functional>
-#include <thread>
 #include <atomic>
 #include <chrono>
+#include <mutex>
+#include <fcntl.h>
+#include <time.h>
 #include <linux/input.h>
-#include "../../common/bsp_common.h"
+#include "../device.h"
+#include "../../common/thread_attr.h"
+#include "key_debounce.h"
 
 namespace bsp
 {
 
-class Key
+/**
+ * @brief 按键输入设备特性
+ */
+struct KeyTraits
+{
+    // 非阻塞：所有读取都在 poll() 之后进行，即使就绪通知不可靠 read() 也不会卡住
+    static constexpr int OPEN_FLAGS = O_RDONLY | O_NONBLOCK;
+
+    static const char *initTraceName()
+    {
+        return "Key::init";
+    }
+};
+
+/**
+ * @brief 按键输入设备：init()/isReady() 等接口由 Device 基类提供
+ *
+ * 线程安全：start()/stop() 可在任意线程并发调用，事件线程只启动、回收一次；回调中可以调用
+ * stop()（回调返回后事件线程退出，不再派发后续事件），但不能调用 start() 或析构 Key。
+ * 析构会等待正在执行的回调返回。setCallback()/setExclusive() 等设置须在 start() 之前完成。
+ */
+class Key : public Device<Key, KeyTraits>
 {
 public:
     using KeyCallback = std::function<void(int code, int value)>;
+    // 异步按键事件回调：value 为内核原始值（0 释放，1 按下，2 自动重复）
+    using EventCallback = std::function<void(ErrorCode error, int code, int value)>;
 
     // 长按检测阈值(ms)
     static constexpr int LONG_PRESS_THRESHOLD_MS = 500;
 
     explicit Key(const std::string &devName = "input/event2");
+    // 从板级设备表项构造（直接使用表中已拼好的设备路径）
+    explicit Key(const DeviceEntry &entry);
     ~Key();
 
-    // 禁止拷贝
-    Key(const Key &) = delete;
-    Key &operator=(const Key &) = delete;
-
-    // 支持移动语义
+    // 支持移动语义：事件线程持有 this，移动前会先停止源对象的事件线程，移动后需重新 start()
     Key(Key &&other) noexcept;
     Key &operator=(Key &&other) noexcept;
 
-    ErrorCode init();
+    /**
+     * @brief 启动事件线程
+     *
+     * 启动前按设置切换事件时钟（EVIOCSCLOCKID）、独占设备（EVIOCGRAB），并查询一次全部按键
+     * 状态（EVIOCGKEY），启动时已按住的键立即可由 isPressed() 查到。
+     * @return ErrorCode::Ok 成功；DevNotReady 未初始化；DevIo 独占失败或线程创建失败；
+     *         Unsupported 在本设备的回调中调用
+     */
     ErrorCode start();
+
+    /**
+     * @brief 停止事件线程并等待其退出；在回调中调用时只通知退出，不等待
+     */
     ErrorCode stop();
-    bool isReady() const;
     bool isRunning() const;
 
+    /**
+     * @brief 按键当前是否按下（消抖后的状态；O(1)、无锁，可在任意线程调用）
+     */
+    bool isPressed(int code) const;
+
+    /**
+     * @brief 从内核查询全部按键状态（EVIOCGKEY），刷新 isPressed() 和消抖状态（不触发回调）
+     * @return ErrorCode::Ok 成功；DevNotReady 未初始化；Unsupported 不是 evdev 设备
+     */
+    ErrorCode refreshState();
+
+    /**
+     * @brief start() 时独占设备（EVIOCGRAB），其他打开同一设备的进程不再收到事件，stop() 时释放
+     */
+    void setExclusive(bool exclusive);
+
+    /**
+     * @brief 选择输入事件时间戳的时钟（CLOCK_REALTIME / CLOCK_MONOTONIC / CLOCK_BOOTTIME），
+     *        start() 时通过 EVIOCSCLOCKID 生效。推荐 CLOCK_MONOTONIC，消抖时间窗不受系统时间调整影响
+     */
+    void setEventClock(clockid_t clock);
+
+    /**
+     * @brief 当前实际使用的事件时钟（设备不支持切换时保持 CLOCK_REALTIME）
+     */
+    clockid_t getEventClock() const;
+
+    /**
+     * @brief 设置事件线程的调度策略、CPU 亲和性、线程名等（下一次 start() 生效）
+     */
+    void setThreadAttr(const ThreadAttr &attr);
+
     void setCallback(KeyCallback cb);
-    std::string getDeviceName() const;
+
+    /**
+     * @brief 设置事件线程的消抖/合并参数（可在运行中调用，会清空消抖状态和统计）
+     *
+     * 抖动产生的按下/释放对在回调之前被吸收，一次物理按键只派发一次按下和一次释放；
+     * 默认参数下原始事件原样派发。nextEvent() 不经过消抖。
+     */
+    void setDebounce(const KeyDebounceConfig &config);
+
+    /**
+     * @brief 为单个按键设置消抖时间窗（在 setDebounce() 之后调用）
+     * @return ErrorCode::Ok 成功；InvalidParam 按键码超出范围
+     */
+    ErrorCode setDebounceWindow(int code, uint32_t windowMs);
+
+    /**
+     * @brief 消抖统计（收到、派发以及按原因抑制的事件数）
+     */
+    KeyDebounceStats debounceStats() const;
+
+    // 在事件循环上等待下一个 EV_KEY 事件（不做长按检测）。与 start() 的事件线程互斥；
+    // 回调执行前 Key 不能析构或移动，需要持续监听时在回调中再次调用。放弃等待并关闭设备时，
+    // 先在循环线程中调用 loop.cancel(getFd())
+    ErrorCode nextEvent(EventLoop &loop, EventCallback cb);
+
+    /**
+     * @brief 在调用线程中限时等待下一个 EV_KEY 事件（不经过消抖，不做长按检测；与 start() 的事件线程互斥）
+     * @param code 按键码
+     * @param value 内核原始值（0 释放，1 按下，2 自动重复）
+     * @param timeoutMs 期限(ms)；< 0 不限时，但可被 cancel() 打断
+     * @return ErrorCode::Ok 成功；Timeout 超过期限；Cancelled 已取消；DevNotReady 未初始化；
+     *         Unsupported 事件线程运行中；DevIo 读取失败
+     */
+    ErrorCode readEvent(int &code, int &value, int timeoutMs);
 
 private:
+    // 一次 read() 最多读取的输入事件数
+    static constexpr std::size_t EVENT_BATCH = 16;
+    // 按键状态位图的字数（每位一个按键码）
+    static constexpr std::size_t STATE_WORDS = (KEY_CNT + 31) / 32;
+
     void eventLoop();
-    void cleanup();
+    int debounceTimeoutMs();             // 距最早一个待确认按键的时间窗结束的毫秒数，没有时为 -1
+    void handleKey(int code, int value); // 处理一个消抖后的逻辑事件（长按检测）
+    void dispatch(int code, int value);  // 调用回调并记录分发耗时
+    void setPressed(int code, bool pressed);
+    ErrorCode syncState(bool notify);    // EVIOCGKEY 查询并校正状态，notify 时派发差异
+    void copyState(const Key &other);
+    void releaseGrab();
+    void wakeEventThread();
+    ErrorCode armNextEvent(EventLoop &loop, EventCallback &cb); // 失败时 cb 保持不变
+    ErrorCode joinEventThread(); // 持有 controlMutex 时调用：通知事件线程退出并回收
+
 
-    std::string devName;
-    std::string devPath;
-    int fd;
+    int wakeFd; // stop() 通过它唤醒阻塞在 poll() 中的事件线程
     std::atomic<bool> running;
-    std::atomic<bool> initialized;
-    std::thread eventThread;
+    std::mutex controlMutex; // 串行化 start()/stop() 对事件线程、wakeFd 和独占状态的操作
+    Thread eventThread;
     KeyCallback callback;
+    EventCallback pendingEvent; // 未完成的 nextEvent() 的回调
+
+    // 消抖状态由事件线程更新，setDebounce()/debounceStats() 可能来自其他线程
+    mutable std::mutex debounceMutex;
+    KeyDebouncer debouncer;
+    clockid_t eventClock;     // 输入事件时间戳所用的时钟（evdev 默认 CLOCK_REALTIME）
+    clockid_t requestedClock; // setEventClock() 设置，start() 时生效
+
+    // 按键状态位图：事件线程写，isPressed() 任意线程读
+    std::atomic<uint32_t> pressedBits[STATE_WORDS];
+    bool exclusive;
+    bool grabbed;
+    ThreadAttr threadAttr;
 
     // 长按检测相关
     int lastKeyCode;
@@ -0,0 +1,305 @@
+#include "key_debounce.h"
+#include <cstring>
+
+namespace bsp
+{
+
+constexpr std::size_t KeyDebouncer::CODE_COUNT;
+constexpr std::size_t KeyDebouncer::RESERVED_KEYS;
+
+KeyDebouncer::KeyDebouncer(const KeyDebounceConfig &config)
+{
+    // 预留常见的同时变化键数，事件线程上不因首次按键扩容
+    pending.reserve(RESERVED_KEYS);
+    frame.reserve(RESERVED_KEYS);
+    ready.reserve(RESERVED_KEYS);
+    configure(config);
+}
+
+void KeyDebouncer::configure(const KeyDebounceConfig &newConfig)
+{
+    config = newConfig;
+    for (std::size_t i = 0; i < CODE_COUNT; ++i)
+    {
+        windowUs[i] = config.windowMs * 1000u;
+    }
+    reset();
+}
+
+bool KeyDebouncer::setWindow(int code, uint32_t windowMs)
+{
+    if (code < 0 || static_cast<std::size_t>(code) >= CODE_COUNT)
+    {
+        return false;
+    }
+    windowUs[code] = windowMs * 1000u;
+    return true;
+}
+
+void KeyDebouncer::reset()
+{
+    std::memset(lockUntil, 0, sizeof(lockUntil));
+    std::memset(reported, 0, sizeof(reported));
+    std::memset(raw, 0, sizeof(raw));
+    std::memset(isPending, 0, sizeof(isPending));
+    std::memset(frameStart, -1, sizeof(frameStart));
+    std::memset(frameAccepted, 0, sizeof(frameAccepted));
+    std::memset(&counters, 0, sizeof(counters));
+    pending.clear();
+    frame.clear();
+    ready.clear();
+    readyHead = 0;
+    dropping = false;
+    needsResync = false;
+}
+
+bool KeyDebouncer::passthrough(uint16_t code) const
+{
+    return windowUs[code] == 0;
+}
+
+void KeyDebouncer::feed(const input_event &event)
+{
+    uint64_t timeUs = static_cast<uint64_t>(event.time.tv_sec) * 1000000u + static_cast<uint64_t>(event.time.tv_usec);
+    feed(event.type, event.code, event.value, timeUs);
+}
+
+void KeyDebouncer::feed(uint16_t type, uint16_t code, int32_t value, uint64_t timeUs)
+{
+    if (type == EV_SYN)
+    {
+        if (code == SYN_REPORT)
+        {
+            if (dropping)
+            {
+                dropping = false;
+                needsResync = true;
+            }
+            else
+            {
+                flushFrame();
+            }
+        }
+        else if (code == SYN_DROPPED)
+        {
+            // 内核缓冲区溢出：本帧不完整，撤销本帧的变化并丢弃到下一个 SYN_REPORT
+            dropFrame();
+            dropping = true;
+        }
+        return;
+    }
+    if (type != EV_KEY || code >= CODE_COUNT)
+    {
+        return;
+    }
+
+    ++counters.received;
+    if (dropping)
+    {
+        ++counters.dropped;
+        return;
+    }
+
+    if (value == 2)
+    {
+        if (config.suppressRepeat)
+        {
+            ++counters.repeats;
+        }
+        else
+        {
+            KeyLogicalEvent event = {code, value, timeUs};
+            emit(event);
+        }
+        return;
+    }
+
+    uint8_t state = value != 0 ? 1 : 0;
+    if (passthrough(code))
+    {
+        raw[code] = state;
+        accept(code, value, timeUs);
+        return;
+    }
+
+    raw[code] = state;
+    if (state == reported[code])
+    {
+        // 抖动的后半段：原始状态回到已报告状态，无需补发
+        ++counters.bounced;
+        return;
+    }
+    if (timeUs < lockUntil[code])
+    {
+        ++counters.bounced;
+        if (!isPending[code])
+        {
+            isPending[code] = true;
+            pending.push_back(code);
+        }
+        return;
+    }
+    accept(code, value, timeUs);
+}
+
+void KeyDebouncer::accept(uint16_t code, int32_t value, uint64_t timeUs)
+{
+    KeyLogicalEvent event = {code, value, timeUs};
+    if (config.frameBatching)
+    {
+        if (frameStart[code] < 0)
+        {
+            frameStart[code] = static_cast<int8_t>(reported[code]);
+        }
+        ++frameAccepted[code];
+        frame.push_back(event);
+    }
+    else
+    {
+        emit(event);
+    }
+    reported[code] = value != 0 ? 1 : 0;
+    lockUntil[code] = timeUs + windowUs[code];
+}
+
+void KeyDebouncer::emit(const KeyLogicalEvent &event)
+{
+    ready.push_back(event);
+    ++counters.dispatched;
+}
+
+void KeyDebouncer::flushFrame()
+{
+    // 每个键只派发本帧最终状态；变回帧开始前状态的键整体合并掉
+    for (std::size_t i = 0; i < frame.size(); ++i)
+    {
+        uint16_t code = frame[i].code;
+        if (frameStart[code] < 0)
+        {
+            continue; // 已处理
+        }
+        if (reported[code] != static_cast<uint8_t>(frameStart[code]))
+        {
+            KeyLogicalEvent last = frame[i];
+            for (std::size_t j = frame.size(); j-- > i;)
+            {
+                if (frame[j].code == code)
+                {
+                    last = frame[j];
+                    break;
+                }
+            }
+            emit(last);
+            counters.coalesced += frameAccepted[code] - 1u;
+        }
+        else
+        {
+            counters.coalesced += frameAccepted[code];
+        }
+        frameStart[code] = -1;
+        frameAccepted[code] = 0;
+    }
+    frame.clear();
+}
+
+void KeyDebouncer::dropFrame()
+{
+    for (std::size_t i = 0; i < frame.size(); ++i)
+    {
+        uint16_t code = frame[i].code;
+        if (frameStart[code] >= 0)
+        {
+            reported[code] = static_cast<uint8_t>(frameStart[code]);
+            raw[code] = reported[code];
+            counters.dropped += frameAccepted[code];
+            frameStart[code] = -1;
+            frameAccepted[code] = 0;
+        }
+    }
+    frame.clear();
+}
+
+void KeyDebouncer::expire(uint64_t nowUs)
+{
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < pending.size(); ++i)
+    {
+        uint16_t code = pending[i];
+        if (nowUs < lockUntil[code])
+        {
+            pending[kept++] = code;
+            continue;
+        }
+        isPending[code] = false;
+        if (raw[code] != reported[code])
+        {
+            // 时间窗内最终稳定在另一状态：补发，时间戳取窗口结束时刻
+            reported[code] = raw[code];
+            uint64_t at = lockUntil[code];
+            lockUntil[code] = at + windowUs[code];
+            KeyLogicalEvent event = {code, raw[code], at};
+            emit(event);
+        }
+    }
+    pending.resize(kept);
+}
+
+uint64_t KeyDebouncer::nextDeadlineUs() const
+{
+    uint64_t deadline = UINT64_MAX;
+    for (uint16_t code : pending)
+    {
+        if (lockUntil[code] < deadline)
+        {
+            deadline = lockUntil[code];
+        }
+    }
+    return deadline;
+}
+
+bool KeyDebouncer::pop(KeyLogicalEvent &event)
+{
+    if (readyHead >= ready.size())
+    {
+        ready.clear();
+        readyHead = 0;
+        return false;
+    }
+    event = ready[readyHead++];
+    return true;
+}
+
+bool KeyDebouncer::isPressed(int code) const
+{
+    return code >= 0 && static_cast<std::size_t>(code) < CODE_COUNT && reported[code] != 0;
+}
+
+void KeyDebouncer::resync(int code, bool pressed, uint64_t timeUs, bool notify)
+{
+    if (code < 0 || static_cast<std::size_t>(code) >= CODE_COUNT)
+    {
+        return;
+    }
+    uint8_t state = pressed ? 1 : 0;
+    raw[code] = state;
+    if (reported[code] == state)
+    {
+        return;
+    }
+    reported[code] = state;
+    lockUntil[code] = timeUs + windowUs[code];
+    if (notify)
+    {
+        KeyLogicalEvent event = {static_cast<uint16_t>(code), state, timeUs};
+        emit(event);
+    }
+}
+
+bool KeyDebouncer::takeResync()
+{
+    bool resync = needsResync;
+    needsResync = false;
+    return resync;
+}
+
+} // namespace bsp
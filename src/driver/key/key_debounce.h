@@ -0,0 +1,161 @@
+#ifndef BSP_KEY_DEBOUNCE_H
+#define BSP_KEY_DEBOUNCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <linux/input.h>
+
+namespace bsp
+{
+
+/**
+ * @brief 按键消抖/合并参数（默认全部关闭，原始事件原样透传）
+ */
+struct KeyDebounceConfig
+{
+    uint32_t windowMs;   // 消抖时间窗：一次状态变化被接受后，该键在窗口内的反复变化被吸收（0 关闭）
+    bool frameBatching;  // 按 SYN_REPORT 帧合并：同一帧内同一键变化后又变回原状态时不派发
+    bool suppressRepeat; // 丢弃内核自动重复事件（EV_KEY value 2）
+
+    KeyDebounceConfig() : windowMs(0), frameBatching(false), suppressRepeat(false)
+    {
+    }
+};
+
+/**
+ * @brief 消抖统计（抑制的事件按原因分别计数）
+ */
+struct KeyDebounceStats
+{
+    uint64_t received;   // 收到的 EV_KEY 事件数
+    uint64_t dispatched; // 派发的逻辑事件数
+    uint64_t bounced;    // 被消抖时间窗吸收的事件数
+    uint64_t coalesced;  // 同一帧内被合并掉的事件数
+    uint64_t repeats;    // 被丢弃的自动重复事件数
+    uint64_t dropped;    // SYN_DROPPED 之后到下一个 SYN_REPORT 之间丢弃的事件数
+};
+
+/**
+ * @brief 一个逻辑按键事件
+ */
+struct KeyLogicalEvent
+{
+    uint16_t code;
+    int32_t value;   // 0 释放，1 按下，2 自动重复
+    uint64_t timeUs; // 事件时间戳（与输入事件同一时钟）
+};
+
+/**
+ * @brief 按键消抖与事件合并
+ *
+ * 按键码逐个维护“已报告状态”和“最新原始状态”。状态变化在时间窗外立即接受并派发
+ * （不增加按下延迟），随后的时间窗内该键的变化只更新原始状态；时间窗结束时原始状态
+ * 仍与已报告状态不同（如窗口内真正松开），由 expire() 补发一次变化，保证最终状态正确。
+ *
+ * 时间全部取自事件时间戳和调用方传入的当前时间，不读时钟，便于用脚本化序列测试。
+ * 不分配内存（除输出队列首次扩容），非线程安全，由按键事件线程独占使用。
+ */
+class KeyDebouncer
+{
+public:
+    // 可处理的按键码个数（0 ~ KEY_MAX）
+    static constexpr std::size_t CODE_COUNT = KEY_CNT;
+    // 构造时为待处理/待派发队列预留的容量（同时变化的键数超过它才会扩容）
+    static constexpr std::size_t RESERVED_KEYS = 32;
+
+    explicit KeyDebouncer(const KeyDebounceConfig &config = KeyDebounceConfig());
+
+    /**
+     * @brief 修改参数（所有键的时间窗恢复为 config.windowMs），并清空状态
+     */
+    void configure(const KeyDebounceConfig &config);
+
+    const KeyDebounceConfig &getConfig() const
+    {
+        return config;
+    }
+
+    /**
+     * @brief 为单个按键设置时间窗（如机械按键用更长的窗口）
+     * @return false 按键码超出范围
+     */
+    bool setWindow(int code, uint32_t windowMs);
+
+    /**
+     * @brief 输入一个原始事件（EV_KEY / EV_SYN，其他类型忽略）
+     */
+    void feed(const input_event &event);
+    void feed(uint16_t type, uint16_t code, int32_t value, uint64_t timeUs);
+
+    /**
+     * @brief 时间推进到 nowUs：补发时间窗已结束、原始状态与已报告状态不同的按键
+     */
+    void expire(uint64_t nowUs);
+
+    /**
+     * @brief 最早一个待确认按键的时间窗结束时刻，没有时返回 UINT64_MAX
+     */
+    uint64_t nextDeadlineUs() const;
+
+    /**
+     * @brief 取出一个待派发的逻辑事件
+     * @return false 没有待派发事件
+     */
+    bool pop(KeyLogicalEvent &event);
+
+    /**
+     * @brief 已报告的按键状态（true 按下）
+     */
+    bool isPressed(int code) const;
+
+    /**
+     * @brief 按内核查询到的状态（EVIOCGKEY）校正一个按键
+     * @param notify true 时状态不同则派发一次变化（补上 SYN_DROPPED 期间丢失的事件）；
+     *               false 时只更新状态（如启动时按键已处于按下状态）
+     */
+    void resync(int code, bool pressed, uint64_t timeUs, bool notify);
+
+    /**
+     * @brief SYN_DROPPED 之后是否需要向内核查询按键状态（调用后清除）
+     */
+    bool takeResync();
+
+    KeyDebounceStats stats() const
+    {
+        return counters;
+    }
+
+    /**
+     * @brief 清空按键状态、待派发事件和统计
+     */
+    void reset();
+
+private:
+    bool passthrough(uint16_t code) const;
+    void accept(uint16_t code, int32_t value, uint64_t timeUs);
+    void emit(const KeyLogicalEvent &event);
+    void flushFrame();
+    void dropFrame();
+
+    KeyDebounceConfig config;
+    uint32_t windowUs[CODE_COUNT];
+    uint64_t lockUntil[CODE_COUNT];
+    uint8_t reported[CODE_COUNT];
+    uint8_t raw[CODE_COUNT];
+    bool isPending[CODE_COUNT];
+    int8_t frameStart[CODE_COUNT]; // 本帧开始前的已报告状态，-1 表示本帧未变化
+    uint16_t frameAccepted[CODE_COUNT];
+
+    std::vector<uint16_t> pending;      // 时间窗内原始状态变化过的按键
+    std::vector<KeyLogicalEvent> frame; // 本帧已接受的变化（开启帧合并时）
+    std::vector<KeyLogicalEvent> ready; // 待派发的逻辑事件
+    std::size_t readyHead;
+    bool dropping;    // 收到 SYN_DROPPED，丢弃到下一个 SYN_REPORT
+    bool needsResync; // 丢弃结束，等待调用方按内核状态校正
+    KeyDebounceStats counters;
+};
+
+} // namespace bsp
+
+#endif // BSP_KEY_DEBOUNCE_H
@@ -1,89 +1,212 @@
 #include "led.h"
+#include "../../common/metrics.h"
+#include "../../common/trace.h"
 #include <spdlog/spdlog.h>
 #include <cstdio>
-#include <cstring>
-#include <fcntl.h>
-#include <unistd.h>
+#include <cstdlib>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
 
 namespace bsp
 {
 
-Led::Led(const std::string &dev_name) : dev_name_(dev_name), fd_(-1), initialized_(false)
+constexpr int LedTraits::OPEN_FLAGS;
+
+namespace
+{
+
+const char BRIGHTNESS_SUFFIX[] = "/brightness";
+
+const char *triggerName(int trigger)
+{
+    static const char *const names[] = {"none", "timer", "oneshot"};
+    return names[trigger];
+}
+
+// 属性路径在栈上拼接，sysfs 设置路径上不申请堆内存
+constexpr std::size_t ATTR_PATH_MAX = 256;
+
+// 打开 <dir>/<attr>，路径超长时返回 -1（errno 为 ENAMETOOLONG）
+int openAttr(const char *dir, const char *attr, int flags)
 {
-    dev_path_ = "/dev/" + dev_name_;
+    char path[ATTR_PATH_MAX];
+    int len = std::snprintf(path, sizeof(path), "%s/%s", dir, attr);
+    if (len < 0 || static_cast<std::size_t>(len) >= sizeof(path))
+    {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    return open(path, flags | O_CLOEXEC);
+}
+
+// 读取一个小的 sysfs 属性（如 max_brightness）到 buf，失败时 buf 为空串
+void readAttrFile(const char *dir, const char *attr, char *buf, std::size_t size)
+{
+    buf[0] = '\0';
+    int fd = openAttr(dir, attr, O_RDONLY);
+    if (fd < 0)
+    {
+        return;
+    }
+    ssize_t n = pread(fd, buf, size - 1, 0);
+    close(fd);
+    buf[n > 0 ? n : 0] = '\0';
+}
+
+bool writeAll(int fd, const char *data, std::size_t len)
+{
+    // sysfs 属性每次写入都从头解析，偏移固定为 0
+    return pwrite(fd, data, len, 0) == static_cast<ssize_t>(len);
+}
+
+} // namespace
+
+Led::Led(const std::string &dev_name)
+    : Device(dev_name), type(LedBackend::Ioctl), maxLevel(1), triggerFd(-1), shotFd(-1), trigger(Trigger::None)
+{
+    detectBackend();
+
+    // 没有 /dev/<name> 时按标准 LED 子系统的同名设备处理
+    struct stat st;
+    std::string classDir = "/sys/class/leds/" + dev_name;
+    if (type == LedBackend::Ioctl && access(devPath.c_str(), F_OK) != 0 && stat(classDir.c_str(), &st) == 0 &&
+        S_ISDIR(st.st_mode))
+    {
+        devPath = classDir;
+        detectBackend();
+    }
+}
+
+Led::Led(const DeviceEntry &entry)
+    : Device(entry), type(LedBackend::Ioctl), maxLevel(1), triggerFd(-1), shotFd(-1), trigger(Trigger::None)
+{
+    detectBackend();
+}
+
+Led Led::sysfs(const std::string &name, const std::string &root)
+{
+    std::string path = root + "/" + name;
+    return Led(makeDeviceEntry(DeviceType::Led, name.c_str(), path.c_str()));
 }
 
 Led::~Led()
 {
-    cleanup();
+    closeSysfs();
 }
 
 Led::Led(Led &&other) noexcept
-    : dev_name_(std::move(other.dev_name_)), dev_path_(std::move(other.dev_path_)), fd_(other.fd_),
-      initialized_(other.initialized_)
+    : Device(std::move(other)), type(other.type), sysfsDir(std::move(other.sysfsDir)), maxLevel(other.maxLevel),
+      triggerFd(other.triggerFd), shotFd(other.shotFd), trigger(other.trigger)
 {
-    other.fd_ = -1;
-    other.initialized_ = false;
+    other.triggerFd = -1;
+    other.shotFd = -1;
 }
 
 Led &Led::operator=(Led &&other) noexcept
 {
     if (this != &other)
     {
-        cleanup();
-        dev_name_ = std::move(other.dev_name_);
-        dev_path_ = std::move(other.dev_path_);
-        fd_ = other.fd_;
-        initialized_ = other.initialized_;
-        other.fd_ = -1;
-        other.initialized_ = false;
+        closeSysfs();
+        Device::operator=(std::move(other));
+        type = other.type;
+        sysfsDir = std::move(other.sysfsDir);
+        maxLevel = other.maxLevel;
+        triggerFd = other.triggerFd;
+        shotFd = other.shotFd;
+        trigger = other.trigger;
+        other.triggerFd = -1;
+        other.shotFd = -1;
     }
     return *this;
 }
 
-ErrorCode Led::init()
+void Led::detectBackend()
 {
-    if (initialized_)
+    struct stat st;
+    const std::size_t suffixLen = sizeof(BRIGHTNESS_SUFFIX) - 1;
+    if (stat(devPath.c_str(), &st) == 0 && S_ISDIR(st.st_mode))
+    {
+        sysfsDir = devPath;
+        devPath += BRIGHTNESS_SUFFIX;
+        type = LedBackend::Sysfs;
+    }
+    else if (devPath.size() > suffixLen &&
+             std::strcmp(devPath.c_str() + devPath.size() - suffixLen, BRIGHTNESS_SUFFIX) == 0)
+    {
+        sysfsDir.assign(devPath.c_str(), devPath.size() - suffixLen);
+        type = LedBackend::Sysfs;
+    }
+}
+
+ErrorCode Led::onOpen()
+{
+    if (type != LedBackend::Sysfs)
     {
-        spdlog::warn("Device {} already initialized", dev_name_);
         return ErrorCode::Ok;
     }
 
-    // 打开设备节点
-    fd_ = open(dev_path_.c_str(), O_RDWR);
-    if (fd_ < 0)
+    char max[32];
+    readAttrFile(sysfsDir.c_str(), "max_brightness", max, sizeof(max));
+    maxLevel = max[0] == '\0' ? 1 : std::atoi(max);
+    if (maxLevel <= 0)
     {
-        spdlog::error("open {} failed", dev_path_);
-        return ErrorCode::DevOpen;
+        spdlog::error("invalid max_brightness for {}: {}", devName.c_str(), max);
+        return ErrorCode::DevIo;
     }
 
-    initialized_ = true;
-    spdlog::info("init {} success", dev_name_);
+    // 没有 trigger 属性时只能设置亮度，闪烁接口返回 Unsupported
+    triggerFd = openAttr(sysfsDir.c_str(), "trigger", O_RDWR);
+    trigger = Trigger::None;
+    spdlog::debug("{}: sysfs LED, max_brightness {}, trigger {}", devName.c_str(), maxLevel,
+                  triggerFd >= 0 ? "available" : "unavailable");
     return ErrorCode::Ok;
 }
 
+void Led::closeSysfs()
+{
+    if (shotFd >= 0)
+    {
+        close(shotFd);
+        shotFd = -1;
+    }
+    if (triggerFd >= 0)
+    {
+        close(triggerFd);
+        triggerFd = -1;
+    }
+}
+
 ErrorCode Led::setState(bool on)
 {
-    if (!initialized_ || fd_ < 0)
+    BSP_TRACE_SCOPE("Led::setState");
+    MetricsTimer timer(MetricOp::LedSetState);
+
+    if (!isReady())
     {
-        spdlog::error("{} not ready (not initialized)", dev_name_);
-        return ErrorCode::DevNotReady;
+        spdlog::error("{} not ready (not initialized)", devName.c_str());
+        return timer.finish(ErrorCode::DevNotReady);
+    }
+
+    if (type == LedBackend::Sysfs)
+    {
+        std::lock_guard<std::mutex> lock(sysfsMutex);
+        return timer.finish(writeBrightness(on ? maxLevel : 0));
     }
 
-    // 写入状态
+    // 写入状态（一次 ioctl，无需加锁）
     int ret = 1;
     if (on)
-        ret = ioctl(this->fd_, LED_ON);
+        ret = ioctl(this->fd, LED_ON);
     else
-        ret = ioctl(this->fd_, LED_OFF);
+        ret = ioctl(this->fd, LED_OFF);
     if (ret == -1)
     {
-        spdlog::error("set {} state failed (on={})", dev_name_, on);
-        return ErrorCode::DevIo;
+        spdlog::error("set {} state failed (on={})", devName.c_str(), on);
+        return timer.finish(ErrorCode::DevIo);
     }
 
-    spdlog::debug("set {} to {}", dev_name_, on ? "on" : "off");
-    return ErrorCode::Ok;
+    spdlog::debug("set {} to {}", devName.c_str(), on ? "on" : "off");
+    return timer.finish(ErrorCode::Ok);
 }
 
 ErrorCode Led::turnOn()
@@ -96,24 +219,210 @@ ErrorCode Led::turnOff()
     return setState(false);
 }
 
-bool Led::isReady() const
+ErrorCode Led::setBrightness(int level)
+{
+    if (!isReady())
+    {
+        spdlog::error("{} not ready (not initialized)", devName.c_str());
+        return ErrorCode::DevNotReady;
+    }
+    if (level < 0 || level > maxLevel)
+    {
+        spdlog::error("{} brightness {} out of range 0~{}", devName.c_str(), level, maxLevel);
+        return ErrorCode::InvalidParam;
+    }
+    if (type == LedBackend::Ioctl)
+    {
+        return setState(level != 0);
+    }
+
+    BSP_TRACE_SCOPE("Led::setState");
+    MetricsTimer timer(MetricOp::LedSetState);
+    std::lock_guard<std::mutex> lock(sysfsMutex);
+    return timer.finish(writeBrightness(level));
+}
+
+ErrorCode Led::writeBrightness(int level)
 {
-    return initialized_ && fd_ >= 0;
+    // 触发器运行时写 brightness 只改变闪烁亮度，先停止触发器
+    if (trigger != Trigger::None)
+    {
+        ErrorCode result = selectTrigger(Trigger::None);
+        if (result != ErrorCode::Ok)
+        {
+            return result;
+        }
+    }
+
+    char buf[16];
+    int len = std::snprintf(buf, sizeof(buf), "%d", level);
+    if (!writeAll(fd, buf, static_cast<std::size_t>(len)))
+    {
+        spdlog::error("set {} brightness {} failed: {}", devName.c_str(), level, std::strerror(errno));
+        return ErrorCode::DevIo;
+    }
+    spdlog::debug("set {} brightness to {}", devName.c_str(), level);
+    return ErrorCode::Ok;
 }
 
-std::string Led::getDeviceName() const
+int Led::maxBrightness() const
 {
-    return dev_name_;
+    return maxLevel;
 }
 
-void Led::cleanup()
+ErrorCode Led::selectTrigger(Trigger next)
 {
-    if (fd_ >= 0)
+    if (type != LedBackend::Sysfs || triggerFd < 0)
+    {
+        return ErrorCode::Unsupported;
+    }
+    if (shotFd >= 0)
+    {
+        close(shotFd);
+        shotFd = -1;
+    }
+
+    const char *name = triggerName(static_cast<int>(next));
+    if (!writeAll(triggerFd, name, std::strlen(name)))
+    {
+        // 内核没有编译该触发器时返回 EINVAL
+        int err = errno;
+        spdlog::error("set {} trigger {} failed: {}", devName.c_str(), name, std::strerror(err));
+        trigger = Trigger::None;
+        return err == EINVAL ? ErrorCode::Unsupported : ErrorCode::DevIo;
+    }
+    trigger = next;
+    return ErrorCode::Ok;
+}
+
+ErrorCode Led::writeAttr(const char *attr, unsigned value)
+{
+    // delay_on / delay_off 等属性在切换触发器后才由内核创建，不能在 init() 时打开
+    int attrFd = openAttr(sysfsDir.c_str(), attr, O_WRONLY);
+    if (attrFd < 0)
+    {
+        spdlog::error("open {}/{} failed: {}", sysfsDir.c_str(), attr, std::strerror(errno));
+        return ErrorCode::DevIo;
+    }
+    char buf[16];
+    int len = std::snprintf(buf, sizeof(buf), "%u", value);
+    bool ok = writeAll(attrFd, buf, static_cast<std::size_t>(len));
+    close(attrFd);
+    if (!ok)
+    {
+        spdlog::error("write {}/{} = {} failed: {}", sysfsDir.c_str(), attr, value, std::strerror(errno));
+        return ErrorCode::DevIo;
+    }
+    return ErrorCode::Ok;
+}
+
+ErrorCode Led::blink(unsigned onMs, unsigned offMs)
+{
+    if (!isReady())
+    {
+        spdlog::error("{} not ready (not initialized)", devName.c_str());
+        return ErrorCode::DevNotReady;
+    }
+
+    std::lock_guard<std::mutex> lock(sysfsMutex);
+    ErrorCode result = selectTrigger(Trigger::Timer);
+    if (result == ErrorCode::Ok)
+    {
+        result = writeAttr("delay_on", onMs);
+    }
+    if (result == ErrorCode::Ok)
+    {
+        result = writeAttr("delay_off", offMs);
+    }
+    if (result == ErrorCode::Ok)
+    {
+        spdlog::debug("{} blinking {}/{} ms", devName.c_str(), onMs, offMs);
+    }
+    return result;
+}
+
+ErrorCode Led::setOneShot(unsigned onMs, unsigned offMs, bool invert)
+{
+    if (!isReady())
+    {
+        spdlog::error("{} not ready (not initialized)", devName.c_str());
+        return ErrorCode::DevNotReady;
+    }
+
+    std::lock_guard<std::mutex> lock(sysfsMutex);
+    ErrorCode result = selectTrigger(Trigger::OneShot);
+    if (result == ErrorCode::Ok)
+    {
+        result = writeAttr("delay_on", onMs);
+    }
+    if (result == ErrorCode::Ok)
+    {
+        result = writeAttr("delay_off", offMs);
+    }
+    if (result == ErrorCode::Ok)
+    {
+        result = writeAttr("invert", invert ? 1u : 0u);
+    }
+    if (result != ErrorCode::Ok)
+    {
+        return result;
+    }
+
+    shotFd = openAttr(sysfsDir.c_str(), "shot", O_WRONLY);
+    if (shotFd < 0)
+    {
+        spdlog::error("open {}/shot failed: {}", sysfsDir.c_str(), std::strerror(errno));
+        return ErrorCode::DevIo;
+    }
+    return ErrorCode::Ok;
+}
+
+ErrorCode Led::shot()
+{
+    std::lock_guard<std::mutex> lock(sysfsMutex);
+    if (shotFd < 0)
+    {
+        spdlog::error("{} oneshot trigger not configured", devName.c_str());
+        return ErrorCode::DevNotReady;
+    }
+    BSP_TRACE_SCOPE("Led::setState");
+    MetricsTimer timer(MetricOp::LedSetState);
+    if (!writeAll(shotFd, "1", 1))
+    {
+        spdlog::error("{} shot failed: {}", devName.c_str(), std::strerror(errno));
+        return timer.finish(ErrorCode::DevIo);
+    }
+    return timer.finish(ErrorCode::Ok);
+}
+
+ErrorCode Led::stopTrigger()
+{
+    if (!isReady())
+    {
+        spdlog::error("{} not ready (not initialized)", devName.c_str());
+        return ErrorCode::DevNotReady;
+    }
+    std::lock_guard<std::mutex> lock(sysfsMutex);
+    return selectTrigger(Trigger::None);
+}
+
+LedBackend Led::backend() const
+{
+    return type;
+}
+
+ErrorCode Led::queueSetState(IoRing &ring, bool on, uint64_t userData)
+{
+    if (!isReady())
+    {
+        spdlog::error("{} not ready (not initialized)", devName.c_str());
+        return ErrorCode::DevNotReady;
+    }
+    if (type == LedBackend::Sysfs)
     {
-        close(fd_);
-        fd_ = -1;
+        return ErrorCode::Unsupported;
     }
-    initialized_ = false;
+    return ring.queueIoctl(fd, on ? LED_ON : LED_OFF, userData);
 }
 
 } // namespace bsp
@@ -2,8 +2,10 @@
 #define LED_H
 
 #include <string>
+#include <mutex>
+#include <fcntl.h>
 #include <sys/ioctl.h> //ioctl() 声明和 _IO 系列宏
-#include "../../common/bsp_common.h"
+#include "../device.h"
 
 namespace bsp
 {
@@ -12,39 +14,69 @@ namespace bsp
 #define LED_ON    _IO(LED_MAGIC, 0)
 #define LED_OFF   _IO(LED_MAGIC, 1)
 
+/**
+ * @brief LED 设备特性
+ */
+struct LedTraits
+{
+    static constexpr int OPEN_FLAGS = O_RDWR;
+
+    static const char *initTraceName()
+    {
+        return "Led::init";
+    }
+};
+
+/**
+ * @brief LED 实际使用的后端
+ */
+enum class LedBackend
+{
+    Ioctl, // 自定义字符设备 /dev/<name>，LED_ON / LED_OFF ioctl
+    Sysfs  // 标准 LED 子系统 /sys/class/leds/<name>/，写 brightness / trigger 属性
+};
+
 /**
  * @brief LED 设备类
  *
- * 用于控制 LED 设备的打开和关闭
+ * 用于控制 LED 设备的打开和关闭。init()/isReady() 等接口由 Device 基类提供。
+ *
+ * 设备路径是目录（如 /sys/class/leds/led0）或以 /brightness 结尾时使用 sysfs 后端：
+ * init() 打开 brightness 并一直保持打开，之后每次设置只是一次 pwrite()；闪烁交给内核
+ * timer / oneshot 触发器，闪烁期间没有用户态线程被唤醒。
+ *
+ * 所有接口可在多个线程中并发调用：ioctl 后端每次设置是一次无锁的 ioctl()；sysfs 后端
+ * 的触发器切换涉及多个属性，设置在同一实例上串行执行。
  */
-class Led
+class Led : public Device<Led, LedTraits>
 {
 public:
     /**
      * @brief 构造函数
-     * @param dev_name LED 设备名（如 "led0"，对应 /dev/led0）
+     * @param dev_name LED 设备名（如 "led0"，对应 /dev/led0；/dev/led0 不存在而
+     *                 /sys/class/leds/led0 存在时使用 sysfs 后端）
      */
     explicit Led(const std::string &dev_name);
 
     /**
-     * @brief 析构函数，自动释放资源
+     * @brief 从板级设备表项构造（直接使用表中已拼好的设备路径）
+     * @param entry 设备表项，如 table.entry(handle)
      */
-    ~Led();
+    explicit Led(const DeviceEntry &entry);
+
+    /**
+     * @brief 构造 sysfs 后端的 LED
+     * @param name LED 类设备名（如 "sys-led"、"green:status"）
+     * @param root LED 类目录
+     */
+    static Led sysfs(const std::string &name, const std::string &root = "/sys/class/leds");
 
-    // 禁止拷贝构造和赋值
-    Led(const Led &) = delete;
-    Led &operator=(const Led &) = delete;
+    ~Led();
 
-    // 允许移动构造和赋值
+    // 允许移动构造和赋值（析构时自动关闭设备）
     Led(Led &&other) noexcept;
     Led &operator=(Led &&other) noexcept;
 
-    /**
-     * @brief 初始化 LED 设备
-     * @return ErrorCode::Ok 成功，其他错误码失败
-     */
-    ErrorCode init();
-
     /**
      * @brief 设置 LED 状态
      * @param on 状态（true-打开，false-关闭）
@@ -65,24 +97,83 @@ public:
     ErrorCode turnOff();
 
     /**
-     * @brief 检查设备是否已初始化
-     * @return true 已初始化，false 未初始化
+     * @brief 设置亮度等级（sysfs 后端先停止触发器；ioctl 后端只区分 0 和非 0）
+     * @param level 0 ~ maxBrightness()
+     * @return ErrorCode::Ok 成功；InvalidParam 超出范围；DevNotReady 未初始化；DevIo 写入失败
      */
-    bool isReady() const;
+    ErrorCode setBrightness(int level);
 
     /**
-     * @brief 获取设备名
-     * @return 设备名字符串
+     * @brief 最大亮度等级（sysfs 后端读自 max_brightness，ioctl 后端为 1；init() 之后有效）
      */
-    std::string getDeviceName() const;
+    int maxBrightness() const;
 
-private:
-    std::string dev_name_;
-    std::string dev_path_;
-    int fd_;
-    bool initialized_;
+    /**
+     * @brief 由内核 timer 触发器周期闪烁，直到下一次 setState()/setBrightness()/stopTrigger()
+     * @param onMs 亮的时间(ms)
+     * @param offMs 灭的时间(ms)
+     * @return ErrorCode::Ok 成功；Unsupported ioctl 后端或内核没有 timer 触发器；DevIo 写入失败
+     */
+    ErrorCode blink(unsigned onMs, unsigned offMs);
 
-    void cleanup();
+    /**
+     * @brief 切换到内核 oneshot 触发器，之后每次 shot() 闪一次
+     * @param onMs 亮的时间(ms)
+     * @param offMs 灭的时间(ms)，期间的 shot() 被忽略
+     * @param invert true 时平时亮、闪一次为灭
+     * @return ErrorCode::Ok 成功；Unsupported ioctl 后端或内核没有 oneshot 触发器；DevIo 写入失败
+     */
+    ErrorCode setOneShot(unsigned onMs, unsigned offMs, bool invert = false);
+
+    /**
+     * @brief 触发一次 oneshot 闪烁（一次 pwrite，shot 属性在 setOneShot() 时已打开）
+     * @return ErrorCode::Ok 成功；DevNotReady 未调用 setOneShot()；DevIo 写入失败
+     */
+    ErrorCode shot();
+
+    /**
+     * @brief 停止内核触发器（trigger 写 none），LED 保持关闭
+     */
+    ErrorCode stopTrigger();
+
+    /**
+     * @brief 当前使用的后端
+     */
+    LedBackend backend() const;
+
+    /**
+     * @brief 把一次状态设置排入批量 I/O 队列（ioctl 在 ring.submit() 时执行）
+     * @param ring 已 init() 的批量 I/O 队列
+     * @param on 状态（true-打开，false-关闭）
+     * @param userData 完成结果中的标识，用 completionResult(c, 0) 检查
+     * @return ErrorCode::Ok 已排入；DevNotReady 设备未初始化；Unsupported sysfs 后端
+     */
+    ErrorCode queueSetState(IoRing &ring, bool on, uint64_t userData);
+
+private:
+    friend class Device<Led, LedTraits>;
+
+    enum class Trigger
+    {
+        None,
+        Timer,
+        OneShot
+    };
+
+    ErrorCode onOpen(); // sysfs 后端：读取 max_brightness 并打开 trigger
+    void detectBackend();
+    void closeSysfs();
+    ErrorCode writeBrightness(int level);
+    ErrorCode selectTrigger(Trigger trigger);
+    ErrorCode writeAttr(const char *attr, unsigned value);
+
+    LedBackend type;
+    DevicePath sysfsDir; // sysfs 后端的 LED 目录
+    int maxLevel;
+    int triggerFd; // 保持打开的 trigger 属性
+    int shotFd;    // oneshot 触发器的 shot 属性
+    Trigger trigger;
+    std::mutex sysfsMutex; // 串行化 sysfs 后端的亮度/触发器设置（保护 trigger、shotFd）
 };
 
 } // namespace bsp
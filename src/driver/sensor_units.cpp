@@ -0,0 +1,80 @@
+#include "sensor_units.h"
+#include <cmath>
+
+namespace bsp
+{
+
+constexpr int LinearCalibration::GAIN_SHIFT;
+constexpr int32_t LinearCalibration::UNITY_GAIN;
+constexpr int32_t UnitConverter<AP3216CData>::ALS_MILLILUX_PER_COUNT;
+
+LinearCalibration LinearCalibration::fromFloat(float gain, float offset)
+{
+    return LinearCalibration(static_cast<int32_t>(std::lround(static_cast<double>(gain) * UNITY_GAIN)),
+                             static_cast<int32_t>(std::lround(static_cast<double>(offset) * 1000.0)));
+}
+
+// 批量转换：循环体无分支、无函数调用，本文件单独开启 -ftree-vectorize（见 CMakeLists），
+// 定点路径在 Cortex-A7 上展开为 NEON 指令；未校准（单位校准）的设备走不含 64 位乘法的循环。ARMv7 NEON 浮点不完全符合 IEEE，GCC 不会在
+// 未开启 -funsafe-math-optimizations 时向量化浮点路径，这里有意保持逐位精确的标量结果。
+
+void UnitConverter<AP3216CData>::convert(const AP3216CData *in, std::size_t count, Fixed *out) const
+{
+    const LinearCalibration als = cal.als;
+    if (als.isIdentity())
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out[i].illuminance.milli = alsMilliLux(in[i].als);
+            out[i].ps = in[i].ps;
+            out[i].ir = in[i].ir;
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i].illuminance.milli = als.apply(alsMilliLux(in[i].als));
+        out[i].ps = in[i].ps;
+        out[i].ir = in[i].ir;
+    }
+}
+
+void UnitConverter<AP3216CData>::convert(const AP3216CData *in, std::size_t count, Float *out) const
+{
+    // 与 toFloat() 逐样本使用相同的运算顺序，保证批量与单样本结果逐位一致
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = toFloat(in[i]);
+    }
+}
+
+void UnitConverter<DHT11Data>::convert(const DHT11Data *in, std::size_t count, Fixed *out) const
+{
+    const LinearCalibration humidity = cal.humidity;
+    const LinearCalibration temperature = cal.temperature;
+    if (humidity.isIdentity() && temperature.isIdentity())
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out[i].humidity.milli = humidityMilli(in[i].humidity_int, in[i].humidity_decimal);
+            out[i].temperature.milli = temperatureMilli(in[i].temperature_int, in[i].temperature_decimal);
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i].humidity.milli = humidity.apply(humidityMilli(in[i].humidity_int, in[i].humidity_decimal));
+        out[i].temperature.milli =
+            temperature.apply(temperatureMilli(in[i].temperature_int, in[i].temperature_decimal));
+    }
+}
+
+void UnitConverter<DHT11Data>::convert(const DHT11Data *in, std::size_t count, Float *out) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = toFloat(in[i]);
+    }
+}
+
+} // namespace bsp
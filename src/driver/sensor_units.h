@@ -0,0 +1,302 @@
+#ifndef BSP_SENSOR_UNITS_H
+#define BSP_SENSOR_UNITS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "ap3216c/ap3216c.h"
+#include "dht11/dht11.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 物理单位标签
+ */
+struct Lux
+{
+    static const char *symbol()
+    {
+        return "lx";
+    }
+};
+
+struct PercentRH
+{
+    static const char *symbol()
+    {
+        return "%RH";
+    }
+};
+
+struct Celsius
+{
+    static const char *symbol()
+    {
+        return "C";
+    }
+};
+
+/**
+ * @brief 定点物理量：以 1/1000 单位存储的 int32（如 MilliUnit<Celsius>{-2500} 表示 -2.5 C）
+ *
+ * 单位作为模板参数，不同单位之间不能混用
+ */
+template <typename Unit> struct MilliUnit
+{
+    int32_t milli;
+
+    float toFloat() const
+    {
+        return static_cast<float>(milli) / 1000.0f;
+    }
+};
+
+template <typename Unit> inline bool operator==(MilliUnit<Unit> a, MilliUnit<Unit> b)
+{
+    return a.milli == b.milli;
+}
+
+template <typename Unit> inline bool operator!=(MilliUnit<Unit> a, MilliUnit<Unit> b)
+{
+    return a.milli != b.milli;
+}
+
+using MilliLux = MilliUnit<Lux>;
+using MilliPercentRH = MilliUnit<PercentRH>;
+using MilliCelsius = MilliUnit<Celsius>;
+
+/**
+ * @brief 线性校准系数：calibrated = raw * gain + offset
+ *
+ * 增益以 Q16 定点存储，定点和浮点两条路径使用同一组系数，结果一致（浮点路径
+ * 不做舍入）。定点路径按四舍五入（.5 向正无穷）取整到 1/1000 单位。
+ */
+struct LinearCalibration
+{
+    static constexpr int GAIN_SHIFT = 16;
+    static constexpr int32_t UNITY_GAIN = 1 << GAIN_SHIFT;
+
+    int32_t gainQ16;     // 增益（Q16，65536 表示 1.0）
+    int32_t offsetMilli; // 偏移（1/1000 单位）
+
+    constexpr LinearCalibration() : gainQ16(UNITY_GAIN), offsetMilli(0)
+    {
+    }
+
+    constexpr LinearCalibration(int32_t gainQ16, int32_t offsetMilli) : gainQ16(gainQ16), offsetMilli(offsetMilli)
+    {
+    }
+
+    /**
+     * @brief 从浮点系数构造（增益按 Q16 四舍五入）
+     * @param gain 增益
+     * @param offset 偏移（物理单位）
+     */
+    static LinearCalibration fromFloat(float gain, float offset);
+
+    constexpr bool isIdentity() const
+    {
+        return gainQ16 == UNITY_GAIN && offsetMilli == 0;
+    }
+
+    constexpr int32_t apply(int32_t milli) const
+    {
+        return static_cast<int32_t>(
+                   (static_cast<int64_t>(milli) * gainQ16 + (static_cast<int64_t>(1) << (GAIN_SHIFT - 1))) >>
+                   GAIN_SHIFT) +
+               offsetMilli;
+    }
+
+    float apply(float value) const
+    {
+        return value * (static_cast<float>(gainQ16) / static_cast<float>(UNITY_GAIN)) +
+               static_cast<float>(offsetMilli) / 1000.0f;
+    }
+};
+
+/**
+ * @brief 单个样本的原始值 -> 物理单位转换（主模板不定义，按传感器数据类型特化）
+ *
+ * 每个特化提供：
+ * - Calibration：该传感器的校准系数（每个设备一份，默认为单位校准）
+ * - Fixed / Float：定点 / 浮点结果类型
+ * - toFixed() / toFloat()：单样本转换（内联）
+ * - convert()：批量转换样本数组（库内单独编译并开启自动向量化）
+ */
+template <typename Data> class UnitConverter;
+
+/**
+ * @brief AP3216C 转换结果（定点）：环境光换算为照度，PS/IR 无物理单位，保留原始计数
+ */
+struct AP3216CReading
+{
+    MilliLux illuminance;
+    uint16_t ps;
+    uint16_t ir;
+};
+
+struct AP3216CReadingF
+{
+    float lux;
+    uint16_t ps;
+    uint16_t ir;
+};
+
+struct AP3216CCalibration
+{
+    LinearCalibration als;
+};
+
+template <> class UnitConverter<AP3216CData>
+{
+public:
+    using Fixed = AP3216CReading;
+    using Float = AP3216CReadingF;
+    using Calibration = AP3216CCalibration;
+
+    // 驱动使用默认量程（0~20661 lux），分辨率 0.35 lux/count
+    static constexpr int32_t ALS_MILLILUX_PER_COUNT = 350;
+
+    /**
+     * @brief 原始 ALS 计数 -> 未校准照度（1/1000 lux）
+     */
+    static constexpr int32_t alsMilliLux(uint16_t als)
+    {
+        return static_cast<int32_t>(als) * ALS_MILLILUX_PER_COUNT;
+    }
+
+    explicit UnitConverter(const Calibration &calibration = Calibration()) : cal(calibration)
+    {
+    }
+
+    const Calibration &calibration() const
+    {
+        return cal;
+    }
+
+    Fixed toFixed(const AP3216CData &data) const
+    {
+        Fixed out;
+        out.illuminance.milli = cal.als.apply(alsMilliLux(data.als));
+        out.ps = data.ps;
+        out.ir = data.ir;
+        return out;
+    }
+
+    Float toFloat(const AP3216CData &data) const
+    {
+        Float out;
+        out.lux = cal.als.apply(static_cast<float>(alsMilliLux(data.als)) / 1000.0f);
+        out.ps = data.ps;
+        out.ir = data.ir;
+        return out;
+    }
+
+    /**
+     * @brief 批量转换
+     * @param in 原始样本数组
+     * @param count 样本数
+     * @param out 输出数组（至少 count 个元素，不可与 in 重叠）
+     */
+    void convert(const AP3216CData *in, std::size_t count, Fixed *out) const;
+    void convert(const AP3216CData *in, std::size_t count, Float *out) const;
+
+private:
+    Calibration cal;
+};
+
+/**
+ * @brief DHT11 转换结果（定点）
+ */
+struct DHT11Reading
+{
+    MilliPercentRH humidity;
+    MilliCelsius temperature;
+};
+
+struct DHT11ReadingF
+{
+    float humidity;
+    float temperature;
+};
+
+struct DHT11Calibration
+{
+    LinearCalibration humidity;
+    LinearCalibration temperature;
+};
+
+template <> class UnitConverter<DHT11Data>
+{
+public:
+    using Fixed = DHT11Reading;
+    using Float = DHT11ReadingF;
+    using Calibration = DHT11Calibration;
+
+    /**
+     * @brief 整数/小数字节 -> 未校准湿度（1/1000 %RH），小数字节单位为 0.1
+     */
+    static constexpr int32_t humidityMilli(uint8_t integer, uint8_t decimal)
+    {
+        return static_cast<int32_t>(integer) * 1000 + static_cast<int32_t>(decimal) * 100;
+    }
+
+    /**
+     * @brief 整数/小数字节 -> 未校准温度（1/1000 C），处理小数字节中的符号位
+     *
+     * 温度小数字节的最高位为符号位（零下温度），低 7 位为 0.1 C。用 (v ^ -s) + s 取负，不含分支，便于批量转换向量化
+     */
+    static constexpr int32_t temperatureMilli(uint8_t integer, uint8_t decimal)
+    {
+        return ((static_cast<int32_t>(integer) * 1000 + static_cast<int32_t>(decimal & 0x7f) * 100) ^
+                -static_cast<int32_t>(decimal >> 7)) +
+               static_cast<int32_t>(decimal >> 7);
+    }
+
+    explicit UnitConverter(const Calibration &calibration = Calibration()) : cal(calibration)
+    {
+    }
+
+    const Calibration &calibration() const
+    {
+        return cal;
+    }
+
+    Fixed toFixed(const DHT11Data &data) const
+    {
+        Fixed out;
+        out.humidity.milli = cal.humidity.apply(humidityMilli(data.humidity_int, data.humidity_decimal));
+        out.temperature.milli =
+            cal.temperature.apply(temperatureMilli(data.temperature_int, data.temperature_decimal));
+        return out;
+    }
+
+    Float toFloat(const DHT11Data &data) const
+    {
+        Float out;
+        out.humidity =
+            cal.humidity.apply(static_cast<float>(humidityMilli(data.humidity_int, data.humidity_decimal)) / 1000.0f);
+        out.temperature = cal.temperature.apply(
+            static_cast<float>(temperatureMilli(data.temperature_int, data.temperature_decimal)) / 1000.0f);
+        return out;
+    }
+
+    /**
+     * @brief 批量转换
+     * @param in 原始样本数组
+     * @param count 样本数
+     * @param out 输出数组（至少 count 个元素，不可与 in 重叠）
+     */
+    void convert(const DHT11Data *in, std::size_t count, Fixed *out) const;
+    void convert(const DHT11Data *in, std::size_t count, Float *out) const;
+
+private:
+    Calibration cal;
+};
+
+using AP3216CConverter = UnitConverter<AP3216CData>;
+using DHT11Converter = UnitConverter<DHT11Data>;
+
+} // namespace bsp
+
+#endif // BSP_SENSOR_UNITS_H
@@ -0,0 +1,431 @@
+#include "shm_ring.h"
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace bsp
+{
+
+constexpr uint32_t ShmPublisher::DEFAULT_SLOTS;
+
+namespace
+{
+
+// 共享内存中的原子变量必须免锁，才能在进程间按地址共享
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "std::atomic<uint32_t> must be lock-free for shared memory");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "unexpected std::atomic<uint32_t> layout");
+static_assert(sizeof(ShmSample) % sizeof(uint32_t) == 0, "ShmSample must be a whole number of words");
+
+constexpr uint32_t SHM_MAGIC = 0x42535052; // "BSPR"
+constexpr uint32_t SHM_VERSION = 1;
+constexpr std::size_t CACHE_LINE = 64;
+constexpr std::size_t SAMPLE_WORDS = sizeof(ShmSample) / sizeof(uint32_t);
+
+/**
+ * @brief 共享内存头（独占一个缓存行，之后是 slotCount 个槽位）
+ */
+struct ShmHeader
+{
+    std::atomic<uint32_t> magic; // 发布者初始化完成后最后写入
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint32_t sampleSize;
+    std::atomic<uint32_t> head;    // 已发布的样本数（低 32 位），同时作为 futex 字
+    std::atomic<uint32_t> waiters; // 正在 futex 等待的订阅者数
+    std::atomic<uint32_t> closed;  // 发布者已关闭
+};
+
+/**
+ * @brief 样本槽位（独占一个缓存行，避免写当前槽位时干扰读相邻槽位的进程）
+ */
+struct ShmSlot
+{
+    std::atomic<uint32_t> seq; // seqlock 序号，写入期间为奇数
+    std::atomic<uint32_t> words[SAMPLE_WORDS];
+};
+
+static_assert(sizeof(ShmHeader) <= CACHE_LINE, "ShmHeader must fit in one cache line");
+static_assert(sizeof(ShmSlot) <= CACHE_LINE, "ShmSlot must fit in one cache line");
+
+std::size_t mappingSize(uint32_t slots)
+{
+    return CACHE_LINE + static_cast<std::size_t>(slots) * CACHE_LINE;
+}
+
+ShmHeader *headerOf(void *base)
+{
+    return static_cast<ShmHeader *>(base);
+}
+
+ShmSlot *slotOf(void *base, uint32_t index, uint32_t slots)
+{
+    return reinterpret_cast<ShmSlot *>(static_cast<char *>(base) + CACHE_LINE + (index & (slots - 1)) * CACHE_LINE);
+}
+
+std::string shmName(const std::string &name)
+{
+    return (!name.empty() && name[0] == '/') ? name : "/" + name;
+}
+
+uint64_t monotonicNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+// 跨进程 futex（不能使用 FUTEX_PRIVATE_FLAG）
+int futexWait(std::atomic<uint32_t> *word, uint32_t expected, const timespec *timeout)
+{
+    return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, expected, timeout,
+                                    nullptr, 0));
+}
+
+void futexWakeAll(std::atomic<uint32_t> *word)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+} // namespace
+
+ShmPublisher::ShmPublisher(const std::string &name, uint32_t slots)
+    : name(shmName(name)), slotCount(slots), base(nullptr), mapSize(0), count(0)
+{
+}
+
+ShmPublisher::~ShmPublisher()
+{
+    close();
+}
+
+ErrorCode ShmPublisher::open()
+{
+    if (base != nullptr)
+    {
+        return ErrorCode::Ok;
+    }
+    if (name.size() < 2 || name.find('/', 1) != std::string::npos || slotCount < 2 ||
+        (slotCount & (slotCount - 1)) != 0)
+    {
+        spdlog::error("invalid shared memory ring {} with {} slots", name, slotCount);
+        return ErrorCode::InvalidParam;
+    }
+
+    // 删除上次运行遗留的共享内存：旧订阅者继续持有旧映射，不会读到新环中的半初始化数据
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+    {
+        spdlog::error("failed to create shared memory {}: {}", name, std::strerror(errno));
+        return ErrorCode::DevOpen;
+    }
+    std::size_t size = mappingSize(slotCount);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        spdlog::error("failed to size shared memory {}: {}", name, std::strerror(errno));
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return ErrorCode::DevOpen;
+    }
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+    {
+        spdlog::error("failed to map shared memory {}: {}", name, std::strerror(errno));
+        shm_unlink(name.c_str());
+        return ErrorCode::DevOpen;
+    }
+
+    // ftruncate 后内容全为 0：槽位序号为偶数、head 为 0，只需填写布局并最后写入 magic
+    ShmHeader *header = headerOf(addr);
+    header->version = SHM_VERSION;
+    header->slotCount = slotCount;
+    header->slotSize = static_cast<uint32_t>(CACHE_LINE);
+    header->sampleSize = static_cast<uint32_t>(sizeof(ShmSample));
+    header->magic.store(SHM_MAGIC, std::memory_order_release);
+
+    base = addr;
+    mapSize = size;
+    count = 0;
+    spdlog::info("shared memory ring {} ready, {} slots", name, slotCount);
+    return ErrorCode::Ok;
+}
+
+void ShmPublisher::close()
+{
+    if (base == nullptr)
+    {
+        return;
+    }
+    ShmHeader *header = headerOf(base);
+    header->closed.store(1, std::memory_order_seq_cst);
+    futexWakeAll(&header->head);
+    munmap(base, mapSize);
+    shm_unlink(name.c_str());
+    base = nullptr;
+    mapSize = 0;
+}
+
+ErrorCode ShmPublisher::publish(ShmSample &sample)
+{
+    if (base == nullptr)
+    {
+        return ErrorCode::DevNotReady;
+    }
+    if (sample.timestampNs == 0)
+    {
+        sample.timestampNs = monotonicNs();
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    ShmHeader *header = headerOf(base);
+    uint32_t index = header->head.load(std::memory_order_relaxed);
+    sample.sequence = index;
+
+    uint32_t words[SAMPLE_WORDS];
+    std::memcpy(words, &sample, sizeof(words));
+
+    // seqlock 写：序号置奇数 -> 写数据 -> 序号置偶数
+    ShmSlot *slot = slotOf(base, index, slotCount);
+    uint32_t seq = slot->seq.load(std::memory_order_relaxed);
+    slot->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < SAMPLE_WORDS; ++i)
+    {
+        slot->words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot->seq.store(seq + 2, std::memory_order_release);
+
+    // 与订阅者 wait() 中"waiters 加一后再检查 head"配对，保证不会漏掉唤醒
+    header->head.store(index + 1, std::memory_order_seq_cst);
+    if (header->waiters.load(std::memory_order_seq_cst) != 0)
+    {
+        futexWakeAll(&header->head);
+    }
+    ++count;
+    return ErrorCode::Ok;
+}
+
+ErrorCode ShmPublisher::publish(const AP3216CData &data, uint16_t device)
+{
+    ShmSample sample;
+    std::memset(&sample, 0, sizeof(sample));
+    sample.type = ShmSampleType::AP3216C;
+    sample.device = device;
+    sample.ap3216c = data;
+    return publish(sample);
+}
+
+ErrorCode ShmPublisher::publish(const DHT11Data &data, uint16_t device)
+{
+    ShmSample sample;
+    std::memset(&sample, 0, sizeof(sample));
+    sample.type = ShmSampleType::DHT11;
+    sample.device = device;
+    sample.dht11 = data;
+    return publish(sample);
+}
+
+ErrorCode ShmPublisher::publishKey(int code, int value, uint16_t device)
+{
+    ShmSample sample;
+    std::memset(&sample, 0, sizeof(sample));
+    sample.type = ShmSampleType::Key;
+    sample.device = device;
+    sample.key.code = code;
+    sample.key.value = value;
+    return publish(sample);
+}
+
+ShmSubscriber::ShmSubscriber(const std::string &name)
+    : name(shmName(name)), slotCount(0), base(nullptr), mapSize(0), next(0), lostCount(0), receivedCount(0)
+{
+}
+
+ShmSubscriber::~ShmSubscriber()
+{
+    close();
+}
+
+ErrorCode ShmSubscriber::open()
+{
+    if (base != nullptr)
+    {
+        return ErrorCode::Ok;
+    }
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        spdlog::error("failed to open shared memory {}: {}", name, std::strerror(errno));
+        return ErrorCode::DevOpen;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < mappingSize(2))
+    {
+        ::close(fd);
+        spdlog::warn("shared memory {} is not initialized yet", name);
+        return ErrorCode::DevNotReady;
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    // 订阅者也需要写权限：等待时更新 waiters
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+    {
+        spdlog::error("failed to map shared memory {}: {}", name, std::strerror(errno));
+        return ErrorCode::DevOpen;
+    }
+
+    ShmHeader *header = headerOf(addr);
+    if (header->magic.load(std::memory_order_acquire) != SHM_MAGIC)
+    {
+        munmap(addr, size);
+        spdlog::warn("shared memory {} is not initialized yet", name);
+        return ErrorCode::DevNotReady;
+    }
+    if (header->version != SHM_VERSION || header->slotSize != CACHE_LINE ||
+        header->sampleSize != sizeof(ShmSample) || mappingSize(header->slotCount) != size)
+    {
+        munmap(addr, size);
+        spdlog::error("shared memory {} layout mismatch (version {})", name, header->version);
+        return ErrorCode::Unsupported;
+    }
+
+    base = addr;
+    mapSize = size;
+    slotCount = header->slotCount;
+    next = header->head.load(std::memory_order_acquire);
+    lostCount = 0;
+    receivedCount = 0;
+    return ErrorCode::Ok;
+}
+
+void ShmSubscriber::close()
+{
+    if (base == nullptr)
+    {
+        return;
+    }
+    munmap(base, mapSize);
+    base = nullptr;
+    mapSize = 0;
+}
+
+bool ShmSubscriber::tryRead(ShmSample &sample)
+{
+    if (base == nullptr)
+    {
+        return false;
+    }
+    ShmHeader *header = headerOf(base);
+    for (;;)
+    {
+        uint32_t head = header->head.load(std::memory_order_acquire);
+        if (head == next)
+        {
+            return false;
+        }
+        // 最多保留 slotCount - 1 个未读样本：下一个要写的槽位可能正在被覆盖
+        uint32_t pending = head - next;
+        if (pending >= slotCount)
+        {
+            uint32_t skip = pending - (slotCount - 1);
+            lostCount += skip;
+            next += skip;
+        }
+
+        // seqlock 读：序号为偶数且读前读后一致才有效
+        ShmSlot *slot = slotOf(base, next, slotCount);
+        uint32_t seq = slot->seq.load(std::memory_order_acquire);
+        if (seq & 1u)
+        {
+            sched_yield(); // 发布者正在改写该槽位（已被套圈），让出 CPU 后重新计算位置
+            continue;
+        }
+        uint32_t words[SAMPLE_WORDS];
+        for (std::size_t i = 0; i < SAMPLE_WORDS; ++i)
+        {
+            words[i] = slot->words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) != seq)
+        {
+            continue;
+        }
+        std::memcpy(&sample, words, sizeof(sample));
+        if (sample.sequence != next)
+        {
+            continue; // 读取期间被套圈，重新读取 head 后跳过被覆盖的样本
+        }
+        ++next;
+        ++receivedCount;
+        return true;
+    }
+}
+
+ErrorCode ShmSubscriber::wait(ShmSample &sample, int timeoutMs)
+{
+    if (base == nullptr)
+    {
+        return ErrorCode::DevNotReady;
+    }
+    ShmHeader *header = headerOf(base);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs < 0 ? 0 : timeoutMs);
+    for (;;)
+    {
+        if (tryRead(sample))
+        {
+            return ErrorCode::Ok;
+        }
+        if (header->closed.load(std::memory_order_acquire) != 0)
+        {
+            return ErrorCode::DevNotReady;
+        }
+
+        timespec ts;
+        timespec *timeout = nullptr;
+        if (timeoutMs >= 0)
+        {
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::steady_clock::duration::zero())
+            {
+                return ErrorCode::Timeout;
+            }
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+            ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+            ts.tv_nsec = static_cast<long>(ns % 1000000000);
+            timeout = &ts;
+        }
+
+        // 先登记等待再复查 head：发布者写 head 后读 waiters，两者至少有一方看到对方
+        header->waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (header->head.load(std::memory_order_seq_cst) == next &&
+            header->closed.load(std::memory_order_seq_cst) == 0)
+        {
+            futexWait(&header->head, next, timeout);
+        }
+        header->waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+void ShmSubscriber::skipToLatest()
+{
+    if (base != nullptr)
+    {
+        next = headerOf(base)->head.load(std::memory_order_acquire);
+    }
+}
+
+} // namespace bsp
@@ -0,0 +1,217 @@
+#ifndef BSP_SHM_RING_H
+#define BSP_SHM_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "../common/bsp_common.h"
+#include "../driver/ap3216c/ap3216c.h"
+#include "../driver/dht11/dht11.h"
+
+namespace bsp
+{
+
+// 默认共享内存名（/dev/shm/bsp-samples）
+constexpr const char *DEFAULT_SHM_NAME = "/bsp-samples";
+
+/**
+ * @brief 共享内存样本类型
+ */
+enum class ShmSampleType : uint16_t
+{
+    AP3216C = 1,
+    DHT11 = 2,
+    Key = 3
+};
+
+/**
+ * @brief 按键事件（value 为内核原始值：0 释放，1 按下，2 自动重复）
+ */
+struct ShmKeyEvent
+{
+    int32_t code;
+    int32_t value;
+};
+
+/**
+ * @brief 共享内存环中的一个样本（定长，按 4 字节字拷贝）
+ */
+struct ShmSample
+{
+    uint64_t timestampNs; // 发布时刻（CLOCK_MONOTONIC，跨进程可比较）
+    uint32_t sequence;    // 发布序号（从 0 开始，32 位回绕）
+    ShmSampleType type;
+    uint16_t device; // 发布者自定义的设备编号，同类设备有多个时区分
+    union
+    {
+        AP3216CData ap3216c;
+        DHT11Data dht11;
+        ShmKeyEvent key;
+    };
+};
+
+/**
+ * @brief 共享内存样本发布者（拥有硬件的守护进程使用）
+ *
+ * 创建 POSIX 共享内存（shm_open），其中是定长样本环：每个槽位用 seqlock 保护
+ * （写入期间序号为奇数），读者无需加锁、无需系统调用即可读取；发布计数兼作 futex 字，
+ * 只有存在阻塞等待的订阅者时 publish() 才调用 FUTEX_WAKE。
+ *
+ * 环满时直接覆盖最旧的样本，发布者从不等待读者；落后超过一圈的订阅者会跳过被覆盖的样本
+ * 并计入 ShmSubscriber::lost()。同一个共享内存只能有一个发布者；publish() 在进程内线程安全
+ * （如按键事件线程与采样线程同时发布）。
+ */
+class ShmPublisher
+{
+public:
+    // 默认槽位数（必须是 2 的幂，实际可缓存 slots - 1 个样本）
+    static constexpr uint32_t DEFAULT_SLOTS = 256;
+
+    /**
+     * @brief 构造函数
+     * @param name 共享内存名（不以 '/' 开头时自动补上）
+     * @param slots 槽位数，必须是 2 的幂且不小于 2
+     */
+    explicit ShmPublisher(const std::string &name = DEFAULT_SHM_NAME, uint32_t slots = DEFAULT_SLOTS);
+
+    /**
+     * @brief 析构函数，调用 close()
+     */
+    ~ShmPublisher();
+
+    ShmPublisher(const ShmPublisher &) = delete;
+    ShmPublisher &operator=(const ShmPublisher &) = delete;
+
+    /**
+     * @brief 创建共享内存并初始化样本环（同名的旧共享内存会先被删除）
+     * @return ErrorCode::Ok 成功；InvalidParam 名称或槽位数无效；DevOpen 创建/映射失败
+     */
+    ErrorCode open();
+
+    /**
+     * @brief 标记关闭、唤醒所有等待的订阅者，解除映射并删除共享内存名
+     *
+     * 已打开的订阅者仍可读完剩余样本，之后 wait() 返回 DevNotReady
+     */
+    void close();
+
+    bool isOpen() const
+    {
+        return base != nullptr;
+    }
+
+    /**
+     * @brief 发布一个样本（填写 sequence；timestampNs 为 0 时填当前时间）
+     * @return ErrorCode::Ok 成功；DevNotReady 未打开
+     */
+    ErrorCode publish(ShmSample &sample);
+
+    /**
+     * @brief 发布一次 AP3216C / DHT11 读数或按键事件
+     */
+    ErrorCode publish(const AP3216CData &data, uint16_t device = 0);
+    ErrorCode publish(const DHT11Data &data, uint16_t device = 0);
+    ErrorCode publishKey(int code, int value, uint16_t device = 0);
+
+    /**
+     * @brief 已发布的样本数
+     */
+    uint64_t published() const
+    {
+        return count;
+    }
+
+    const std::string &getName() const
+    {
+        return name;
+    }
+
+private:
+    std::string name;
+    uint32_t slotCount;
+    void *base;
+    std::size_t mapSize;
+    uint64_t count;
+    std::mutex writeMutex;
+};
+
+/**
+ * @brief 共享内存样本订阅者（UI、日志、控制进程使用）
+ *
+ * 映射发布者创建的样本环，从打开时刻之后发布的样本开始读取。tryRead() 不进入内核；
+ * wait() 没有新样本时在发布计数上 futex 等待。每个订阅者只有本地读位置，
+ * 订阅者数量不影响发布者的开销（除 FUTEX_WAKE 唤醒的进程数外）。
+ * 非线程安全，每个线程使用各自的订阅者。
+ */
+class ShmSubscriber
+{
+public:
+    explicit ShmSubscriber(const std::string &name = DEFAULT_SHM_NAME);
+
+    /**
+     * @brief 析构函数，解除映射
+     */
+    ~ShmSubscriber();
+
+    ShmSubscriber(const ShmSubscriber &) = delete;
+    ShmSubscriber &operator=(const ShmSubscriber &) = delete;
+
+    /**
+     * @brief 映射共享内存
+     * @return ErrorCode::Ok 成功；DevOpen 共享内存不存在或映射失败；DevNotReady 发布者尚未完成初始化；
+     *         Unsupported 版本或布局不匹配
+     */
+    ErrorCode open();
+
+    void close();
+
+    bool isOpen() const
+    {
+        return base != nullptr;
+    }
+
+    /**
+     * @brief 非阻塞读取下一个样本
+     * @return true 读到样本；false 暂无新样本或未打开
+     */
+    bool tryRead(ShmSample &sample);
+
+    /**
+     * @brief 读取下一个样本，没有时等待
+     * @param timeoutMs 超时时间，负数表示一直等待
+     * @return ErrorCode::Ok 读到样本；Timeout 超时；DevNotReady 未打开或发布者已关闭且样本已读完
+     */
+    ErrorCode wait(ShmSample &sample, int timeoutMs = -1);
+
+    /**
+     * @brief 丢弃尚未读取的样本，从下一个发布的样本开始读取
+     */
+    void skipToLatest();
+
+    /**
+     * @brief 因落后超过一圈而被覆盖、未能读到的样本数
+     */
+    uint64_t lost() const
+    {
+        return lostCount;
+    }
+
+    uint64_t received() const
+    {
+        return receivedCount;
+    }
+
+private:
+    std::string name;
+    uint32_t slotCount;
+    void *base;
+    std::size_t mapSize;
+    uint32_t next; // 下一个要读的发布序号
+    uint64_t lostCount;
+    uint64_t receivedCount;
+};
+
+} // namespace bsp
+
+#endif // BSP_SHM_RING_H
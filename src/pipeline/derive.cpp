@@ -0,0 +1,104 @@
+#include "derive.h"
+#include <cmath>
+#include <limits>
+
+namespace bsp
+{
+
+namespace derive
+{
+
+namespace
+{
+
+// Magnus 系数（Sonntag 1990，水面饱和蒸汽压）
+constexpr float MAGNUS_B = 17.62f;
+constexpr float MAGNUS_C = 243.12f;
+
+// Rothfusz 回归的适用下限(F)，低于此值使用 Steadman 简化公式
+constexpr float ROTHFUSZ_MIN_F = 80.0f;
+
+float toFahrenheit(float celsius)
+{
+    return celsius * 1.8f + 32.0f;
+}
+
+float toCelsius(float fahrenheit)
+{
+    return (fahrenheit - 32.0f) / 1.8f;
+}
+
+} // namespace
+
+float dewPoint(float celsius, float relativeHumidity)
+{
+    if (!(relativeHumidity > 0.0f))
+    {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    float gamma = std::log(relativeHumidity / 100.0f) + MAGNUS_B * celsius / (MAGNUS_C + celsius);
+    return MAGNUS_C * gamma / (MAGNUS_B - gamma);
+}
+
+float heatIndex(float celsius, float relativeHumidity)
+{
+    const float t = toFahrenheit(celsius);
+    const float rh = relativeHumidity;
+
+    float simple = 0.5f * (t + 61.0f + (t - 68.0f) * 1.2f + rh * 0.094f);
+    if ((simple + t) / 2.0f < ROTHFUSZ_MIN_F)
+    {
+        return toCelsius(simple);
+    }
+
+    float hi = -42.379f + 2.04901523f * t + 10.14333127f * rh - 0.22475541f * t * rh - 0.00683783f * t * t -
+               0.05481717f * rh * rh + 0.00122874f * t * t * rh + 0.00085282f * t * rh * rh -
+               0.00000199f * t * t * rh * rh;
+    if (rh < 13.0f && t >= 80.0f && t <= 112.0f)
+    {
+        hi -= (13.0f - rh) / 4.0f * std::sqrt((17.0f - std::fabs(t - 95.0f)) / 17.0f);
+    }
+    else if (rh > 85.0f && t >= 80.0f && t <= 87.0f)
+    {
+        hi += (rh - 85.0f) / 10.0f * ((87.0f - t) / 5.0f);
+    }
+    return toCelsius(hi);
+}
+
+Derivation dewPoint()
+{
+    return Derivation([](const float *in, float) { return dewPoint(in[0], in[1]); });
+}
+
+Derivation heatIndex()
+{
+    return Derivation([](const float *in, float) { return heatIndex(in[0], in[1]); });
+}
+
+Derivation ema(float alpha)
+{
+    return Derivation(
+        [alpha](const float *in, float previous) {
+            return std::isnan(previous) ? in[0] : previous + alpha * (in[0] - previous);
+        },
+        Trigger::OnSample);
+}
+
+Derivation hysteresis(float low, float high)
+{
+    return Derivation([low, high](const float *in, float previous) {
+        if (in[0] >= high)
+        {
+            return 1.0f;
+        }
+        if (in[0] <= low)
+        {
+            return 0.0f;
+        }
+        return std::isnan(previous) ? 0.0f : previous;
+    });
+}
+
+} // namespace derive
+
+} // namespace bsp
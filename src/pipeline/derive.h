@@ -0,0 +1,90 @@
+#ifndef BSP_DERIVE_H
+#define BSP_DERIVE_H
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace bsp
+{
+
+/**
+ * @brief 派生通道的重算时机
+ */
+enum class Trigger
+{
+    OnChange, // 任一输入的值发生变化时重算（纯函数，相同输入必得相同输出）
+    OnSample  // 任一输入收到新样本时重算，即使值未变（有状态的滤波器，如滑动平均）
+};
+
+/**
+ * @brief 派生通道计算函数
+ * @param inputs 按声明顺序排列的输入值
+ * @param previous 本通道上一次的输出（从未计算过时为 NaN）
+ * @return 新的输出值
+ */
+using DeriveFn = std::function<float(const float *inputs, float previous)>;
+
+/**
+ * @brief 派生通道的计算方式：计算函数 + 重算时机
+ *
+ * 可由 lambda 隐式构造（默认 OnChange），或使用 derive 命名空间中的预置实现
+ */
+struct Derivation
+{
+    DeriveFn fn;
+    Trigger trigger;
+
+    template <typename Fn, typename = typename std::enable_if<
+                               !std::is_same<typename std::decay<Fn>::type, Derivation>::value>::type>
+    Derivation(Fn fn, Trigger trigger = Trigger::OnChange) : fn(std::move(fn)), trigger(trigger)
+    {
+    }
+};
+
+namespace derive
+{
+
+/**
+ * @brief 露点（Magnus 公式，-45~60 C 范围内误差 < 0.35 C）
+ * @param celsius 温度(C)
+ * @param relativeHumidity 相对湿度(%RH)，<= 0 时结果为 NaN
+ */
+float dewPoint(float celsius, float relativeHumidity);
+
+/**
+ * @brief 体感温度（美国国家气象局 Rothfusz 回归，低温区使用 Steadman 简化公式）
+ * @param celsius 温度(C)
+ * @param relativeHumidity 相对湿度(%RH)
+ * @return 体感温度(C)
+ */
+float heatIndex(float celsius, float relativeHumidity);
+
+/**
+ * @brief 露点通道，输入为 {温度, 湿度}
+ */
+Derivation dewPoint();
+
+/**
+ * @brief 体感温度通道，输入为 {温度, 湿度}
+ */
+Derivation heatIndex();
+
+/**
+ * @brief 指数滑动平均 y += alpha * (x - y)，每个样本都会更新（OnSample）
+ * @param alpha 平滑系数 (0, 1]，越小越平滑
+ */
+Derivation ema(float alpha);
+
+/**
+ * @brief 带回差的二值状态：输入 >= high 时为 1，<= low 时为 0，之间保持上一状态
+ * @param low 释放阈值
+ * @param high 触发阈值
+ */
+Derivation hysteresis(float low, float high);
+
+} // namespace derive
+
+} // namespace bsp
+
+#endif // BSP_DERIVE_H
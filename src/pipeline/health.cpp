@@ -0,0 +1,313 @@
+#include "health.h"
+#include "../driver/sensor_units.h"
+#include <spdlog/spdlog.h>
+#include <cmath>
+#include <cstring>
+
+namespace bsp
+{
+
+constexpr std::size_t HealthMonitor::MAX_CHANNELS;
+constexpr std::size_t HealthMonitor::MAX_RAW_BYTES;
+
+namespace
+{
+
+uint8_t conditionBit(HealthStatus status)
+{
+    return static_cast<uint8_t>(1u << -static_cast<int>(status));
+}
+
+// 告警位中最严重（最接近 0）的状态
+HealthStatus mostSevere(uint8_t mask)
+{
+    for (int code = -1; code > -HEALTH_STATUS_COUNT; --code)
+    {
+        if (mask & conditionBit(static_cast<HealthStatus>(code)))
+        {
+            return static_cast<HealthStatus>(code);
+        }
+    }
+    return HealthStatus::Ok;
+}
+
+uint8_t withCondition(uint8_t mask, HealthStatus status, bool on)
+{
+    uint8_t bit = conditionBit(status);
+    return static_cast<uint8_t>(on ? (mask | bit) : (mask & ~bit));
+}
+
+bool sameValue(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+} // namespace
+
+const char *healthToString(HealthStatus status)
+{
+    switch (status)
+    {
+    case HealthStatus::Ok:
+        return "ok";
+    case HealthStatus::ErrorRate:
+        return "error_rate";
+    case HealthStatus::Stuck:
+        return "stuck";
+    case HealthStatus::Spike:
+        return "spike";
+    case HealthStatus::Outlier:
+        return "outlier";
+    default:
+        return "unknown";
+    }
+}
+
+HealthMonitor::HealthMonitor(const std::string &device, const HealthConfig &config)
+    : device(device), config(config), channelNum(0)
+{
+    reset();
+}
+
+HealthMonitor HealthMonitor::forAP3216C(const std::string &device)
+{
+    HealthConfig config;
+    config.stuckRun = 200;
+    config.maxErrorRate = 0.2f;
+    HealthMonitor monitor(device, config);
+
+    ChannelHealthConfig light;
+    light.zThreshold = 8.0f;
+    light.alpha = 0.1f;
+    light.minSigma = 4.0f;
+    monitor.addChannel("als", light);
+    monitor.addChannel("ps", ChannelHealthConfig());
+    monitor.addChannel("ir", light);
+    return monitor;
+}
+
+HealthMonitor HealthMonitor::forDHT11(const std::string &device)
+{
+    HealthConfig config;
+    config.maxErrorRate = 0.3f;
+    HealthMonitor monitor(device, config);
+
+    ChannelHealthConfig humidity;
+    humidity.maxStep = 20.0f;
+    humidity.zThreshold = 6.0f;
+    ChannelHealthConfig temperature;
+    temperature.maxStep = 10.0f;
+    temperature.zThreshold = 6.0f;
+    monitor.addChannel("humidity", humidity);
+    monitor.addChannel("temperature", temperature);
+    return monitor;
+}
+
+int HealthMonitor::addChannel(const std::string &name, const ChannelHealthConfig &channelConfig)
+{
+    if (channelNum >= MAX_CHANNELS)
+    {
+        spdlog::error("health monitor {}: too many channels, cannot add {}", device, name);
+        return -1;
+    }
+    Channel &channel = channels[channelNum];
+    channel.name = name;
+    channel.config = channelConfig;
+    channel.last = 0.0f;
+    channel.mean = 0.0f;
+    channel.variance = 0.0f;
+    channel.run = 0;
+    channel.count = 0;
+    channel.active = 0;
+    return static_cast<int>(channelNum++);
+}
+
+void HealthMonitor::setCallback(Callback callback)
+{
+    this->callback = std::move(callback);
+}
+
+void HealthMonitor::transition(uint8_t &mask, uint8_t next, const char *channel, float value)
+{
+    uint8_t changed = static_cast<uint8_t>(mask ^ next);
+    mask = next;
+    for (int code = -1; code > -HEALTH_STATUS_COUNT; --code)
+    {
+        HealthStatus status = static_cast<HealthStatus>(code);
+        uint8_t bit = conditionBit(status);
+        if ((changed & bit) == 0)
+        {
+            continue;
+        }
+        bool on = (next & bit) != 0;
+        if (on)
+        {
+            spdlog::warn("{}{}{}: {} (value {})", device, channel ? "." : "", channel ? channel : "",
+                         healthToString(status), value);
+        }
+        else
+        {
+            spdlog::info("{}{}{}: {} cleared", device, channel ? "." : "", channel ? channel : "",
+                         healthToString(status));
+        }
+        if (callback)
+        {
+            HealthEvent event = {device.c_str(), channel, status, on, value, sampleCount};
+            callback(event);
+        }
+    }
+}
+
+void HealthMonitor::checkChannel(Channel &channel, float value)
+{
+    const ChannelHealthConfig &cfg = channel.config;
+
+    bool repeated = channel.count > 0 && sameValue(channel.last, value);
+    channel.run = repeated ? (channel.run == UINT32_MAX ? UINT32_MAX : channel.run + 1) : 1;
+    bool stuck = cfg.stuckRun != 0 && channel.run >= cfg.stuckRun;
+    bool spike = cfg.maxStep > 0.0f && channel.count > 0 && std::fabs(value - channel.last) > cfg.maxStep;
+
+    // 离群判定使用更新前的统计量，比较平方避免开方
+    float delta = value - channel.mean;
+    bool outlier = false;
+    if (cfg.zThreshold > 0.0f && channel.count >= cfg.warmup)
+    {
+        float floor2 = cfg.minSigma * cfg.minSigma;
+        float sigma2 = channel.variance > floor2 ? channel.variance : floor2;
+        outlier = delta * delta > cfg.zThreshold * cfg.zThreshold * sigma2;
+    }
+
+    // 指数滑动均值/方差（West 增量公式）
+    if (channel.count == 0)
+    {
+        channel.mean = value;
+        channel.variance = 0.0f;
+    }
+    else
+    {
+        channel.mean += cfg.alpha * delta;
+        channel.variance = (1.0f - cfg.alpha) * (channel.variance + cfg.alpha * delta * delta);
+    }
+    channel.last = value;
+    if (channel.count != UINT32_MAX)
+    {
+        ++channel.count;
+    }
+
+    // 告警位无变化时不进入日志/回调路径
+    uint8_t next = static_cast<uint8_t>((stuck ? conditionBit(HealthStatus::Stuck) : 0) |
+                                        (spike ? conditionBit(HealthStatus::Spike) : 0) |
+                                        (outlier ? conditionBit(HealthStatus::Outlier) : 0));
+    if (next != channel.active)
+    {
+        transition(channel.active, next, channel.name.c_str(), value);
+    }
+}
+
+HealthStatus HealthMonitor::record(ErrorCode result, const float *values, const void *raw, std::size_t rawSize)
+{
+    ++sampleCount;
+    bool failed = result != ErrorCode::Ok;
+    errRate += config.errorAlpha * ((failed ? 1.0f : 0.0f) - errRate);
+    if (config.maxErrorRate > 0.0f)
+    {
+        bool active = (deviceActive & conditionBit(HealthStatus::ErrorRate)) != 0;
+        bool on = active ? errRate >= config.maxErrorRate * 0.5f : errRate > config.maxErrorRate;
+        uint8_t next = withCondition(deviceActive, HealthStatus::ErrorRate, on);
+        if (next != deviceActive)
+        {
+            transition(deviceActive, next, nullptr, errRate);
+        }
+    }
+    if (failed || values == nullptr)
+    {
+        return status();
+    }
+
+    for (std::size_t i = 0; i < channelNum; ++i)
+    {
+        checkChannel(channels[i], values[i]);
+    }
+
+    if (raw != nullptr && config.stuckRun != 0)
+    {
+        std::size_t size = rawSize < MAX_RAW_BYTES ? rawSize : MAX_RAW_BYTES;
+        if (size == lastRawSize && std::memcmp(lastRaw, raw, size) == 0)
+        {
+            rawRun = rawRun == UINT32_MAX ? UINT32_MAX : rawRun + 1;
+        }
+        else
+        {
+            std::memcpy(lastRaw, raw, size);
+            lastRawSize = size;
+            rawRun = 1;
+        }
+        uint8_t next = withCondition(deviceActive, HealthStatus::Stuck, rawRun >= config.stuckRun);
+        if (next != deviceActive)
+        {
+            transition(deviceActive, next, nullptr, channelNum > 0 ? values[0] : 0.0f);
+        }
+    }
+    return status();
+}
+
+HealthStatus HealthMonitor::record(ErrorCode result, const AP3216CData &data)
+{
+    float values[MAX_CHANNELS] = {static_cast<float>(data.als), static_cast<float>(data.ps),
+                                  static_cast<float>(data.ir)};
+    return record(result, values, &data, sizeof(data));
+}
+
+HealthStatus HealthMonitor::record(ErrorCode result, const DHT11Data &data)
+{
+    DHT11ReadingF reading = DHT11Converter().toFloat(data);
+    float values[MAX_CHANNELS] = {reading.humidity, reading.temperature};
+    return record(result, values, &data, sizeof(data));
+}
+
+HealthStatus HealthMonitor::status() const
+{
+    uint8_t mask = deviceActive;
+    for (std::size_t i = 0; i < channelNum; ++i)
+    {
+        mask |= channels[i].active;
+    }
+    return mostSevere(mask);
+}
+
+HealthStatus HealthMonitor::channelStatus(std::size_t channel) const
+{
+    return mostSevere(channels[channel].active);
+}
+
+float HealthMonitor::mean(std::size_t channel) const
+{
+    return channels[channel].mean;
+}
+
+float HealthMonitor::sigma(std::size_t channel) const
+{
+    return std::sqrt(channels[channel].variance);
+}
+
+void HealthMonitor::reset()
+{
+    for (std::size_t i = 0; i < channelNum; ++i)
+    {
+        Channel &channel = channels[i];
+        channel.last = 0.0f;
+        channel.mean = 0.0f;
+        channel.variance = 0.0f;
+        channel.run = 0;
+        channel.count = 0;
+        channel.active = 0;
+    }
+    std::memset(lastRaw, 0, sizeof(lastRaw));
+    lastRawSize = 0;
+    rawRun = 0;
+    errRate = 0.0f;
+    sampleCount = 0;
+    deviceActive = 0;
+}
+
+} // namespace bsp
@@ -0,0 +1,229 @@
+#ifndef BSP_HEALTH_H
+#define BSP_HEALTH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "../common/bsp_common.h"
+#include "../driver/ap3216c/ap3216c.h"
+#include "../driver/dht11/dht11.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 传感器健康状态（取值方式与 ErrorCode 一致：0 正常，负数为告警，越接近 0 越严重）
+ */
+enum class HealthStatus
+{
+    Ok = 0,         // 正常
+    ErrorRate = -1, // 读取失败率过高
+    Stuck = -2,     // 读数长时间完全不变
+    Spike = -3,     // 相邻样本变化量超过上限
+    Outlier = -4    // 偏离滑动均值超过 z 阈值
+};
+
+// 健康状态个数（取值为 0 ~ -(HEALTH_STATUS_COUNT - 1)，新增状态时同步修改）
+constexpr int HEALTH_STATUS_COUNT = 5;
+
+/**
+ * @brief 健康状态转字符串（如 "stuck"）
+ */
+const char *healthToString(HealthStatus status);
+
+/**
+ * @brief 单个通道的检测参数（各项为 0 表示关闭该项检测）
+ */
+struct ChannelHealthConfig
+{
+    uint32_t stuckRun; // 连续相同读数达到该次数判定为卡死
+    float maxStep;     // 相邻样本变化量上限（绝对值）
+    float zThreshold;  // |x - 均值| / 标准差 超过该值判定为离群
+    float alpha;       // 均值/方差的指数滑动系数 (0, 1]
+    float minSigma;    // 标准差下限（通常取传感器分辨率），避免恒定信号上的微小变化被判为离群
+    uint32_t warmup;   // 前若干个样本只更新统计量，不做离群判定
+
+    ChannelHealthConfig()
+        : stuckRun(0), maxStep(0.0f), zThreshold(0.0f), alpha(0.05f), minSigma(1.0f), warmup(20)
+    {
+    }
+};
+
+/**
+ * @brief 设备级检测参数
+ */
+struct HealthConfig
+{
+    uint32_t stuckRun;  // 整个原始样本逐字节相同的连续次数，达到即判定卡死（0 关闭）
+    float errorAlpha;   // 读取失败率的指数滑动系数
+    float maxErrorRate; // 失败率超过该值告警，回落到一半以下解除（0 关闭）
+
+    HealthConfig() : stuckRun(0), errorAlpha(0.05f), maxErrorRate(0.0f)
+    {
+    }
+};
+
+/**
+ * @brief 健康事件（告警产生或解除时各触发一次）
+ */
+struct HealthEvent
+{
+    const char *device;  // 设备名
+    const char *channel; // 通道名，设备级事件（失败率、整样本卡死）为 nullptr
+    HealthStatus status;
+    bool active;     // true 告警产生，false 告警解除
+    float value;     // 触发时的样本值；失败率事件为当前失败率
+    uint64_t sample; // 触发时是第几次读取（从 1 开始）
+};
+
+/**
+ * @brief 单个设备的流式健康监测
+ *
+ * 每次读取后调用 record()，按常数内存、常数时间更新每个通道的统计量：
+ * 相同读数的游程长度、相邻样本变化量、指数滑动均值/方差（z 分数）以及设备的读取失败率。
+ * 告警按边沿触发：状态进入或离开告警时各回调一次，持续异常不会重复回调。
+ * 非线程安全，应在读取该设备的线程中使用。
+ */
+class HealthMonitor
+{
+public:
+    // 单个设备最多的通道数 / 整样本卡死检测比较的最大字节数
+    static constexpr std::size_t MAX_CHANNELS = 4;
+    static constexpr std::size_t MAX_RAW_BYTES = 8;
+
+    using Callback = std::function<void(const HealthEvent &)>;
+
+    /**
+     * @brief 构造函数
+     * @param device 设备名（用于事件和日志）
+     * @param config 设备级检测参数
+     */
+    explicit HealthMonitor(const std::string &device, const HealthConfig &config = HealthConfig());
+
+    /**
+     * @brief AP3216C 预置监测：通道 als / ps / ir（原始计数），整样本 200 次不变判定卡死，
+     *        失败率超过 20% 告警
+     */
+    static HealthMonitor forAP3216C(const std::string &device);
+
+    /**
+     * @brief DHT11 预置监测：通道 humidity / temperature，单次跳变超过 20 %RH / 10 C 告警，
+     *        失败率超过 30% 告警（DHT11 单线时序偶发校验失败属正常）
+     */
+    static HealthMonitor forDHT11(const std::string &device);
+
+    /**
+     * @brief 添加通道
+     * @param name 通道名
+     * @param config 通道检测参数
+     * @return 通道下标；超过 MAX_CHANNELS 时返回 -1
+     */
+    int addChannel(const std::string &name, const ChannelHealthConfig &config);
+
+    /**
+     * @brief 设置事件回调（传入空函数取消）
+     */
+    void setCallback(Callback callback);
+
+    /**
+     * @brief 记录一次读取结果
+     * @param result 读取返回值，非 Ok 时只计入失败率
+     * @param values 各通道的值（按添加顺序），result 非 Ok 时可为 nullptr
+     * @param raw 原始样本字节（用于整样本卡死检测，可为 nullptr）
+     * @param rawSize 原始样本字节数（超过 MAX_RAW_BYTES 的部分不参与比较）
+     * @return 记录后的设备健康状态，同 status()
+     */
+    HealthStatus record(ErrorCode result, const float *values, const void *raw = nullptr, std::size_t rawSize = 0);
+
+    /**
+     * @brief 记录一次 AP3216C / DHT11 读取（通道需按 forAP3216C() / forDHT11() 的顺序添加）
+     */
+    HealthStatus record(ErrorCode result, const AP3216CData &data);
+    HealthStatus record(ErrorCode result, const DHT11Data &data);
+
+    /**
+     * @brief 设备当前最严重的告警，无告警时为 Ok
+     */
+    HealthStatus status() const;
+
+    /**
+     * @brief 指定通道当前最严重的告警
+     */
+    HealthStatus channelStatus(std::size_t channel) const;
+
+    const std::string &deviceName() const
+    {
+        return device;
+    }
+
+    std::size_t channelCount() const
+    {
+        return channelNum;
+    }
+
+    const std::string &channelName(std::size_t channel) const
+    {
+        return channels[channel].name;
+    }
+
+    /**
+     * @brief 通道的滑动均值 / 标准差（未收到样本时为 0）
+     */
+    float mean(std::size_t channel) const;
+    float sigma(std::size_t channel) const;
+
+    /**
+     * @brief 读取失败率（指数滑动平均）
+     */
+    float errorRate() const
+    {
+        return errRate;
+    }
+
+    /**
+     * @brief 已记录的读取次数（含失败）
+     */
+    uint64_t samples() const
+    {
+        return sampleCount;
+    }
+
+    /**
+     * @brief 清空所有统计量和告警（不触发回调）
+     */
+    void reset();
+
+private:
+    struct Channel
+    {
+        std::string name;
+        ChannelHealthConfig config;
+        float last;
+        float mean;
+        float variance;
+        uint32_t run;   // 当前值已连续出现的次数
+        uint32_t count; // 成功样本数
+        uint8_t active; // 告警位（1 << -HealthStatus）
+    };
+
+    // 告警位变化时更新并逐位输出日志、触发回调（仅在状态变化时调用）
+    void transition(uint8_t &mask, uint8_t next, const char *channel, float value);
+    void checkChannel(Channel &channel, float value);
+
+    std::string device;
+    HealthConfig config;
+    Channel channels[MAX_CHANNELS];
+    std::size_t channelNum;
+    unsigned char lastRaw[MAX_RAW_BYTES];
+    std::size_t lastRawSize;
+    uint32_t rawRun;
+    float errRate;
+    uint64_t sampleCount;
+    uint8_t deviceActive;
+    Callback callback;
+};
+
+} // namespace bsp
+
+#endif // BSP_HEALTH_H
@@ -0,0 +1,232 @@
+#include "pipeline.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace bsp
+{
+
+constexpr std::size_t Pipeline::MAX_INPUTS;
+
+namespace
+{
+
+// 按位比较，NaN -> NaN 视为未变化
+bool sameValue(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+} // namespace
+
+Pipeline::Pipeline() : dirtyCount(0), seq(0), evalCount(0)
+{
+}
+
+ChannelId Pipeline::addChannel(const std::string &name)
+{
+    if (channels.size() >= INVALID_CHANNEL)
+    {
+        spdlog::error("pipeline channel limit reached, cannot add {}", name);
+        return INVALID_CHANNEL;
+    }
+    if (name.empty() || find(name) != INVALID_CHANNEL)
+    {
+        spdlog::error("pipeline channel name '{}' is empty or already declared", name);
+        return INVALID_CHANNEL;
+    }
+
+    Channel channel;
+    channel.name = name;
+    channel.inputCount = 0;
+    channel.trigger = Trigger::OnChange;
+    channels.push_back(std::move(channel));
+    values.push_back(std::numeric_limits<float>::quiet_NaN());
+    changedAt.push_back(0);
+    dirty.push_back(0);
+    return static_cast<ChannelId>(channels.size() - 1);
+}
+
+ChannelId Pipeline::addInput(const std::string &name)
+{
+    return addChannel(name);
+}
+
+ChannelId Pipeline::addDerived(const std::string &name, std::initializer_list<ChannelId> inputs,
+                               const Derivation &derivation)
+{
+    if (inputs.size() == 0 || inputs.size() > MAX_INPUTS || !derivation.fn)
+    {
+        spdlog::error("derived channel {} needs 1..{} inputs and a function", name, MAX_INPUTS);
+        return INVALID_CHANNEL;
+    }
+    for (ChannelId input : inputs)
+    {
+        if (input >= channels.size())
+        {
+            spdlog::error("derived channel {} references unknown channel {}", name, input);
+            return INVALID_CHANNEL;
+        }
+    }
+
+    ChannelId id = addChannel(name);
+    if (id == INVALID_CHANNEL)
+    {
+        return INVALID_CHANNEL;
+    }
+    Channel &channel = channels[id];
+    channel.inputCount = static_cast<uint8_t>(inputs.size());
+    std::size_t i = 0;
+    for (ChannelId input : inputs)
+    {
+        channel.inputs[i++] = input;
+        std::vector<ChannelId> &dependents = channels[input].dependents;
+        if (std::find(dependents.begin(), dependents.end(), id) == dependents.end())
+        {
+            dependents.push_back(id);
+        }
+    }
+    channel.fn = derivation.fn;
+    channel.trigger = derivation.trigger;
+    derived.push_back(id);
+    return id;
+}
+
+AP3216CSource Pipeline::addSource(const std::string &prefix, const AP3216CConverter &converter)
+{
+    AP3216CSource source = {addInput(prefix + ".lux"), addInput(prefix + ".ps"), addInput(prefix + ".ir"),
+                            converter};
+    return source;
+}
+
+DHT11Source Pipeline::addSource(const std::string &prefix, const DHT11Converter &converter)
+{
+    DHT11Source source = {addInput(prefix + ".humidity"), addInput(prefix + ".temperature"), converter};
+    return source;
+}
+
+void Pipeline::set(ChannelId input, float value)
+{
+    if (input >= channels.size() || channels[input].inputCount != 0)
+    {
+        return;
+    }
+    bool valueChanged = !sameValue(values[input], value);
+    if (valueChanged)
+    {
+        values[input] = value;
+        changedAt[input] = seq + 1;
+    }
+    markDependents(input, valueChanged);
+}
+
+void Pipeline::markDependents(ChannelId id, bool valueChanged)
+{
+    for (ChannelId dependent : channels[id].dependents)
+    {
+        if (!dirty[dependent] && (valueChanged || channels[dependent].trigger == Trigger::OnSample))
+        {
+            dirty[dependent] = 1;
+            ++dirtyCount;
+        }
+    }
+}
+
+std::size_t Pipeline::update()
+{
+    return publish(DeviceType::Custom, 0, nullptr, 0);
+}
+
+std::size_t Pipeline::evaluate()
+{
+    ++seq;
+    std::size_t evaluated = 0;
+    float args[MAX_INPUTS];
+
+    // 派生通道只依赖先声明的通道，一次正向遍历即可把变化传播到底
+    for (std::size_t n = 0; n < derived.size() && dirtyCount > 0; ++n)
+    {
+        ChannelId id = derived[n];
+        if (!dirty[id])
+        {
+            continue;
+        }
+        dirty[id] = 0;
+        --dirtyCount;
+
+        const Channel &channel = channels[id];
+        for (uint8_t i = 0; i < channel.inputCount; ++i)
+        {
+            args[i] = values[channel.inputs[i]];
+        }
+        float result = channel.fn(args, values[id]);
+        ++evaluated;
+
+        bool valueChanged = !sameValue(values[id], result);
+        if (valueChanged)
+        {
+            values[id] = result;
+            changedAt[id] = seq;
+        }
+        markDependents(id, valueChanged);
+    }
+
+    evalCount += evaluated;
+    return evaluated;
+}
+
+std::size_t Pipeline::publish(DeviceType source, uint64_t timestampNs, const void *raw, std::size_t rawSize)
+{
+    std::size_t evaluated = evaluate();
+    if (listener)
+    {
+        PipelineSample sample;
+        std::memset(&sample, 0, sizeof(sample));
+        sample.sequence = seq;
+        sample.timestampNs = timestampNs;
+        sample.source = source;
+        if (raw != nullptr)
+        {
+            std::memcpy(&sample.ap3216c, raw, rawSize);
+        }
+        listener(*this, sample);
+    }
+    return evaluated;
+}
+
+std::size_t Pipeline::push(const AP3216CSource &source, const AP3216CData &data, uint64_t timestampNs)
+{
+    AP3216CReadingF reading = source.converter.toFloat(data);
+    set(source.lux, reading.lux);
+    set(source.ps, static_cast<float>(reading.ps));
+    set(source.ir, static_cast<float>(reading.ir));
+    return publish(DeviceType::AP3216C, timestampNs, &data, sizeof(data));
+}
+
+std::size_t Pipeline::push(const DHT11Source &source, const DHT11Data &data, uint64_t timestampNs)
+{
+    DHT11ReadingF reading = source.converter.toFloat(data);
+    set(source.humidity, reading.humidity);
+    set(source.temperature, reading.temperature);
+    return publish(DeviceType::DHT11, timestampNs, &data, sizeof(data));
+}
+
+void Pipeline::setListener(Listener listener)
+{
+    this->listener = std::move(listener);
+}
+
+ChannelId Pipeline::find(const std::string &name) const
+{
+    for (std::size_t i = 0; i < channels.size(); ++i)
+    {
+        if (channels[i].name == name)
+        {
+            return static_cast<ChannelId>(i);
+        }
+    }
+    return INVALID_CHANNEL;
+}
+
+} // namespace bsp
@@ -0,0 +1,233 @@
+#ifndef BSP_PIPELINE_H
+#define BSP_PIPELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "../common/bsp_common.h"
+#include "../common/device_table.h"
+#include "../driver/sensor_units.h"
+#include "derive.h"
+
+namespace bsp
+{
+
+// 通道句柄，即通道的声明下标
+using ChannelId = uint16_t;
+constexpr ChannelId INVALID_CHANNEL = 0xffff;
+
+/**
+ * @brief AP3216C 数据源对应的输入通道（lux 为校准后照度，ps/ir 为原始计数）
+ */
+struct AP3216CSource
+{
+    ChannelId lux;
+    ChannelId ps;
+    ChannelId ir;
+    AP3216CConverter converter;
+};
+
+/**
+ * @brief DHT11 数据源对应的输入通道（校准后的 %RH 和 C）
+ */
+struct DHT11Source
+{
+    ChannelId humidity;
+    ChannelId temperature;
+    DHT11Converter converter;
+};
+
+/**
+ * @brief 一次发布：触发本次计算的原始样本
+ *
+ * 派生结果通过 Pipeline::value() / changed() 读取，与原始样本一起交给监听者
+ */
+struct PipelineSample
+{
+    uint64_t sequence;    // 第几次 update()
+    uint64_t timestampNs; // 调用方提供的采样时间戳，未提供时为 0
+    DeviceType source;    // Custom 表示由 set() + update() 直接驱动
+    union
+    {
+        AP3216CData ap3216c;
+        DHT11Data dht11;
+    };
+};
+
+/**
+ * @brief 派生量流水线
+ *
+ * 输入通道保存传感器换算后的物理量，派生通道（露点、体感温度、平滑照度、接近状态等）
+ * 在启动阶段声明一次，由若干已声明的通道计算得到。每个新样本到来时只重算受影响的
+ * 派生通道：
+ * - Trigger::OnChange 的通道只在某个输入的值真正变化时重算；
+ * - Trigger::OnSample 的通道在某个输入收到新样本时重算（用于有状态滤波器）；
+ * - 派生通道的输出未变化时，下游 OnChange 通道不会被重算。
+ *
+ * 派生通道只能依赖先声明的通道，声明顺序即计算顺序，天然无环。
+ * 非线程安全，应在单个采样线程（或事件循环）中使用。
+ *
+ * @code
+ * Pipeline pipe;
+ * DHT11Source th = pipe.addSource("dht11", DHT11Converter());
+ * ChannelId dew = pipe.addDerived("dew_point", {th.temperature, th.humidity}, derive::dewPoint());
+ * pipe.push(th, data);           // 换算、重算、通知监听者
+ * float v = pipe.value(dew);
+ * @endcode
+ */
+class Pipeline
+{
+public:
+    // 单个派生通道最多的输入数
+    static constexpr std::size_t MAX_INPUTS = 4;
+
+    /**
+     * @brief 发布回调，每次 update() 结束后调用
+     */
+    using Listener = std::function<void(const Pipeline &, const PipelineSample &)>;
+
+    Pipeline();
+
+    /**
+     * @brief 声明输入通道
+     * @param name 通道名（流水线内唯一）
+     * @return 通道句柄；名字重复或通道数超限时返回 INVALID_CHANNEL
+     */
+    ChannelId addInput(const std::string &name);
+
+    /**
+     * @brief 声明派生通道
+     * @param name 通道名（流水线内唯一）
+     * @param inputs 输入通道，计算函数按此顺序收到输入值
+     * @param derivation 计算方式
+     * @return 通道句柄；输入无效、输入过多或名字重复时返回 INVALID_CHANNEL
+     */
+    ChannelId addDerived(const std::string &name, std::initializer_list<ChannelId> inputs,
+                         const Derivation &derivation);
+
+    /**
+     * @brief 声明传感器数据源，创建 "<prefix>.lux" / ".ps" / ".ir" 输入通道
+     * @param prefix 通道名前缀（通常为设备名）
+     * @param converter 该设备的单位转换器（含校准系数）
+     * @return 数据源；任一通道创建失败时其中的句柄为 INVALID_CHANNEL
+     */
+    AP3216CSource addSource(const std::string &prefix, const AP3216CConverter &converter);
+
+    /**
+     * @brief 声明传感器数据源，创建 "<prefix>.humidity" / ".temperature" 输入通道
+     */
+    DHT11Source addSource(const std::string &prefix, const DHT11Converter &converter);
+
+    /**
+     * @brief 写入一个输入样本（不立即计算，下一次 update() 生效）
+     * @param input 输入通道句柄（派生通道或无效句柄会被忽略）
+     * @param value 新值
+     */
+    void set(ChannelId input, float value);
+
+    /**
+     * @brief 重算受影响的派生通道并通知监听者
+     * @return 本次重算的派生通道数
+     */
+    std::size_t update();
+
+    /**
+     * @brief 换算一个原始样本、写入对应输入通道并 update()
+     * @param timestampNs 采样时间戳，随发布一起交给监听者
+     * @return 本次重算的派生通道数
+     */
+    std::size_t push(const AP3216CSource &source, const AP3216CData &data, uint64_t timestampNs = 0);
+    std::size_t push(const DHT11Source &source, const DHT11Data &data, uint64_t timestampNs = 0);
+
+    /**
+     * @brief 设置发布回调（传入空函数取消）
+     */
+    void setListener(Listener listener);
+
+    /**
+     * @brief 按名字查找通道（建议只在启动阶段调用）
+     * @return 通道句柄，不存在时返回 INVALID_CHANNEL
+     */
+    ChannelId find(const std::string &name) const;
+
+    /**
+     * @brief 通道当前值（从未写入/计算过时为 NaN）
+     */
+    float value(ChannelId id) const
+    {
+        return values[id];
+    }
+
+    /**
+     * @brief 通道的值是否在最近一次 update() 中发生变化
+     */
+    bool changed(ChannelId id) const
+    {
+        return changedAt[id] == seq && seq != 0;
+    }
+
+    const std::string &name(ChannelId id) const
+    {
+        return channels[id].name;
+    }
+
+    bool isInput(ChannelId id) const
+    {
+        return channels[id].inputCount == 0;
+    }
+
+    std::size_t size() const
+    {
+        return channels.size();
+    }
+
+    /**
+     * @brief 已执行的 update() 次数
+     */
+    uint64_t sequence() const
+    {
+        return seq;
+    }
+
+    /**
+     * @brief 累计重算派生通道的次数（用于评估增量计算的收益）
+     */
+    uint64_t evaluations() const
+    {
+        return evalCount;
+    }
+
+private:
+    // 通道的声明信息（冷数据），热路径只访问下面按通道下标排列的数组
+    struct Channel
+    {
+        std::string name;
+        uint8_t inputCount; // 0 表示输入通道
+        Trigger trigger;
+        ChannelId inputs[MAX_INPUTS];
+        DeriveFn fn;
+        std::vector<ChannelId> dependents; // 以本通道为输入的派生通道
+    };
+
+    ChannelId addChannel(const std::string &name);
+    void markDependents(ChannelId id, bool valueChanged);
+    std::size_t evaluate();
+    std::size_t publish(DeviceType source, uint64_t timestampNs, const void *raw, std::size_t rawSize);
+
+    std::vector<Channel> channels;
+    std::vector<float> values;
+    std::vector<uint64_t> changedAt;  // 最近一次值发生变化时的 update 序号
+    std::vector<uint8_t> dirty;       // 派生通道待重算标记
+    std::vector<ChannelId> derived;   // 派生通道，按声明（即计算）顺序
+    std::size_t dirtyCount;
+    uint64_t seq;
+    uint64_t evalCount;
+    Listener listener;
+};
+
+} // namespace bsp
+
+#endif // BSP_PIPELINE_H
@@ -0,0 +1,195 @@
+#include "sampler.h"
+#include "../driver/sensor_units.h"
+#include <algorithm>
+#include <cmath>
+
+namespace bsp
+{
+
+constexpr std::size_t AdaptiveRate::MAX_CHANNELS;
+
+AdaptiveRate::AdaptiveRate(const AdaptiveRateConfig &config) : config(config), channelNum(0)
+{
+    if (this->config.minIntervalMs == 0)
+    {
+        this->config.minIntervalMs = 1;
+    }
+    if (this->config.maxIntervalMs < this->config.minIntervalMs)
+    {
+        spdlog::warn("adaptive rate: max interval {} ms below min {} ms, using min", this->config.maxIntervalMs,
+                     this->config.minIntervalMs);
+        this->config.maxIntervalMs = this->config.minIntervalMs;
+    }
+    if (!(this->config.decay > 1.0f))
+    {
+        this->config.decay = 1.0f;
+    }
+    reset();
+}
+
+AdaptiveRate AdaptiveRate::forAP3216C(uint32_t maxIntervalMs)
+{
+    AdaptiveRateConfig config;
+    config.minIntervalMs = 100;
+    config.maxIntervalMs = maxIntervalMs;
+    AdaptiveRate rate(config);
+
+    ChannelRateConfig als;
+    als.absThreshold = 10.0f;
+    als.relThreshold = 0.1f;
+    ChannelRateConfig ps;
+    ps.absThreshold = 30.0f;
+    ps.eventLevel = 500.0f;
+    ps.eventHysteresis = 100.0f;
+    ChannelRateConfig ir;
+    ir.absThreshold = 20.0f;
+    ir.relThreshold = 0.1f;
+    rate.addChannel("als", als);
+    rate.addChannel("ps", ps);
+    rate.addChannel("ir", ir);
+    return rate;
+}
+
+AdaptiveRate AdaptiveRate::forDHT11(uint32_t maxIntervalMs)
+{
+    AdaptiveRateConfig config;
+    config.minIntervalMs = 2000;
+    config.maxIntervalMs = maxIntervalMs;
+    config.holdSamples = 5;
+    AdaptiveRate rate(config);
+
+    ChannelRateConfig humidity;
+    humidity.absThreshold = 2.0f;
+    ChannelRateConfig temperature;
+    temperature.absThreshold = 0.5f;
+    rate.addChannel("humidity", humidity);
+    rate.addChannel("temperature", temperature);
+    return rate;
+}
+
+int AdaptiveRate::addChannel(const std::string &name, const ChannelRateConfig &channelConfig)
+{
+    if (channelNum >= MAX_CHANNELS)
+    {
+        spdlog::error("adaptive rate: too many channels, cannot add {}", name);
+        return -1;
+    }
+    Channel &channel = channels[channelNum];
+    channel.name = name;
+    channel.config = channelConfig;
+    channel.reference = 0.0f;
+    channel.eventOn = false;
+    return static_cast<int>(channelNum++);
+}
+
+uint32_t AdaptiveRate::record(ErrorCode result, const float *values)
+{
+    ++sampleCount;
+    if (result != ErrorCode::Ok || values == nullptr)
+    {
+        return current;
+    }
+
+    bool changed = false;
+    bool event = false;
+    for (std::size_t i = 0; i < channelNum; ++i)
+    {
+        Channel &channel = channels[i];
+        const ChannelRateConfig &cfg = channel.config;
+        float value = values[i];
+
+        if (cfg.eventLevel > 0.0f)
+        {
+            bool on = channel.eventOn ? value >= cfg.eventLevel - cfg.eventHysteresis : value >= cfg.eventLevel;
+            if (on != channel.eventOn)
+            {
+                channel.eventOn = on;
+                event = true;
+            }
+        }
+
+        if (!primed)
+        {
+            channel.reference = value;
+            continue;
+        }
+        float threshold = std::max(cfg.absThreshold, cfg.relThreshold * std::fabs(channel.reference));
+        if (threshold > 0.0f && std::fabs(value - channel.reference) >= threshold)
+        {
+            changed = true;
+        }
+    }
+
+    if (!primed)
+    {
+        // 第一个样本只建立参考值，保持最高速率直到 hold 用完
+        primed = true;
+        return current;
+    }
+
+    if (event)
+    {
+        ++eventCount;
+    }
+    if (changed || event)
+    {
+        if (changed)
+        {
+            ++changeCount;
+        }
+        // 所有通道以当前读数为新参考，避免同一次变化在后续样本中反复触发
+        for (std::size_t i = 0; i < channelNum; ++i)
+        {
+            channels[i].reference = values[i];
+        }
+        current = config.minIntervalMs;
+        holdLeft = config.holdSamples;
+        return current;
+    }
+
+    if (holdLeft > 0)
+    {
+        --holdLeft;
+        return current;
+    }
+    float next = std::ceil(static_cast<float>(current) * config.decay);
+    current = next >= static_cast<float>(config.maxIntervalMs) ? config.maxIntervalMs : static_cast<uint32_t>(next);
+    return current;
+}
+
+uint32_t AdaptiveRate::record(ErrorCode result, const AP3216CData &data)
+{
+    float values[MAX_CHANNELS] = {static_cast<float>(data.als), static_cast<float>(data.ps),
+                                  static_cast<float>(data.ir)};
+    return record(result, values);
+}
+
+uint32_t AdaptiveRate::record(ErrorCode result, const DHT11Data &data)
+{
+    DHT11ReadingF reading = DHT11Converter().toFloat(data);
+    float values[MAX_CHANNELS] = {reading.humidity, reading.temperature};
+    return record(result, values);
+}
+
+void AdaptiveRate::boost()
+{
+    current = config.minIntervalMs;
+    holdLeft = config.holdSamples;
+}
+
+void AdaptiveRate::reset()
+{
+    primed = false;
+    current = config.minIntervalMs;
+    holdLeft = config.holdSamples;
+    sampleCount = 0;
+    changeCount = 0;
+    eventCount = 0;
+    for (std::size_t i = 0; i < channelNum; ++i)
+    {
+        channels[i].reference = 0.0f;
+        channels[i].eventOn = false;
+    }
+}
+
+} // namespace bsp
@@ -0,0 +1,554 @@
+#ifndef BSP_SAMPLER_H
+#define BSP_SAMPLER_H
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <spdlog/spdlog.h>
+#include "../common/bsp_common.h"
+#include "../common/thread_attr.h"
+#include "../driver/ap3216c/ap3216c.h"
+#include "../driver/dht11/dht11.h"
+
+namespace bsp
+{
+
+/**
+ * @brief 自适应采样的速率范围
+ *
+ * 读数变化（或发生事件）后以最短间隔采样，并保持 holdSamples 个样本；之后每个稳定样本
+ * 把间隔乘以 decay，直到最长间隔
+ */
+struct AdaptiveRateConfig
+{
+    uint32_t minIntervalMs; // 活跃时的采样间隔（最高速率）
+    uint32_t maxIntervalMs; // 稳定时的最长采样间隔（最低速率）
+    float decay;            // 稳定后每个样本间隔的放大倍数（> 1）
+    uint32_t holdSamples;   // 变化后保持最高速率的样本数
+
+    AdaptiveRateConfig() : minIntervalMs(100), maxIntervalMs(5000), decay(1.5f), holdSamples(10)
+    {
+    }
+};
+
+/**
+ * @brief 单个通道的变化判定参数
+ *
+ * 与上一次判定为变化时的读数（而不是上一个样本）比较，缓慢漂移累积到阈值同样算变化。
+ * 阈值取 max(absThreshold, relThreshold * |参考值|)，两项都为 0 的通道不参与变化判定。
+ */
+struct ChannelRateConfig
+{
+    float absThreshold;    // 绝对变化阈值（通道单位）
+    float relThreshold;    // 相对变化阈值（相对参考值的比例）
+    float eventLevel;      // 读数升到该值以上为事件（如接近），0 表示该通道没有事件
+    float eventHysteresis; // 读数降到 eventLevel - eventHysteresis 以下事件解除（解除同样算事件）
+
+    ChannelRateConfig() : absThreshold(0.0f), relThreshold(0.0f), eventLevel(0.0f), eventHysteresis(0.0f)
+    {
+    }
+};
+
+/**
+ * @brief 自适应采样速率策略
+ *
+ * 只根据送入的样本计算下一次采样间隔，不读设备、不计时，可直接用录制的数据回放评估。
+ * 非线程安全。
+ *
+ * @code
+ * AdaptiveRate rate = AdaptiveRate::forAP3216C();
+ * for (;;)
+ * {
+ *     ErrorCode result = sensor.readData(data);
+ *     std::this_thread::sleep_for(std::chrono::milliseconds(rate.record(result, data)));
+ * }
+ * @endcode
+ */
+class AdaptiveRate
+{
+public:
+    // 最多的通道数
+    static constexpr std::size_t MAX_CHANNELS = 4;
+
+    explicit AdaptiveRate(const AdaptiveRateConfig &config = AdaptiveRateConfig());
+
+    /**
+     * @brief AP3216C 预置：100 ms ~ maxIntervalMs；als/ir 变化 10%（至少 10 / 20 个计数）判定为变化，
+     *        ps 变化 30 个计数判定为变化，ps 升到 500 以上为接近事件（回差 100）
+     * @param maxIntervalMs 最长采样间隔；短于该间隔的接近事件可能整个落在两次采样之间而被错过
+     */
+    static AdaptiveRate forAP3216C(uint32_t maxIntervalMs = 1000);
+
+    /**
+     * @brief DHT11 预置：2 s ~ maxIntervalMs（DHT11 两次读取至少间隔 1 s）；湿度变化 2 %RH 或
+     *        温度变化 0.5 C 判定为变化
+     */
+    static AdaptiveRate forDHT11(uint32_t maxIntervalMs = 60000);
+
+    /**
+     * @brief 添加通道
+     * @return 通道下标；超过 MAX_CHANNELS 时返回 -1
+     */
+    int addChannel(const std::string &name, const ChannelRateConfig &config);
+
+    /**
+     * @brief 记录一次读取结果
+     * @param result 读取返回值，非 Ok 时间隔保持不变
+     * @param values 各通道的值（按添加顺序），result 非 Ok 时可为 nullptr
+     * @return 到下一次采样的间隔(ms)
+     */
+    uint32_t record(ErrorCode result, const float *values);
+
+    /**
+     * @brief 记录一次 AP3216C / DHT11 读取（通道需按 forAP3216C() / forDHT11() 的顺序添加）
+     */
+    uint32_t record(ErrorCode result, const AP3216CData &data);
+    uint32_t record(ErrorCode result, const DHT11Data &data);
+
+    /**
+     * @brief 外部事件（中断、按键等）：回到最高速率并重新开始保持计数
+     */
+    void boost();
+
+    /**
+     * @brief 当前的采样间隔(ms)
+     */
+    uint32_t interval() const
+    {
+        return current;
+    }
+
+    /**
+     * @brief 是否处于最高速率
+     */
+    bool active() const
+    {
+        return current <= config.minIntervalMs;
+    }
+
+    /**
+     * @brief 通道的事件状态（如是否接近）
+     */
+    bool eventActive(std::size_t channel) const
+    {
+        return channels[channel].eventOn;
+    }
+
+    const AdaptiveRateConfig &rateConfig() const
+    {
+        return config;
+    }
+
+    std::size_t channelCount() const
+    {
+        return channelNum;
+    }
+
+    const std::string &channelName(std::size_t channel) const
+    {
+        return channels[channel].name;
+    }
+
+    /**
+     * @brief 已记录的读取次数（含失败）/ 判定为变化的次数 / 事件次数
+     */
+    uint64_t samples() const
+    {
+        return sampleCount;
+    }
+
+    uint64_t changes() const
+    {
+        return changeCount;
+    }
+
+    uint64_t events() const
+    {
+        return eventCount;
+    }
+
+    /**
+     * @brief 回到初始状态（最高速率、没有参考值）
+     */
+    void reset();
+
+private:
+    struct Channel
+    {
+        std::string name;
+        ChannelRateConfig config;
+        float reference; // 上一次判定为变化时的读数
+        bool eventOn;
+    };
+
+    AdaptiveRateConfig config;
+    Channel channels[MAX_CHANNELS];
+    std::size_t channelNum;
+    bool primed; // 是否已有参考值
+    uint32_t current;
+    uint32_t holdLeft;
+    uint64_t sampleCount;
+    uint64_t changeCount;
+    uint64_t eventCount;
+};
+
+/**
+ * @brief 按订阅启停的自适应采样线程
+ *
+ * 第一个订阅者加入时启动采样线程，按 AdaptiveRate 给出的间隔读取传感器并把结果交给所有
+ * 订阅者；最后一个订阅者退出后线程在下一次唤醒时自行结束，不再读设备。采样线程阻塞在
+ * poll() 上等待下一次采样时刻，boost() 可立即唤醒它采样。
+ *
+ * 回调在采样线程中执行，可以在回调中 subscribe()/unsubscribe()/boost()，但不能调用 stop()。
+ * 采样期间传感器不能析构或移动，也不应在其他线程中同时读取。
+ *
+ * @code
+ * DHT11 dht("dht11");
+ * dht.init();
+ * AdaptiveSampler<DHT11> sampler(dht, AdaptiveRate::forDHT11());
+ * int id = sampler.subscribe([](ErrorCode error, const DHT11Data &data) { ... });
+ * ...
+ * sampler.unsubscribe(id); // 没有订阅者，采样线程随即停止
+ * @endcode
+ */
+template <typename SensorT> class AdaptiveSampler
+{
+public:
+    using DataType = typename SensorT::DataType;
+    using Callback = std::function<void(ErrorCode error, const DataType &data)>;
+
+    /**
+     * @brief 构造函数
+     * @param sensor 已 init() 的传感器
+     * @param rate 采样速率策略（如 AdaptiveRate::forAP3216C()）
+     */
+    AdaptiveSampler(SensorT &sensor, const AdaptiveRate &rate)
+        : sensor(sensor), policy(rate), wakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)), running(false),
+          stopping(false), boosted(false), nextId(0), subscriberVersion(0), readCount(0)
+    {
+        if (wakeFd < 0)
+        {
+            spdlog::error("create wake fd for sampler failed: {}", std::strerror(errno));
+        }
+    }
+
+    ~AdaptiveSampler()
+    {
+        stop();
+        if (wakeFd >= 0)
+        {
+            close(wakeFd);
+        }
+    }
+
+    AdaptiveSampler(const AdaptiveSampler &) = delete;
+    AdaptiveSampler &operator=(const AdaptiveSampler &) = delete;
+
+    /**
+     * @brief 设置采样线程的属性（下一次启动时生效）
+     */
+    void setThreadAttr(const ThreadAttr &attr)
+    {
+        std::lock_guard<std::mutex> lock(control);
+        threadAttr = attr;
+    }
+
+    /**
+     * @brief 添加订阅者，采样线程未运行时启动它
+     * @param callback 每次读取后在采样线程中调用
+     * @return 订阅 id；采样线程启动失败时返回 -1
+     */
+    int subscribe(Callback callback)
+    {
+        int id;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            id = nextId++;
+            subscribers[id] = std::move(callback);
+            ++subscriberVersion;
+            if (running)
+            {
+                return id;
+            }
+        }
+
+        // 只有启动线程时才串行化；运行中（包括在回调里）订阅不经过 control
+        std::lock_guard<std::mutex> controlLock(control);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (running || subscribers.count(id) == 0)
+            {
+                return subscribers.count(id) != 0 ? id : -1;
+            }
+            running = true;
+        }
+
+        // 上一个线程已因没有订阅者自行结束，先回收
+        if (samplerThread.joinable())
+        {
+            samplerThread.join();
+        }
+        ErrorCode result = startThread();
+        if (result != ErrorCode::Ok)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            subscribers.erase(id);
+            ++subscriberVersion;
+            running = false;
+            return -1;
+        }
+        return id;
+    }
+
+    /**
+     * @brief 移除订阅者；移除最后一个后采样线程自行结束
+     */
+    void unsubscribe(int id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (subscribers.erase(id) == 0)
+        {
+            return;
+        }
+        ++subscriberVersion;
+        if (subscribers.empty())
+        {
+            wake();
+        }
+    }
+
+    /**
+     * @brief 外部事件：立即采样一次并回到最高速率（采样线程未运行时无效）
+     */
+    void boost()
+    {
+        boosted = true;
+        wake();
+    }
+
+    /**
+     * @brief 移除所有订阅者并等待采样线程结束
+     */
+    ErrorCode stop()
+    {
+        std::lock_guard<std::mutex> controlLock(control);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            subscribers.clear();
+            ++subscriberVersion;
+            stopping = true;
+        }
+        wake();
+        if (samplerThread.joinable())
+        {
+            samplerThread.join();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        subscribers.clear();
+        ++subscriberVersion;
+        stopping = false;
+        return ErrorCode::Ok;
+    }
+
+    /**
+     * @brief 采样线程是否在运行
+     */
+    bool isRunning() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return running;
+    }
+
+    std::size_t subscriberCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return subscribers.size();
+    }
+
+    /**
+     * @brief 累计读取次数
+     */
+    uint64_t reads() const
+    {
+        return readCount;
+    }
+
+    /**
+     * @brief 当前速率策略的副本（间隔、变化/事件计数等）
+     */
+    AdaptiveRate rate() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return policy;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void wake()
+    {
+        uint64_t one = 1;
+        ssize_t n = write(wakeFd, &one, sizeof(one));
+        (void)n;
+    }
+
+    ErrorCode startThread()
+    {
+        if (wakeFd < 0)
+        {
+            return ErrorCode::DevIo;
+        }
+        if (validateThreadAttr(threadAttr) != ErrorCode::Ok)
+        {
+            return ErrorCode::InvalidParam;
+        }
+        uint64_t pending;
+        ssize_t n = read(wakeFd, &pending, sizeof(pending));
+        (void)n;
+
+        ErrorCode result = samplerThread.start<AdaptiveSampler, &AdaptiveSampler::sampleLoop>(this);
+        if (result != ErrorCode::Ok)
+        {
+            spdlog::error("Failed to start sampler for {}", sensor.getDeviceName().c_str());
+            return result;
+        }
+
+        result = applyThreadAttr(samplerThread, threadAttr, "bsp-sampler");
+        if (result != ErrorCode::Ok)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake();
+            samplerThread.join();
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = false;
+            return result;
+        }
+        spdlog::debug("sampler for {} started", sensor.getDeviceName().c_str());
+        return ErrorCode::Ok;
+    }
+
+    void sampleLoop()
+    {
+        prefaultStack(threadAttr.stackPrefaultBytes);
+        Metrics::attachThread();
+        // 订阅者列表的副本，只在订阅变化后重建：稳态下每次采样不拷贝回调、不申请堆内存
+        std::vector<Callback> targets;
+        uint64_t targetsVersion = 0;
+        bool haveTargets = false;
+        Clock::time_point due = Clock::now();
+
+        for (;;)
+        {
+            Clock::time_point now = Clock::now();
+            int timeoutMs = 0;
+            if (due > now)
+            {
+                // 向上取整，避免提前醒来后空转一轮
+                timeoutMs = static_cast<int>(
+                    (std::chrono::duration_cast<std::chrono::microseconds>(due - now).count() + 999) / 1000);
+            }
+            pollfd pfd = {wakeFd, POLLIN, 0};
+            int ret = poll(&pfd, 1, timeoutMs);
+            if (ret < 0 && errno != EINTR)
+            {
+                spdlog::error("poll in sampler for {} failed: {}", sensor.getDeviceName().c_str(),
+                              std::strerror(errno));
+                std::lock_guard<std::mutex> lock(mutex);
+                running = false;
+                break;
+            }
+            if (ret > 0)
+            {
+                uint64_t pending;
+                ssize_t n = read(wakeFd, &pending, sizeof(pending));
+                (void)n;
+            }
+
+            bool boost = boosted.exchange(false);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                // 与 subscribe() 在同一把锁下判断，不会漏掉刚加入的订阅者
+                if (stopping || subscribers.empty())
+                {
+                    running = false;
+                    break;
+                }
+                if (!boost && Clock::now() < due)
+                {
+                    continue;
+                }
+                if (boost)
+                {
+                    policy.boost();
+                }
+                if (!haveTargets || targetsVersion != subscriberVersion)
+                {
+                    targets.clear();
+                    for (const auto &item : subscribers)
+                    {
+                        targets.push_back(item.second);
+                    }
+                    targetsVersion = subscriberVersion;
+                    haveTargets = true;
+                }
+            }
+
+            DataType data;
+            std::memset(&data, 0, sizeof(data));
+            ErrorCode result = sensor.readData(data);
+            ++readCount;
+            uint32_t intervalMs;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                intervalMs = policy.record(result, data);
+            }
+            due = Clock::now() + std::chrono::milliseconds(intervalMs);
+
+            for (const Callback &callback : targets)
+            {
+                if (callback)
+                {
+                    callback(result, data);
+                }
+            }
+        }
+
+        spdlog::debug("sampler for {} stopped after {} reads", sensor.getDeviceName().c_str(),
+                      readCount.load());
+    }
+
+    SensorT &sensor;
+    AdaptiveRate policy;
+    ThreadAttr threadAttr;
+
+    int wakeFd; // 订阅变化、boost() 和 stop() 通过它唤醒阻塞在 poll() 中的采样线程
+    bool running;
+    bool stopping;
+    std::atomic<bool> boosted;
+    Thread samplerThread;
+
+    std::mutex control;         // 串行化线程的启动与停止
+    mutable std::mutex mutex;   // 保护订阅者、policy 和 running/stopping
+    std::map<int, Callback> subscribers;
+    int nextId;
+    uint64_t subscriberVersion; // 订阅者每次变化加一
+    std::atomic<uint64_t> readCount;
+};
+
+} // namespace bsp
+
+#endif // BSP_SAMPLER_H
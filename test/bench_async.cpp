@@ -0,0 +1,226 @@
+// 异步事件循环与每设备一线程的对比基准
+// 用管道模拟 1~64 个 AP3216C 设备，生产者线程轮流向各设备写入采样，
+// 分别用"每设备一个阻塞读线程"和"单线程 EventLoop + readAsync()"读完全部采样，
+// 比较吞吐、CPU 时间和上下文切换次数
+
+#include "../src/common/event_loop.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+struct MockSensor
+{
+    int fds[2];
+    std::string path;
+    std::unique_ptr<AP3216C> sensor;
+    long reads;
+};
+
+struct Result
+{
+    double seconds;
+    double cpuSeconds;
+    long contextSwitches;
+    long samples;
+};
+
+double toSeconds(const timeval &tv)
+{
+    return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+}
+
+// 创建 count 个管道设备（读端通过 /proc/self/fd 打开）
+bool openSensors(std::vector<MockSensor> &sensors, int count)
+{
+    sensors.resize(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        MockSensor &m = sensors[static_cast<std::size_t>(i)];
+        if (pipe(m.fds) != 0)
+        {
+            return false;
+        }
+        m.path = "/proc/self/fd/" + std::to_string(m.fds[0]);
+        DeviceEntry entry = makeDeviceEntry(DeviceType::AP3216C, "mock-ap3216c", m.path.c_str());
+        m.sensor.reset(new AP3216C(entry));
+        m.reads = 0;
+        if (m.sensor->init() != ErrorCode::Ok)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void closeSensors(std::vector<MockSensor> &sensors)
+{
+    for (MockSensor &m : sensors)
+    {
+        m.sensor.reset();
+        close(m.fds[0]);
+        close(m.fds[1]);
+    }
+    sensors.clear();
+}
+
+// 生产者：每轮给每个设备写一条采样（管道满时阻塞，相当于设备产生数据的速率受消费者限制）
+void produce(std::vector<MockSensor> &sensors, long samplesPerDevice)
+{
+    uint16_t raw[3] = {1, 2, 3};
+    for (long s = 0; s < samplesPerDevice; ++s)
+    {
+        for (MockSensor &m : sensors)
+        {
+            ssize_t n = write(m.fds[1], raw, sizeof(raw));
+            (void)n;
+        }
+    }
+}
+
+template <typename Fn> Result measure(std::vector<MockSensor> &sensors, long samplesPerDevice, Fn consume)
+{
+    rusage before;
+    getrusage(RUSAGE_SELF, &before);
+    Clock::time_point start = Clock::now();
+
+    std::thread producer(produce, std::ref(sensors), samplesPerDevice);
+    consume();
+    producer.join();
+
+    Clock::time_point end = Clock::now();
+    rusage after;
+    getrusage(RUSAGE_SELF, &after);
+
+    Result r;
+    r.seconds = std::chrono::duration<double>(end - start).count();
+    r.cpuSeconds = toSeconds(after.ru_utime) + toSeconds(after.ru_stime) - toSeconds(before.ru_utime) -
+                   toSeconds(before.ru_stime);
+    r.contextSwitches = (after.ru_nvcsw + after.ru_nivcsw) - (before.ru_nvcsw + before.ru_nivcsw);
+    r.samples = 0;
+    for (const MockSensor &m : sensors)
+    {
+        r.samples += m.reads;
+    }
+    return r;
+}
+
+// 每设备一个线程，阻塞 readData()
+Result benchThreads(int devices, long samplesPerDevice)
+{
+    std::vector<MockSensor> sensors;
+    if (!openSensors(sensors, devices))
+    {
+        closeSensors(sensors);
+        return Result{0, 0, 0, 0};
+    }
+
+    Result r = measure(sensors, samplesPerDevice, [&] {
+        std::vector<std::thread> readers;
+        for (MockSensor &m : sensors)
+        {
+            readers.emplace_back([&m, samplesPerDevice] {
+                AP3216CData data;
+                for (long i = 0; i < samplesPerDevice; ++i)
+                {
+                    if (m.sensor->readData(data) == ErrorCode::Ok)
+                    {
+                        ++m.reads;
+                    }
+                }
+            });
+        }
+        for (std::thread &t : readers)
+        {
+            t.join();
+        }
+    });
+    closeSensors(sensors);
+    return r;
+}
+
+// 单线程事件循环，每个设备在回调中发起下一次 readAsync()
+Result benchLoop(int devices, long samplesPerDevice)
+{
+    std::vector<MockSensor> sensors;
+    EventLoop loop;
+    if (!openSensors(sensors, devices) || loop.init() != ErrorCode::Ok)
+    {
+        closeSensors(sensors);
+        return Result{0, 0, 0, 0};
+    }
+
+    std::vector<AP3216C::ReadCallback> callbacks(sensors.size());
+    for (std::size_t i = 0; i < sensors.size(); ++i)
+    {
+        MockSensor &m = sensors[i];
+        AP3216C::ReadCallback &self = callbacks[i];
+        self = [&m, &self, &loop, samplesPerDevice](ErrorCode err, const AP3216CData &) {
+            if (err == ErrorCode::Ok)
+            {
+                ++m.reads;
+            }
+            if (m.reads < samplesPerDevice && err == ErrorCode::Ok)
+            {
+                m.sensor->readAsync(loop, self);
+            }
+        };
+    }
+
+    Result r = measure(sensors, samplesPerDevice, [&] {
+        for (std::size_t i = 0; i < sensors.size(); ++i)
+        {
+            sensors[i].sensor->readAsync(loop, callbacks[i]);
+        }
+        loop.run();
+    });
+    closeSensors(sensors);
+    return r;
+}
+
+void printRow(const char *model, int devices, const Result &r)
+{
+    double rate = (r.seconds > 0) ? static_cast<double>(r.samples) / r.seconds : 0;
+    std::printf("%-8s %7d %10ld %12.0f %10.3f %10ld\n", model, devices, r.samples, rate, r.cpuSeconds,
+                r.contextSwitches);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    long totalSamples = (argc >= 2) ? std::atol(argv[1]) : 256000;
+
+    spdlog::set_level(spdlog::level::warn);
+
+    std::printf("========================================\n");
+    std::printf("BSP Async Event Loop Benchmark\n");
+    std::printf("========================================\n");
+    std::printf("Samples per run: %ld (split across devices)\n\n", totalSamples);
+    std::printf("%-8s %7s %10s %12s %10s %10s\n", "model", "devices", "samples", "samples/s", "cpu(s)", "ctxsw");
+
+    const int deviceCounts[] = {1, 4, 16, 64};
+    for (int devices : deviceCounts)
+    {
+        long perDevice = totalSamples / devices;
+        printRow("threads", devices, benchThreads(devices, perDevice));
+        printRow("loop", devices, benchLoop(devices, perDevice));
+    }
+
+    std::printf("========================================\n");
+    return 0;
+}
@@ -0,0 +1,56 @@
+#!/bin/sh
+# bsp_tool 批处理模式基准：对比 N 次独立进程调用与一次 `bsp_tool run` 执行同样 N 条命令的总耗时
+#
+# 用法: bench_batch.sh [次数] [命令...]
+#   bench_batch.sh 500 led set led0 on
+#   bench_batch.sh 1000 ap3216c read ap3216c
+# 环境变量 BSP_TOOL 指定 bsp_tool 路径（默认从 PATH 查找）
+
+COUNT=${1:-200}
+[ $# -gt 0 ] && shift
+[ $# -gt 0 ] || set -- led set led0 on
+BSP_TOOL=${BSP_TOOL:-bsp_tool}
+
+now_ms() {
+    # BusyBox date 可能不支持 %N，回退到 /proc/uptime
+    t=$(date +%s%N 2>/dev/null)
+    case "$t" in
+    *N | "") awk '{ printf "%d\n", $1 * 1000 }' /proc/uptime ;;
+    *) echo $((t / 1000000)) ;;
+    esac
+}
+
+SCRIPT=$(mktemp /tmp/bsp_batch.XXXXXX)
+trap 'rm -f "$SCRIPT"' EXIT
+i=0
+while [ $i -lt "$COUNT" ]; do
+    echo "$*" >>"$SCRIPT"
+    i=$((i + 1))
+done
+
+echo "========================================"
+echo "bsp_tool batch benchmark"
+echo "========================================"
+echo "Command:    $*"
+echo "Iterations: $COUNT"
+
+start=$(now_ms)
+i=0
+fail=0
+while [ $i -lt "$COUNT" ]; do
+    "$BSP_TOOL" "$@" >/dev/null 2>&1 || fail=$((fail + 1))
+    i=$((i + 1))
+done
+per_process=$(($(now_ms) - start))
+
+start=$(now_ms)
+"$BSP_TOOL" run --keep-going "$SCRIPT" >/dev/null 2>&1 || true
+batch=$(($(now_ms) - start))
+
+echo ""
+echo "per-process: ${per_process} ms total ($fail failed)"
+echo "batch (run): ${batch} ms total"
+if [ "$batch" -gt 0 ]; then
+    echo "speedup:     $(awk -v a="$per_process" -v b="$batch" 'BEGIN { printf "%.1fx", a / b }')"
+fi
+echo "========================================"
@@ -0,0 +1,134 @@
+// CLI 注册表解析基准测试
+// 模拟 bsp_tool run 的批处理场景：对一批脚本行做原地切分 + 查表解析，统计每行耗时和堆分配次数
+
+#include "../src/cli/cli_registry.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+// 统计全局堆分配次数
+static std::atomic<unsigned long> allocations(0);
+
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static int noopHandler(CliSession &, const ParsedArgs &)
+{
+    return 0;
+}
+
+// 与 bsp_tool 实际命令表规模相当的测试表
+static const ArgSpec setArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, nullptr, "Device name"},
+    {"state", ArgKind::Choice, "on|off", nullptr, "LED state"},
+};
+static const ArgSpec readArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, "ap3216c", "Device name"},
+};
+static const ArgSpec streamArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, "ap3216c", "Device name"},
+    {"--rate", ArgKind::Double, nullptr, "10", "Sample rate"},
+    {"--count", ArgKind::Int, nullptr, "0", "Samples"},
+    {"--path", ArgKind::Word, nullptr, nullptr, "Node"},
+    {"--trace", ArgKind::Word, nullptr, nullptr, "Trace"},
+    {"--format", ArgKind::Choice, "csv|bin", "csv", "Format"},
+    {"--output", ArgKind::Word, nullptr, nullptr, "Output"},
+};
+static const ArgSpec sleepArgs[] = {
+    {"duration", ArgKind::Duration, nullptr, nullptr, "Time"},
+};
+
+static const CommandSpec benchCommands[] = {
+    {"help|-h|--help", nullptr, nullptr, 0, noopHandler, "", nullptr},
+    {"version|-v|--version", nullptr, nullptr, 0, noopHandler, "", nullptr},
+    {"metrics", nullptr, nullptr, 0, noopHandler, "", nullptr},
+    {"key", "watch", readArgs, argCount(readArgs), noopHandler, "", nullptr},
+    {"dht11", "read", readArgs, argCount(readArgs), noopHandler, "", nullptr},
+    {"dht11", "stream", streamArgs, argCount(streamArgs), noopHandler, "", nullptr},
+    {"ap3216c", "read", readArgs, argCount(readArgs), noopHandler, "", nullptr},
+    {"ap3216c", "stream", streamArgs, argCount(streamArgs), noopHandler, "", nullptr},
+    {"led", "set", setArgs, argCount(setArgs), noopHandler, "", nullptr},
+    {"sleep", nullptr, sleepArgs, argCount(sleepArgs), noopHandler, "", nullptr},
+};
+
+static CommandRegistrar registrar(benchCommands);
+
+int main(int argc, char *argv[])
+{
+    long lines = (argc >= 2) ? std::atol(argv[1]) : 1000000;
+
+    const char *script[] = {
+        "led set led0 on",
+        "sleep 10ms",
+        "led set led0 off  # comment",
+        "ap3216c read",
+        "ap3216c stream als --rate 100 --count 1000 --format bin --output /tmp/a.bin",
+    };
+    const std::size_t scriptLines = sizeof(script) / sizeof(script[0]);
+
+    // 预先准备好可改写的行缓冲区（模拟 getline 复用同一个 std::string）
+    std::vector<std::string> buffers;
+    for (std::size_t i = 0; i < scriptLines; ++i)
+    {
+        buffers.push_back(script[i]);
+        buffers.back().reserve(128);
+    }
+    std::string line;
+    line.reserve(128);
+
+    StrRef tokens[CommandRegistry::MAX_TOKENS];
+    ParsedArgs args;
+    long failures = 0;
+
+    const unsigned long allocBefore = allocations.load();
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < lines; ++i)
+    {
+        line.assign(buffers[static_cast<std::size_t>(i) % scriptLines]);
+        std::size_t count = CommandRegistry::splitLine(&line[0], tokens, CommandRegistry::MAX_TOKENS);
+        if (CommandRegistry::parse(tokens, count, args) != ErrorCode::Ok)
+        {
+            ++failures;
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const unsigned long allocAfter = allocations.load();
+
+    std::printf("========================================\n");
+    std::printf("BSP CLI Parse Benchmark\n");
+    std::printf("========================================\n");
+    std::printf("Lines:             %ld (%ld failed)\n", lines, failures);
+    std::printf("Total:             %.3f s\n", seconds);
+    std::printf("Per line:          %.1f ns\n", seconds * 1e9 / static_cast<double>(lines));
+    std::printf("Throughput:        %.2f M lines/s\n", static_cast<double>(lines) / seconds / 1e6);
+    std::printf("Heap allocations:  %lu\n", allocAfter - allocBefore);
+    std::printf("========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+// 驱动热路径基准：readData()/setState()/isReady() 以及设备对象构造、移动的开销
+// 用于确认驱动迁移到 Device<Derived, Traits> 公共基类后没有性能退化
+
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/dht11/dht11.h"
+#include "../src/driver/led/led.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+static double nsPerOp(Clock::time_point start, Clock::time_point end, long iterations)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
+
+template <typename Sensor, typename Data> static double benchRead(Sensor &sensor, long iterations)
+{
+    Data data;
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        sensor.readData(data);
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+static double benchReadRaw(AP3216C &sensor, long iterations)
+{
+    AP3216CData data;
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        sensor.readRaw(data);
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+static double benchLed(Led &led, long iterations)
+{
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        led.setState((i & 1) != 0);
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+static double benchIsReady(const AP3216C &sensor, long iterations)
+{
+    volatile long ready = 0;
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        ready = ready + (sensor.isReady() ? 1 : 0);
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+// 构造 + 移动构造 + 移动赋值 + 析构（不打开设备）
+static double benchMove(long iterations)
+{
+    DeviceEntry entry = makeDeviceEntry(DeviceType::AP3216C, "ap3216c-zero", "/dev/zero");
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        AP3216C a(entry);
+        AP3216C b(std::move(a));
+        a = std::move(b);
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+int main(int argc, char *argv[])
+{
+    long iterations = (argc >= 2) ? std::atol(argv[1]) : 2000000;
+
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("========================================\n");
+    std::printf("BSP Driver Hot Path Benchmark\n");
+    std::printf("========================================\n");
+    std::printf("Iterations: %ld\n\n", iterations);
+
+    DeviceEntry alsEntry = makeDeviceEntry(DeviceType::AP3216C, "ap3216c-zero", "/dev/zero");
+    DeviceEntry thEntry = makeDeviceEntry(DeviceType::DHT11, "dht11-zero", "/dev/zero");
+    DeviceEntry ledEntry = makeDeviceEntry(DeviceType::Led, "led-null", "/dev/null");
+    AP3216C als(alsEntry);
+    DHT11 th(thEntry);
+    Led led(ledEntry);
+    if (als.init() != ErrorCode::Ok || th.init() != ErrorCode::Ok || led.init() != ErrorCode::Ok)
+    {
+        std::fprintf(stderr, "init failed\n");
+        return 1;
+    }
+
+    // 预热
+    benchRead<AP3216C, AP3216CData>(als, iterations / 10);
+
+    std::printf("AP3216C::readData(/dev/zero):   %8.1f ns/op\n", benchRead<AP3216C, AP3216CData>(als, iterations));
+    std::printf("DHT11::readData(/dev/zero):     %8.1f ns/op\n", benchRead<DHT11, DHT11Data>(th, iterations));
+    std::printf("AP3216C::readRaw(/dev/zero):    %8.1f ns/op\n", benchReadRaw(als, iterations));
+    std::printf("Led::setState(/dev/null ioctl): %8.1f ns/op\n", benchLed(led, iterations));
+    std::printf("AP3216C::isReady():             %8.2f ns/op\n", benchIsReady(als, iterations * 10));
+    std::printf("construct + move + move-assign: %8.1f ns/op\n", benchMove(iterations));
+    std::printf("========================================\n");
+    return 0;
+}
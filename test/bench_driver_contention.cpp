@@ -0,0 +1,218 @@
+// 驱动并发访问基准：1~16 个线程共享同一个驱动实例
+// external = 调用方给每个驱动套一把互斥锁（以前的做法），builtin = 驱动自带的线程安全保证
+// （isReady() 无锁，只有硬件需要时读取才在驱动内串行）
+// 场景：
+//   isReady   所有线程只查询就绪状态
+//   read      所有线程读取同一个 AP3216C（/dev/zero 代替设备）
+//   mixed     1 个线程持续读取，其余线程查询就绪状态（服务中的健康检查、状态页等）
+//   led       所有线程设置同一个 sysfs LED（临时目录代替 /sys/class/leds）
+// 用法: bench_driver_contention [每组运行毫秒数，默认 200]
+
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/led/led.h"
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+// 一个线程的一次操作；role 为线程序号
+using Op = std::function<void(int role)>;
+
+struct RunResult
+{
+    double totalOps;  // 所有线程每秒操作数之和（百万）
+    double probeOps;  // mixed 场景中查询线程每秒操作数之和（百万）
+};
+
+static RunResult run(int threads, int durationMs, const Op &op, bool mixed)
+{
+    std::atomic<bool> go(false);
+    std::atomic<bool> done(false);
+    std::vector<long> counts(static_cast<std::size_t>(threads), 0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i)
+    {
+        workers.push_back(std::thread([&, i] {
+            while (!go.load())
+            {
+                std::this_thread::yield();
+            }
+            long n = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                op(i);
+                ++n;
+            }
+            counts[static_cast<std::size_t>(i)] = n;
+        }));
+    }
+    Clock::time_point start = Clock::now();
+    go = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+    done = true;
+    for (std::thread &t : workers)
+    {
+        t.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    RunResult r = {0.0, 0.0};
+    for (int i = 0; i < threads; ++i)
+    {
+        double mops = static_cast<double>(counts[static_cast<std::size_t>(i)]) / seconds / 1e6;
+        r.totalOps += mops;
+        if (!mixed || i > 0)
+        {
+            r.probeOps += mops;
+        }
+    }
+    return r;
+}
+
+// 临时目录中的 sysfs LED
+struct FakeSysfsLed
+{
+    std::string root;
+    std::string dir;
+
+    FakeSysfsLed()
+    {
+        char tmpl[] = "/tmp/bsp-leds-XXXXXX";
+        root = mkdtemp(tmpl) ? tmpl : "";
+        dir = root + "/bench";
+        mkdir(dir.c_str(), 0755);
+        write("brightness", "0\n");
+        write("max_brightness", "1\n");
+        write("trigger", "[none] timer oneshot\n");
+    }
+
+    ~FakeSysfsLed()
+    {
+        unlink((dir + "/brightness").c_str());
+        unlink((dir + "/max_brightness").c_str());
+        unlink((dir + "/trigger").c_str());
+        rmdir(dir.c_str());
+        rmdir(root.c_str());
+    }
+
+    void write(const char *attr, const char *value)
+    {
+        std::FILE *f = std::fopen((dir + "/" + attr).c_str(), "w");
+        if (f != nullptr)
+        {
+            std::fputs(value, f);
+            std::fclose(f);
+        }
+    }
+};
+
+static void row(const char *scenario, int threads, const RunResult &external, const RunResult &builtin, bool mixed)
+{
+    double a = mixed ? external.probeOps : external.totalOps;
+    double b = mixed ? builtin.probeOps : builtin.totalOps;
+    std::printf("%-8s %7d %12.3f %12.3f %8.2fx\n", scenario, threads, a, b, a > 0.0 ? b / a : 0.0);
+}
+
+int main(int argc, char *argv[])
+{
+    spdlog::set_level(spdlog::level::warn);
+    int durationMs = argc > 1 ? std::atoi(argv[1]) : 200;
+    if (durationMs <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [ms per run]\n", argv[0]);
+        return 1;
+    }
+
+    AP3216C sensor(makeDeviceEntry(DeviceType::AP3216C, "ap3216c", "/dev/zero"));
+    FakeSysfsLed fake;
+    Led led = Led::sysfs("bench", fake.root);
+    if (sensor.init() != ErrorCode::Ok || led.init() != ErrorCode::Ok)
+    {
+        std::fprintf(stderr, "init failed\n");
+        return 1;
+    }
+
+    std::mutex external;
+    Op readyExternal = [&](int) {
+        std::lock_guard<std::mutex> lock(external);
+        (void)sensor.isReady();
+    };
+    Op readyBuiltin = [&](int) { (void)sensor.isReady(); };
+    Op readExternal = [&](int) {
+        AP3216CData data;
+        std::lock_guard<std::mutex> lock(external);
+        sensor.readData(data);
+    };
+    Op readBuiltin = [&](int) {
+        AP3216CData data;
+        sensor.readData(data);
+    };
+    Op mixedExternal = [&](int role) {
+        if (role == 0)
+        {
+            readExternal(role);
+        }
+        else
+        {
+            readyExternal(role);
+        }
+    };
+    Op mixedBuiltin = [&](int role) {
+        if (role == 0)
+        {
+            readBuiltin(role);
+        }
+        else
+        {
+            readyBuiltin(role);
+        }
+    };
+    Op ledExternal = [&](int role) {
+        std::lock_guard<std::mutex> lock(external);
+        led.setState(role % 2 == 0);
+    };
+    Op ledBuiltin = [&](int role) { led.setState(role % 2 == 0); };
+
+    struct Scenario
+    {
+        const char *name;
+        Op *external;
+        Op *builtin;
+        bool mixed;
+    };
+    Scenario scenarios[] = {{"isReady", &readyExternal, &readyBuiltin, false},
+                            {"read", &readExternal, &readBuiltin, false},
+                            {"mixed", &mixedExternal, &mixedBuiltin, true},
+                            {"led", &ledExternal, &ledBuiltin, false}};
+    const int threadCounts[] = {1, 2, 4, 8, 16};
+
+    std::printf("%u CPUs, %d ms per run; Mops/s summed over threads (mixed: isReady() threads only)\n",
+                std::thread::hardware_concurrency(), durationMs);
+    std::printf("%-8s %7s %12s %12s %9s\n", "scenario", "threads", "external", "builtin", "speedup");
+    for (const Scenario &s : scenarios)
+    {
+        for (int threads : threadCounts)
+        {
+            if (s.mixed && threads < 2)
+            {
+                continue;
+            }
+            RunResult a = run(threads, durationMs, *s.external, s.mixed);
+            RunResult b = run(threads, durationMs, *s.builtin, s.mixed);
+            row(s.name, threads, a, b, s.mixed);
+        }
+    }
+    return 0;
+}
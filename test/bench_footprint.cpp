@@ -0,0 +1,145 @@
+// 驱动实例占用：sizeof、构造与 init() 期间的堆分配、init() 之后 1000 次操作的堆分配
+// 同一程序分别在默认配置和嵌入式配置（-DBSP_EMBEDDED=ON）下编译运行，由 size_report.sh 汇总对比
+// 构造使用板级描述文件中常见的设备名/路径；init() 和读取使用 /dev/zero 代替设备
+// 用法: bench_footprint
+
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/dht11/dht11.h"
+#include "../src/driver/key/key.h"
+#include "../src/driver/led/led.h"
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace bsp;
+
+// ============================================================================
+// 堆分配计数
+// ============================================================================
+
+static std::atomic<long> heapAllocations(0);
+static std::atomic<long> heapBytes(0);
+
+void *operator new(std::size_t size)
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    heapBytes.fetch_add(static_cast<long>(size), std::memory_order_relaxed);
+    void *p = std::malloc(size != 0 ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    heapBytes.fetch_add(static_cast<long>(size), std::memory_order_relaxed);
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
+
+struct HeapDelta
+{
+    long allocations;
+    long bytes;
+};
+
+class HeapMeter
+{
+public:
+    HeapMeter() : allocations(heapAllocations.load()), bytes(heapBytes.load())
+    {
+    }
+
+    HeapDelta delta() const
+    {
+        HeapDelta d = {heapAllocations.load() - allocations, heapBytes.load() - bytes};
+        return d;
+    }
+
+private:
+    long allocations;
+    long bytes;
+};
+
+static const int OPS = 1000;
+
+// 无操作的驱动（Key 的事件需要真实输入设备）
+template <typename Driver> static bool noOp(Driver &)
+{
+    return false;
+}
+
+template <typename Sensor> static bool readOps(Sensor &sensor)
+{
+    typename Sensor::DataType data;
+    for (int i = 0; i < OPS; ++i)
+    {
+        sensor.readData(data);
+    }
+    return true;
+}
+
+template <typename Driver>
+static void row(const char *label, DeviceType type, const char *name, const char *path, bool (*ops)(Driver &))
+{
+    HeapDelta ctor;
+    {
+        HeapMeter meter;
+        Driver driver(makeDeviceEntry(type, name, path));
+        ctor = meter.delta();
+    }
+
+    Driver driver(makeDeviceEntry(type, name, "/dev/zero"));
+    HeapMeter initMeter;
+    ErrorCode ret = driver.init();
+    HeapDelta init = initMeter.delta();
+
+    HeapMeter opsMeter;
+    bool ran = ret == ErrorCode::Ok && ops(driver);
+    HeapDelta run = opsMeter.delta();
+
+    char opsCol[32];
+    if (ran)
+    {
+        std::snprintf(opsCol, sizeof(opsCol), "%ld/%ld", run.allocations, run.bytes);
+    }
+    else
+    {
+        std::snprintf(opsCol, sizeof(opsCol), "-");
+    }
+    std::printf("%-8s %7zu %14ld/%-6ld %12ld/%-6ld %14s   %s\n", label, sizeof(Driver), ctor.allocations, ctor.bytes,
+                init.allocations, init.bytes, opsCol, path);
+}
+
+int main()
+{
+    spdlog::set_level(spdlog::level::off);
+
+#if BSP_EMBEDDED
+    std::printf("profile: embedded (device name <= %d, path <= %d characters)\n", BSP_DEVICE_NAME_MAX,
+                BSP_DEVICE_PATH_MAX);
+#else
+    std::printf("profile: default\n");
+#endif
+    std::printf("heap columns: allocations/bytes; ops = %d readData() calls\n", OPS);
+    std::printf("%-8s %7s %21s %19s %14s   %s\n", "driver", "sizeof", "construct", "init", "ops", "path");
+    row<Led>("led", DeviceType::Led, "sys-led", "/sys/class/leds/sys-led", noOp<Led>);
+    row<Key>("key", DeviceType::Key, "key0", "/dev/input/event2", noOp<Key>);
+    row<AP3216C>("ap3216c", DeviceType::AP3216C, "ap3216c", "/dev/ap3216c", readOps<AP3216C>);
+    row<DHT11>("dht11", DeviceType::DHT11, "dht11", "/dev/dht11", readOps<DHT11>);
+    return 0;
+}
@@ -0,0 +1,86 @@
+// 传感器健康监测基准：每个样本 record() 的额外开销
+// 对比仅做读数转换与转换 + HealthMonitor::record() 的每样本耗时
+// 用法: bench_health [样本数]
+
+#include "../src/driver/sensor_units.h"
+#include "../src/pipeline/health.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+static volatile float sink;
+
+static double nsPerSample(Clock::time_point start, Clock::time_point end, std::size_t samples)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(samples);
+}
+
+static double benchConvertOnly(const std::vector<AP3216CData> &samples)
+{
+    AP3216CConverter converter;
+    Clock::time_point start = Clock::now();
+    for (const AP3216CData &s : samples)
+    {
+        sink = converter.toFloat(s).lux;
+    }
+    return nsPerSample(start, Clock::now(), samples.size());
+}
+
+static double benchMonitored(const std::vector<AP3216CData> &samples, uint64_t &events)
+{
+    AP3216CConverter converter;
+    HealthMonitor monitor = HealthMonitor::forAP3216C("ap3216c");
+    events = 0;
+    monitor.setCallback([&events](const HealthEvent &) { ++events; });
+
+    Clock::time_point start = Clock::now();
+    for (const AP3216CData &s : samples)
+    {
+        sink = converter.toFloat(s).lux;
+        monitor.record(ErrorCode::Ok, s);
+    }
+    return nsPerSample(start, Clock::now(), samples.size());
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+    if (count == 0)
+    {
+        std::fprintf(stderr, "usage: %s [samples]\n", argv[0]);
+        return 1;
+    }
+
+    // 照度带噪声缓慢起伏（三角波），接近值大部分时间不变，偶有一次跳变
+    std::vector<AP3216CData> samples(count);
+    unsigned seed = 1;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        samples[i].ir = static_cast<uint16_t>(10 + (seed >> 16) % 3);
+        std::size_t phase = (i / 50) % 80;
+        samples[i].als = static_cast<uint16_t>(800 + (phase < 40 ? phase : 80 - phase) + (seed >> 20) % 5);
+        samples[i].ps = static_cast<uint16_t>((i % 100000) == 99999 ? 900 : 40);
+    }
+
+    // 告警日志不计入 record() 开销
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("samples=%zu\n", count);
+    std::printf("%-28s %10s %8s\n", "method", "ns/sample", "events");
+
+    double base = benchConvertOnly(samples);
+    std::printf("%-28s %10.1f %8s\n", "convert only", base, "-");
+
+    uint64_t events = 0;
+    double monitored = benchMonitored(samples, events);
+    std::printf("%-28s %10.1f %8llu\n", "convert + health record", monitored, static_cast<unsigned long long>(events));
+    std::printf("%-28s %10.1f\n", "health overhead", monitored - base);
+
+    return 0;
+}
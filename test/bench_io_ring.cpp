@@ -0,0 +1,267 @@
+// 批量 I/O 基准：逐次 readData() 与 IoRing 批量提交（POSIX / io_uring / io_uring + 固定 fd 和缓冲区）
+// 用普通文件和管道代替设备节点，比较每次读取的耗时和系统调用数
+
+#include "../src/common/io_ring.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+// 每批的设备数（每个设备一次读取）
+constexpr int DEVICES = 8;
+
+enum class Mode
+{
+    Sync,       // AP3216C::readData()
+    RingPosix,  // IoRing POSIX 后端
+    RingUring,  // IoRing io_uring 后端
+    RingFixed   // io_uring + registerFiles/registerBuffers
+};
+
+const char *modeName(Mode mode)
+{
+    switch (mode)
+    {
+    case Mode::Sync:
+        return "readData()";
+    case Mode::RingPosix:
+        return "IoRing posix";
+    case Mode::RingUring:
+        return "IoRing io_uring";
+    case Mode::RingFixed:
+        return "io_uring + fixed";
+    }
+    return "?";
+}
+
+// 设备替身：普通文件（足够长，顺序读不到末尾）或管道（生产者线程持续写入）
+struct StandIn
+{
+    std::string path;
+    int pipeFds[2];
+    std::unique_ptr<AP3216C> sensor;
+};
+
+class Fixture
+{
+public:
+    Fixture(bool usePipes, long opsPerDevice) : pipes(usePipes), opsPerDevice(opsPerDevice), devices(DEVICES)
+    {
+        std::vector<char> zeros(static_cast<std::size_t>(opsPerDevice) * sizeof(AP3216CData), 1);
+        for (int i = 0; i < DEVICES; ++i)
+        {
+            StandIn &d = devices[static_cast<std::size_t>(i)];
+            d.pipeFds[0] = d.pipeFds[1] = -1;
+            if (pipes)
+            {
+                if (pipe(d.pipeFds) != 0)
+                {
+                    continue;
+                }
+                d.path = "/proc/self/fd/" + std::to_string(d.pipeFds[0]);
+            }
+            else
+            {
+                d.path = "/tmp/bsp_bench_io_ring_" + std::to_string(getpid()) + "_" + std::to_string(i);
+                FILE *file = std::fopen(d.path.c_str(), "wb");
+                if (file != nullptr)
+                {
+                    std::fwrite(zeros.data(), 1, zeros.size(), file);
+                    std::fclose(file);
+                }
+            }
+            DeviceEntry entry = makeDeviceEntry(DeviceType::AP3216C, "standin", d.path.c_str());
+            d.sensor.reset(new AP3216C(entry));
+            d.sensor->init();
+        }
+        if (pipes)
+        {
+            producer = std::thread(&Fixture::produce, this);
+        }
+    }
+
+    ~Fixture()
+    {
+        // 先关闭读端，提前结束的运行中生产者会因 EPIPE 退出
+        for (StandIn &d : devices)
+        {
+            d.sensor.reset();
+            if (pipes)
+            {
+                close(d.pipeFds[0]);
+            }
+            else
+            {
+                unlink(d.path.c_str());
+            }
+        }
+        if (producer.joinable())
+        {
+            producer.join();
+        }
+        for (StandIn &d : devices)
+        {
+            if (pipes)
+            {
+                close(d.pipeFds[1]);
+            }
+        }
+    }
+
+    AP3216C &sensor(int i)
+    {
+        return *devices[static_cast<std::size_t>(i)].sensor;
+    }
+
+private:
+    void produce()
+    {
+        AP3216CData sample = {1, 2, 3};
+        for (long s = 0; s < opsPerDevice; ++s)
+        {
+            for (StandIn &d : devices)
+            {
+                if (write(d.pipeFds[1], &sample, sizeof(sample)) < 0)
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    bool pipes;
+    long opsPerDevice;
+    std::vector<StandIn> devices;
+    std::thread producer;
+};
+
+struct Result
+{
+    double nsPerOp;
+    double syscallsPerOp;
+    long errors;
+};
+
+Result run(Mode mode, bool usePipes, long opsPerDevice)
+{
+    Fixture fixture(usePipes, opsPerDevice);
+    AP3216CData data[DEVICES];
+    long errors = 0;
+    long total = opsPerDevice * DEVICES;
+
+    IoRing ring;
+    if (mode != Mode::Sync)
+    {
+        ring.init(DEVICES, mode != Mode::RingPosix);
+        if (mode != Mode::RingPosix && ring.backend() != IoBackend::IoUring)
+        {
+            return Result{-1, -1, 0};
+        }
+        if (mode == Mode::RingFixed)
+        {
+            int fds[DEVICES];
+            for (int i = 0; i < DEVICES; ++i)
+            {
+                fds[i] = fixture.sensor(i).getFd();
+            }
+            iovec buffer = {data, sizeof(data)};
+            if (ring.registerFiles(fds, DEVICES) != ErrorCode::Ok || ring.registerBuffers(&buffer, 1) != ErrorCode::Ok)
+            {
+                return Result{-1, -1, 0};
+            }
+        }
+    }
+    IoRingStats before = ring.stats();
+
+    Clock::time_point start = Clock::now();
+    for (long s = 0; s < opsPerDevice; ++s)
+    {
+        if (mode == Mode::Sync)
+        {
+            for (int i = 0; i < DEVICES; ++i)
+            {
+                if (fixture.sensor(i).readData(data[i]) != ErrorCode::Ok)
+                {
+                    ++errors;
+                }
+            }
+            continue;
+        }
+
+        for (int i = 0; i < DEVICES; ++i)
+        {
+            fixture.sensor(i).queueRead(ring, data[i], static_cast<uint64_t>(i));
+        }
+        ring.submit(DEVICES);
+        IoCompletion completions[DEVICES];
+        unsigned got = ring.reap(completions, DEVICES);
+        for (unsigned i = 0; i < got; ++i)
+        {
+            if (completionResult(completions[i], sizeof(AP3216CData)) != ErrorCode::Ok)
+            {
+                ++errors;
+            }
+        }
+        errors += DEVICES - static_cast<long>(got);
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    Result r;
+    r.nsPerOp = elapsed / static_cast<double>(total);
+    // 同步路径每次读取就是一次 read()
+    r.syscallsPerOp = (mode == Mode::Sync)
+                          ? 1.0
+                          : static_cast<double>(ring.stats().syscalls - before.syscalls) / static_cast<double>(total);
+    r.errors = errors;
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    long totalOps = (argc >= 2) ? std::atol(argv[1]) : 400000;
+    long opsPerDevice = totalOps / DEVICES;
+
+    spdlog::set_level(spdlog::level::off);
+    signal(SIGPIPE, SIG_IGN);
+
+    std::printf("========================================\n");
+    std::printf("BSP Batched I/O Benchmark\n");
+    std::printf("========================================\n");
+    std::printf("%ld reads per run, %d devices per batch\n\n", opsPerDevice * DEVICES, DEVICES);
+    std::printf("%-8s %-18s %10s %12s %12s %8s\n", "stand-in", "path", "ns/op", "reads/s", "syscalls/op", "errors");
+
+    const Mode modes[] = {Mode::Sync, Mode::RingPosix, Mode::RingUring, Mode::RingFixed};
+    const bool standIns[] = {false, true};
+    for (bool usePipes : standIns)
+    {
+        for (Mode mode : modes)
+        {
+            Result r = run(mode, usePipes, opsPerDevice);
+            if (r.nsPerOp < 0)
+            {
+                std::printf("%-8s %-18s %10s\n", usePipes ? "pipe" : "file", modeName(mode), "n/a");
+                continue;
+            }
+            std::printf("%-8s %-18s %10.1f %12.0f %12.3f %8ld\n", usePipes ? "pipe" : "file", modeName(mode),
+                        r.nsPerOp, 1e9 / r.nsPerOp, r.syscallsPerOp, r.errors);
+        }
+    }
+
+    std::printf("========================================\n");
+    return 0;
+}
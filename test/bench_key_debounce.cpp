@@ -0,0 +1,148 @@
+// 按键消抖基准：模拟带机械抖动和自动重复的按键序列，统计每次物理按键派发的逻辑事件数
+// 以及每个原始事件的处理开销
+// 用法: bench_key_debounce [物理按键次数]
+
+#include "../src/driver/key/key_debounce.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+struct RawEvent
+{
+    uint16_t type;
+    uint16_t code;
+    int32_t value;
+    uint64_t timeUs;
+};
+
+static unsigned seed = 1;
+
+static unsigned nextRandom(unsigned range)
+{
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 16) % range;
+}
+
+static void push(std::vector<RawEvent> &events, uint16_t code, int32_t value, uint64_t timeUs)
+{
+    RawEvent key = {EV_KEY, code, value, timeUs};
+    RawEvent syn = {EV_SYN, SYN_REPORT, 0, timeUs};
+    events.push_back(key);
+    events.push_back(syn);
+}
+
+// 一次边沿：先抖动 0~8 次（间隔 0.2~2 ms），最后停在 value
+static uint64_t edge(std::vector<RawEvent> &events, uint16_t code, int32_t value, uint64_t t)
+{
+    unsigned bounces = nextRandom(9);
+    for (unsigned i = 0; i < bounces; ++i)
+    {
+        push(events, code, (i % 2 == 0) ? value : !value, t);
+        t += 200 + nextRandom(1800);
+    }
+    push(events, code, value, t);
+    return t;
+}
+
+static std::vector<RawEvent> makeScript(std::size_t presses)
+{
+    static const uint16_t codes[] = {KEY_ENTER, KEY_UP, KEY_DOWN, KEY_POWER};
+    std::vector<RawEvent> events;
+    uint64_t t = 0;
+    for (std::size_t i = 0; i < presses; ++i)
+    {
+        uint16_t code = codes[nextRandom(4)];
+        t = edge(events, code, 1, t);
+        // 按住 50~800 ms，超过 250 ms 后每 33 ms 一次自动重复
+        uint64_t hold = (50 + nextRandom(750)) * 1000u;
+        for (uint64_t r = 250000; r < hold; r += 33000)
+        {
+            push(events, code, 2, t + r);
+        }
+        t = edge(events, code, 0, t + hold);
+        t += (100 + nextRandom(400)) * 1000u;
+    }
+    return events;
+}
+
+static void run(const char *label, const KeyDebounceConfig &config, const std::vector<RawEvent> &events,
+                std::size_t presses)
+{
+    KeyDebouncer debouncer(config);
+    KeyLogicalEvent out;
+    uint64_t pressed = 0;
+    uint64_t released = 0;
+
+    Clock::time_point start = Clock::now();
+    for (const RawEvent &e : events)
+    {
+        // 事件线程在时间窗结束时醒来确认状态，这里在每个事件到来前推进时间
+        debouncer.expire(e.timeUs);
+        debouncer.feed(e.type, e.code, e.value, e.timeUs);
+        while (debouncer.pop(out))
+        {
+            pressed += out.value == 1 ? 1 : 0;
+            released += out.value == 0 ? 1 : 0;
+        }
+    }
+    debouncer.expire(UINT64_MAX);
+    while (debouncer.pop(out))
+    {
+        pressed += out.value == 1 ? 1 : 0;
+        released += out.value == 0 ? 1 : 0;
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    KeyDebounceStats s = debouncer.stats();
+    std::printf("%-26s %10.2f %8llu %8llu %8llu %8llu %8llu %10.1f\n", label,
+                static_cast<double>(s.dispatched) / static_cast<double>(presses),
+                static_cast<unsigned long long>(pressed), static_cast<unsigned long long>(released),
+                static_cast<unsigned long long>(s.bounced), static_cast<unsigned long long>(s.coalesced),
+                static_cast<unsigned long long>(s.repeats), ns / static_cast<double>(events.size()));
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t presses = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 100000;
+    if (presses == 0)
+    {
+        std::fprintf(stderr, "usage: %s [presses]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<RawEvent> events = makeScript(presses);
+    std::size_t keyEvents = 0;
+    for (const RawEvent &e : events)
+    {
+        keyEvents += e.type == EV_KEY ? 1 : 0;
+    }
+    std::printf("physical presses=%zu, raw EV_KEY events=%zu (%.2f per press)\n", presses, keyEvents,
+                static_cast<double>(keyEvents) / static_cast<double>(presses));
+    std::printf("%-26s %10s %8s %8s %8s %8s %8s %10s\n", "config", "per press", "press", "release", "bounced",
+                "coalesce", "repeats", "ns/event");
+
+    KeyDebounceConfig config;
+    run("raw (no debounce)", config, events, presses);
+
+    config.windowMs = 5;
+    run("window 5 ms", config, events, presses);
+
+    config.windowMs = 10;
+    run("window 10 ms", config, events, presses);
+
+    // 抖动最长持续约 16 ms，窗口需覆盖整段抖动
+    config.windowMs = 20;
+    run("window 20 ms", config, events, presses);
+
+    config.suppressRepeat = true;
+    run("window 20 ms + no repeat", config, events, presses);
+
+    config.frameBatching = true;
+    run("  + frame batching", config, events, presses);
+
+    return 0;
+}
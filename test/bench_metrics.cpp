@@ -0,0 +1,135 @@
+// 驱动运行统计埋点开销基准测试
+// 测量 MetricsTimer 计时 + 记录的单次开销，以及多线程并发记录时是否存在伪共享
+
+#include "../src/common/metrics.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+static double nsPerOp(Clock::time_point start, Clock::time_point end, long iterations)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
+
+// 仅两次读时钟（埋点开销的下限）
+static double benchClockOnly(long iterations)
+{
+    volatile int64_t sink = 0;
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        Clock::time_point a = Clock::now();
+        Clock::time_point b = Clock::now();
+        sink = sink + (b - a).count();
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+// MetricsTimer 完整埋点：两次读时钟 + 记录
+static double benchTimer(long iterations)
+{
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        MetricsTimer timer(MetricOp::LedSetState);
+        timer.finish(ErrorCode::Ok);
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+// 仅记录（不读时钟）
+static double benchRecord(long iterations)
+{
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        Metrics::record(MetricOp::DHT11Read, ErrorCode::Ok, static_cast<uint64_t>(i & 0xFFFF));
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+// 真实驱动路径：AP3216C::readData() 读 /dev/zero
+static double benchDriverRead(long iterations)
+{
+    DeviceEntry entry = makeDeviceEntry(DeviceType::AP3216C, "ap3216c-zero", "/dev/zero");
+
+    AP3216C sensor(entry);
+    if (sensor.init() != ErrorCode::Ok)
+    {
+        return -1.0;
+    }
+
+    AP3216CData data;
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        sensor.readData(data);
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+int main(int argc, char *argv[])
+{
+    long iterations = (argc >= 2) ? std::atol(argv[1]) : 2000000;
+    unsigned threads = (argc >= 3) ? static_cast<unsigned>(std::atoi(argv[2])) : 4;
+
+    spdlog::set_level(spdlog::level::warn);
+
+    std::printf("========================================\n");
+    std::printf("BSP Metrics Overhead Benchmark\n");
+    std::printf("========================================\n");
+    std::printf("Metrics compiled in: %s\n", Metrics::enabled() ? "yes" : "no");
+    std::printf("Iterations:          %ld\n\n", iterations);
+
+    double clockNs = benchClockOnly(iterations);
+    double timerNs = benchTimer(iterations);
+    double recordNs = benchRecord(iterations);
+    double readNs = benchDriverRead(iterations / 10);
+
+    std::printf("2x steady_clock::now():           %8.1f ns/op\n", clockNs);
+    std::printf("MetricsTimer (clock + record):    %8.1f ns/op\n", timerNs);
+    std::printf("Metrics::record() only:           %8.1f ns/op\n", recordNs);
+    std::printf("AP3216C::readData(/dev/zero):     %8.1f ns/op\n", readNs);
+
+    // 多线程并发记录：各线程写各自分片，单线程开销应基本不变
+    std::vector<double> perThread(threads, 0.0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([t, iterations, &perThread] { perThread[t] = benchTimer(iterations); });
+    }
+    for (auto &w : workers)
+    {
+        w.join();
+    }
+    double sum = 0.0;
+    for (double v : perThread)
+    {
+        sum += v;
+    }
+    std::printf("MetricsTimer, %u threads:          %8.1f ns/op (per thread avg)\n", threads,
+                threads ? sum / threads : 0.0);
+
+    MetricsSnapshot snap = Metrics::snapshot();
+    const OpStats &led = snap[MetricOp::LedSetState];
+    const OpStats &ap = snap[MetricOp::AP3216CRead];
+    std::printf("\nSnapshot: %s ops=%llu p50=%llu ns p99=%llu ns\n", metricOpName(MetricOp::LedSetState),
+                static_cast<unsigned long long>(led.ops),
+                static_cast<unsigned long long>(led.latency.valueAtQuantile(0.5)),
+                static_cast<unsigned long long>(led.latency.valueAtQuantile(0.99)));
+    std::printf("Snapshot: %s ops=%llu p50=%llu ns p99=%llu ns errors=%llu\n", metricOpName(MetricOp::AP3216CRead),
+                static_cast<unsigned long long>(ap.ops),
+                static_cast<unsigned long long>(ap.latency.valueAtQuantile(0.5)),
+                static_cast<unsigned long long>(ap.latency.valueAtQuantile(0.99)),
+                static_cast<unsigned long long>(ap.errors()));
+    std::printf("========================================\n");
+
+    return 0;
+}
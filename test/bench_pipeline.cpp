@@ -0,0 +1,141 @@
+// 派生量流水线基准：每个样本到来时应用层全量重算 vs Pipeline 增量重算
+// 样本流模拟实际采样节奏：AP3216C 每 100 个样本穿插一个 DHT11 样本
+// 用法: bench_pipeline [样本数]
+
+#include "../src/pipeline/pipeline.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+static volatile float sink;
+
+struct Sample
+{
+    bool isDHT11;
+    AP3216CData light;
+    DHT11Data climate;
+};
+
+static double nsPerSample(Clock::time_point start, Clock::time_point end, std::size_t samples)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(samples);
+}
+
+// 迁移前的写法：每个样本都重算全部派生量
+static double benchFullRecompute(const std::vector<Sample> &samples)
+{
+    AP3216CConverter lightConverter;
+    DHT11Converter climateConverter;
+    float humidity = NAN;
+    float temperature = NAN;
+    float lux = NAN;
+    float ps = NAN;
+    float smooth = NAN;
+    float nearState = 0.0f;
+
+    Clock::time_point start = Clock::now();
+    for (const Sample &s : samples)
+    {
+        if (s.isDHT11)
+        {
+            DHT11ReadingF r = climateConverter.toFloat(s.climate);
+            humidity = r.humidity;
+            temperature = r.temperature;
+        }
+        else
+        {
+            AP3216CReadingF r = lightConverter.toFloat(s.light);
+            lux = r.lux;
+            ps = r.ps;
+        }
+        float dew = derive::dewPoint(temperature, humidity);
+        float heat = derive::heatIndex(temperature, humidity);
+        smooth = std::isnan(smooth) ? lux : smooth + 0.25f * (lux - smooth);
+        nearState = ps >= 500.0f ? 1.0f : (ps <= 100.0f ? 0.0f : nearState);
+        float brightness = nearState != 0.0f ? 0.0f : smooth;
+        sink = dew + heat + brightness;
+    }
+    return nsPerSample(start, Clock::now(), samples.size());
+}
+
+static double benchPipeline(const std::vector<Sample> &samples, bool withListener, uint64_t &evaluations)
+{
+    Pipeline pipe;
+    DHT11Source th = pipe.addSource("dht11", DHT11Converter());
+    AP3216CSource als = pipe.addSource("ap3216c", AP3216CConverter());
+    ChannelId dew = pipe.addDerived("dew_point", {th.temperature, th.humidity}, derive::dewPoint());
+    pipe.addDerived("heat_index", {th.temperature, th.humidity}, derive::heatIndex());
+    ChannelId smooth = pipe.addDerived("lux_smooth", {als.lux}, derive::ema(0.25f));
+    ChannelId nearState = pipe.addDerived("proximity", {als.ps}, derive::hysteresis(100.0f, 500.0f));
+    ChannelId brightness = pipe.addDerived("brightness", {smooth, nearState},
+                                           [](const float *in, float) { return in[1] != 0.0f ? 0.0f : in[0]; });
+    if (withListener)
+    {
+        pipe.setListener([dew, brightness](const Pipeline &p, const PipelineSample &) {
+            sink = p.value(dew) + p.value(brightness);
+        });
+    }
+
+    Clock::time_point start = Clock::now();
+    for (const Sample &s : samples)
+    {
+        if (s.isDHT11)
+        {
+            pipe.push(th, s.climate);
+        }
+        else
+        {
+            pipe.push(als, s.light);
+        }
+    }
+    double ns = nsPerSample(start, Clock::now(), samples.size());
+    evaluations = pipe.evaluations();
+    return ns;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+    if (count == 0)
+    {
+        std::fprintf(stderr, "usage: %s [samples]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Sample> samples(count);
+    unsigned seed = 1;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        Sample &s = samples[i];
+        s.isDHT11 = (i % 100) == 0;
+        // 照度缓慢变化，接近传感器大部分时间不变；温湿度偶尔变化
+        s.light.ir = 10;
+        s.light.als = static_cast<uint16_t>(800 + (i / 50) % 40);
+        s.light.ps = static_cast<uint16_t>(((seed >> 16) % 1000) < 5 ? 700 : 40);
+        s.climate.humidity_int = static_cast<uint8_t>(55 + (i / 20000) % 5);
+        s.climate.humidity_decimal = 0;
+        s.climate.temperature_int = static_cast<uint8_t>(28 + (i / 50000) % 3);
+        s.climate.temperature_decimal = 0;
+    }
+
+    std::printf("samples=%zu (1 DHT11 per 100 AP3216C)\n", count);
+    std::printf("%-28s %10s %12s\n", "method", "ns/sample", "evals/sample");
+
+    double ns = benchFullRecompute(samples);
+    std::printf("%-28s %10.1f %12.2f\n", "full recompute (app code)", ns, 5.0);
+
+    uint64_t evaluations = 0;
+    ns = benchPipeline(samples, false, evaluations);
+    std::printf("%-28s %10.1f %12.2f\n", "pipeline", ns, static_cast<double>(evaluations) / count);
+
+    ns = benchPipeline(samples, true, evaluations);
+    std::printf("%-28s %10.1f %12.2f\n", "pipeline + listener", ns, static_cast<double>(evaluations) / count);
+
+    return 0;
+}
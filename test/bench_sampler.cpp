@@ -0,0 +1,287 @@
+// 自适应采样基准：在数据集上回放 AdaptiveRate，与按最高速率固定采样对比读取次数，
+// 并统计接近事件的发现延迟和被跟踪量的最大偏差（两次采样之间沿用上一次读数）
+// 数据集默认为合成数据（办公室光照 8 小时、室内温湿度 24 小时），也可以回放
+// `bsp ap3216c stream --format bin` / `bsp dht11 stream --format bin` 录制的文件
+// 合成数据集按不同的最长采样间隔各回放一次
+// 用法: bench_sampler [ap3216c|dht11 录制文件]
+
+#include "../src/cli/cli_stream.h"
+#include "../src/driver/sensor_units.h"
+#include "../src/pipeline/sampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+using namespace bsp;
+
+template <typename T> struct Recorded
+{
+    uint64_t timestampNs;
+    T data;
+};
+
+struct ReplayResult
+{
+    uint64_t fixedReads;
+    uint64_t adaptiveReads;
+    uint64_t events;     // 数据集中的事件数
+    uint64_t seen;       // 自适应采样看到的事件数
+    double meanDelayMs;  // 看到的事件的平均发现延迟
+    double maxDelayMs;
+    double maxError;     // 被跟踪量的最大偏差
+};
+
+static uint64_t msToNs(uint64_t ms)
+{
+    return ms * 1000000u;
+}
+
+/**
+ * 回放：t 时刻的读数取时间戳不晚于 t 的最后一条记录
+ * @param tracked 被跟踪量（用于计算偏差）
+ * @param event 记录是否处于事件中（如接近），nullptr 表示不统计事件
+ */
+template <typename T>
+static ReplayResult replay(const std::vector<Recorded<T>> &records, AdaptiveRate rate,
+                           std::function<float(const T &)> tracked, std::function<bool(const T &)> event)
+{
+    ReplayResult r;
+    std::memset(&r, 0, sizeof(r));
+    uint64_t end = records.back().timestampNs;
+    uint64_t start = records.front().timestampNs;
+    r.fixedReads = (end - start) / msToNs(rate.rateConfig().minIntervalMs) + 1;
+
+    // 各事件的开始/结束时刻
+    std::vector<std::pair<uint64_t, uint64_t>> spans;
+    if (event)
+    {
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            bool on = event(records[i].data);
+            if (on && (i == 0 || !event(records[i - 1].data)))
+            {
+                spans.push_back(std::make_pair(records[i].timestampNs, end));
+            }
+            else if (!on && i > 0 && event(records[i - 1].data) && !spans.empty())
+            {
+                spans.back().second = records[i].timestampNs;
+            }
+        }
+    }
+    r.events = spans.size();
+
+    std::vector<bool> seen(spans.size(), false);
+    std::size_t idx = 0;
+    std::size_t span = 0;
+    float held = tracked(records.front().data);
+    uint64_t t = start;
+    double delaySum = 0.0;
+    while (t <= end)
+    {
+        while (idx + 1 < records.size() && records[idx + 1].timestampNs <= t)
+        {
+            ++idx;
+            // 两次采样之间的真实值与沿用读数的偏差
+            r.maxError = std::max(r.maxError, static_cast<double>(std::fabs(tracked(records[idx].data) - held)));
+        }
+        const T &data = records[idx].data;
+        held = tracked(data);
+        ++r.adaptiveReads;
+
+        while (span < spans.size() && spans[span].second <= t)
+        {
+            ++span;
+        }
+        if (event && span < spans.size() && spans[span].first <= t && event(data) && !seen[span])
+        {
+            seen[span] = true;
+            ++r.seen;
+            double delay = static_cast<double>(t - spans[span].first) / 1e6;
+            delaySum += delay;
+            r.maxDelayMs = std::max(r.maxDelayMs, delay);
+        }
+
+        t += msToNs(rate.record(ErrorCode::Ok, data));
+    }
+    r.meanDelayMs = r.seen > 0 ? delaySum / static_cast<double>(r.seen) : 0.0;
+    return r;
+}
+
+static void printResult(const char *dataset, uint64_t durationS, const ReplayResult &r, bool events)
+{
+    double saved = 100.0 * (1.0 - static_cast<double>(r.adaptiveReads) / static_cast<double>(r.fixedReads));
+    std::printf("%-26s %8llu %10llu %10llu %7.1f%%", dataset, static_cast<unsigned long long>(durationS),
+                static_cast<unsigned long long>(r.fixedReads), static_cast<unsigned long long>(r.adaptiveReads),
+                saved);
+    if (events)
+    {
+        std::printf(" %5llu/%-5llu %8.0f %8.0f", static_cast<unsigned long long>(r.seen),
+                    static_cast<unsigned long long>(r.events), r.meanDelayMs, r.maxDelayMs);
+    }
+    else
+    {
+        std::printf(" %11s %8s %8s", "-", "-", "-");
+    }
+    std::printf(" %9.1f\n", r.maxError);
+}
+
+// 办公室光照，10 Hz 记录 8 小时：日光缓慢起伏、偶尔开关灯，约每 15 分钟有人靠近一次（1~3 s）
+static std::vector<Recorded<AP3216CData>> officeLight()
+{
+    const uint64_t periodMs = 100;
+    const std::size_t count = 8 * 3600 * 1000 / periodMs;
+    std::vector<Recorded<AP3216CData>> records(count);
+    unsigned seed = 7;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        double hours = static_cast<double>(i * periodMs) / 3.6e6;
+        double daylight = 300.0 + 250.0 * std::sin(hours / 8.0 * 3.14159);
+        bool lamp = (hours > 1.0 && hours < 3.5) || (hours > 5.2 && hours < 7.8);
+        std::size_t inCycle = i % 9000;
+        bool near = inCycle >= 4000 && inCycle < 4000 + 10 + (i / 9000) % 20;
+
+        AP3216CData &d = records[i].data;
+        d.als = static_cast<uint16_t>(daylight + (lamp ? 400.0 : 0.0) + (seed >> 16) % 7);
+        d.ir = static_cast<uint16_t>(daylight / 20.0 + (seed >> 20) % 3);
+        d.ps = static_cast<uint16_t>((near ? 700 : 40) + (seed >> 24) % 5);
+        records[i].timestampNs = msToNs(i * periodMs);
+    }
+    return records;
+}
+
+// 室内温湿度，1 Hz 记录 24 小时：温度随昼夜 20~24 C 变化，傍晚开暖气 1 小时，湿度 40~50 %RH
+static std::vector<Recorded<DHT11Data>> roomClimate()
+{
+    const std::size_t count = 24 * 3600;
+    std::vector<Recorded<DHT11Data>> records(count);
+    unsigned seed = 11;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        double hours = static_cast<double>(i) / 3600.0;
+        double temp = 22.0 + 2.0 * std::sin((hours - 9.0) / 24.0 * 2.0 * 3.14159);
+        if (hours > 18.0 && hours < 19.0)
+        {
+            temp += 3.0 * (hours - 18.0);
+        }
+        double humidity = 45.0 - 5.0 * std::sin((hours - 9.0) / 24.0 * 2.0 * 3.14159);
+        // 偶发 ±1 个最低有效位的抖动
+        temp += ((seed >> 16) % 10 == 0) ? 0.1 : 0.0;
+
+        DHT11Data &d = records[i].data;
+        d.humidity_int = static_cast<uint8_t>(humidity);
+        d.humidity_decimal = 0;
+        d.temperature_int = static_cast<uint8_t>(temp);
+        d.temperature_decimal = static_cast<uint8_t>(static_cast<int>(temp * 10.0) % 10);
+        records[i].timestampNs = msToNs(i * 1000);
+    }
+    return records;
+}
+
+template <typename Rec, typename T> static bool loadRecording(const char *path, std::vector<Recorded<T>> &records)
+{
+    FILE *f = std::fopen(path, "rb");
+    if (f == nullptr)
+    {
+        std::perror(path);
+        return false;
+    }
+    Rec rec;
+    while (std::fread(&rec, sizeof(rec), 1, f) == 1)
+    {
+        Recorded<T> r;
+        r.timestampNs = rec.timestamp_ns;
+        std::memcpy(&r.data, reinterpret_cast<const char *>(&rec) + sizeof(uint64_t), sizeof(T));
+        records.push_back(r);
+    }
+    std::fclose(f);
+    return records.size() >= 2;
+}
+
+static float lux(const AP3216CData &d)
+{
+    return static_cast<float>(d.als);
+}
+
+static bool proximity(const AP3216CData &d)
+{
+    return d.ps >= 500;
+}
+
+static float celsius(const DHT11Data &d)
+{
+    return DHT11Converter().toFloat(d).temperature;
+}
+
+static void header()
+{
+    std::printf("%-26s %8s %10s %10s %8s %11s %8s %8s %9s\n", "dataset", "secs", "fixed", "adaptive", "saved",
+                "events", "mean_ms", "max_ms", "max_err");
+}
+
+int main(int argc, char *argv[])
+{
+    spdlog::set_level(spdlog::level::warn);
+
+    if (argc == 3)
+    {
+        std::string device = argv[1];
+        header();
+        if (device == "ap3216c")
+        {
+            std::vector<Recorded<AP3216CData>> records;
+            if (!loadRecording<AP3216CRecord>(argv[2], records))
+            {
+                return 1;
+            }
+            ReplayResult r = replay<AP3216CData>(records, AdaptiveRate::forAP3216C(), lux, proximity);
+            printResult(argv[2], (records.back().timestampNs - records.front().timestampNs) / 1000000000u, r, true);
+            return 0;
+        }
+        if (device == "dht11")
+        {
+            std::vector<Recorded<DHT11Data>> records;
+            if (!loadRecording<DHT11Record>(argv[2], records))
+            {
+                return 1;
+            }
+            ReplayResult r = replay<DHT11Data>(records, AdaptiveRate::forDHT11(), celsius, nullptr);
+            printResult(argv[2], (records.back().timestampNs - records.front().timestampNs) / 1000000000u, r, false);
+            return 0;
+        }
+    }
+    if (argc != 1)
+    {
+        std::fprintf(stderr, "usage: %s [ap3216c|dht11 recording.bin]\n", argv[0]);
+        return 1;
+    }
+
+    // 最长间隔越长省得越多，但短于最长间隔的接近事件可能被错过
+    std::printf("fixed = reads at the preset's fastest rate; max_err = als counts / C\n");
+    header();
+    std::vector<Recorded<AP3216CData>> light = officeLight();
+    const uint32_t lightMax[] = {500, 1000, 2000, 5000};
+    for (uint32_t maxMs : lightMax)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "ap3216c office, %u ms", maxMs);
+        printResult(name, 8 * 3600, replay<AP3216CData>(light, AdaptiveRate::forAP3216C(maxMs), lux, proximity),
+                    true);
+    }
+    std::vector<Recorded<DHT11Data>> climate = roomClimate();
+    const uint32_t climateMax[] = {10000, 60000};
+    for (uint32_t maxMs : climateMax)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "dht11 room, %u ms", maxMs);
+        printResult(name, 24 * 3600, replay<DHT11Data>(climate, AdaptiveRate::forDHT11(maxMs), celsius, nullptr),
+                    false);
+    }
+    return 0;
+}
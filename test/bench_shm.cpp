@@ -0,0 +1,193 @@
+// 共享内存样本环基准：发布开销，以及 1~16 个订阅进程下的端到端延迟
+// 端到端延迟 = 订阅进程 wait() 返回时刻 - 样本发布时刻（同一 CLOCK_MONOTONIC）
+// 用法: bench_shm [每轮样本数] [发布间隔(us)]
+
+#include "../src/ipc/shm_ring.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+// 订阅进程通过管道回传的统计结果
+struct SubscriberResult
+{
+    double meanUs;
+    double p50Us;
+    double p99Us;
+    double maxUs;
+    uint64_t received;
+    uint64_t lost;
+};
+
+static uint64_t nowNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+static void runSubscriber(const std::string &name, std::size_t samples, int readyFd, int resultFd)
+{
+    ShmSubscriber sub(name);
+    SubscriberResult result = {0, 0, 0, 0, 0, 0};
+    std::vector<double> latencies;
+    latencies.reserve(samples);
+    bool ok = sub.open() == ErrorCode::Ok;
+    char byte = ok ? 1 : 0;
+    if (write(readyFd, &byte, 1) != 1 || !ok)
+    {
+        _exit(1);
+    }
+
+    ShmSample sample;
+    while (sub.wait(sample, 10000) == ErrorCode::Ok)
+    {
+        latencies.push_back(static_cast<double>(nowNs() - sample.timestampNs) / 1000.0);
+    }
+    if (!latencies.empty())
+    {
+        double sum = 0;
+        for (double v : latencies)
+        {
+            sum += v;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        result.meanUs = sum / static_cast<double>(latencies.size());
+        result.p50Us = latencies[latencies.size() / 2];
+        result.p99Us = latencies[latencies.size() * 99 / 100];
+        result.maxUs = latencies.back();
+    }
+    result.received = sub.received();
+    result.lost = sub.lost();
+    ssize_t n = write(resultFd, &result, sizeof(result));
+    _exit(n == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+}
+
+static double benchPublishOnly(std::size_t samples)
+{
+    ShmPublisher pub("/bsp-bench-" + std::to_string(getpid()));
+    if (pub.open() != ErrorCode::Ok)
+    {
+        return -1;
+    }
+    AP3216CData data = {10, 800, 40};
+    Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < samples; ++i)
+    {
+        data.als = static_cast<uint16_t>(i);
+        pub.publish(data);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(samples);
+}
+
+static bool benchSubscribers(int subscribers, std::size_t samples, int intervalUs)
+{
+    std::string name = "/bsp-bench-" + std::to_string(getpid());
+    ShmPublisher pub(name);
+    if (pub.open() != ErrorCode::Ok)
+    {
+        return false;
+    }
+
+    int readyPipe[2];
+    int resultPipe[2];
+    if (pipe(readyPipe) != 0 || pipe(resultPipe) != 0)
+    {
+        return false;
+    }
+    std::vector<pid_t> pids;
+    for (int i = 0; i < subscribers; ++i)
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            runSubscriber(name, samples, readyPipe[1], resultPipe[1]);
+        }
+        pids.push_back(pid);
+    }
+    for (int i = 0; i < subscribers; ++i)
+    {
+        char byte = 0;
+        if (read(readyPipe[0], &byte, 1) != 1 || byte != 1)
+        {
+            std::fprintf(stderr, "subscriber failed to start\n");
+            return false;
+        }
+    }
+
+    AP3216CData data = {10, 800, 40};
+    double publishNs = 0;
+    Clock::time_point next = Clock::now();
+    for (std::size_t i = 0; i < samples; ++i)
+    {
+        next += std::chrono::microseconds(intervalUs);
+        std::this_thread::sleep_until(next);
+        data.als = static_cast<uint16_t>(i);
+        Clock::time_point start = Clock::now();
+        pub.publish(data);
+        publishNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+    pub.close();
+
+    SubscriberResult total = {0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < subscribers; ++i)
+    {
+        SubscriberResult r;
+        if (read(resultPipe[0], &r, sizeof(r)) != static_cast<ssize_t>(sizeof(r)))
+        {
+            std::fprintf(stderr, "subscriber result missing\n");
+            break;
+        }
+        total.meanUs += r.meanUs / subscribers;
+        total.p50Us += r.p50Us / subscribers;
+        total.p99Us = std::max(total.p99Us, r.p99Us);
+        total.maxUs = std::max(total.maxUs, r.maxUs);
+        total.received += r.received;
+        total.lost += r.lost;
+    }
+    for (pid_t pid : pids)
+    {
+        waitpid(pid, nullptr, 0);
+    }
+    close(readyPipe[0]);
+    close(readyPipe[1]);
+    close(resultPipe[0]);
+    close(resultPipe[1]);
+
+    std::printf("%6d %12.0f %10.1f %10.1f %10.1f %10.1f %10llu %8llu\n", subscribers,
+                publishNs / static_cast<double>(samples), total.meanUs, total.p50Us, total.p99Us, total.maxUs,
+                static_cast<unsigned long long>(total.received), static_cast<unsigned long long>(total.lost));
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t samples = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 2000;
+    int intervalUs = (argc > 2) ? std::atoi(argv[2]) : 500;
+    if (samples == 0 || intervalUs <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [samples] [interval_us]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("publish only (no subscribers): %.1f ns/sample\n", benchPublishOnly(1000000));
+    std::printf("\nsamples=%zu per run, one sample every %d us\n", samples, intervalUs);
+    std::printf("%6s %12s %10s %10s %10s %10s %10s %8s\n", "subs", "publish(ns)", "mean(us)", "p50(us)",
+                "p99(us)", "max(us)", "received", "lost");
+    const int counts[] = {1, 2, 4, 8, 16};
+    for (int subscribers : counts)
+    {
+        if (!benchSubscribers(subscribers, samples, intervalUs))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+// 线程唤醒抖动基准：周期线程每 period 微秒用 clock_nanosleep(TIMER_ABSTIME) 醒来一次，
+// 统计实际醒来时刻相对预定时刻的延迟；分别在空载和 CPU 占满（忙循环线程与测量线程
+// 绑在同一核上）时，对比 SCHED_OTHER 与 SCHED_FIFO + 锁内存 + 栈预触碰
+// 用法: bench_thread_jitter [唤醒次数] [周期(us)] [忙循环线程数]
+
+#include "../src/common/thread_attr.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+using namespace bsp;
+
+struct JitterResult
+{
+    double meanUs;
+    double p50Us;
+    double p99Us;
+    double maxUs;
+};
+
+static uint64_t toNs(const timespec &ts)
+{
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static JitterResult measure(std::size_t wakeups, int periodUs)
+{
+    std::vector<double> late;
+    late.reserve(wakeups);
+    timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (std::size_t i = 0; i < wakeups; ++i)
+    {
+        next.tv_nsec += periodUs * 1000;
+        while (next.tv_nsec >= 1000000000)
+        {
+            next.tv_nsec -= 1000000000;
+            ++next.tv_sec;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        late.push_back(static_cast<double>(toNs(now) - toNs(next)) / 1000.0);
+    }
+
+    JitterResult r = {0, 0, 0, 0};
+    for (double v : late)
+    {
+        r.meanUs += v / static_cast<double>(late.size());
+    }
+    std::sort(late.begin(), late.end());
+    r.p50Us = late[late.size() / 2];
+    r.p99Us = late[late.size() * 99 / 100];
+    r.maxUs = late.back();
+    return r;
+}
+
+static bool run(const char *label, const ThreadAttr &attr, int hogs, std::size_t wakeups, int periodUs)
+{
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> hogThreads;
+    ThreadAttr hogAttr;
+    hogAttr.cpuMask = attr.cpuMask;
+    for (int i = 0; i < hogs; ++i)
+    {
+        hogThreads.push_back(std::thread([&stop] {
+            volatile uint64_t spin = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                ++spin;
+            }
+        }));
+        applyThreadAttr(hogThreads.back(), hogAttr, "bench-hog");
+    }
+
+    JitterResult result = {0, 0, 0, 0};
+    std::atomic<bool> ready(false);
+    std::thread worker([&] {
+        // 属性在线程创建后才应用；用睡眠而不是 yield 等待，实时线程不会饿死同核上的主线程
+        while (!ready)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        prefaultStack(attr.stackPrefaultBytes);
+        result = measure(wakeups, periodUs);
+    });
+    ErrorCode applied = applyThreadAttr(worker, attr, "bench-jitter");
+    ready = true;
+    worker.join();
+    stop = true;
+    for (std::thread &t : hogThreads)
+    {
+        t.join();
+    }
+
+    if (applied != ErrorCode::Ok)
+    {
+        std::printf("%-30s %6d   (skipped: %s)\n", label, hogs, errorToString(applied).c_str());
+        return false;
+    }
+    std::printf("%-30s %6d %10.1f %10.1f %10.1f %10.1f\n", label, hogs, result.meanUs, result.p50Us, result.p99Us,
+                result.maxUs);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t wakeups = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 2000;
+    int periodUs = (argc > 2) ? std::atoi(argv[2]) : 1000;
+    int hogs = (argc > 3) ? std::atoi(argv[3]) : 2;
+    if (wakeups == 0 || periodUs <= 0 || hogs < 0)
+    {
+        std::fprintf(stderr, "usage: %s [wakeups] [period_us] [hog_threads]\n", argv[0]);
+        return 1;
+    }
+    spdlog::set_level(spdlog::level::warn);
+
+    // 忙循环线程与测量线程都绑在 CPU 0 上，制造确定的争用
+    ThreadAttr other;
+    other.cpuMask = 0x1;
+    ThreadAttr rt = ThreadAttr::realtime(80, 0x1);
+
+    std::printf("wakeups=%zu, period=%d us, lateness in us\n", wakeups, periodUs);
+    std::printf("%-30s %6s %10s %10s %10s %10s\n", "config", "hogs", "mean", "p50", "p99", "max");
+    run("SCHED_OTHER idle", other, 0, wakeups, periodUs);
+    run("SCHED_OTHER + CPU hog", other, hogs, wakeups, periodUs);
+    run("SCHED_FIFO 80 + mlock + CPU hog", rt, hogs, wakeups, periodUs);
+    return 0;
+}
@@ -0,0 +1,97 @@
+// 事件追踪埋点开销基准测试
+// 对比追踪关闭（仅一次分支）与开启（写本线程环形缓冲区）时每个区间埋点的开销
+
+#include "../src/common/trace.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+static double nsPerOp(Clock::time_point start, Clock::time_point end, long iterations)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
+
+// 空循环基线
+static double benchBaseline(long iterations)
+{
+    volatile long sink = 0;
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        sink = sink + i;
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+// 一个 BSP_TRACE_SCOPE（开启时为 B + E 两个事件）
+static double benchScope(long iterations)
+{
+    volatile long sink = 0;
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        BSP_TRACE_SCOPE("bench::scope");
+        sink = sink + i;
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+// 真实驱动路径：AP3216C::readData() 读 /dev/zero
+static double benchDriver(long iterations)
+{
+    DeviceEntry entry = makeDeviceEntry(DeviceType::AP3216C, "ap3216c-zero", "/dev/zero");
+
+    AP3216C sensor(entry);
+    if (sensor.init() != ErrorCode::Ok)
+    {
+        return -1.0;
+    }
+
+    AP3216CData data;
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        sensor.readData(data);
+    }
+    return nsPerOp(start, Clock::now(), iterations);
+}
+
+int main(int argc, char *argv[])
+{
+    long iterations = (argc >= 2) ? std::atol(argv[1]) : 5000000;
+
+    spdlog::set_level(spdlog::level::warn);
+
+    std::printf("========================================\n");
+    std::printf("BSP Trace Overhead Benchmark\n");
+    std::printf("========================================\n");
+    std::printf("Iterations: %ld\n\n", iterations);
+
+    double baseline = benchBaseline(iterations);
+
+    Trace::disable();
+    double scopeOff = benchScope(iterations);
+    double driverOff = benchDriver(iterations / 10);
+
+    Trace::enable();
+    double scopeOn = benchScope(iterations);
+    double driverOn = benchDriver(iterations / 10);
+    Trace::disable();
+
+    std::printf("empty loop:                      %8.2f ns/op\n", baseline);
+    std::printf("BSP_TRACE_SCOPE, disabled:       %8.2f ns/op\n", scopeOff);
+    std::printf("BSP_TRACE_SCOPE, enabled:        %8.2f ns/op\n", scopeOn);
+    std::printf("AP3216C::readData(/dev/zero), off: %6.1f ns/op\n", driverOff);
+    std::printf("AP3216C::readData(/dev/zero), on:  %6.1f ns/op\n", driverOn);
+
+    std::size_t bytes = Trace::toJson().size();
+    std::printf("\nJSON export of retained events: %zu bytes\n", bytes);
+    std::printf("========================================\n");
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+// 传感器单位转换基准：各调用方自行用浮点逐样本换算 vs UnitConverter 单样本 / 批量转换
+// 用法: bench_units [样本数] [轮数]
+
+#include "../src/driver/sensor_units.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace bsp;
+using Clock = std::chrono::steady_clock;
+
+// 防止结果被优化掉
+static volatile int32_t sinkFixed;
+static volatile float sinkFloat;
+
+static double nsPerSample(Clock::time_point start, Clock::time_point end, long samples)
+{
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(samples);
+}
+
+// 迁移前各调用方的写法：逐样本 double 运算再截断为 float
+static void legacyConvert(const DHT11Data *in, std::size_t count, DHT11ReadingF *out, double humOffset,
+                          double tempOffset)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double humidity = in[i].humidity_int + in[i].humidity_decimal / 10.0;
+        double temperature = in[i].temperature_int + (in[i].temperature_decimal & 0x7f) / 10.0;
+        if (in[i].temperature_decimal & 0x80)
+        {
+            temperature = -temperature;
+        }
+        out[i].humidity = static_cast<float>(humidity + humOffset);
+        out[i].temperature = static_cast<float>(temperature + tempOffset);
+    }
+}
+
+static void legacyConvert(const AP3216CData *in, std::size_t count, AP3216CReadingF *out, double gain,
+                          double offset)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i].lux = static_cast<float>(in[i].als * 0.35 * gain + offset);
+        out[i].ps = in[i].ps;
+        out[i].ir = in[i].ir;
+    }
+}
+
+template <typename Data, typename Fn> static double run(const std::vector<Data> &in, int rounds, Fn fn)
+{
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        fn(in.data(), in.size());
+    }
+    return nsPerSample(start, Clock::now(), static_cast<long>(in.size()) * rounds);
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 4096;
+    int rounds = (argc > 2) ? std::atoi(argv[2]) : 2000;
+    if (count == 0 || rounds <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [samples] [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<DHT11Data> climate(count);
+    std::vector<AP3216CData> light(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        DHT11Data d = {static_cast<uint8_t>(i % 100), static_cast<uint8_t>(i % 10), static_cast<uint8_t>(i % 50),
+                       static_cast<uint8_t>(i % 10)};
+        AP3216CData a = {static_cast<uint16_t>(i), static_cast<uint16_t>(i * 13), static_cast<uint16_t>(i & 1023)};
+        climate[i] = d;
+        light[i] = a;
+    }
+
+    DHT11Calibration climateCal;
+    climateCal.humidity = LinearCalibration::fromFloat(1.0f, -2.0f);
+    climateCal.temperature = LinearCalibration::fromFloat(1.0f, 0.5f);
+    DHT11Converter climateConverter(climateCal);
+
+    AP3216CCalibration lightCal;
+    lightCal.als = LinearCalibration::fromFloat(1.08f, 0.0f);
+    AP3216CConverter lightConverter(lightCal);
+
+    std::vector<DHT11Reading> climateFixed(count);
+    std::vector<DHT11ReadingF> climateFloat(count);
+    std::vector<AP3216CReading> lightFixed(count);
+    std::vector<AP3216CReadingF> lightFloat(count);
+
+    std::printf("samples=%zu rounds=%d\n", count, rounds);
+    std::printf("%-10s %-24s %10s\n", "sensor", "method", "ns/sample");
+
+    double ns = run(climate, rounds, [&](const DHT11Data *in, std::size_t n) {
+        legacyConvert(in, n, climateFloat.data(), -2.0, 0.5);
+        sinkFloat = climateFloat[n - 1].temperature;
+    });
+    std::printf("%-10s %-24s %10.2f\n", "dht11", "legacy double", ns);
+
+    ns = run(climate, rounds, [&](const DHT11Data *in, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            climateFixed[i] = climateConverter.toFixed(in[i]);
+        }
+        sinkFixed = climateFixed[n - 1].temperature.milli;
+    });
+    std::printf("%-10s %-24s %10.2f\n", "dht11", "toFixed() per sample", ns);
+
+    ns = run(climate, rounds, [&](const DHT11Data *in, std::size_t n) {
+        climateConverter.convert(in, n, climateFixed.data());
+        sinkFixed = climateFixed[n - 1].temperature.milli;
+    });
+    std::printf("%-10s %-24s %10.2f\n", "dht11", "convert() fixed", ns);
+
+    DHT11Converter uncalibrated;
+    ns = run(climate, rounds, [&](const DHT11Data *in, std::size_t n) {
+        uncalibrated.convert(in, n, climateFixed.data());
+        sinkFixed = climateFixed[n - 1].temperature.milli;
+    });
+    std::printf("%-10s %-24s %10.2f\n", "dht11", "convert() fixed, no cal", ns);
+
+    ns = run(climate, rounds, [&](const DHT11Data *in, std::size_t n) {
+        climateConverter.convert(in, n, climateFloat.data());
+        sinkFloat = climateFloat[n - 1].temperature;
+    });
+    std::printf("%-10s %-24s %10.2f\n", "dht11", "convert() float", ns);
+
+    ns = run(light, rounds, [&](const AP3216CData *in, std::size_t n) {
+        legacyConvert(in, n, lightFloat.data(), 1.08, 0.0);
+        sinkFloat = lightFloat[n - 1].lux;
+    });
+    std::printf("%-10s %-24s %10.2f\n", "ap3216c", "legacy double", ns);
+
+    ns = run(light, rounds, [&](const AP3216CData *in, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            lightFixed[i] = lightConverter.toFixed(in[i]);
+        }
+        sinkFixed = lightFixed[n - 1].illuminance.milli;
+    });
+    std::printf("%-10s %-24s %10.2f\n", "ap3216c", "toFixed() per sample", ns);
+
+    ns = run(light, rounds, [&](const AP3216CData *in, std::size_t n) {
+        lightConverter.convert(in, n, lightFixed.data());
+        sinkFixed = lightFixed[n - 1].illuminance.milli;
+    });
+    std::printf("%-10s %-24s %10.2f\n", "ap3216c", "convert() fixed", ns);
+
+    ns = run(light, rounds, [&](const AP3216CData *in, std::size_t n) {
+        lightConverter.convert(in, n, lightFloat.data());
+        sinkFloat = lightFloat[n - 1].lux;
+    });
+    std::printf("%-10s %-24s %10.2f\n", "ap3216c", "convert() float", ns);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+#!/bin/sh
+# 默认配置与嵌入式配置（-DBSP_EMBEDDED=ON）的体积对比：libbsp.so、组成它的各个静态库、
+# bsp_driver 中每个驱动的目标文件，以及 bench_footprint 测得的驱动实例占用
+#
+# 用法: size_report.sh [源码目录] [额外的 cmake 参数...]
+#   size_report.sh .
+#   size_report.sh . -DBSP_DEVICE_PATH_MAX=95
+# 环境变量 SIZE 指定 size 工具（默认按编译器前缀推导，如 arm-linux-gnueabihf-size），
+# BUILD_DIR 指定构建目录（默认临时目录，结束时删除），BUILD_TYPE 默认 Release
+
+SRC=${1:-.}
+[ $# -gt 0 ] && shift
+BUILD_TYPE=${BUILD_TYPE:-Release}
+
+if [ -n "$BUILD_DIR" ]; then
+    WORK=$BUILD_DIR
+    mkdir -p "$WORK"
+else
+    WORK=$(mktemp -d /tmp/bsp_size.XXXXXX)
+    trap 'rm -rf "$WORK"' EXIT
+fi
+
+build() {
+    dir="$WORK/$1"
+    shift
+    cmake -S "$SRC" -B "$dir" -DCMAKE_BUILD_TYPE="$BUILD_TYPE" "$@" >"$dir.log" 2>&1 &&
+        cmake --build "$dir" --target bsp bench_footprint -j"$(nproc 2>/dev/null || echo 2)" >>"$dir.log" 2>&1 || {
+        echo "build $dir failed, see $dir.log" >&2
+        exit 1
+    }
+}
+
+build default -DBSP_EMBEDDED=OFF "$@"
+build embedded -DBSP_EMBEDDED=ON "$@"
+
+if [ -z "$SIZE" ]; then
+    cxx=$(sed -n 's/^CMAKE_CXX_COMPILER:[A-Z]*=//p' "$WORK/default/CMakeCache.txt")
+    case "$cxx" in
+    *g++) SIZE=${cxx%g++}size ;;
+    esac
+    [ -n "$SIZE" ] && [ -x "$SIZE" ] || SIZE=size
+fi
+
+# text+data+bss（size 默认 Berkeley 格式，多个目标文件时取总和）
+total() {
+    "$SIZE" -t "$@" 2>/dev/null | tail -1 | awk '{ print $1 + $2 + $3 }'
+}
+
+# 某一节的大小总和（如 .eh_frame、.gcc_except_table）
+section() {
+    name=$1
+    shift
+    "$SIZE" -A "$@" 2>/dev/null | awk -v s="$name" '$1 == s { n += $2 } END { print n + 0 }'
+}
+
+row() {
+    awk -v l="$1" -v a="$2" -v b="$3" 'BEGIN {
+        printf "%-28s %12d %12d", l, a, b
+        if (a > 0) printf " %+8.1f%%", (b - a) * 100.0 / a
+        printf "\n"
+    }'
+}
+
+lib() {
+    find "$WORK/$1" -name "lib$2*" -type f | head -1
+}
+
+echo "========================================"
+echo "bsp size report ($BUILD_TYPE, $SIZE)"
+echo "========================================"
+printf "%-28s %12s %12s %9s\n" "bytes (text+data+bss)" "default" "embedded" "change"
+row "libbsp.so" "$(total "$(lib default bsp.so)")" "$(total "$(lib embedded bsp.so)")"
+
+all_default=""
+all_embedded=""
+for name in bsp_common bsp_driver bsp_board bsp_pipeline bsp_ipc; do
+    a=$(lib default "$name.a")
+    b=$(lib embedded "$name.a")
+    all_default="$all_default $a"
+    all_embedded="$all_embedded $b"
+    row "lib$name.a" "$(total "$a")" "$(total "$b")"
+done
+# shellcheck disable=SC2086
+row "all archives" "$(total $all_default)" "$(total $all_embedded)"
+# shellcheck disable=SC2086
+row "  .eh_frame" "$(section .eh_frame $all_default)" "$(section .eh_frame $all_embedded)"
+# shellcheck disable=SC2086
+row "  .gcc_except_table" "$(section .gcc_except_table $all_default)" \
+    "$(section .gcc_except_table $all_embedded)"
+
+echo ""
+echo "bsp_driver objects:"
+for obj in $(cd "$WORK/default/src/driver/CMakeFiles/bsp_driver.dir" && find . -name "*.o" | sort); do
+    row "  ${obj#./}" "$(total "$WORK/default/src/driver/CMakeFiles/bsp_driver.dir/$obj")" \
+        "$(total "$WORK/embedded/src/driver/CMakeFiles/bsp_driver.dir/$obj")"
+done
+
+# 交叉编译的程序不能在主机上运行，拷到板上执行 bench_footprint 即可
+for profile in default embedded; do
+    echo ""
+    bench="$WORK/$profile/bin/bench_footprint"
+    "$bench" 2>/dev/null || echo "$profile: cannot run $bench here, run it on the target"
+done
+echo "========================================"
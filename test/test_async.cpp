@@ -0,0 +1,185 @@
+// C++20 协程适配层测试：asyncRead()/nextEvent() 在事件循环上挂起与恢复、提交失败时不挂起
+// 只在编译器支持 C++20 时构建（见 test/CMakeLists.txt）
+
+#include "../src/driver/async.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "test_support.h"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+#if !(__cplusplus >= 202002L && defined(__cpp_impl_coroutine))
+#error "test_async must be compiled as C++20 with coroutine support"
+#endif
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+static void feedKey(MockDevice &dev, int type, int code, int value)
+{
+    struct input_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.type = static_cast<uint16_t>(type);
+    event.code = static_cast<uint16_t>(code);
+    event.value = value;
+    dev.feed(&event, sizeof(event));
+}
+
+struct ReadLog
+{
+    int count = 0;
+    uint16_t als[4] = {0};
+    ErrorCode last = ErrorCode::DevIo;
+    bool finished = false;
+};
+
+// 连续读取 n 次，出错时提前结束
+DetachedTask readSamples(EventLoop &loop, AP3216C &sensor, int n, ReadLog &log)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        auto r = co_await asyncRead(loop, sensor);
+        log.last = r.error;
+        if (r.error != ErrorCode::Ok)
+        {
+            break;
+        }
+        log.als[log.count++] = r.data.als;
+    }
+    log.finished = true;
+}
+
+// 测试传感器 co_await asyncRead()
+void test_async_read()
+{
+    std::printf("\n=== Testing co_await asyncRead() ===\n");
+
+    EventLoop loop;
+    loop.init();
+    MockDevice dev(DeviceType::AP3216C, "async-ap3216c");
+    AP3216C sensor(dev.entry);
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok, "init mock sensor");
+
+    ReadLog log;
+    readSamples(loop, sensor, 3, log);
+    TEST_ASSERT(!log.finished && loop.pending() == 1, "coroutine suspended on the first read");
+
+    for (uint16_t i = 1; i <= 3; ++i)
+    {
+        AP3216CData sample = {0, static_cast<uint16_t>(i * 100), 0};
+        dev.feed(&sample, sizeof(sample));
+    }
+    loop.run();
+    TEST_ASSERT(log.finished && log.count == 3 && log.last == ErrorCode::Ok,
+                "three reads resumed in the loop");
+    TEST_ASSERT(log.als[0] == 100 && log.als[1] == 200 && log.als[2] == 300, "samples delivered in order");
+
+    // 同一传感器已有未完成的读取：第二个协程的提交失败，不挂起直接得到错误
+    ReadLog first;
+    ReadLog second;
+    readSamples(loop, sensor, 1, first);
+    readSamples(loop, sensor, 1, second);
+    TEST_ASSERT(second.finished && second.last == ErrorCode::InvalidParam,
+                "concurrent read fails without suspending");
+    AP3216CData sample = {0, 42, 0};
+    dev.feed(&sample, sizeof(sample));
+    loop.run();
+    TEST_ASSERT(first.finished && first.als[0] == 42, "pending read unaffected");
+
+    AP3216C closed("async-missing");
+    ReadLog notReady;
+    readSamples(loop, closed, 1, notReady);
+    TEST_ASSERT(notReady.finished && notReady.last == ErrorCode::DevNotReady,
+                "uninitialized sensor reported");
+}
+
+struct KeyLog
+{
+    int count = 0;
+    int codes[4] = {0};
+    int values[4] = {0};
+    bool finished = false;
+};
+
+DetachedTask watchKeys(EventLoop &loop, Key &key, int n, KeyLog &log)
+{
+    while (log.count < n)
+    {
+        auto e = co_await nextEvent(loop, key);
+        if (e.error != ErrorCode::Ok)
+        {
+            break;
+        }
+        log.codes[log.count] = e.code;
+        log.values[log.count] = e.value;
+        ++log.count;
+    }
+    log.finished = true;
+}
+
+// 测试按键 co_await nextEvent()
+void test_next_event()
+{
+    std::printf("\n=== Testing co_await nextEvent() ===\n");
+
+    EventLoop loop;
+    loop.init();
+    MockDevice dev(DeviceType::Key, "async-key");
+    Key key(dev.entry);
+    TEST_ASSERT(key.init() == ErrorCode::Ok, "init mock key");
+
+    KeyLog log;
+    watchKeys(loop, key, 2, log);
+    feedKey(dev, EV_KEY, KEY_ENTER, 1);
+    feedKey(dev, EV_SYN, SYN_REPORT, 0);
+    feedKey(dev, EV_KEY, KEY_ENTER, 0);
+    feedKey(dev, EV_SYN, SYN_REPORT, 0);
+    loop.run();
+
+    TEST_ASSERT(log.finished && log.count == 2, "two key events resumed the coroutine");
+    TEST_ASSERT(log.codes[0] == KEY_ENTER && log.values[0] == 1, "press reported");
+    TEST_ASSERT(log.codes[1] == KEY_ENTER && log.values[1] == 0, "release reported, EV_SYN skipped");
+}
+
+int main()
+{
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("========================================\n");
+    std::printf("BSP Coroutine Adapter Test Suite\n");
+    std::printf("========================================\n");
+
+    test_async_read();
+    test_next_event();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,261 @@
+// Board 功能测试：并行初始化结果、失败与超时设备、就绪集合与访问接口、超时后完成的设备被关闭
+
+#include "../src/board/board.h"
+#include "test_support.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <spdlog/spdlog.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 模拟设备：睡眠指定时长后返回给定结果
+static DeviceConfig mockDevice(const std::string &name, int latencyMs, ErrorCode result = ErrorCode::Ok,
+                               int timeoutMs = 0)
+{
+    DeviceConfig dev(DeviceType::Custom, name, timeoutMs);
+    dev.customInit = [latencyMs, result] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(latencyMs));
+        return result;
+    };
+    return dev;
+}
+
+// 测试全部成功：报告顺序、就绪集合、句柄与类型化访问接口
+void test_all_ready()
+{
+    std::printf("\n=== Testing All Devices Ready ===\n");
+
+    BoardConfig config;
+    config.devices.push_back(mockDevice("slow", 30));
+    DeviceConfig led(DeviceType::Led, "led0");
+    led.path = "/dev/zero";
+    config.devices.push_back(led);
+    config.devices.push_back(mockDevice("fast", 1));
+
+    Board board(config);
+    TEST_ASSERT(board.readyDevices().empty() && !board.isReady("led0"), "nothing ready before init()");
+    TEST_ASSERT(board.init() == ErrorCode::Ok, "init() returns Ok");
+
+    const std::vector<DeviceInitReport> &reports = board.initReport();
+    TEST_ASSERT(reports.size() == 3 && reports[0].name == "slow" && reports[1].name == "led0" &&
+                    reports[2].name == "fast",
+                "reports follow declaration order");
+    TEST_ASSERT(reports[0].latency >= std::chrono::milliseconds(30) && reports[2].latency < reports[0].latency,
+                "per-device latency measured");
+    TEST_ASSERT(board.startupTime() >= reports[0].latency, "startup time covers the slowest device");
+
+    std::vector<std::string> ready = board.readyDevices();
+    TEST_ASSERT(ready.size() == 3 && ready[0] == "slow" && ready[1] == "led0" && ready[2] == "fast",
+                "readyDevices() lists all devices in order");
+
+    DeviceHandle handle = board.handle("led0");
+    TEST_ASSERT(handle == 1 && board.handle("missing") == INVALID_DEVICE_HANDLE, "handle() by name");
+    TEST_ASSERT(board.isReady(handle) && !board.isReady(INVALID_DEVICE_HANDLE), "isReady() by handle");
+    TEST_ASSERT(board.led("led0") != nullptr && board.led(handle) == board.led("led0"), "led() by name and handle");
+    TEST_ASSERT(board.led("led0")->isReady(), "led0 opened");
+    TEST_ASSERT(board.key("led0") == nullptr && board.dht11(handle) == nullptr, "type mismatch returns nullptr");
+    TEST_ASSERT(board.led("missing") == nullptr && board.led(static_cast<DeviceHandle>(99)) == nullptr,
+                "unknown device returns nullptr");
+
+    TEST_ASSERT(board.init() == ErrorCode::Ok && board.initReport().size() == 3, "second init() keeps the report");
+}
+
+// 测试初始化失败的设备：不进入就绪集合，init() 返回按声明顺序的第一个错误
+void test_failing_init()
+{
+    std::printf("\n=== Testing Failing Init ===\n");
+
+    BoardConfig config;
+    config.devices.push_back(mockDevice("ok0", 1));
+    config.devices.push_back(mockDevice("broken", 20, ErrorCode::DevOpen));
+    DeviceConfig missing(DeviceType::DHT11, "dht11");
+    missing.path = "/nonexistent/dht11";
+    config.devices.push_back(missing);
+    config.devices.push_back(mockDevice("ok1", 1));
+
+    Board board(config);
+    TEST_ASSERT(board.init() == ErrorCode::DevOpen, "init() returns first failure");
+
+    const std::vector<DeviceInitReport> &reports = board.initReport();
+    TEST_ASSERT(reports[1].result == ErrorCode::DevOpen, "failing custom device reported");
+    TEST_ASSERT(reports[2].result == ErrorCode::DevOpen && reports[2].type == DeviceType::DHT11,
+                "missing device node reported");
+    TEST_ASSERT(reports[0].result == ErrorCode::Ok && reports[3].result == ErrorCode::Ok, "other devices Ok");
+
+    std::vector<std::string> ready = board.readyDevices();
+    TEST_ASSERT(ready.size() == 2 && ready[0] == "ok0" && ready[1] == "ok1", "failed devices not ready");
+    TEST_ASSERT(board.dht11("dht11") == nullptr, "failed device not accessible");
+    TEST_ASSERT(board.init() == ErrorCode::DevOpen, "second init() returns the same error");
+}
+
+// 测试超时：按期限返回，报告为 Timeout，之后完成也不会变为就绪
+void test_timeout()
+{
+    std::printf("\n=== Testing Init Timeout ===\n");
+
+    BoardConfig config;
+    config.devices.push_back(mockDevice("quick", 1, ErrorCode::Ok, 500));
+    config.devices.push_back(mockDevice("wedged", 300, ErrorCode::Ok, 50));
+
+    Board board(config);
+    TEST_ASSERT(board.init() == ErrorCode::Timeout, "init() returns Timeout");
+    TEST_ASSERT(board.startupTime() < std::chrono::milliseconds(250), "init() returns at the deadline");
+
+    const DeviceInitReport &wedged = board.initReport()[1];
+    TEST_ASSERT(wedged.result == ErrorCode::Timeout && wedged.latency >= std::chrono::milliseconds(50),
+                "wedged device reported as Timeout");
+    TEST_ASSERT(board.isReady("quick") && !board.isReady("wedged"), "only quick device ready");
+
+    // 等后台的 init() 返回（成功）后，状态仍保持超时
+    std::this_thread::sleep_for(std::chrono::milliseconds(350));
+    TEST_ASSERT(!board.isReady("wedged") && board.readyDevices().size() == 1, "late success does not become ready");
+    TEST_ASSERT(board.initReport()[1].result == ErrorCode::Timeout && board.init() == ErrorCode::Timeout,
+                "report keeps Timeout");
+}
+
+// 测试初始化线程属性：设备的 init() 在按 BoardConfig::threadAttr 命名的线程中执行
+void test_thread_attr()
+{
+    std::printf("\n=== Testing Init Thread Attributes ===\n");
+
+    std::string names[2];
+    BoardConfig config;
+    config.threadAttr.name = "brd-init";
+    config.initThreads = 1;
+    for (int i = 0; i < 2; ++i)
+    {
+        DeviceConfig dev(DeviceType::Custom, "named" + std::to_string(i));
+        std::string *name = &names[i];
+        dev.customInit = [name] {
+            char buf[16] = {0};
+            pthread_getname_np(pthread_self(), buf, sizeof(buf));
+            *name = buf;
+            return ErrorCode::Ok;
+        };
+        config.devices.push_back(dev);
+    }
+
+    Board board(config);
+    TEST_ASSERT(board.init() == ErrorCode::Ok, "init() with thread attributes");
+    TEST_ASSERT(names[0] == "brd-init-0" && names[1] == "brd-init-0", "init workers use the configured name");
+
+    BoardConfig defaults;
+    std::string defaultName;
+    DeviceConfig dev(DeviceType::Custom, "unnamed");
+    dev.customInit = [&defaultName] {
+        char buf[16] = {0};
+        pthread_getname_np(pthread_self(), buf, sizeof(buf));
+        defaultName = buf;
+        return ErrorCode::Ok;
+    };
+    defaults.devices.push_back(dev);
+    Board plain(defaults);
+    TEST_ASSERT(plain.init() == ErrorCode::Ok && defaultName == "bsp-pool-0", "default worker name kept");
+}
+
+// 测试超时后才打开成功的真实设备：Board 关闭它而不是一直占用 fd
+void test_late_device_closed()
+{
+    std::printf("\n=== Testing Late Device Closed ===\n");
+
+    // 没有写端时以只读方式打开 FIFO 会阻塞，模拟探测卡住的设备
+    char path[] = "/tmp/bsp_board_fifoXXXXXX";
+    int tmp = mkstemp(path);
+    if (tmp < 0)
+    {
+        TEST_ASSERT(false, "create temporary path");
+        return;
+    }
+    close(tmp);
+    unlink(path);
+    if (mkfifo(path, 0600) != 0)
+    {
+        TEST_ASSERT(false, "mkfifo()");
+        return;
+    }
+
+    int before = openFdCount();
+    {
+        BoardConfig config;
+        DeviceConfig dht11(DeviceType::DHT11, "dht11", 50);
+        dht11.path = path;
+        config.devices.push_back(dht11);
+
+        Board board(config);
+        TEST_ASSERT(board.init() == ErrorCode::Timeout, "blocked open() times out");
+
+        // 以读写方式打开 FIFO 不会阻塞，同时让设备的 open() 返回
+        int writer = open(path, O_RDWR);
+        TEST_ASSERT(writer >= 0, "unblock device open()");
+
+        // 设备 fd 与取消 eventfd 被关闭后，只剩测试自己的 writer
+        int now = -1;
+        for (int i = 0; i < 200; ++i)
+        {
+            now = openFdCount();
+            if (now == before + 1)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        TEST_ASSERT(now == before + 1, "late device fds closed");
+        TEST_ASSERT(!board.isReady("dht11") && board.dht11("dht11") == nullptr, "late device not accessible");
+        if (writer >= 0)
+        {
+            close(writer);
+        }
+    }
+    TEST_ASSERT(openFdCount() == before, "no fds left after Board destroyed");
+    unlink(path);
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Board Test Suite\n");
+    std::printf("========================================\n");
+
+    spdlog::set_level(spdlog::level::off);
+    test_all_ready();
+    test_failing_init();
+    test_timeout();
+    test_thread_attr();
+    test_late_device_closed();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+#include "../src/cli/cli_registry.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 测试用命令表（处理函数不会被调用）
+static int noopHandler(CliSession &, const ParsedArgs &)
+{
+    return 0;
+}
+
+static const ArgSpec setArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, nullptr, "Device name"},
+    {"state", ArgKind::Choice, "on|off", nullptr, "LED state"},
+};
+
+static const ArgSpec streamArgs[] = {
+    {"dev_name", ArgKind::Word, nullptr, "sensor", "Device name"},
+    {"--rate", ArgKind::Double, nullptr, "10", "Sample rate"},
+    {"--count", ArgKind::Int, nullptr, "0", "Samples"},
+    {"--format", ArgKind::Choice, "csv|bin", "csv", "Format"},
+    {"--keep-going|-k", ArgKind::Flag, nullptr, nullptr, "Continue on error"},
+};
+
+static const ArgSpec sleepArgs[] = {
+    {"duration", ArgKind::Duration, nullptr, nullptr, "Time"},
+};
+
+static const CommandSpec testCommands[] = {
+    {"led", "set", setArgs, argCount(setArgs), noopHandler, "Set LED", nullptr},
+    {"sensor", "stream|s", streamArgs, argCount(streamArgs), noopHandler, "Stream", nullptr},
+    {"sleep", nullptr, sleepArgs, argCount(sleepArgs), noopHandler, "Sleep", nullptr},
+    {"version|-v", nullptr, nullptr, 0, noopHandler, "Version", nullptr},
+};
+
+static CommandRegistrar registrar(testCommands);
+
+// 切分一行并解析
+static ErrorCode parseLine(const char *text, ParsedArgs &args)
+{
+    static char line[256];
+    std::strncpy(line, text, sizeof(line) - 1);
+    StrRef tokens[CommandRegistry::MAX_TOKENS];
+    std::size_t count = CommandRegistry::splitLine(line, tokens, CommandRegistry::MAX_TOKENS);
+    return CommandRegistry::parse(tokens, count, args);
+}
+
+// 测试 StrRef 与别名匹配
+void test_strref()
+{
+    std::printf("\n=== Testing StrRef ===\n");
+
+    TEST_ASSERT(StrRef("abc") == StrRef("abc", 3), "StrRef equality");
+    TEST_ASSERT(StrRef("abc") != StrRef("abcd"), "StrRef length mismatch");
+    TEST_ASSERT(StrRef().empty() && StrRef(nullptr).empty(), "empty StrRef");
+    TEST_ASSERT(matchAlternatives("a|bb|ccc", StrRef("bb")), "match middle alternative");
+    TEST_ASSERT(!matchAlternatives("a|bb|ccc", StrRef("b")), "no prefix match");
+    TEST_ASSERT(matchAlternatives("x", StrRef("x")), "single alternative");
+}
+
+// 测试原地切分
+void test_split()
+{
+    std::printf("\n=== Testing splitLine ===\n");
+
+    char line[] = "  led\tset  led0 on  # trailing comment\r\n";
+    StrRef tokens[8];
+    std::size_t count = CommandRegistry::splitLine(line, tokens, 8);
+    TEST_ASSERT(count == 4, "token count");
+    TEST_ASSERT(tokens[0] == StrRef("led") && tokens[3] == StrRef("on"), "token content");
+    TEST_ASSERT(tokens[1].data[tokens[1].size] == '\0', "tokens are NUL terminated in place");
+
+    char comment[] = "# only a comment";
+    TEST_ASSERT(CommandRegistry::splitLine(comment, tokens, 8) == 0, "comment line is empty");
+
+    char many[] = "a b c d e f g h i j";
+    TEST_ASSERT(CommandRegistry::splitLine(many, tokens, 4) == 4, "token overflow is truncated");
+}
+
+// 打印 spec 的用法，返回输出的第一行（把标准输出重定向到临时文件）
+static std::string captureUsage(const CommandSpec &spec)
+{
+    std::fflush(stdout);
+    FILE *capture = std::tmpfile();
+    int saved = dup(fileno(stdout));
+    if (capture == nullptr || saved < 0)
+    {
+        return std::string();
+    }
+    dup2(fileno(capture), fileno(stdout));
+    CommandRegistry::printUsage(spec);
+    std::fflush(stdout);
+    dup2(saved, fileno(stdout));
+    close(saved);
+
+    char line[1024] = {0};
+    std::rewind(capture);
+    if (std::fgets(line, sizeof(line), capture) == nullptr)
+    {
+        line[0] = '\0';
+    }
+    std::fclose(capture);
+    return line;
+}
+
+// 测试用法行超过缓冲区时截断而不越界
+void test_usage_truncated()
+{
+    std::printf("\n=== Testing Usage Truncation ===\n");
+
+    // 别名列表在缓冲区末尾附近继续追加 ", "
+    std::string aliases = std::string(253, 'g') + "|a|b|c|d|e|f";
+    CommandSpec aliasCommand = {aliases.c_str(), nullptr, nullptr, 0, noopHandler, "Aliases", nullptr};
+    std::string line = captureUsage(aliasCommand);
+    TEST_ASSERT(line.compare(0, 5, "  ggg") == 0 && line.size() <= 2 + 255 + 1, "long alias list truncated");
+
+    // 位置参数占位说明超出缓冲区
+    std::string name(200, 'p');
+    ArgSpec args[] = {
+        {name.c_str(), ArgKind::Word, nullptr, nullptr, "First"},
+        {name.c_str(), ArgKind::Word, nullptr, nullptr, "Second"},
+        {"--rate", ArgKind::Double, nullptr, "10", "Sample rate"},
+    };
+    CommandSpec argCommand = {"long", "usage", args, argCount(args), noopHandler, "Long", nullptr};
+    line = captureUsage(argCommand);
+    TEST_ASSERT(line.compare(0, 14, "  long usage <") == 0 && line.size() <= 2 + 255 + 1,
+                "long positional arguments truncated");
+}
+
+// 测试命令查找与参数解析
+void test_parse()
+{
+    std::printf("\n=== Testing parse ===\n");
+
+    ParsedArgs args;
+    TEST_ASSERT(parseLine("led set led0 on", args) == ErrorCode::Ok, "parse led set");
+    TEST_ASSERT(args.spec() == &testCommands[0], "led set spec");
+    TEST_ASSERT(args.get(0) == StrRef("led0") && args.is(1, "on"), "positional values");
+
+    TEST_ASSERT(parseLine("led set led0", args) == ErrorCode::InvalidParam, "missing required argument");
+    TEST_ASSERT(std::strstr(args.error(), "<state>") != nullptr, "error names the argument");
+    TEST_ASSERT(parseLine("led set led0 dim", args) == ErrorCode::InvalidParam, "choice validated");
+    TEST_ASSERT(parseLine("led blink led0", args) == ErrorCode::InvalidParam, "unknown subcommand");
+    TEST_ASSERT(parseLine("camera read", args) == ErrorCode::InvalidParam && args.spec() == nullptr,
+                "unknown command");
+
+    TEST_ASSERT(parseLine("sensor stream", args) == ErrorCode::Ok, "all arguments optional");
+    TEST_ASSERT(args.is(0, "sensor") && args.toDouble(1) == 10.0 && !args.has(1), "defaults applied");
+    TEST_ASSERT(!args.has(4), "flag absent");
+
+    TEST_ASSERT(parseLine("sensor s als0 --count 500 -k --rate 2.5 --format bin", args) == ErrorCode::Ok,
+                "options in any order, verb alias");
+    TEST_ASSERT(args.is(0, "als0") && args.toLong(2) == 500 && args.toDouble(1) == 2.5, "option values");
+    TEST_ASSERT(args.is(3, "bin") && args.has(4), "choice option and flag");
+
+    TEST_ASSERT(parseLine("sensor stream --count -1", args) == ErrorCode::InvalidParam, "negative int rejected");
+    TEST_ASSERT(parseLine("sensor stream --count", args) == ErrorCode::InvalidParam, "option without value");
+    TEST_ASSERT(parseLine("sensor stream --bogus 1", args) == ErrorCode::InvalidParam, "unknown option");
+    TEST_ASSERT(parseLine("sensor stream a b", args) == ErrorCode::InvalidParam, "too many positionals");
+
+    TEST_ASSERT(parseLine("sleep 10ms", args) == ErrorCode::Ok && args.durationUs(0) == 10000, "duration ms");
+    TEST_ASSERT(parseLine("sleep 2s", args) == ErrorCode::Ok && args.durationUs(0) == 2000000, "duration s");
+    TEST_ASSERT(parseLine("sleep 250us", args) == ErrorCode::Ok && args.durationUs(0) == 250, "duration us");
+    TEST_ASSERT(parseLine("sleep 5", args) == ErrorCode::Ok && args.durationUs(0) == 5000, "duration default ms");
+    TEST_ASSERT(parseLine("sleep 5min", args) == ErrorCode::InvalidParam, "bad duration unit");
+
+    TEST_ASSERT(parseLine("-v", args) == ErrorCode::Ok && args.spec() == &testCommands[3], "group alias");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP CLI Registry Test Suite\n");
+    std::printf("========================================\n");
+
+    test_strref();
+    test_split();
+    test_parse();
+    test_usage_truncated();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+// 命令会话测试：同一进程中连续执行的 stream 命令互不影响（Ctrl-C 标志与信号处理函数）
+
+#include "../src/cli/cli_session.h"
+#include <spdlog/spdlog.h>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 模拟交互模式（REPL）自己的 SIGINT 处理函数
+static volatile std::sig_atomic_t replSignals = 0;
+
+static void onReplSignal(int)
+{
+    replSignals = replSignals + 1;
+}
+
+static int countLines(const std::string &path)
+{
+    std::ifstream in(path.c_str());
+    std::string line;
+    int lines = 0;
+    while (std::getline(in, line))
+    {
+        ++lines;
+    }
+    return lines;
+}
+
+// 测试 Ctrl-C 中断一条 stream 后，同一会话中的下一条 stream 仍完整执行
+void test_stream_after_interrupt()
+{
+    std::printf("\n=== Testing Stream After Ctrl-C ===\n");
+
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onReplSignal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, nullptr);
+
+    std::string first = "/tmp/bsp_cli_session_" + std::to_string(getpid()) + "_1.csv";
+    std::string second = "/tmp/bsp_cli_session_" + std::to_string(getpid()) + "_2.csv";
+    CliSession session;
+
+    // 不限次数的 stream 只能由 Ctrl-C 结束
+    std::thread interrupter([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        kill(getpid(), SIGINT);
+    });
+    std::string line = "ap3216c stream als --path /dev/zero --rate 200 --count 0 --output " + first;
+    TEST_ASSERT(session.executeLine(line) == 0, "interrupted stream returns 0");
+    interrupter.join();
+    TEST_ASSERT(countLines(first) > 1, "interrupted stream wrote samples");
+    TEST_ASSERT(replSignals == 0, "SIGINT handled by the stream command");
+
+    struct sigaction current;
+    sigaction(SIGINT, nullptr, &current);
+    TEST_ASSERT(current.sa_handler == onReplSignal, "previous SIGINT handler restored");
+    raise(SIGINT);
+    TEST_ASSERT(replSignals == 1, "Ctrl-C between commands reaches the session");
+
+    line = "ap3216c stream als --path /dev/zero --rate 0 --count 50 --output " + second;
+    TEST_ASSERT(session.executeLine(line) == 0, "second stream returns 0");
+    TEST_ASSERT(countLines(second) == 51, "second stream wrote header and all 50 samples");
+
+    unlink(first.c_str());
+    unlink(second.c_str());
+    signal(SIGINT, SIG_DFL);
+}
+
+int main()
+{
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("========================================\n");
+    std::printf("BSP CLI Session Test Suite\n");
+    std::printf("========================================\n");
+
+    test_stream_after_interrupt();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/dht11/dht11.h"
+#include "../src/driver/key/key.h"
+#include "../src/driver/led/led.h"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 测试公共基类提供的路径、打开标志和就绪状态
+void test_common_state()
+{
+    std::printf("\n=== Testing Device Base ===\n");
+
+    static_assert(!std::is_polymorphic<AP3216C>::value && !std::is_polymorphic<Key>::value,
+                  "drivers must not have a vtable");
+    static_assert(std::is_same<AP3216C::DataType, AP3216CData>::value, "AP3216C::DataType");
+    static_assert(!std::is_copy_constructible<Led>::value, "drivers are move-only");
+    static_assert(std::is_nothrow_move_constructible<DHT11>::value, "sensor move is noexcept");
+
+    AP3216C byName("ap3216c-missing-node");
+    TEST_ASSERT(byName.getDeviceName() == "ap3216c-missing-node", "name from constructor");
+    TEST_ASSERT(byName.init() == ErrorCode::DevOpen, "missing /dev node -> DevOpen");
+    TEST_ASSERT(!byName.isReady() && byName.getFd() == -1, "not ready after failed init()");
+
+    AP3216CData data;
+    TEST_ASSERT(byName.readRaw(data) == ErrorCode::DevNotReady, "readRaw() before init()");
+    TEST_ASSERT(byName.readData(data) == ErrorCode::DevNotReady, "readData() before init()");
+
+    DHT11 th(makeDeviceEntry(DeviceType::DHT11, "dht11-zero", "/dev/zero"));
+    TEST_ASSERT(th.init() == ErrorCode::Ok && th.isReady() && th.getFd() >= 0, "init() from DeviceEntry");
+    TEST_ASSERT(th.init() == ErrorCode::Ok, "second init() is a no-op");
+
+    DHT11Data thData;
+    std::memset(&thData, 0xff, sizeof(thData));
+    TEST_ASSERT(th.readData(thData) == ErrorCode::Ok && thData.humidity_int == 0, "readData() through base");
+
+    uint32_t word = 0xffffffffu;
+    TEST_ASSERT(th.readRaw(word) == ErrorCode::Ok && word == 0, "typed readRaw<uint32_t>()");
+
+    // 读到末尾的普通文件：长度不符
+    std::string path = "/tmp/bsp_device_test_" + std::to_string(getpid()) + ".bin";
+    FILE *file = std::fopen(path.c_str(), "wb");
+    std::fputc(1, file);
+    std::fclose(file);
+    AP3216C shortFile(makeDeviceEntry(DeviceType::AP3216C, "short-file", path.c_str()));
+    shortFile.init();
+    TEST_ASSERT(shortFile.readData(data) == ErrorCode::DevIo, "short read -> DevIo");
+    unlink(path.c_str());
+}
+
+// 测试移动语义：fd 所有权随对象转移
+void test_move()
+{
+    std::printf("\n=== Testing Move Semantics ===\n");
+
+    AP3216C a(makeDeviceEntry(DeviceType::AP3216C, "ap3216c-zero", "/dev/zero"));
+    a.init();
+    int fd = a.getFd();
+
+    AP3216C b(std::move(a));
+    TEST_ASSERT(!a.isReady() && a.getFd() == -1, "moved-from sensor released the fd");
+    TEST_ASSERT(b.isReady() && b.getFd() == fd && b.getDeviceName() == "ap3216c-zero", "moved-to sensor owns the fd");
+
+    AP3216C c("unused");
+    c = std::move(b);
+    TEST_ASSERT(c.isReady() && c.getFd() == fd && !b.isReady(), "move assignment transfers the fd");
+    AP3216CData data;
+    TEST_ASSERT(c.readData(data) == ErrorCode::Ok, "moved sensor still reads");
+
+    Led led(makeDeviceEntry(DeviceType::Led, "led-null", "/dev/null"));
+    led.init();
+    Led other(std::move(led));
+    TEST_ASSERT(other.isReady() && !led.isReady(), "Led move");
+    TEST_ASSERT(led.setState(true) == ErrorCode::DevNotReady, "moved-from Led rejects setState()");
+}
+
+// 测试移动正在运行的 Key：源对象的事件线程先停止，不会访问已转移的状态
+void test_key_move()
+{
+    std::printf("\n=== Testing Key Move While Running ===\n");
+
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "pipe()");
+    std::string path = "/proc/self/fd/" + std::to_string(fds[0]);
+
+    Key key(makeDeviceEntry(DeviceType::Key, "mock-key", path.c_str()));
+    key.init();
+    int calls = 0;
+    key.setCallback([&calls](int, int) { ++calls; });
+    TEST_ASSERT(key.start() == ErrorCode::Ok && key.isRunning(), "start()");
+
+    Key moved(std::move(key));
+    TEST_ASSERT(!key.isRunning() && !key.isReady(), "moved-from Key stopped and released");
+    TEST_ASSERT(moved.isReady() && !moved.isRunning(), "moved-to Key owns the fd, not running");
+
+    TEST_ASSERT(moved.start() == ErrorCode::Ok, "restart after move");
+    struct input_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.type = EV_KEY;
+    event.code = KEY_ENTER;
+    event.value = 1;
+    ssize_t n = write(fds[1], &event, sizeof(event));
+    (void)n;
+    for (int i = 0; i < 100 && calls == 0; ++i)
+    {
+        usleep(1000);
+    }
+    TEST_ASSERT(calls == 1, "callback moved with the Key");
+
+    Key assigned("unused");
+    assigned = std::move(moved);
+    TEST_ASSERT(!moved.isRunning() && assigned.isReady() && !assigned.isRunning(), "move assignment stops the source");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main()
+{
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("========================================\n");
+    std::printf("BSP Device Base Test Suite\n");
+    std::printf("========================================\n");
+
+    test_common_state();
+    test_move();
+    test_key_move();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
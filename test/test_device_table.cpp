@@ -0,0 +1,159 @@
+#include "../src/common/device_table.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+static const char *BOARD_TEXT = "# sample board\n"
+                                "[board]\n"
+                                "init_threads = 3\n"
+                                "\n"
+                                "[led0]\n"
+                                "type = led\n"
+                                "timeout_ms = 200  ; inline comment\n"
+                                "[key0]\n"
+                                "type = key\n"
+                                "path = /dev/input/event2\n"
+                                "[ap3216c]\n"
+                                "type = ap3216c\n"
+                                "[alias]\n"
+                                "type = led\n"
+                                "path = /dev/led0\n";
+
+// 测试正常解析
+void test_parse()
+{
+    std::printf("\n=== Testing Parse ===\n");
+
+    DeviceTable table;
+    ErrorCode ret = DeviceTable::parse(BOARD_TEXT, table);
+    TEST_ASSERT(ret == ErrorCode::Ok, "parse() sample description");
+    TEST_ASSERT(table.size() == 4, "table has 4 devices");
+    TEST_ASSERT(table.initThreads() == 3, "[board] init_threads parsed");
+
+    DeviceHandle led = table.find("led0");
+    DeviceHandle key = table.find("key0");
+    TEST_ASSERT(led == 0 && key == 1, "handles follow declaration order");
+    TEST_ASSERT(table.find("missing") == INVALID_DEVICE_HANDLE, "find() unknown name");
+
+    TEST_ASSERT(table[led].type == DeviceType::Led, "led0 type");
+    TEST_ASSERT(std::strcmp(table[led].path, "/dev/led0") == 0, "default path is /dev/<name>");
+    TEST_ASSERT(table[led].initTimeoutMs == 200, "timeout_ms parsed");
+    TEST_ASSERT(std::strcmp(table[key].path, "/dev/input/event2") == 0, "explicit path kept");
+
+    // led0 的默认路径与 alias 的显式路径相同，应驻留为同一份字符串
+    DeviceHandle alias = table.find("alias");
+    TEST_ASSERT(table[alias].path == table[led].path, "identical strings are interned");
+
+    // 移动后条目指针仍然有效
+    const char *name = table[key].name;
+    DeviceTable moved(std::move(table));
+    TEST_ASSERT(moved[key].name == name && std::strcmp(name, "key0") == 0, "entries survive move");
+    TEST_ASSERT(table.size() == 0, "moved-from table is empty");
+}
+
+// 测试注释只在行首或空白之后开始，值中间的 '#'/';' 保留
+void test_comments()
+{
+    std::printf("\n=== Testing Comments ===\n");
+
+    DeviceTable table;
+    ErrorCode ret = DeviceTable::parse("; leading comment\n"
+                                       "[a] # section comment\n"
+                                       "type = led\t# tab comment\n"
+                                       "path = /dev/by-id/foo;1 ; trailing comment\n"
+                                       "timeout_ms = 2147483647\n"
+                                       "[b]\n"
+                                       "type = key\n"
+                                       "path = /dev/input/by-path/x#2\n",
+                                       table);
+    TEST_ASSERT(ret == ErrorCode::Ok, "parse() with comments");
+    TEST_ASSERT(table.size() == 2 && table[0].type == DeviceType::Led, "comment after value stripped");
+    TEST_ASSERT(std::strcmp(table[0].path, "/dev/by-id/foo;1") == 0, "';' inside value kept");
+    TEST_ASSERT(std::strcmp(table[1].path, "/dev/input/by-path/x#2") == 0, "'#' inside value kept");
+    TEST_ASSERT(table[0].initTimeoutMs == 2147483647, "timeout_ms INT_MAX accepted");
+}
+
+// 测试格式错误
+void test_parse_errors()
+{
+    std::printf("\n=== Testing Parse Errors ===\n");
+
+    DeviceTable table;
+    TEST_ASSERT(DeviceTable::parse("[a]\ntype = led\n[a]\ntype = led\n", table) == ErrorCode::InvalidParam,
+                "duplicate device rejected");
+    TEST_ASSERT(DeviceTable::parse("[a]\npath = /dev/a\n", table) == ErrorCode::InvalidParam,
+                "missing type rejected");
+    TEST_ASSERT(DeviceTable::parse("[a]\ntype = camera\n", table) == ErrorCode::InvalidParam,
+                "unknown type rejected");
+    TEST_ASSERT(DeviceTable::parse("type = led\n", table) == ErrorCode::InvalidParam,
+                "key outside section rejected");
+    TEST_ASSERT(DeviceTable::parse("[a\n", table) == ErrorCode::InvalidParam, "bad section header rejected");
+    TEST_ASSERT(DeviceTable::parse("[a]\ntype = led\ntimeout_ms = 99999999999\n", table) ==
+                    ErrorCode::InvalidParam,
+                "timeout_ms beyond int rejected");
+    TEST_ASSERT(DeviceTable::parse("[a]\ntype = led\ntimeout_ms = 2147483648\n", table) ==
+                    ErrorCode::InvalidParam,
+                "timeout_ms INT_MAX + 1 rejected");
+    TEST_ASSERT(DeviceTable::parse("[board]\ninit_threads = 99999999999999999999\n", table) ==
+                    ErrorCode::InvalidParam,
+                "init_threads overflow rejected");
+    TEST_ASSERT(DeviceTable::parse("[board]\ninit_threads = 1025\n", table) == ErrorCode::InvalidParam,
+                "init_threads above limit rejected");
+    TEST_ASSERT(DeviceTable::parse("[board]\ninit_threads = -1\n", table) == ErrorCode::InvalidParam,
+                "negative init_threads rejected");
+    TEST_ASSERT(table.size() == 0, "table stays empty on failure");
+}
+
+// 测试文件不存在
+void test_load_missing_file()
+{
+    std::printf("\n=== Testing Load Missing File ===\n");
+
+    DeviceTable table;
+    TEST_ASSERT(DeviceTable::load("/nonexistent/board.ini", table) == ErrorCode::DevOpen,
+                "load() with non-existent file");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Device Table Test Suite\n");
+    std::printf("========================================\n");
+
+    test_parse();
+    test_comments();
+    test_parse_errors();
+    test_load_missing_file();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+// 嵌入式配置相关的基础设施测试：定长字符串、错误码说明、不依赖异常的 bsp::Thread、
+// 驱动的设备名/路径类型。默认配置和嵌入式配置（-DBSP_EMBEDDED=ON）下都应通过
+
+#include "../src/common/fixed_string.h"
+#include "../src/common/thread_attr.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/led/led.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+#include <sstream>
+#include <string>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 测试定长字符串：赋值、追加、截断标记、比较
+void test_fixed_string()
+{
+    std::printf("\n=== Testing FixedString ===\n");
+
+    FixedString<8> empty;
+    TEST_ASSERT(empty.empty() && empty.size() == 0 && std::strcmp(empty.c_str(), "") == 0, "default is empty");
+    TEST_ASSERT(FixedString<8>::capacity() == 8 && sizeof(FixedString<8>) <= 16, "capacity stored inline");
+
+    FixedString<8> s("led");
+    TEST_ASSERT(s.size() == 3 && s == "led" && !s.truncated(), "construct from C string");
+    s += "0";
+    TEST_ASSERT(s == "led0" && s == std::string("led0") && std::string("led0") == s, "append and compare");
+    TEST_ASSERT(s != "led1" && "led1" != s && s != FixedString<16>("led"), "inequality");
+
+    s += "-status";
+    TEST_ASSERT(s.size() == 8 && s == "led0-sta" && s.truncated(), "append beyond capacity truncates");
+    s = "key";
+    TEST_ASSERT(s == "key" && !s.truncated(), "reassign clears truncation");
+
+    s.assign("/dev/zero", 4);
+    TEST_ASSERT(s == "/dev", "assign prefix");
+    s = std::string("0123456789");
+    TEST_ASSERT(s == "01234567" && s.truncated(), "assign long std::string truncates");
+    s.clear();
+    TEST_ASSERT(s.empty() && !s.truncated(), "clear()");
+
+    FixedString<16> a("ap3216c");
+    FixedString<32> b("ap3216c");
+    TEST_ASSERT(a == b && !(a != b), "compare different capacities");
+    std::string converted = a;
+    TEST_ASSERT(converted == "ap3216c", "convert to std::string");
+    std::ostringstream os;
+    os << a;
+    TEST_ASSERT(os.str() == "ap3216c", "stream output");
+}
+
+// 测试错误码说明：静态字符串，与 errorToString() 一致
+void test_error_message()
+{
+    std::printf("\n=== Testing errorMessage() ===\n");
+
+    bool same = true;
+    for (int i = 0; i < ERROR_CODE_COUNT; ++i)
+    {
+        ErrorCode err = static_cast<ErrorCode>(-i);
+        same = same && errorToString(err) == errorMessage(err);
+    }
+    TEST_ASSERT(same, "errorMessage() matches errorToString() for all codes");
+    TEST_ASSERT(std::strcmp(errorMessage(ErrorCode::Timeout), "Operation timed out") == 0, "errorMessage(Timeout)");
+    TEST_ASSERT(std::strcmp(errorMessage(static_cast<ErrorCode>(-100)), "Unknown error") == 0, "unknown code");
+}
+
+struct Worker
+{
+    std::atomic<int> runs;
+    std::atomic<pthread_t> runner;
+    Thread thread;
+
+    Worker() : runs(0), runner(pthread_t())
+    {
+    }
+
+    void run()
+    {
+        runner = pthread_self();
+        runs.fetch_add(1);
+    }
+};
+
+static ErrorCode startWorker(Worker &worker)
+{
+    return worker.thread.start<Worker, &Worker::run>(&worker);
+}
+
+// 测试 bsp::Thread：启动、join、重复启动、线程属性
+void test_thread()
+{
+    std::printf("\n=== Testing bsp::Thread ===\n");
+
+    Worker worker;
+    TEST_ASSERT(!worker.thread.joinable(), "not joinable before start");
+    TEST_ASSERT(applyThreadAttr(worker.thread, ThreadAttr(), "x") == ErrorCode::InvalidParam,
+                "attributes rejected before start");
+
+    TEST_ASSERT(startWorker(worker) == ErrorCode::Ok, "start()");
+    TEST_ASSERT(worker.thread.joinable(), "joinable after start");
+    TEST_ASSERT(startWorker(worker) == ErrorCode::InvalidParam, "second start() rejected");
+    worker.thread.join();
+    TEST_ASSERT(worker.runs == 1 && pthread_equal(worker.runner.load(), worker.thread.nativeHandle()) != 0 &&
+                    pthread_equal(worker.runner.load(), pthread_self()) == 0,
+                "member function ran once on the new thread");
+    TEST_ASSERT(!worker.thread.joinable(), "not joinable after join");
+    worker.thread.join();
+
+    TEST_ASSERT(startWorker(worker) == ErrorCode::Ok, "restart after join");
+    ThreadAttr attr;
+    attr.name = "bsp-embedded-test";
+    ErrorCode applied = applyThreadAttr(worker.thread, attr, "x");
+    worker.thread.join();
+    TEST_ASSERT(worker.runs == 2, "restarted thread ran");
+    // 线程可能已经退出，只检查不是参数错误
+    TEST_ASSERT(applied != ErrorCode::InvalidParam, "attributes accepted on started thread");
+}
+
+// 测试驱动的设备名/路径
+void test_device_strings()
+{
+    std::printf("\n=== Testing Device Name / Path ===\n");
+
+    AP3216C sensor(makeDeviceEntry(DeviceType::AP3216C, "ap3216c", "/dev/zero"));
+    const DeviceName &name = sensor.getDeviceName();
+    TEST_ASSERT(name == "ap3216c" && std::strcmp(name.c_str(), "ap3216c") == 0, "getDeviceName()");
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok, "init() with short path");
+
+    AP3216C byName("ap3216c-missing-node");
+    TEST_ASSERT(byName.getDeviceName() == "ap3216c-missing-node", "name from constructor");
+    TEST_ASSERT(byName.init() == ErrorCode::DevOpen, "missing /dev node");
+
+    // 超过嵌入式配置路径容量的路径：默认配置按原路径打开（不存在），嵌入式配置不打开截断后的路径
+    std::string longPath = "/tmp/" + std::string(120, 'x') + "/ap3216c";
+    std::string longName(80, 'n');
+    AP3216C longSensor(makeDeviceEntry(DeviceType::AP3216C, longName.c_str(), longPath.c_str()));
+#if BSP_EMBEDDED
+    TEST_ASSERT(longSensor.getDeviceName().size() == BSP_DEVICE_NAME_MAX &&
+                    longSensor.getDeviceName().truncated(),
+                "long name truncated to BSP_DEVICE_NAME_MAX");
+    TEST_ASSERT(longSensor.init() == ErrorCode::InvalidParam, "path beyond BSP_DEVICE_PATH_MAX rejected by init()");
+    TEST_ASSERT(sizeof(DevicePath) > BSP_DEVICE_PATH_MAX, "path stored inline");
+#else
+    TEST_ASSERT(longSensor.getDeviceName() == longName, "long name kept");
+    TEST_ASSERT(longSensor.init() == ErrorCode::DevOpen, "long path opened as given");
+#endif
+
+    Led led(makeDeviceEntry(DeviceType::Led, "led0", "/dev/zero"));
+    TEST_ASSERT(led.getDeviceName() == "led0" && led.init() == ErrorCode::Ok, "Led name and init()");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Embedded Profile Test Suite\n");
+#if BSP_EMBEDDED
+    std::printf("Profile: embedded (name <= %d, path <= %d)\n", BSP_DEVICE_NAME_MAX, BSP_DEVICE_PATH_MAX);
+#else
+    std::printf("Profile: default\n");
+#endif
+    std::printf("========================================\n");
+
+    spdlog::set_level(spdlog::level::off);
+    test_fixed_string();
+    test_error_message();
+    test_thread();
+    test_device_strings();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
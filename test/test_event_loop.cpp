@@ -0,0 +1,361 @@
+#include "../src/common/event_loop.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/dht11/dht11.h"
+#include "../src/driver/key/key.h"
+#include "test_support.h"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+static void feedKey(MockDevice &dev, int type, int code, int value)
+{
+    struct input_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.type = static_cast<uint16_t>(type);
+    event.code = static_cast<uint16_t>(code);
+    event.value = value;
+    dev.feed(&event, sizeof(event));
+}
+
+// 测试任务投递与停止
+void test_post_and_stop()
+{
+    std::printf("\n=== Testing Post / Stop ===\n");
+
+    EventLoop loop;
+    TEST_ASSERT(loop.watchOnce(0, [](uint32_t) {}) == ErrorCode::DevNotReady, "watchOnce() before init()");
+    TEST_ASSERT(loop.init() == ErrorCode::Ok, "init()");
+
+    int ran = 0;
+    loop.post([&ran] { ++ran; });
+    loop.post([&ran] { ++ran; });
+    TEST_ASSERT(loop.pending() == 2, "pending() counts posted tasks");
+    loop.run();
+    TEST_ASSERT(ran == 2, "run() executes posted tasks and returns when idle");
+    TEST_ASSERT(loop.runOnce(0) == 0, "runOnce(0) with nothing pending");
+
+    // 其他线程投递的任务在循环线程中执行并停止循环（fd 一直不可读，run() 不会因空闲返回）
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "pipe()");
+    loop.watchOnce(fds[0], [](uint32_t) {});
+    std::thread other([&loop, &ran] {
+        loop.post([&loop, &ran] {
+            ran = 100;
+            loop.stop();
+        });
+    });
+    loop.run();
+    other.join();
+    TEST_ASSERT(ran == 100, "post() from another thread");
+    TEST_ASSERT(loop.pending() == 1, "stop() leaves the watch pending");
+    loop.cancel(fds[0]);
+    TEST_ASSERT(loop.pending() == 0, "cancel() removes the watch");
+    close(fds[0]);
+    close(fds[1]);
+}
+
+// 测试传感器异步读取
+void test_sensor_async()
+{
+    std::printf("\n=== Testing Sensor readAsync() ===\n");
+
+    EventLoop loop;
+    loop.init();
+
+    MockDevice alsDev(DeviceType::AP3216C, "mock-ap3216c");
+    MockDevice thDev(DeviceType::DHT11, "mock-dht11");
+    AP3216C als(alsDev.entry);
+    DHT11 th(thDev.entry);
+
+    TEST_ASSERT(als.readAsync(loop, [](ErrorCode, const AP3216CData &) {}) == ErrorCode::DevNotReady,
+                "readAsync() before init()");
+    TEST_ASSERT(als.init() == ErrorCode::Ok && th.init() == ErrorCode::Ok, "init mock sensors");
+
+    int alsReads = 0;
+    uint16_t lastAls = 0;
+    std::function<void(ErrorCode, const AP3216CData &)> onAls;
+    onAls = [&](ErrorCode err, const AP3216CData &data) {
+        if (err == ErrorCode::Ok)
+        {
+            ++alsReads;
+            lastAls = data.als;
+            if (alsReads < 3)
+            {
+                als.readAsync(loop, onAls); // 在回调中发起下一次读取
+            }
+        }
+    };
+    TEST_ASSERT(als.readAsync(loop, onAls) == ErrorCode::Ok, "AP3216C readAsync() submitted");
+    TEST_ASSERT(als.readAsync(loop, onAls) == ErrorCode::InvalidParam, "second pending read rejected");
+
+    bool thDone = false;
+    DHT11Data thData;
+    std::memset(&thData, 0, sizeof(thData));
+    TEST_ASSERT(th.readAsync(loop, [&](ErrorCode err, const DHT11Data &data) {
+        thDone = (err == ErrorCode::Ok);
+        thData = data;
+    }) == ErrorCode::Ok,
+                "DHT11 readAsync() submitted");
+
+    TEST_ASSERT(loop.runOnce(0) == 0, "nothing ready before data arrives");
+
+    uint8_t th_raw[4] = {55, 0, 23, 5};
+    thDev.feed(th_raw, sizeof(th_raw));
+    for (uint16_t i = 1; i <= 3; ++i)
+    {
+        uint16_t raw[3] = {i, static_cast<uint16_t>(i * 100), i};
+        alsDev.feed(raw, sizeof(raw));
+    }
+    loop.run();
+
+    TEST_ASSERT(thDone && thData.humidity_int == 55 && thData.temperature_int == 23 &&
+                    thData.temperature_decimal == 5,
+                "DHT11 data delivered");
+    TEST_ASSERT(alsReads == 3 && lastAls == 300, "AP3216C chained reads delivered in order");
+    TEST_ASSERT(loop.pending() == 0, "loop idle after reads");
+}
+
+// 测试不支持 poll 的设备节点（普通文件）退化为直接读取
+void test_non_pollable()
+{
+    std::printf("\n=== Testing Non-pollable Fallback ===\n");
+
+    EventLoop loop;
+    loop.init();
+
+    DeviceEntry entry = makeDeviceEntry(DeviceType::AP3216C, "zero-ap3216c", "/dev/zero");
+    AP3216C zero(entry);
+    zero.init();
+
+    std::string path = "/tmp/bsp_event_loop_test_" + std::to_string(getpid()) + ".bin";
+    FILE *file = std::fopen(path.c_str(), "wb");
+    uint8_t raw[4] = {40, 0, 20, 0};
+    std::fwrite(raw, 1, sizeof(raw), file);
+    std::fclose(file);
+    entry = makeDeviceEntry(DeviceType::DHT11, "file-dht11", path.c_str());
+    DHT11 th(entry);
+    th.init();
+
+    ErrorCode zeroErr = ErrorCode::DevIo;
+    ErrorCode fileErr = ErrorCode::DevIo;
+    int fileHumidity = -1;
+    TEST_ASSERT(zero.readAsync(loop, [&](ErrorCode err, const AP3216CData &) { zeroErr = err; }) == ErrorCode::Ok,
+                "readAsync() on /dev/zero");
+    TEST_ASSERT(th.readAsync(loop, [&](ErrorCode err, const DHT11Data &data) {
+        fileErr = err;
+        fileHumidity = data.humidity_int;
+    }) == ErrorCode::Ok,
+                "readAsync() on regular file (epoll EPERM)");
+    loop.run();
+    TEST_ASSERT(zeroErr == ErrorCode::Ok, "/dev/zero read completed");
+    TEST_ASSERT(fileErr == ErrorCode::Ok && fileHumidity == 40, "regular file read completed");
+
+    // 文件已读到末尾，再次读取应返回 DevIo
+    th.readAsync(loop, [&](ErrorCode err, const DHT11Data &) { fileErr = err; });
+    loop.run();
+    TEST_ASSERT(fileErr == ErrorCode::DevIo, "short read reported as DevIo");
+
+    zeroErr = ErrorCode::Timeout;
+    zero.readAsync(loop, [&](ErrorCode err, const AP3216CData &) { zeroErr = err; });
+    TEST_ASSERT(loop.pending() == 2, "armed watch and its posted task pending");
+    loop.run();
+    TEST_ASSERT(zeroErr == ErrorCode::Ok, "non-pollable watch fires on next iteration");
+    unlink(path.c_str());
+}
+
+// 测试 fd 关闭后号码被复用：watchOnce() 重新注册新文件
+void test_fd_reuse()
+{
+    std::printf("\n=== Testing fd Reuse ===\n");
+
+    EventLoop loop;
+    loop.init();
+
+    // 可 poll 的 fd 触发后未 cancel() 就关闭，同号的新管道仍可等待
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "pipe()");
+    int fired = 0;
+    loop.watchOnce(fds[0], [&fired](uint32_t) { ++fired; });
+    ssize_t n = write(fds[1], "x", 1);
+    (void)n;
+    loop.run();
+    int oldFd = fds[0];
+    close(fds[0]);
+    close(fds[1]);
+
+    TEST_ASSERT(pipe(fds) == 0 && fds[0] == oldFd, "new pipe reuses the fd number");
+    TEST_ASSERT(loop.watchOnce(fds[0], [&fired](uint32_t) { ++fired; }) == ErrorCode::Ok,
+                "watchOnce() on reused fd");
+    TEST_ASSERT(loop.runOnce(0) == 0, "reused fd not ready before data");
+    n = write(fds[1], "x", 1);
+    TEST_ASSERT(loop.runOnce(0) == 1 && fired == 2, "reused fd fires");
+    close(fds[0]);
+    close(fds[1]);
+
+    // 不支持 poll 的普通文件关闭后，同号的管道按可 poll 处理（不再直接投递）
+    std::string path = "/tmp/bsp_event_loop_reuse_" + std::to_string(getpid()) + ".bin";
+    int fileFd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    TEST_ASSERT(loop.watchOnce(fileFd, [&fired](uint32_t) { ++fired; }) == ErrorCode::Ok,
+                "watchOnce() on regular file reusing a pollable fd number");
+    loop.run();
+    TEST_ASSERT(fired == 3, "regular file fires directly");
+    close(fileFd);
+    unlink(path.c_str());
+
+    TEST_ASSERT(pipe(fds) == 0 && fds[0] == fileFd, "pipe reuses the regular file's fd number");
+    TEST_ASSERT(loop.watchOnce(fds[0], [&fired](uint32_t) { ++fired; }) == ErrorCode::Ok,
+                "watchOnce() re-probes reused fd");
+    TEST_ASSERT(loop.runOnce(0) == 0 && fired == 3, "reused fd waits for data");
+    n = write(fds[1], "x", 1);
+    TEST_ASSERT(loop.runOnce(0) == 1 && fired == 4, "reused fd fires when readable");
+    close(fds[0]);
+    close(fds[1]);
+
+    // 驱动层：传感器关闭后重新创建（fd 号相同），异步读取继续可用
+    for (int round = 0; round < 2; ++round)
+    {
+        MockDevice mock(DeviceType::AP3216C, "reuse-ap3216c");
+        AP3216C sensor(mock.entry);
+        sensor.init();
+        ErrorCode err = ErrorCode::DevIo;
+        TEST_ASSERT(sensor.readAsync(loop, [&err](ErrorCode e, const AP3216CData &) { err = e; }) == ErrorCode::Ok,
+                    "readAsync() on recreated sensor");
+        uint16_t raw[3] = {1, 2, 3};
+        mock.feed(raw, sizeof(raw));
+        loop.run();
+        TEST_ASSERT(err == ErrorCode::Ok, "recreated sensor read completed");
+    }
+}
+
+// 测试循环的唤醒、fd 回调和投递任务写入事件追踪
+void test_trace_events()
+{
+    std::printf("\n=== Testing Trace Events ===\n");
+
+    EventLoop loop;
+    loop.init();
+    Trace::enable();
+    Trace::clear();
+
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "pipe()");
+    loop.watchOnce(fds[0], [](uint32_t) {});
+    loop.post([] {});
+    ssize_t n = write(fds[1], "x", 1);
+    (void)n;
+    loop.run();
+    loop.cancel(fds[0]);
+    close(fds[0]);
+    close(fds[1]);
+
+    std::string json = Trace::toJson();
+    Trace::disable();
+    Trace::clear();
+    TEST_ASSERT(json.find("\"EventLoop::wakeup\"") != std::string::npos, "wakeup instant recorded");
+    TEST_ASSERT(json.find("\"EventLoop::callback\"") != std::string::npos, "fd callback span recorded");
+    TEST_ASSERT(json.find("\"EventLoop::task\"") != std::string::npos, "posted task span recorded");
+}
+
+// 测试按键异步事件
+void test_key_next_event()
+{
+    std::printf("\n=== Testing Key nextEvent() ===\n");
+
+    EventLoop loop;
+    loop.init();
+
+    MockDevice dev(DeviceType::Key, "mock-key");
+    Key key(dev.entry);
+    TEST_ASSERT(key.init() == ErrorCode::Ok, "init mock key");
+
+    int codes[4] = {0};
+    int values[4] = {0};
+    int count = 0;
+    std::function<void(ErrorCode, int, int)> onKey;
+    onKey = [&](ErrorCode err, int code, int value) {
+        if (err != ErrorCode::Ok || count >= 4)
+        {
+            return;
+        }
+        codes[count] = code;
+        values[count] = value;
+        if (++count < 2)
+        {
+            key.nextEvent(loop, onKey);
+        }
+    };
+    TEST_ASSERT(key.nextEvent(loop, onKey) == ErrorCode::Ok, "nextEvent() submitted");
+
+    feedKey(dev, EV_KEY, KEY_ENTER, 1);
+    feedKey(dev, EV_SYN, SYN_REPORT, 0);
+    feedKey(dev, EV_KEY, KEY_ENTER, 0);
+    feedKey(dev, EV_SYN, SYN_REPORT, 0);
+    loop.run();
+
+    TEST_ASSERT(count == 2, "two key events delivered");
+    TEST_ASSERT(codes[0] == KEY_ENTER && values[0] == 1, "press reported");
+    TEST_ASSERT(codes[1] == KEY_ENTER && values[1] == 0, "release reported, EV_SYN skipped");
+
+    // 剩余的 EV_SYN 不会触发回调
+    key.nextEvent(loop, onKey);
+    loop.runOnce(0);
+    TEST_ASSERT(count == 2 && loop.pending() == 1, "EV_SYN re-arms the wait");
+
+    TEST_ASSERT(key.start() == ErrorCode::Ok, "start() event thread");
+    EventLoop other;
+    other.init();
+    TEST_ASSERT(key.nextEvent(other, onKey) == ErrorCode::Unsupported, "nextEvent() rejected while running");
+    key.stop();
+}
+
+int main()
+{
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("========================================\n");
+    std::printf("BSP Event Loop Test Suite\n");
+    std::printf("========================================\n");
+
+    test_post_and_stop();
+    test_sensor_async();
+    test_non_pollable();
+    test_fd_reuse();
+    test_trace_events();
+    test_key_next_event();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
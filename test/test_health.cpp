@@ -0,0 +1,312 @@
+#include "../src/pipeline/health.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 记录收到的事件
+struct EventLog
+{
+    std::vector<HealthEvent> events;
+    std::vector<std::string> channels;
+
+    HealthMonitor::Callback callback()
+    {
+        return [this](const HealthEvent &event) {
+            events.push_back(event);
+            channels.push_back(event.channel ? event.channel : "");
+        };
+    }
+};
+
+// 逐个喂入脚本化样本（单通道），返回最后一次的状态
+static HealthStatus feed(HealthMonitor &monitor, const std::vector<float> &script)
+{
+    HealthStatus status = HealthStatus::Ok;
+    for (float v : script)
+    {
+        status = monitor.record(ErrorCode::Ok, &v);
+    }
+    return status;
+}
+
+void test_strings()
+{
+    std::printf("\n=== Testing Status Strings ===\n");
+
+    TEST_ASSERT(std::strcmp(healthToString(HealthStatus::Ok), "ok") == 0, "ok");
+    TEST_ASSERT(std::strcmp(healthToString(HealthStatus::ErrorRate), "error_rate") == 0, "error_rate");
+    TEST_ASSERT(std::strcmp(healthToString(HealthStatus::Stuck), "stuck") == 0, "stuck");
+    TEST_ASSERT(std::strcmp(healthToString(HealthStatus::Spike), "spike") == 0, "spike");
+    TEST_ASSERT(std::strcmp(healthToString(HealthStatus::Outlier), "outlier") == 0, "outlier");
+    TEST_ASSERT(-static_cast<int>(HealthStatus::Outlier) == HEALTH_STATUS_COUNT - 1, "HEALTH_STATUS_COUNT");
+}
+
+// 测试相同读数游程
+void test_stuck()
+{
+    std::printf("\n=== Testing Stuck Detection ===\n");
+
+    HealthMonitor monitor("mock");
+    ChannelHealthConfig cfg;
+    cfg.stuckRun = 5;
+    TEST_ASSERT(monitor.addChannel("value", cfg) == 0, "addChannel()");
+    EventLog log;
+    monitor.setCallback(log.callback());
+
+    TEST_ASSERT(feed(monitor, {3, 7, 7, 7, 7}) == HealthStatus::Ok, "run of 4 is healthy");
+    TEST_ASSERT(log.events.empty(), "no event yet");
+    TEST_ASSERT(feed(monitor, {7}) == HealthStatus::Stuck, "run of 5 -> Stuck");
+    TEST_ASSERT(log.events.size() == 1 && log.events[0].active && log.events[0].status == HealthStatus::Stuck,
+                "stuck event raised");
+    TEST_ASSERT(log.channels[0] == "value" && std::strcmp(log.events[0].device, "mock") == 0 &&
+                    log.events[0].sample == 6 && log.events[0].value == 7.0f,
+                "event carries device, channel, sample index and value");
+
+    feed(monitor, {7, 7, 7});
+    TEST_ASSERT(log.events.size() == 1, "edge triggered: no repeat while still stuck");
+    TEST_ASSERT(feed(monitor, {8}) == HealthStatus::Ok, "value change clears Stuck");
+    TEST_ASSERT(log.events.size() == 2 && !log.events[1].active && log.events[1].sample == 10, "clear event");
+}
+
+// 测试变化率上限
+void test_spike()
+{
+    std::printf("\n=== Testing Rate-of-Change Bound ===\n");
+
+    HealthMonitor monitor("mock");
+    ChannelHealthConfig cfg;
+    cfg.maxStep = 10.0f;
+    monitor.addChannel("value", cfg);
+    EventLog log;
+    monitor.setCallback(log.callback());
+
+    TEST_ASSERT(feed(monitor, {100, 110, 101}) == HealthStatus::Ok, "steps within bound");
+    TEST_ASSERT(feed(monitor, {130}) == HealthStatus::Spike, "jump of 29 -> Spike");
+    TEST_ASSERT(monitor.channelStatus(0) == HealthStatus::Spike, "channelStatus()");
+    TEST_ASSERT(feed(monitor, {125}) == HealthStatus::Ok, "next small step clears Spike");
+    TEST_ASSERT(log.events.size() == 2 && log.events[0].value == 130.0f && !log.events[1].active,
+                "spike raise + clear events");
+    TEST_ASSERT(feed(monitor, {90}) == HealthStatus::Spike, "negative jump -> Spike");
+}
+
+// 测试 EWMA 均值/方差与 z 分数
+void test_outlier()
+{
+    std::printf("\n=== Testing EWMA Z-Score ===\n");
+
+    HealthMonitor monitor("mock");
+    ChannelHealthConfig cfg;
+    cfg.zThreshold = 4.0f;
+    cfg.alpha = 0.1f;
+    cfg.minSigma = 0.5f;
+    cfg.warmup = 10;
+    monitor.addChannel("value", cfg);
+    EventLog log;
+    monitor.setCallback(log.callback());
+
+    TEST_ASSERT(feed(monitor, {100, 500}) == HealthStatus::Ok, "no z-score during warm-up");
+    monitor.reset();
+    TEST_ASSERT(monitor.samples() == 0 && monitor.status() == HealthStatus::Ok, "reset()");
+
+    std::vector<float> noise;
+    for (int i = 0; i < 60; ++i)
+    {
+        noise.push_back(100.0f + static_cast<float>((i * 7) % 5) - 2.0f); // 98..102
+    }
+    TEST_ASSERT(feed(monitor, noise) == HealthStatus::Ok, "noise around 100 is healthy");
+    TEST_ASSERT(monitor.mean(0) > 99.0f && monitor.mean(0) < 101.0f, "EWMA mean tracks 100");
+    TEST_ASSERT(monitor.sigma(0) > 0.8f && monitor.sigma(0) < 2.0f, "EWMA sigma tracks noise");
+
+    TEST_ASSERT(feed(monitor, {103}) == HealthStatus::Ok, "within 4 sigma");
+    TEST_ASSERT(feed(monitor, {140}) == HealthStatus::Outlier, "far outside 4 sigma -> Outlier");
+    TEST_ASSERT(log.events.size() == 1 && log.events[0].status == HealthStatus::Outlier, "outlier event");
+    TEST_ASSERT(feed(monitor, {100}) == HealthStatus::Ok, "back to normal clears Outlier");
+
+    // 恒定信号：minSigma 防止 1 个计数的变化被判为离群
+    HealthMonitor flat("flat");
+    flat.addChannel("value", cfg);
+    std::vector<float> constant(30, 50.0f);
+    feed(flat, constant);
+    TEST_ASSERT(feed(flat, {51}) == HealthStatus::Ok, "minSigma floor on constant signal");
+    TEST_ASSERT(feed(flat, {60}) == HealthStatus::Outlier, "large step on constant signal");
+}
+
+// 测试读取失败率
+void test_error_rate()
+{
+    std::printf("\n=== Testing Read Error Rate ===\n");
+
+    HealthConfig config;
+    config.errorAlpha = 0.1f;
+    config.maxErrorRate = 0.3f;
+    HealthMonitor monitor("mock", config);
+    monitor.addChannel("value", ChannelHealthConfig());
+    EventLog log;
+    monitor.setCallback(log.callback());
+
+    float v = 1.0f;
+    // 失败率 = 1 - 0.9^k：k = 3 时 0.271，k = 4 时 0.344
+    for (int i = 0; i < 3; ++i)
+    {
+        monitor.record(ErrorCode::DevIo, nullptr);
+    }
+    TEST_ASSERT(monitor.status() == HealthStatus::Ok && log.events.empty(), "3 failures below threshold");
+    TEST_ASSERT(monitor.record(ErrorCode::Timeout, nullptr) == HealthStatus::ErrorRate, "4th failure -> ErrorRate");
+    TEST_ASSERT(log.events.size() == 1 && log.events[0].channel == nullptr && log.events[0].sample == 4,
+                "device-level event");
+    TEST_ASSERT(monitor.errorRate() > 0.34f && monitor.errorRate() < 0.35f, "errorRate() value");
+
+    // 回落到 0.15 以下才解除：0.344 * 0.9^n < 0.15 -> n = 8
+    for (int i = 0; i < 7; ++i)
+    {
+        monitor.record(ErrorCode::Ok, &v);
+    }
+    TEST_ASSERT(monitor.status() == HealthStatus::ErrorRate, "hysteresis keeps ErrorRate above half threshold");
+    TEST_ASSERT(monitor.record(ErrorCode::Ok, &v) == HealthStatus::Ok, "cleared below half threshold");
+    TEST_ASSERT(log.events.size() == 2 && !log.events[1].active && log.events[1].sample == 12, "clear event");
+    TEST_ASSERT(monitor.samples() == 12, "samples() counts failures too");
+}
+
+// 测试预置监测与状态优先级
+void test_presets()
+{
+    std::printf("\n=== Testing Sensor Presets ===\n");
+
+    HealthMonitor light = HealthMonitor::forAP3216C("ap3216c");
+    TEST_ASSERT(light.channelCount() == 3 && light.channelName(0) == "als" && light.channelName(1) == "ps" &&
+                    light.channelName(2) == "ir",
+                "AP3216C preset channels");
+    EventLog log;
+    light.setCallback(log.callback());
+
+    AP3216CData frozen = {12, 345, 67};
+    HealthStatus status = HealthStatus::Ok;
+    for (int i = 0; i < 199; ++i)
+    {
+        status = light.record(ErrorCode::Ok, frozen);
+    }
+    TEST_ASSERT(status == HealthStatus::Ok, "199 identical samples healthy");
+    TEST_ASSERT(light.record(ErrorCode::Ok, frozen) == HealthStatus::Stuck, "200 identical raw samples -> Stuck");
+    TEST_ASSERT(log.events.size() == 1 && log.events[0].channel == nullptr, "whole-sample stuck is device-level");
+    AP3216CData moved = {12, 346, 67};
+    TEST_ASSERT(light.record(ErrorCode::Ok, moved) == HealthStatus::Ok, "one byte changed clears Stuck");
+
+    HealthMonitor climate = HealthMonitor::forDHT11("dht11");
+    TEST_ASSERT(climate.channelCount() == 2 && climate.channelName(1) == "temperature", "DHT11 preset channels");
+    DHT11Data normal = {45, 0, 24, 0};
+    DHT11Data jump = {45, 0, 39, 0};
+    for (int i = 0; i < 5; ++i)
+    {
+        climate.record(ErrorCode::Ok, normal);
+    }
+    TEST_ASSERT(climate.status() == HealthStatus::Ok, "constant DHT11 readings are not stuck");
+    TEST_ASSERT(climate.record(ErrorCode::Ok, jump) == HealthStatus::Spike, "15 C jump -> Spike");
+    TEST_ASSERT(climate.channelStatus(1) == HealthStatus::Spike && climate.channelStatus(0) == HealthStatus::Ok,
+                "spike attributed to temperature");
+
+    // ErrorRate 比 Spike 更严重
+    // 失败率 1 - 0.95^7 = 0.302
+    for (int i = 0; i < 7; ++i)
+    {
+        climate.record(ErrorCode::DevIo, normal);
+    }
+    TEST_ASSERT(climate.status() == HealthStatus::ErrorRate, "ErrorRate outranks Spike");
+    TEST_ASSERT(climate.channelStatus(1) == HealthStatus::Spike, "channel status kept while reads fail");
+}
+
+// 脚本化模拟设备：预设样本写入文件，驱动逐个读取后交给监测器，读到末尾后读取失败
+void test_mock_device()
+{
+    std::printf("\n=== Testing Scripted Mock Device ===\n");
+
+    std::string path = "/tmp/bsp_health_test_" + std::to_string(getpid()) + ".bin";
+    AP3216CData script[] = {{20, 300, 10}, {21, 302, 11}, {20, 300, 10}, {20, 9000, 10}};
+    FILE *fp = std::fopen(path.c_str(), "wb");
+    TEST_ASSERT(fp != nullptr && std::fwrite(script, sizeof(script), 1, fp) == 1, "script written");
+    if (fp != nullptr)
+    {
+        std::fclose(fp);
+    }
+
+    DeviceEntry entry = makeDeviceEntry(DeviceType::AP3216C, "ap3216c-mock", path.c_str());
+    AP3216C sensor(entry);
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok, "mock sensor init()");
+
+    HealthConfig config;
+    config.errorAlpha = 0.5f;
+    config.maxErrorRate = 0.6f;
+    HealthMonitor monitor("ap3216c-mock", config);
+    ChannelHealthConfig als;
+    als.maxStep = 1000.0f;
+    monitor.addChannel("als", als);
+    monitor.addChannel("ps", ChannelHealthConfig());
+    monitor.addChannel("ir", ChannelHealthConfig());
+    EventLog log;
+    monitor.setCallback(log.callback());
+
+    AP3216CData data;
+    HealthStatus status = HealthStatus::Ok;
+    for (int i = 0; i < 3; ++i)
+    {
+        status = monitor.record(sensor.readData(data), data);
+    }
+    TEST_ASSERT(status == HealthStatus::Ok, "scripted normal samples healthy");
+    TEST_ASSERT(monitor.record(sensor.readData(data), data) == HealthStatus::Spike, "scripted spike detected");
+
+    // 脚本读完：之后的读取失败，失败率 0.5 -> 0.75
+    ErrorCode ret = sensor.readData(data);
+    TEST_ASSERT(ret != ErrorCode::Ok, "read after end of script fails");
+    monitor.record(ret, data);
+    TEST_ASSERT(monitor.record(sensor.readData(data), data) == HealthStatus::ErrorRate, "failing reads -> ErrorRate");
+    TEST_ASSERT(log.events.size() == 2 && log.events[1].status == HealthStatus::ErrorRate, "events in order");
+    unlink(path.c_str());
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Sensor Health Monitor Test Suite\n");
+    std::printf("========================================\n");
+
+    test_strings();
+    test_stuck();
+    test_spike();
+    test_outlier();
+    test_error_rate();
+    test_presets();
+    test_mock_device();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
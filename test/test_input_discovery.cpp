@@ -0,0 +1,287 @@
+#include "../src/driver/key/input_discovery.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <linux/uinput.h>
+#include <sys/ioctl.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+template <typename Pred> static bool waitFor(Pred pred, int timeoutMs = 2000)
+{
+    for (int i = 0; i < timeoutMs / 5; ++i)
+    {
+        if (pred())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return pred();
+}
+
+static void setKey(InputDeviceInfo &info, int code)
+{
+    info.keys[code / 8] |= static_cast<uint8_t>(1u << (code % 8));
+}
+
+// 测试规则匹配：按设备名子串和按键能力
+void test_matching()
+{
+    std::printf("\n=== Testing Rule Matching ===\n");
+
+    InputDeviceInfo info;
+    info.name = "20000000.gpio-keys";
+    info.keys.assign((KEY_CNT + 7) / 8, 0);
+    setKey(info, KEY_POWER);
+    setKey(info, KEY_VOLUMEUP);
+
+    TEST_ASSERT(info.hasKey(KEY_POWER) && !info.hasKey(KEY_A), "hasKey()");
+    TEST_ASSERT(!info.hasKey(-1) && !info.hasKey(KEY_CNT + 8), "hasKey() out of range");
+
+    InputRule any;
+    TEST_ASSERT(InputDiscovery::matches(info, any), "empty rule matches anything");
+
+    InputRule byName;
+    byName.name = "gpio-keys";
+    TEST_ASSERT(InputDiscovery::matches(info, byName), "name substring matches");
+    byName.name = "usb-keyboard";
+    TEST_ASSERT(!InputDiscovery::matches(info, byName), "different name rejected");
+
+    InputRule byKeys;
+    byKeys.keys.push_back(KEY_POWER);
+    byKeys.keys.push_back(KEY_VOLUMEUP);
+    TEST_ASSERT(InputDiscovery::matches(info, byKeys), "all required keys present");
+    byKeys.keys.push_back(KEY_ENTER);
+    TEST_ASSERT(!InputDiscovery::matches(info, byKeys), "missing key rejected");
+}
+
+// 测试 probe()：非 evdev 节点和不存在的节点
+void test_probe()
+{
+    std::printf("\n=== Testing probe() ===\n");
+
+    InputDeviceInfo info;
+    TEST_ASSERT(InputDiscovery::probe("/nonexistent/event0", info) == ErrorCode::DevOpen, "missing node");
+
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "pipe()");
+    std::string path = "/proc/self/fd/" + std::to_string(fds[0]);
+    TEST_ASSERT(InputDiscovery::probe(path, info) == ErrorCode::Unsupported, "pipe is not evdev");
+    close(fds[0]);
+    close(fds[1]);
+}
+
+// 测试目录监视：临时目录中出现/删除的普通文件不会被挂接，stop() 立即返回
+void test_watch_directory()
+{
+    std::printf("\n=== Testing Directory Watch ===\n");
+
+    InputDiscovery missing("/nonexistent-input-dir");
+    TEST_ASSERT(missing.start() == ErrorCode::DevOpen, "start() on missing directory");
+
+    char tmpl[] = "/tmp/bsp-input-XXXXXX";
+    char *dir = mkdtemp(tmpl);
+    TEST_ASSERT(dir != nullptr, "mkdtemp()");
+    if (dir == nullptr)
+    {
+        return;
+    }
+    std::string existing = std::string(dir) + "/event0";
+    std::FILE *f = std::fopen(existing.c_str(), "w");
+    if (f != nullptr)
+    {
+        std::fclose(f);
+    }
+
+    std::mutex mutex;
+    std::vector<InputHotplugEvent> events;
+    InputDiscovery discovery(dir);
+    InputRule rule;
+    TEST_ASSERT(discovery.addRule(rule) == 0, "addRule() returns index");
+    discovery.setHotplugCallback([&](const InputHotplugEvent &e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(e);
+    });
+    TEST_ASSERT(discovery.start() == ErrorCode::Ok, "start() on temp directory");
+    TEST_ASSERT(discovery.isRunning(), "isRunning()");
+    TEST_ASSERT(discovery.addRule(rule) == -1, "addRule() rejected while running");
+    TEST_ASSERT(discovery.attachedCount() == 0, "existing non-evdev file skipped");
+
+    std::string created = std::string(dir) + "/event1";
+    f = std::fopen(created.c_str(), "w");
+    if (f != nullptr)
+    {
+        std::fclose(f);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    TEST_ASSERT(discovery.attachedCount() == 0 && discovery.attached().empty(), "new non-evdev file skipped");
+    unlink(created.c_str());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        TEST_ASSERT(events.empty(), "no hotplug events for non-evdev files");
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TEST_ASSERT(discovery.stop() == ErrorCode::Ok, "stop()");
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT(ms < 100.0, "stop() wakes the idle watcher immediately");
+    TEST_ASSERT(!discovery.isRunning() && discovery.stop() == ErrorCode::Ok, "stop() is idempotent");
+
+    unlink(existing.c_str());
+    rmdir(dir);
+}
+
+static int createUinput(const char *name)
+{
+    int ui = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+    if (ui < 0)
+    {
+        return -1;
+    }
+    uinput_setup setup;
+    std::memset(&setup, 0, sizeof(setup));
+    setup.id.bustype = BUS_VIRTUAL;
+    setup.id.vendor = 0x1;
+    setup.id.product = 0x2;
+    std::strncpy(setup.name, name, UINPUT_MAX_NAME_SIZE - 1);
+    if (ioctl(ui, UI_SET_EVBIT, EV_KEY) != 0 || ioctl(ui, UI_SET_KEYBIT, KEY_A) != 0 ||
+        ioctl(ui, UI_DEV_SETUP, &setup) != 0 || ioctl(ui, UI_DEV_CREATE) != 0)
+    {
+        close(ui);
+        return -1;
+    }
+    return ui;
+}
+
+static bool writeKey(int fd, uint16_t code, int32_t value)
+{
+    input_event ev[2];
+    std::memset(ev, 0, sizeof(ev));
+    ev[0].type = EV_KEY;
+    ev[0].code = code;
+    ev[0].value = value;
+    ev[1].type = EV_SYN;
+    ev[1].code = SYN_REPORT;
+    return write(fd, ev, sizeof(ev)) == static_cast<ssize_t>(sizeof(ev));
+}
+
+// 测试真实热插拔：测试期间创建并销毁 uinput 设备（需要 /dev/uinput，否则跳过）
+void test_uinput_hotplug()
+{
+    std::printf("\n=== Testing Hotplug via uinput ===\n");
+
+    if (access("/dev/uinput", W_OK) != 0 || access("/dev/input", R_OK) != 0)
+    {
+        std::printf("[SKIP] /dev/uinput or /dev/input unavailable\n");
+        return;
+    }
+
+    std::mutex mutex;
+    std::vector<InputHotplugEvent> events;
+    std::vector<std::pair<int, int>> keys;
+    InputDiscovery discovery;
+    InputRule rule;
+    rule.name = "bsp-discovery-test";
+    rule.keys.push_back(KEY_A);
+    rule.callback = [&](int code, int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        keys.push_back(std::make_pair(code, value));
+    };
+    discovery.addRule(rule);
+    discovery.setHotplugCallback([&](const InputHotplugEvent &e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(e);
+    });
+    TEST_ASSERT(discovery.start() == ErrorCode::Ok, "start() on /dev/input");
+    std::size_t before = discovery.attachedCount();
+
+    int ui = createUinput("bsp-discovery-test");
+    if (ui < 0)
+    {
+        std::printf("[SKIP] uinput device creation failed: %s\n", std::strerror(errno));
+        discovery.stop();
+        return;
+    }
+    TEST_ASSERT(waitFor([&] { return discovery.attachedCount() == before + 1; }), "device attached on create");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        TEST_ASSERT(events.size() == 1 && events[0].attached && events[0].rule == 0 &&
+                        events[0].name == "bsp-discovery-test",
+                    "attach notification");
+    }
+
+    TEST_ASSERT(writeKey(ui, KEY_A, 1) && writeKey(ui, KEY_A, 0), "press KEY_A");
+    TEST_ASSERT(waitFor([&] {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return keys.size() >= 2;
+                }),
+                "attached Key delivers events");
+
+    ioctl(ui, UI_DEV_DESTROY);
+    close(ui);
+    TEST_ASSERT(waitFor([&] { return discovery.attachedCount() == before; }), "device detached on destroy");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        TEST_ASSERT(events.size() == 2 && !events[1].attached, "detach notification");
+    }
+
+    // 再次创建（内核可能分配不同的 eventN）同样被发现
+    ui = createUinput("bsp-discovery-test");
+    TEST_ASSERT(ui >= 0 && waitFor([&] { return discovery.attachedCount() == before + 1; }), "re-created device attached");
+    if (ui >= 0)
+    {
+        ioctl(ui, UI_DEV_DESTROY);
+        close(ui);
+    }
+    TEST_ASSERT(discovery.stop() == ErrorCode::Ok && discovery.attachedCount() == 0, "stop() detaches all");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Input Discovery Test Suite\n");
+    std::printf("========================================\n");
+
+    test_matching();
+    test_probe();
+    test_watch_directory();
+    test_uinput_hotplug();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+#include "../src/common/event_loop.h"
+#include "../src/common/io_ring.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/dht11/dht11.h"
+#include "../src/driver/led/led.h"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <string>
+#include <unistd.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+static const char *backendName(IoBackend backend)
+{
+    return backend == IoBackend::IoUring ? "io_uring" : "posix";
+}
+
+// 生成内容为 0,1,2,... 的临时文件
+static std::string makeFile(const char *tag, std::size_t size)
+{
+    std::string path = std::string("/tmp/bsp_io_ring_") + tag + "_" + std::to_string(getpid()) + ".bin";
+    FILE *file = std::fopen(path.c_str(), "wb");
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        std::fputc(static_cast<int>(i & 0xff), file);
+    }
+    std::fclose(file);
+    return path;
+}
+
+// 测试基本的批量读取（普通文件 pread + 管道按当前位置读取）
+void test_batch_read(bool allowIoUring)
+{
+    std::printf("\n=== Testing Batched Reads (%s requested) ===\n", allowIoUring ? "io_uring" : "posix");
+
+    IoRing ring;
+    char buf[16];
+    TEST_ASSERT(ring.queueRead(0, buf, 1, -1, 0) == ErrorCode::DevNotReady, "queueRead() before init()");
+    TEST_ASSERT(ring.init(4, allowIoUring) == ErrorCode::Ok, "init()");
+    std::printf("backend: %s\n", backendName(ring.backend()));
+    if (!allowIoUring)
+    {
+        TEST_ASSERT(ring.backend() == IoBackend::Posix, "io_uring disabled forces posix backend");
+    }
+    TEST_ASSERT(ring.queueRead(-1, buf, 1, -1, 0) == ErrorCode::InvalidParam, "invalid fd rejected");
+
+    std::string path = makeFile("batch", 256);
+    int fileFd = open(path.c_str(), O_RDONLY);
+    int fds[2];
+    TEST_ASSERT(fileFd >= 0 && pipe(fds) == 0, "open file and pipe");
+    ssize_t w = write(fds[1], "abcdefgh", 8);
+    (void)w;
+
+    // 10 个操作超过提交深度 4 和完成队列容量 8
+    uint8_t fileData[8][4];
+    for (int i = 0; i < 8; ++i)
+    {
+        ring.queueRead(fileFd, fileData[i], 4, i * 16, static_cast<uint64_t>(i));
+    }
+    char pipeData[2][4];
+    ring.queueRead(fds[0], pipeData[0], 4, -1, 100);
+    ring.queueRead(fds[0], pipeData[1], 4, -1, 101);
+    TEST_ASSERT(ring.inFlight() == 10, "inFlight() counts queued ops");
+
+    int first = ring.submit(10);
+    TEST_ASSERT(ring.backend() == IoBackend::IoUring ? first == 8 : first == 10,
+                "submit() caps in-flight reads at completion queue capacity");
+
+    IoCompletion completions[16];
+    unsigned got = ring.reap(completions, 16);
+    while (ring.inFlight() > 0 && got < 16)
+    {
+        ring.submit(1);
+        got += ring.reap(completions + got, 16 - got);
+    }
+    TEST_ASSERT(got == 10, "all completions reaped");
+    TEST_ASSERT(ring.inFlight() == 0, "nothing in flight after reap");
+
+    bool allOk = true;
+    for (unsigned i = 0; i < got; ++i)
+    {
+        if (completionResult(completions[i], 4) != ErrorCode::Ok)
+        {
+            allOk = false;
+        }
+    }
+    TEST_ASSERT(allOk, "every read returned 4 bytes");
+
+    bool offsetsOk = true;
+    for (int i = 0; i < 8; ++i)
+    {
+        offsetsOk = offsetsOk && fileData[i][0] == i * 16 && fileData[i][3] == i * 16 + 3;
+    }
+    TEST_ASSERT(offsetsOk, "file reads honour offsets");
+    // 两个管道读取之间没有顺序保证，只检查拼起来的内容
+    bool pipeOk = (std::memcmp(pipeData[0], "abcd", 4) == 0 && std::memcmp(pipeData[1], "efgh", 4) == 0) ||
+                  (std::memcmp(pipeData[0], "efgh", 4) == 0 && std::memcmp(pipeData[1], "abcd", 4) == 0);
+    TEST_ASSERT(pipeOk, "pipe reads from current position");
+
+    // 读到文件末尾之后
+    ring.queueRead(fileFd, buf, 4, 1024, 7);
+    ring.submit(1);
+    got = ring.reap(completions, 16);
+    TEST_ASSERT(got == 1 && completions[0].result == 0 && completionResult(completions[0], 4) == ErrorCode::DevIo,
+                "read past EOF reports short read");
+
+    close(fileFd);
+    close(fds[0]);
+    close(fds[1]);
+    unlink(path.c_str());
+}
+
+// 测试驱动接口、固定 fd / 缓冲区和 LED ioctl
+void test_drivers(bool allowIoUring)
+{
+    std::printf("\n=== Testing Driver Batching (%s requested) ===\n", allowIoUring ? "io_uring" : "posix");
+
+    IoRing ring;
+    ring.init(16, allowIoUring);
+
+    std::string alsPath = makeFile("als", 64);
+    std::string thPath = makeFile("th", 64);
+    DeviceEntry alsEntry = makeDeviceEntry(DeviceType::AP3216C, "file-ap3216c", alsPath.c_str());
+    DeviceEntry thEntry = makeDeviceEntry(DeviceType::DHT11, "file-dht11", thPath.c_str());
+    DeviceEntry ledEntry = makeDeviceEntry(DeviceType::Led, "null-led", "/dev/null");
+    AP3216C als(alsEntry);
+    DHT11 th(thEntry);
+    Led led(ledEntry);
+
+    AP3216CData alsData[2];
+    DHT11Data thData;
+    TEST_ASSERT(als.queueRead(ring, alsData[0], 1) == ErrorCode::DevNotReady, "queueRead() before init()");
+    TEST_ASSERT(led.queueSetState(ring, true, 9) == ErrorCode::DevNotReady, "queueSetState() before init()");
+    als.init();
+    th.init();
+    led.init();
+
+    int files[2] = {als.getFd(), th.getFd()};
+    TEST_ASSERT(ring.registerFiles(files, 2) == ErrorCode::Ok, "registerFiles()");
+    TEST_ASSERT(ring.registerFiles(files, 2) == ErrorCode::InvalidParam || ring.backend() == IoBackend::Posix,
+                "registerFiles() only once");
+    iovec buffers[1] = {{alsData, sizeof(alsData)}};
+    TEST_ASSERT(ring.registerBuffers(buffers, 1) == ErrorCode::Ok, "registerBuffers()");
+
+    int notifyFd = ring.completionFd();
+    TEST_ASSERT(notifyFd >= 0, "completionFd()");
+
+    als.queueRead(ring, alsData[0], 1);
+    als.queueRead(ring, alsData[1], 2);
+    th.queueRead(ring, thData, 3);
+    led.queueSetState(ring, true, 4);
+
+    IoRingStats before = ring.stats();
+    TEST_ASSERT(ring.submit(4) == 4, "submit() driver batch");
+    IoRingStats after = ring.stats();
+    if (ring.backend() == IoBackend::IoUring)
+    {
+        // 3 个读取一次 io_uring_enter，LED ioctl 同步执行
+        TEST_ASSERT(after.syscalls - before.syscalls == 2, "io_uring: one enter for the reads plus the ioctl");
+    }
+    else
+    {
+        TEST_ASSERT(after.syscalls - before.syscalls == 4, "posix: one syscall per op");
+    }
+
+    pollfd pfd = {notifyFd, POLLIN, 0};
+    TEST_ASSERT(poll(&pfd, 1, 1000) == 1, "completionFd() readable after submit");
+
+    IoCompletion completions[8];
+    unsigned got = ring.reap(completions, 8);
+    TEST_ASSERT(got == 4, "four completions");
+    ErrorCode results[5] = {ErrorCode::Timeout, ErrorCode::Timeout, ErrorCode::Timeout, ErrorCode::Timeout,
+                            ErrorCode::Timeout};
+    for (unsigned i = 0; i < got; ++i)
+    {
+        uint64_t id = completions[i].userData;
+        unsigned expected = (id == 1 || id == 2) ? sizeof(AP3216CData) : (id == 3 ? sizeof(DHT11Data) : 0);
+        if (id >= 1 && id <= 4)
+        {
+            results[id] = completionResult(completions[i], expected);
+        }
+    }
+    TEST_ASSERT(results[1] == ErrorCode::Ok && results[2] == ErrorCode::Ok, "AP3216C batched reads");
+    // 两次读取共享文件位置，合起来覆盖前 12 字节
+    uint16_t first = alsData[0].ir < alsData[1].ir ? alsData[0].ir : alsData[1].ir;
+    TEST_ASSERT(first == 0x0100, "AP3216C data read in place");
+    TEST_ASSERT(results[3] == ErrorCode::Ok && thData.humidity_int == 0 && thData.temperature_int == 2,
+                "DHT11 batched read");
+    TEST_ASSERT(results[4] == ErrorCode::DevIo, "LED ioctl error propagated (/dev/null has no LED_ON)");
+    TEST_ASSERT(poll(&pfd, 1, 0) == 0, "reap() clears completionFd()");
+
+    unlink(alsPath.c_str());
+    unlink(thPath.c_str());
+}
+
+// 测试通过事件循环取回完成结果
+void test_event_loop(bool allowIoUring)
+{
+    std::printf("\n=== Testing EventLoop Delivery (%s requested) ===\n", allowIoUring ? "io_uring" : "posix");
+
+    EventLoop loop;
+    loop.init();
+    IoRing ring;
+    ring.init(8, allowIoUring);
+
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "pipe()");
+    char data[4];
+    bool async = ring.backend() == IoBackend::IoUring;
+    if (!async)
+    {
+        // POSIX 后端在 submit() 中同步读取，数据须先就绪
+        ssize_t w = write(fds[1], "ping", 4);
+        (void)w;
+    }
+    ring.queueRead(fds[0], data, 4, -1, 42);
+    ring.submit();
+
+    uint64_t delivered = 0;
+    TEST_ASSERT(loop.watchOnce(ring.completionFd(), [&](uint32_t) {
+        IoCompletion c;
+        if (ring.reap(&c, 1) == 1 && completionResult(c, 4) == ErrorCode::Ok)
+        {
+            delivered = c.userData;
+        }
+    }) == ErrorCode::Ok,
+                "watch completionFd()");
+
+    if (async)
+    {
+        TEST_ASSERT(loop.runOnce(0) == 0, "no completion before data arrives");
+        ssize_t w = write(fds[1], "ping", 4);
+        (void)w;
+    }
+    loop.run();
+    TEST_ASSERT(delivered == 42, "completion delivered on the loop thread");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main()
+{
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("========================================\n");
+    std::printf("BSP I/O Ring Test Suite\n");
+    std::printf("========================================\n");
+
+    const bool backends[] = {true, false};
+    for (bool allowIoUring : backends)
+    {
+        test_batch_read(allowIoUring);
+        test_drivers(allowIoUring);
+        test_event_loop(allowIoUring);
+    }
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,333 @@
+#include "../src/driver/key/key.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+static const uint64_t MS = 1000; // 事件时间戳单位为微秒
+
+// 脚本化输入：按时间顺序喂入一个按键事件，可选地紧跟 SYN_REPORT
+static void key(KeyDebouncer &d, uint16_t code, int32_t value, uint64_t timeUs, bool syn = false)
+{
+    d.feed(EV_KEY, code, value, timeUs);
+    if (syn)
+    {
+        d.feed(EV_SYN, SYN_REPORT, 0, timeUs);
+    }
+}
+
+static std::vector<KeyLogicalEvent> drain(KeyDebouncer &d)
+{
+    std::vector<KeyLogicalEvent> out;
+    KeyLogicalEvent event;
+    while (d.pop(event))
+    {
+        out.push_back(event);
+    }
+    return out;
+}
+
+void test_passthrough()
+{
+    std::printf("\n=== Testing Default Passthrough ===\n");
+
+    KeyDebouncer d;
+    key(d, KEY_ENTER, 1, 0);
+    key(d, KEY_ENTER, 0, 1 * MS);
+    key(d, KEY_ENTER, 1, 2 * MS);
+    key(d, KEY_ENTER, 2, 3 * MS);
+    key(d, KEY_ENTER, 0, 4 * MS);
+    std::vector<KeyLogicalEvent> out = drain(d);
+    TEST_ASSERT(out.size() == 5 && out[0].value == 1 && out[1].value == 0 && out[3].value == 2,
+                "default config forwards every event");
+    KeyDebounceStats s = d.stats();
+    TEST_ASSERT(s.received == 5 && s.dispatched == 5 && s.bounced == 0, "passthrough stats");
+    TEST_ASSERT(d.nextDeadlineUs() == UINT64_MAX, "no pending deadline");
+}
+
+// 测试典型的机械抖动：按下和松开各抖动几次
+void test_bouncy_press()
+{
+    std::printf("\n=== Testing Bouncy Press / Release ===\n");
+
+    KeyDebounceConfig config;
+    config.windowMs = 10;
+    KeyDebouncer d(config);
+
+    // 按下抖动 4 次后稳定
+    const int pressScript[] = {1, 0, 1, 0, 1};
+    for (int i = 0; i < 5; ++i)
+    {
+        key(d, KEY_ENTER, pressScript[i], i * MS);
+    }
+    std::vector<KeyLogicalEvent> out = drain(d);
+    TEST_ASSERT(out.size() == 1 && out[0].value == 1 && out[0].timeUs == 0, "press dispatched at first edge");
+    TEST_ASSERT(d.isPressed(KEY_ENTER), "isPressed() after press");
+    d.expire(10 * MS);
+    TEST_ASSERT(drain(d).empty(), "settled pressed: nothing to confirm");
+
+    // 松开抖动 2 次后稳定
+    const int releaseScript[] = {0, 1, 0};
+    for (int i = 0; i < 3; ++i)
+    {
+        key(d, KEY_ENTER, releaseScript[i], (100 + i) * MS);
+    }
+    d.expire(110 * MS);
+    out = drain(d);
+    TEST_ASSERT(out.size() == 1 && out[0].value == 0 && out[0].timeUs == 100 * MS, "release dispatched once");
+    KeyDebounceStats s = d.stats();
+    TEST_ASSERT(s.received == 8 && s.dispatched == 2 && s.bounced == 6, "8 raw events -> 2 logical, 6 bounced");
+}
+
+// 测试时间窗内真正松开（快速点按）：时间窗结束时补发释放
+void test_release_inside_window()
+{
+    std::printf("\n=== Testing Release Inside Window ===\n");
+
+    KeyDebounceConfig config;
+    config.windowMs = 10;
+    KeyDebouncer d(config);
+
+    key(d, KEY_A, 1, 0);
+    key(d, KEY_A, 0, 3 * MS);
+    std::vector<KeyLogicalEvent> out = drain(d);
+    TEST_ASSERT(out.size() == 1 && out[0].value == 1, "press only until window ends");
+    TEST_ASSERT(d.nextDeadlineUs() == 10 * MS, "deadline at end of window");
+
+    d.expire(10 * MS - 1);
+    TEST_ASSERT(drain(d).empty() && d.isPressed(KEY_A), "not confirmed before deadline");
+    d.expire(10 * MS);
+    out = drain(d);
+    TEST_ASSERT(out.size() == 1 && out[0].code == KEY_A && out[0].value == 0 && out[0].timeUs == 10 * MS,
+                "release confirmed at deadline");
+    TEST_ASSERT(!d.isPressed(KEY_A) && d.nextDeadlineUs() == UINT64_MAX, "state settled, no deadline");
+
+    // 补发后重新计时：补发时刻之后的时间窗内再按下仍被吸收
+    key(d, KEY_A, 1, 15 * MS);
+    TEST_ASSERT(drain(d).empty() && d.nextDeadlineUs() == 20 * MS, "window restarts at confirmed release");
+}
+
+// 测试按键独立的时间窗
+void test_per_code_window()
+{
+    std::printf("\n=== Testing Per-Code Window ===\n");
+
+    KeyDebounceConfig config;
+    config.windowMs = 20;
+    KeyDebouncer d(config);
+    TEST_ASSERT(d.setWindow(KEY_VOLUMEUP, 0), "setWindow()");
+    TEST_ASSERT(!d.setWindow(KEY_CNT, 5) && !d.setWindow(-1, 5), "setWindow() range check");
+
+    for (int i = 0; i < 4; ++i)
+    {
+        key(d, KEY_VOLUMEUP, (i + 1) % 2, i * MS);
+        key(d, KEY_ENTER, (i + 1) % 2, i * MS);
+    }
+    std::size_t volume = 0;
+    std::size_t enter = 0;
+    for (const KeyLogicalEvent &e : drain(d))
+    {
+        volume += e.code == KEY_VOLUMEUP ? 1 : 0;
+        enter += e.code == KEY_ENTER ? 1 : 0;
+    }
+    TEST_ASSERT(volume == 4 && enter == 1, "window 0 key passes through, other key debounced");
+}
+
+// 测试 SYN_REPORT 帧合并
+void test_frame_batching()
+{
+    std::printf("\n=== Testing SYN_REPORT Frame Batching ===\n");
+
+    KeyDebounceConfig config;
+    config.frameBatching = true;
+    KeyDebouncer d(config);
+
+    key(d, KEY_A, 1, 0);
+    TEST_ASSERT(drain(d).empty(), "held until SYN_REPORT");
+    key(d, KEY_A, 0, 0, true);
+    KeyDebounceStats s = d.stats();
+    TEST_ASSERT(drain(d).empty() && s.coalesced == 2, "press + release in one frame cancel out");
+
+    key(d, KEY_A, 1, 1 * MS);
+    key(d, KEY_B, 1, 1 * MS);
+    key(d, KEY_A, 0, 1 * MS);
+    key(d, KEY_A, 1, 1 * MS, true);
+    std::vector<KeyLogicalEvent> out = drain(d);
+    TEST_ASSERT(out.size() == 2 && out[0].code == KEY_A && out[0].value == 1 && out[1].code == KEY_B,
+                "one event per key with the frame's final state, in first-touched order");
+    TEST_ASSERT(d.stats().coalesced == 4, "coalesced counter");
+}
+
+// 测试自动重复抑制
+void test_repeat_suppression()
+{
+    std::printf("\n=== Testing Autorepeat Suppression ===\n");
+
+    KeyDebounceConfig config;
+    config.suppressRepeat = true;
+    config.windowMs = 5;
+    KeyDebouncer d(config);
+
+    key(d, KEY_DOWN, 1, 0, true);
+    for (int i = 0; i < 10; ++i)
+    {
+        key(d, KEY_DOWN, 2, (250 + 33 * i) * MS, true);
+    }
+    key(d, KEY_DOWN, 0, 700 * MS, true);
+    std::vector<KeyLogicalEvent> out = drain(d);
+    TEST_ASSERT(out.size() == 2 && out[0].value == 1 && out[1].value == 0, "repeats dropped");
+    TEST_ASSERT(d.stats().repeats == 10, "repeats counter");
+
+    config.suppressRepeat = false;
+    d.configure(config);
+    key(d, KEY_DOWN, 1, 0);
+    key(d, KEY_DOWN, 2, 250 * MS);
+    TEST_ASSERT(drain(d).size() == 2 && d.stats().received == 2, "configure() resets and keeps repeats");
+}
+
+// 测试 SYN_DROPPED：撤销不完整的帧，丢弃到下一个 SYN_REPORT
+void test_syn_dropped()
+{
+    std::printf("\n=== Testing SYN_DROPPED ===\n");
+
+    KeyDebounceConfig config;
+    config.frameBatching = true;
+    KeyDebouncer d(config);
+
+    key(d, KEY_A, 1, 0);
+    d.feed(EV_SYN, SYN_DROPPED, 0, 0);
+    key(d, KEY_B, 1, 0);
+    d.feed(EV_SYN, SYN_REPORT, 0, 0);
+    TEST_ASSERT(drain(d).empty(), "incomplete frame discarded");
+    TEST_ASSERT(!d.isPressed(KEY_A) && !d.isPressed(KEY_B), "state rolled back");
+    TEST_ASSERT(d.stats().dropped == 2, "dropped counter");
+
+    key(d, KEY_B, 1, 1 * MS, true);
+    TEST_ASSERT(drain(d).size() == 1, "normal frames resume after SYN_REPORT");
+
+    d.reset();
+    TEST_ASSERT(!d.isPressed(KEY_B) && d.stats().received == 0, "reset()");
+}
+
+// 测试 Key 事件线程：管道模拟输入设备，写入带抖动的按键序列
+void test_key_thread()
+{
+    std::printf("\n=== Testing Debounce Inside Key ===\n");
+
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "pipe()");
+    std::string path = "/proc/self/fd/" + std::to_string(fds[0]);
+    DeviceEntry entry = makeDeviceEntry(DeviceType::Key, "key-pipe", path.c_str());
+    Key keyDev(entry);
+    TEST_ASSERT(keyDev.init() == ErrorCode::Ok, "Key init() on pipe");
+
+    std::mutex mutex;
+    std::vector<std::pair<int, int>> seen;
+    keyDev.setCallback([&](int code, int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        seen.push_back(std::make_pair(code, value));
+    });
+    KeyDebounceConfig config;
+    config.windowMs = 20;
+    config.frameBatching = true;
+    keyDev.setDebounce(config);
+    TEST_ASSERT(keyDev.setDebounceWindow(KEY_CNT, 5) == ErrorCode::InvalidParam, "setDebounceWindow() range");
+    TEST_ASSERT(keyDev.start() == ErrorCode::Ok, "start()");
+
+    // 时间戳基于当前 CLOCK_REALTIME（evdev 默认时钟）：按下抖动 3 次，随后松开抖动 2 次
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    uint64_t base = static_cast<uint64_t>(now.tv_sec) * 1000000u + static_cast<uint64_t>(now.tv_nsec) / 1000u;
+    const int values[] = {1, 0, 1, 0, 1, 0, 1, 0};
+    const int offsetsMs[] = {0, 1, 2, 3, 4, 40, 41, 42};
+    std::vector<input_event> script;
+    for (int i = 0; i < 8; ++i)
+    {
+        input_event ev;
+        uint64_t t = base + static_cast<uint64_t>(offsetsMs[i]) * MS;
+        ev.time.tv_sec = static_cast<time_t>(t / 1000000u);
+        ev.time.tv_usec = static_cast<suseconds_t>(t % 1000000u);
+        ev.type = EV_KEY;
+        ev.code = KEY_ENTER;
+        ev.value = values[i];
+        script.push_back(ev);
+        ev.type = EV_SYN;
+        ev.code = SYN_REPORT;
+        ev.value = 0;
+        script.push_back(ev);
+    }
+    ssize_t n = write(fds[1], script.data(), script.size() * sizeof(input_event));
+    TEST_ASSERT(n == static_cast<ssize_t>(script.size() * sizeof(input_event)), "script written");
+
+    // 最后一次松开之后还需等待时间窗结束
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    keyDev.stop();
+
+    std::vector<std::pair<int, int>> events;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        events = seen;
+    }
+    TEST_ASSERT(events.size() == 2 && events[0] == std::make_pair(static_cast<int>(KEY_ENTER), 1) &&
+                    events[1] == std::make_pair(static_cast<int>(KEY_ENTER), 0),
+                "callback sees one press and one release");
+    KeyDebounceStats s = keyDev.debounceStats();
+    std::printf("  received %llu, dispatched %llu, bounced %llu\n", static_cast<unsigned long long>(s.received),
+                static_cast<unsigned long long>(s.dispatched), static_cast<unsigned long long>(s.bounced));
+    TEST_ASSERT(s.received == 8 && s.dispatched == 2 && s.bounced == 6, "Key debounceStats()");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Key Debounce Test Suite\n");
+    std::printf("========================================\n");
+
+    test_passthrough();
+    test_bouncy_press();
+    test_release_inside_window();
+    test_per_code_window();
+    test_frame_batching();
+    test_repeat_suppression();
+    test_syn_dropped();
+    test_key_thread();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
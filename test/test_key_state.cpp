@@ -0,0 +1,291 @@
+#include "../src/driver/key/key.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <linux/uinput.h>
+#include <sys/ioctl.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 等待条件成立（事件线程异步更新状态），最多 timeoutMs
+template <typename Pred> static bool waitFor(Pred pred, int timeoutMs = 1000)
+{
+    for (int i = 0; i < timeoutMs / 5; ++i)
+    {
+        if (pred())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return pred();
+}
+
+static bool writeEvent(int fd, uint16_t type, uint16_t code, int32_t value)
+{
+    input_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.type = type;
+    ev.code = code;
+    ev.value = value;
+    return write(fd, &ev, sizeof(ev)) == static_cast<ssize_t>(sizeof(ev));
+}
+
+static bool writeKey(int fd, uint16_t code, int32_t value)
+{
+    return writeEvent(fd, EV_KEY, code, value) && writeEvent(fd, EV_SYN, SYN_REPORT, 0);
+}
+
+// 管道模拟的按键设备（不是 evdev，EVIOCGKEY 等 ioctl 均失败）
+struct PipeKey
+{
+    int fds[2];
+    std::string path;
+    DeviceEntry entry;
+
+    PipeKey()
+    {
+        if (pipe(fds) != 0)
+        {
+            fds[0] = fds[1] = -1;
+        }
+        path = "/proc/self/fd/" + std::to_string(fds[0]);
+        entry = makeDeviceEntry(DeviceType::Key, "key-pipe", path.c_str());
+    }
+
+    ~PipeKey()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+};
+
+// 测试 isPressed() 跟随事件线程派发的状态
+void test_pressed_bitmap()
+{
+    std::printf("\n=== Testing isPressed() Bitmap ===\n");
+
+    PipeKey pipeKey;
+    Key keyDev(pipeKey.entry);
+    TEST_ASSERT(!keyDev.isPressed(KEY_A), "isPressed() before init");
+    TEST_ASSERT(keyDev.refreshState() == ErrorCode::DevNotReady, "refreshState() before init");
+    TEST_ASSERT(keyDev.init() == ErrorCode::Ok, "init() on pipe");
+    TEST_ASSERT(keyDev.refreshState() == ErrorCode::Unsupported, "refreshState() on non-evdev");
+
+    keyDev.setEventClock(CLOCK_MONOTONIC);
+    TEST_ASSERT(keyDev.start() == ErrorCode::Ok, "start() succeeds without EVIOCGKEY/EVIOCSCLOCKID");
+    TEST_ASSERT(keyDev.getEventClock() == CLOCK_REALTIME, "event clock stays CLOCK_REALTIME when unsupported");
+
+    TEST_ASSERT(writeKey(pipeKey.fds[1], KEY_A, 1) && writeKey(pipeKey.fds[1], KEY_POWER, 1), "write presses");
+    TEST_ASSERT(waitFor([&] { return keyDev.isPressed(KEY_A) && keyDev.isPressed(KEY_POWER); }),
+                "pressed keys visible");
+    TEST_ASSERT(!keyDev.isPressed(KEY_B), "other keys released");
+
+    TEST_ASSERT(writeKey(pipeKey.fds[1], KEY_A, 2), "write auto repeat");
+    TEST_ASSERT(writeKey(pipeKey.fds[1], KEY_A, 0), "write release");
+    TEST_ASSERT(waitFor([&] { return !keyDev.isPressed(KEY_A); }), "released key cleared");
+    TEST_ASSERT(keyDev.isPressed(KEY_POWER), "unrelated key still pressed");
+
+    TEST_ASSERT(!keyDev.isPressed(-1) && !keyDev.isPressed(KEY_CNT), "out of range codes");
+    TEST_ASSERT(keyDev.stop() == ErrorCode::Ok, "stop()");
+}
+
+// 测试独占：非 evdev 设备上 EVIOCGRAB 失败，start() 报错
+void test_exclusive_on_pipe()
+{
+    std::printf("\n=== Testing Exclusive Grab Failure ===\n");
+
+    PipeKey pipeKey;
+    Key keyDev(pipeKey.entry);
+    TEST_ASSERT(keyDev.init() == ErrorCode::Ok, "init() on pipe");
+    keyDev.setExclusive(true);
+    TEST_ASSERT(keyDev.start() == ErrorCode::DevIo, "start() fails when grab is refused");
+    TEST_ASSERT(!keyDev.isRunning(), "thread not started");
+    keyDev.setExclusive(false);
+    TEST_ASSERT(keyDev.start() == ErrorCode::Ok, "start() without exclusive");
+    TEST_ASSERT(keyDev.stop() == ErrorCode::Ok, "stop()");
+}
+
+// 测试消抖器按内核状态校正
+void test_debouncer_resync()
+{
+    std::printf("\n=== Testing Debouncer Resync ===\n");
+
+    KeyDebounceConfig config;
+    config.windowMs = 20;
+    KeyDebouncer d(config);
+    KeyLogicalEvent event;
+
+    d.resync(KEY_A, true, 0, false);
+    TEST_ASSERT(d.isPressed(KEY_A) && !d.pop(event), "silent resync updates state only");
+
+    // SYN_DROPPED 期间松开了 KEY_A
+    d.feed(EV_SYN, SYN_DROPPED, 0, 1000);
+    d.feed(EV_KEY, KEY_A, 0, 1000);
+    TEST_ASSERT(!d.takeResync(), "no resync before SYN_REPORT");
+    d.feed(EV_SYN, SYN_REPORT, 0, 1000);
+    TEST_ASSERT(d.takeResync(), "resync requested after drop");
+    TEST_ASSERT(!d.takeResync(), "takeResync() clears the flag");
+
+    d.resync(KEY_A, false, 2000, true);
+    TEST_ASSERT(d.pop(event) && event.code == KEY_A && event.value == 0, "notify resync emits release");
+    d.resync(KEY_A, false, 3000, true);
+    TEST_ASSERT(!d.pop(event), "no event when state unchanged");
+
+    // 时间窗内的原始变化被校正覆盖，不再补发
+    d.feed(EV_KEY, KEY_B, 1, 10000);
+    d.feed(EV_KEY, KEY_B, 0, 11000);
+    d.feed(EV_KEY, KEY_B, 1, 12000);
+    while (d.pop(event))
+    {
+    }
+    d.resync(KEY_B, true, 13000, true);
+    d.expire(100000);
+    TEST_ASSERT(!d.pop(event) && d.isPressed(KEY_B), "resync clears pending window state");
+}
+
+// 在 /sys/class/input/<sysname>/ 下找到 eventN 节点
+static std::string findEventNode(const char *sysname)
+{
+    std::string dir = std::string("/sys/class/input/") + sysname;
+    DIR *d = opendir(dir.c_str());
+    if (d == nullptr)
+    {
+        return "";
+    }
+    std::string node;
+    while (dirent *entry = readdir(d))
+    {
+        if (std::strncmp(entry->d_name, "event", 5) == 0)
+        {
+            node = std::string("/dev/input/") + entry->d_name;
+            break;
+        }
+    }
+    closedir(d);
+    return node;
+}
+
+// 测试真实 evdev：通过 uinput 创建虚拟键盘（需要 /dev/uinput 和权限，否则跳过）
+void test_uinput()
+{
+    std::printf("\n=== Testing evdev State via uinput ===\n");
+
+    int ui = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+    if (ui < 0)
+    {
+        std::printf("[SKIP] /dev/uinput unavailable: %s\n", std::strerror(errno));
+        return;
+    }
+
+    uinput_setup setup;
+    std::memset(&setup, 0, sizeof(setup));
+    setup.id.bustype = BUS_VIRTUAL;
+    setup.id.vendor = 0x1;
+    setup.id.product = 0x1;
+    std::strncpy(setup.name, "bsp-test-keys", UINPUT_MAX_NAME_SIZE - 1);
+    char sysname[64] = {0};
+    bool created = ioctl(ui, UI_SET_EVBIT, EV_KEY) == 0 && ioctl(ui, UI_SET_KEYBIT, KEY_A) == 0 &&
+                   ioctl(ui, UI_SET_KEYBIT, KEY_B) == 0 && ioctl(ui, UI_DEV_SETUP, &setup) == 0 &&
+                   ioctl(ui, UI_DEV_CREATE) == 0;
+    if (!created || ioctl(ui, UI_GET_SYSNAME(sizeof(sysname)), sysname) < 0)
+    {
+        std::printf("[SKIP] uinput device creation failed: %s\n", std::strerror(errno));
+        close(ui);
+        return;
+    }
+
+    std::string node;
+    waitFor([&] {
+        node = findEventNode(sysname);
+        return !node.empty() && access(node.c_str(), R_OK) == 0;
+    });
+    if (node.empty() || access(node.c_str(), R_OK) != 0)
+    {
+        std::printf("[SKIP] event node for %s not readable\n", sysname);
+        ioctl(ui, UI_DEV_DESTROY);
+        close(ui);
+        return;
+    }
+
+    // 启动前按住 KEY_A：启动后应立即可见
+    TEST_ASSERT(writeKey(ui, KEY_A, 1), "press KEY_A before start");
+    DeviceEntry entry = makeDeviceEntry(DeviceType::Key, "key-uinput", node.c_str(), 1000);
+    Key keyDev(entry);
+    TEST_ASSERT(keyDev.init() == ErrorCode::Ok, "init() on uinput device");
+    keyDev.setEventClock(CLOCK_MONOTONIC);
+    keyDev.setExclusive(true);
+    TEST_ASSERT(keyDev.start() == ErrorCode::Ok, "start() with grab and monotonic clock");
+    TEST_ASSERT(keyDev.getEventClock() == CLOCK_MONOTONIC, "EVIOCSCLOCKID applied");
+    TEST_ASSERT(keyDev.isPressed(KEY_A), "EVIOCGKEY snapshot sees held key");
+    TEST_ASSERT(!keyDev.isPressed(KEY_B), "snapshot: KEY_B released");
+
+    // 独占期间第二个读者收不到事件
+    int other = open(node.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    TEST_ASSERT(writeKey(ui, KEY_B, 1), "press KEY_B");
+    TEST_ASSERT(waitFor([&] { return keyDev.isPressed(KEY_B); }), "grabbing reader sees KEY_B");
+    input_event ev;
+    TEST_ASSERT(other >= 0 && read(other, &ev, sizeof(ev)) < 0 && errno == EAGAIN, "second reader starved by grab");
+
+    TEST_ASSERT(writeKey(ui, KEY_A, 0) && writeKey(ui, KEY_B, 0), "release keys");
+    TEST_ASSERT(waitFor([&] { return !keyDev.isPressed(KEY_A) && !keyDev.isPressed(KEY_B); }), "releases seen");
+    TEST_ASSERT(keyDev.stop() == ErrorCode::Ok, "stop() releases grab");
+
+    TEST_ASSERT(writeKey(ui, KEY_A, 1), "press KEY_A after stop");
+    TEST_ASSERT(waitFor([&] { return read(other, &ev, sizeof(ev)) == static_cast<ssize_t>(sizeof(ev)); }),
+                "second reader receives events after ungrab");
+    TEST_ASSERT(keyDev.refreshState() == ErrorCode::Ok && keyDev.isPressed(KEY_A), "refreshState() while stopped");
+
+    if (other >= 0)
+    {
+        close(other);
+    }
+    ioctl(ui, UI_DEV_DESTROY);
+    close(ui);
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Key State Test Suite\n");
+    std::printf("========================================\n");
+
+    test_pressed_bitmap();
+    test_exclusive_on_pipe();
+    test_debouncer_resync();
+    test_uinput();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -3,7 +3,10 @@
 #include <cstdlib>
 #include <cstring>
 #include <chrono>
+#include <string>
 #include <thread>
+#include <unistd.h>
+#include <sys/stat.h>
 
 using namespace bsp;
 
@@ -100,6 +103,142 @@ void test_device_not_found()
     TEST_ASSERT(!led.isReady(), "device not ready after init failure");
 }
 
+// 伪造的 /sys/class/leds/<name> 目录：属性都是普通文件
+struct FakeSysfsLed
+{
+    std::string root;
+    std::string dir;
+
+    FakeSysfsLed(const char *name, bool withTrigger)
+    {
+        char tmpl[] = "/tmp/bsp-leds-XXXXXX";
+        root = mkdtemp(tmpl) ? tmpl : "";
+        dir = root + "/" + name;
+        mkdir(dir.c_str(), 0755);
+        write("brightness", "0\n");
+        write("max_brightness", "255\n");
+        if (withTrigger)
+        {
+            write("trigger", "[none] timer oneshot heartbeat\n");
+            // 真实内核在切换触发器后才创建这些属性
+            write("delay_on", "");
+            write("delay_off", "");
+            write("invert", "");
+            write("shot", "");
+        }
+    }
+
+    ~FakeSysfsLed()
+    {
+        const char *attrs[] = {"brightness", "max_brightness", "trigger", "delay_on", "delay_off", "invert", "shot"};
+        for (const char *attr : attrs)
+        {
+            unlink((dir + "/" + attr).c_str());
+        }
+        rmdir(dir.c_str());
+        rmdir(root.c_str());
+    }
+
+    void write(const char *attr, const char *value)
+    {
+        std::FILE *f = std::fopen((dir + "/" + attr).c_str(), "w");
+        if (f != nullptr)
+        {
+            std::fputs(value, f);
+            std::fclose(f);
+        }
+    }
+
+    // 读取属性并清空，下一次写入的内容不会与旧内容混在一起
+    std::string take(const char *attr)
+    {
+        std::string path = dir + "/" + attr;
+        std::string value;
+        std::FILE *f = std::fopen(path.c_str(), "r");
+        if (f != nullptr)
+        {
+            char buf[128];
+            std::size_t n = std::fread(buf, 1, sizeof(buf), f);
+            value.assign(buf, n);
+            std::fclose(f);
+        }
+        truncate(path.c_str(), 0);
+        return value;
+    }
+};
+
+// 测试 sysfs 后端：亮度等级、保持打开的 brightness、内核触发器
+void test_sysfs_backend()
+{
+    std::printf("\n=== Testing sysfs Backend ===\n");
+
+    FakeSysfsLed fake("green:status", true);
+    Led led = Led::sysfs("green:status", fake.root);
+    TEST_ASSERT(led.backend() == LedBackend::Sysfs, "directory path selects sysfs backend");
+    TEST_ASSERT(led.init() == ErrorCode::Ok, "init() opens brightness");
+    TEST_ASSERT(led.maxBrightness() == 255, "max_brightness read");
+    fake.take("brightness");
+
+    // init() 之后删除 brightness 目录项，写入仍然成功说明没有每次重新打开
+    std::string brightness = fake.dir + "/brightness";
+    std::string moved = fake.dir + "/brightness.moved";
+    rename(brightness.c_str(), moved.c_str());
+    TEST_ASSERT(led.turnOn() == ErrorCode::Ok, "turnOn() through the open fd");
+    rename(moved.c_str(), brightness.c_str());
+    TEST_ASSERT(fake.take("brightness") == "255", "turnOn() writes max_brightness");
+
+    TEST_ASSERT(led.setBrightness(17) == ErrorCode::Ok && fake.take("brightness") == "17", "setBrightness(17)");
+    TEST_ASSERT(led.setBrightness(256) == ErrorCode::InvalidParam, "setBrightness() above max rejected");
+    TEST_ASSERT(led.setBrightness(-1) == ErrorCode::InvalidParam, "negative brightness rejected");
+    TEST_ASSERT(led.turnOff() == ErrorCode::Ok && fake.take("brightness") == "0", "turnOff() writes 0");
+
+    fake.take("trigger");
+    TEST_ASSERT(led.blink(100, 900) == ErrorCode::Ok, "blink() via timer trigger");
+    TEST_ASSERT(fake.take("trigger") == "timer", "trigger set to timer");
+    TEST_ASSERT(fake.take("delay_on") == "100" && fake.take("delay_off") == "900", "blink delays written");
+
+    TEST_ASSERT(led.shot() == ErrorCode::DevNotReady, "shot() before setOneShot()");
+    TEST_ASSERT(led.setOneShot(50, 200, true) == ErrorCode::Ok, "setOneShot()");
+    TEST_ASSERT(fake.take("trigger") == "oneshot" && fake.take("invert") == "1", "oneshot trigger and invert");
+    TEST_ASSERT(led.shot() == ErrorCode::Ok && led.shot() == ErrorCode::Ok, "shot() twice");
+    TEST_ASSERT(fake.take("shot") == "1", "shot written");
+
+    // 触发器运行中设置亮度：先停止触发器
+    TEST_ASSERT(led.turnOn() == ErrorCode::Ok, "turnOn() while oneshot active");
+    TEST_ASSERT(fake.take("trigger") == "none" && fake.take("brightness") == "255", "trigger stopped before brightness");
+    TEST_ASSERT(led.shot() == ErrorCode::DevNotReady, "shot() after trigger stopped");
+
+    TEST_ASSERT(led.stopTrigger() == ErrorCode::Ok && fake.take("trigger") == "none", "stopTrigger()");
+
+    // 移动后由新对象继续持有打开的属性
+    Led moved2 = std::move(led);
+    TEST_ASSERT(!led.isReady() && moved2.isReady(), "move keeps sysfs state");
+    TEST_ASSERT(moved2.blink(10, 10) == ErrorCode::Ok && fake.take("trigger") == "timer", "moved LED still blinks");
+
+    IoRing ring;
+    TEST_ASSERT(ring.init(4) == ErrorCode::Ok && moved2.queueSetState(ring, true, 1) == ErrorCode::Unsupported,
+                "queueSetState() unsupported on sysfs");
+}
+
+// 测试没有 trigger 属性的 LED 和 ioctl 后端上的触发器接口
+void test_sysfs_without_trigger()
+{
+    std::printf("\n=== Testing sysfs Without Trigger ===\n");
+
+    FakeSysfsLed fake("plain", false);
+    std::string path = fake.dir + "/brightness";
+    DeviceEntry entry = makeDeviceEntry(DeviceType::Led, "plain", path.c_str());
+    Led led(entry);
+    TEST_ASSERT(led.backend() == LedBackend::Sysfs, "brightness path selects sysfs backend");
+    TEST_ASSERT(led.init() == ErrorCode::Ok, "init()");
+    TEST_ASSERT(led.setState(true) == ErrorCode::Ok && fake.take("brightness") == "255", "setState(true)");
+    TEST_ASSERT(led.blink(100, 100) == ErrorCode::Unsupported, "blink() without trigger attribute");
+
+    Led ioctlLed("led_nonexistent");
+    TEST_ASSERT(ioctlLed.backend() == LedBackend::Ioctl, "/dev path keeps ioctl backend");
+    TEST_ASSERT(ioctlLed.blink(100, 100) == ErrorCode::DevNotReady, "blink() before init");
+}
+
 int main(int argc, char *argv[])
 {
     std::printf("========================================\n");
@@ -110,6 +249,8 @@ int main(int argc, char *argv[])
     test_normal_function();
     test_move_semantics();
     test_device_not_found();
+    test_sysfs_backend();
+    test_sysfs_without_trigger();
 
     // 输出测试结果
     std::printf("\n========================================\n");
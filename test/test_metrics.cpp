@@ -0,0 +1,134 @@
+#include "../src/common/metrics.h"
+#include <cstdio>
+#include <thread>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 测试直方图分桶
+void test_histogram_buckets()
+{
+    std::printf("\n=== Testing Histogram Buckets ===\n");
+
+    bool contiguous = true;
+    for (int i = 1; i < LatencyHistogram::BUCKET_COUNT; ++i)
+    {
+        if (LatencyHistogram::bucketLowerBound(i) != LatencyHistogram::bucketUpperBound(i - 1) + 1)
+        {
+            contiguous = false;
+        }
+    }
+    TEST_ASSERT(contiguous, "buckets are contiguous");
+
+    bool roundTrip = true;
+    for (uint64_t v = 0; v < (1u << 20); v = v * 3 / 2 + 1)
+    {
+        int idx = LatencyHistogram::bucketIndex(v);
+        if (v < LatencyHistogram::bucketLowerBound(idx) || v > LatencyHistogram::bucketUpperBound(idx))
+        {
+            roundTrip = false;
+        }
+    }
+    TEST_ASSERT(roundTrip, "value falls inside its bucket");
+    TEST_ASSERT(LatencyHistogram::bucketIndex(UINT64_MAX) == LatencyHistogram::BUCKET_COUNT - 1,
+                "overflow clamps to last bucket");
+}
+
+// 测试分位数与合并
+void test_histogram_quantiles()
+{
+    std::printf("\n=== Testing Histogram Quantiles ===\n");
+
+    LatencyHistogram a;
+    for (uint64_t v = 1; v <= 1000; ++v)
+    {
+        a.record(v * 1000);
+    }
+    uint64_t p50 = a.valueAtQuantile(0.5);
+    uint64_t p99 = a.valueAtQuantile(0.99);
+    TEST_ASSERT(p50 >= 500000 && p50 <= 500000 * 1125 / 1000, "p50 within 12.5%");
+    TEST_ASSERT(p99 >= 990000 && p99 <= 1000000, "p99 within bucket and below max");
+    TEST_ASSERT(a.valueAtQuantile(1.0) == 1000000, "p100 equals max");
+    TEST_ASSERT(a.valueAtQuantile(0.0) == 1000, "p0 equals min");
+
+    LatencyHistogram b;
+    b.record(5);
+    a.merge(b);
+    TEST_ASSERT(a.count == 1001 && a.minNs == 5, "merge combines count and min");
+}
+
+// 测试线程分片汇总
+void test_snapshot_threads()
+{
+    std::printf("\n=== Testing Snapshot Across Threads ===\n");
+
+    if (!Metrics::enabled())
+    {
+        std::printf("[SKIP] metrics compiled out\n");
+        return;
+    }
+
+    MetricsSnapshot before = Metrics::snapshot();
+
+    Metrics::record(MetricOp::AP3216CRead, ErrorCode::Ok, 100);
+    std::thread worker([] {
+        Metrics::record(MetricOp::AP3216CRead, ErrorCode::DevIo, 200);
+        Metrics::record(MetricOp::AP3216CRead, ErrorCode::Timeout, 300);
+    });
+    worker.join(); // 线程退出后分片并入全局累计值
+
+    MetricsSnapshot after = Metrics::snapshot();
+    const OpStats &op0 = before[MetricOp::AP3216CRead];
+    const OpStats &op1 = after[MetricOp::AP3216CRead];
+    TEST_ASSERT(op1.ops - op0.ops == 3, "ops from live and exited threads");
+    TEST_ASSERT(op1.errors() - op0.errors() == 2, "errors counted");
+    TEST_ASSERT(op1.results[-static_cast<int>(ErrorCode::Timeout)] -
+                        op0.results[-static_cast<int>(ErrorCode::Timeout)] ==
+                    1,
+                "errors split by ErrorCode");
+    TEST_ASSERT(op1.latency.maxNs >= 300, "max latency recorded");
+
+    MetricsSnapshot merged = after;
+    merged.merge(after);
+    TEST_ASSERT(merged[MetricOp::AP3216CRead].ops == 2 * op1.ops, "snapshot merge");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Metrics Test Suite\n");
+    std::printf("========================================\n");
+
+    test_histogram_buckets();
+    test_histogram_quantiles();
+    test_snapshot_threads();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#include "../src/common/metrics_export.h"
+#include "../src/common/metrics_server.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+static bool contains(const std::string &text, const char *needle)
+{
+    return text.find(needle) != std::string::npos;
+}
+
+// 原始 HTTP 请求，模拟 curl --unix-socket
+static std::string httpGet(const std::string &socketPath, const char *target)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    std::string response;
+    if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0)
+    {
+        std::string request = std::string("GET ") + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        ssize_t w = write(fd, request.data(), request.size());
+        (void)w;
+        char buf[4096];
+        ssize_t n;
+        while ((n = read(fd, buf, sizeof(buf))) > 0)
+        {
+            response.append(buf, static_cast<std::size_t>(n));
+        }
+    }
+    close(fd);
+    return response;
+}
+
+// 测试序列化格式
+void test_format()
+{
+    std::printf("\n=== Testing Format ===\n");
+
+    MetricsSnapshot snapshot;
+    OpStats &led = snapshot.ops[static_cast<std::size_t>(MetricOp::LedSetState)];
+    led.ops = 3;
+    led.results[0] = 2;
+    led.results[-static_cast<int>(ErrorCode::DevIo)] = 1;
+    led.latency.record(1000);
+    led.latency.record(2000);
+    led.latency.record(3000);
+
+    Gauge depth("queue_depth", "test_queue");
+    depth.set(7);
+
+    std::string prom = formatPrometheus(snapshot);
+    TEST_ASSERT(contains(prom, "# TYPE bsp_driver_ops_total counter"), "prometheus TYPE line");
+    TEST_ASSERT(contains(prom, "bsp_driver_ops_total{op=\"led_set_state\",result=\"ok\"} 2"), "prometheus ok count");
+    TEST_ASSERT(contains(prom, "bsp_driver_ops_total{op=\"led_set_state\",result=\"dev_io\"} 1"),
+                "prometheus errors by ErrorCode");
+    TEST_ASSERT(contains(prom, "bsp_driver_latency_seconds_count{op=\"led_set_state\"} 3"), "prometheus summary count");
+    TEST_ASSERT(contains(prom, "bsp_queue_depth{instance=\"test_queue\"} 7"), "prometheus gauge");
+
+    std::string json = formatJson(snapshot);
+    TEST_ASSERT(contains(json, "\"led_set_state\":{\"ops\":3,\"errors\":1"), "json op entry");
+    TEST_ASSERT(contains(json, "\"dev_io\":1"), "json errors by ErrorCode");
+    TEST_ASSERT(contains(json, "\"max\":3000"), "json latency max");
+    TEST_ASSERT(contains(json, "{\"name\":\"queue_depth\",\"instance\":\"test_queue\",\"value\":7}"), "json gauge");
+}
+
+// 测试 Unix 套接字应答器
+void test_server()
+{
+    std::printf("\n=== Testing Unix Socket Server ===\n");
+
+    std::string path = "/tmp/bsp_metrics_test_" + std::to_string(getpid()) + ".sock";
+    Metrics::record(MetricOp::DHT11Read, ErrorCode::Ok, 1234);
+
+    MetricsServer server;
+    TEST_ASSERT(server.start(path) == ErrorCode::Ok, "server.start()");
+    TEST_ASSERT(server.isRunning(), "server running");
+
+    std::string text;
+    TEST_ASSERT(fetchMetrics(path, MetricsFormat::Prometheus, text) == ErrorCode::Ok, "fetchMetrics(prom)");
+    TEST_ASSERT(contains(text, "bsp_driver_ops_total{op=\"dht11_read\",result=\"ok\"}"), "prom body from server");
+
+    TEST_ASSERT(fetchMetrics(path, MetricsFormat::Json, text) == ErrorCode::Ok, "fetchMetrics(json)");
+    TEST_ASSERT(text.size() > 0 && text[0] == '{', "json body from server");
+
+    std::string http = httpGet(path, "/metrics");
+    TEST_ASSERT(http.compare(0, 15, "HTTP/1.0 200 OK") == 0, "HTTP status line");
+    TEST_ASSERT(contains(http, "text/plain; version=0.0.4"), "HTTP prometheus content type");
+
+    http = httpGet(path, "/metrics.json");
+    TEST_ASSERT(contains(http, "application/json"), "HTTP json content type");
+
+    server.stop();
+    TEST_ASSERT(!server.isRunning(), "server stopped");
+    TEST_ASSERT(access(path.c_str(), F_OK) != 0, "socket file removed");
+    TEST_ASSERT(fetchMetrics(path, MetricsFormat::Json, text) == ErrorCode::DevOpen, "fetch after stop fails");
+}
+
+// 测试启动时只替换残留的套接字文件，不删除路径上的其他文件
+void test_server_path()
+{
+    std::printf("\n=== Testing Server Socket Path ===\n");
+
+    std::string path = "/tmp/bsp_metrics_path_" + std::to_string(getpid());
+    FILE *file = std::fopen(path.c_str(), "w");
+    TEST_ASSERT(file != nullptr, "create regular file");
+    if (file != nullptr)
+    {
+        std::fclose(file);
+    }
+
+    MetricsServer server;
+    TEST_ASSERT(server.start(path) == ErrorCode::DevOpen, "start() on a regular file fails");
+    TEST_ASSERT(access(path.c_str(), F_OK) == 0 && !server.isRunning(), "regular file kept");
+    unlink(path.c_str());
+
+    // 上次运行残留的套接字文件（未监听）被替换
+    int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    TEST_ASSERT(bind(stale, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0, "create stale socket file");
+    close(stale);
+
+    TEST_ASSERT(server.start(path) == ErrorCode::Ok, "start() replaces stale socket");
+    std::string text;
+    TEST_ASSERT(fetchMetrics(path, MetricsFormat::Json, text) == ErrorCode::Ok, "fetch from replaced socket");
+    server.stop();
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Metrics Export Test Suite\n");
+    std::printf("========================================\n");
+
+    test_format();
+    test_server();
+    test_server_path();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
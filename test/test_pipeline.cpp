@@ -0,0 +1,276 @@
+#include "../src/pipeline/pipeline.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+static bool near(float actual, float expected, float tolerance)
+{
+    return std::fabs(actual - expected) <= tolerance;
+}
+
+static DHT11Data makeDHT11(uint8_t humidity, uint8_t temperature)
+{
+    DHT11Data data = {humidity, 0, temperature, 0};
+    return data;
+}
+
+static AP3216CData makeAP3216C(uint16_t als, uint16_t ps)
+{
+    AP3216CData data = {0, als, ps};
+    return data;
+}
+
+// 测试预置派生函数（参考值由双精度公式计算）
+void test_derive_functions()
+{
+    std::printf("\n=== Testing Derive Functions ===\n");
+
+    TEST_ASSERT(near(derive::dewPoint(25.0f, 60.0f), 16.693f, 0.01f), "dew point 25 C / 60 %RH");
+    TEST_ASSERT(near(derive::dewPoint(20.0f, 50.0f), 9.255f, 0.01f), "dew point 20 C / 50 %RH");
+    TEST_ASSERT(near(derive::dewPoint(0.0f, 100.0f), 0.0f, 0.001f), "dew point at saturation equals temperature");
+    TEST_ASSERT(std::isnan(derive::dewPoint(25.0f, 0.0f)), "dew point of 0 %RH is NaN");
+
+    TEST_ASSERT(near(derive::heatIndex(30.0f, 70.0f), 35.038f, 0.02f), "heat index 30 C / 70 %RH (Rothfusz)");
+    TEST_ASSERT(near(derive::heatIndex(20.0f, 50.0f), 19.361f, 0.01f), "heat index 20 C / 50 %RH (Steadman)");
+    TEST_ASSERT(near(derive::heatIndex(27.0f, 90.0f), 31.091f, 0.02f), "heat index high humidity adjustment");
+    TEST_ASSERT(near(derive::heatIndex(40.0f, 10.0f), 36.705f, 0.02f), "heat index low humidity adjustment");
+
+    float in[1] = {10.0f};
+    Derivation ema = derive::ema(0.5f);
+    TEST_ASSERT(ema.trigger == Trigger::OnSample, "ema recomputes on every sample");
+    float y = ema.fn(in, NAN);
+    TEST_ASSERT(y == 10.0f, "ema seeds with first sample");
+    in[0] = 20.0f;
+    TEST_ASSERT(ema.fn(in, y) == 15.0f, "ema step");
+
+    Derivation hyst = derive::hysteresis(100.0f, 500.0f);
+    TEST_ASSERT(hyst.trigger == Trigger::OnChange, "hysteresis recomputes on change");
+    in[0] = 300.0f;
+    TEST_ASSERT(hyst.fn(in, NAN) == 0.0f, "hysteresis starts released");
+    in[0] = 600.0f;
+    TEST_ASSERT(hyst.fn(in, 0.0f) == 1.0f, "hysteresis triggers at high");
+    in[0] = 300.0f;
+    TEST_ASSERT(hyst.fn(in, 1.0f) == 1.0f, "hysteresis holds between thresholds");
+    in[0] = 50.0f;
+    TEST_ASSERT(hyst.fn(in, 1.0f) == 0.0f, "hysteresis releases at low");
+}
+
+// 测试通道声明
+void test_declaration()
+{
+    std::printf("\n=== Testing Channel Declaration ===\n");
+
+    Pipeline pipe;
+    ChannelId a = pipe.addInput("a");
+    ChannelId b = pipe.addInput("b");
+    TEST_ASSERT(a == 0 && b == 1, "channel id is declaration index");
+    TEST_ASSERT(pipe.addInput("a") == INVALID_CHANNEL, "duplicate name rejected");
+    TEST_ASSERT(pipe.addInput("") == INVALID_CHANNEL, "empty name rejected");
+
+    auto sum = [](const float *in, float) { return in[0] + in[1]; };
+    TEST_ASSERT(pipe.addDerived("bad", {a, 7}, sum) == INVALID_CHANNEL, "unknown input rejected");
+    TEST_ASSERT(pipe.addDerived("none", {}, sum) == INVALID_CHANNEL, "derived without inputs rejected");
+    TEST_ASSERT(pipe.addDerived("many", {a, b, a, b, a}, sum) == INVALID_CHANNEL, "too many inputs rejected");
+
+    ChannelId s = pipe.addDerived("sum", {a, b}, sum);
+    TEST_ASSERT(s == 2 && !pipe.isInput(s) && pipe.isInput(a), "derived channel declared");
+    TEST_ASSERT(pipe.find("sum") == s && pipe.find("missing") == INVALID_CHANNEL, "find() by name");
+    TEST_ASSERT(std::isnan(pipe.value(s)), "value is NaN before first update");
+
+    pipe.set(s, 1.0f);
+    TEST_ASSERT(std::isnan(pipe.value(s)), "set() on derived channel ignored");
+
+    DHT11Source th = pipe.addSource("dht11", DHT11Converter());
+    TEST_ASSERT(pipe.find("dht11.humidity") == th.humidity && pipe.find("dht11.temperature") == th.temperature,
+                "DHT11 source channels");
+    AP3216CSource als = pipe.addSource("ap3216c", AP3216CConverter());
+    TEST_ASSERT(pipe.find("ap3216c.lux") == als.lux && pipe.find("ap3216c.ps") == als.ps &&
+                    pipe.find("ap3216c.ir") == als.ir,
+                "AP3216C source channels");
+    TEST_ASSERT(pipe.size() == 8, "channel count");
+}
+
+// 测试增量计算：只重算输入变化的通道
+void test_incremental()
+{
+    std::printf("\n=== Testing Incremental Recompute ===\n");
+
+    Pipeline pipe;
+    ChannelId a = pipe.addInput("a");
+    ChannelId b = pipe.addInput("b");
+    int sumCalls = 0;
+    int signCalls = 0;
+    int doubledCalls = 0;
+    ChannelId sum = pipe.addDerived("sum", {a, b}, [&sumCalls](const float *in, float) {
+        ++sumCalls;
+        return in[0] + in[1];
+    });
+    ChannelId sign = pipe.addDerived("sign", {sum}, [&signCalls](const float *in, float) {
+        ++signCalls;
+        return in[0] >= 0.0f ? 1.0f : -1.0f;
+    });
+    ChannelId doubled = pipe.addDerived("doubled", {b}, [&doubledCalls](const float *in, float) {
+        ++doubledCalls;
+        return in[0] * 2.0f;
+    });
+
+    pipe.set(a, 1.0f);
+    pipe.set(b, 2.0f);
+    TEST_ASSERT(pipe.update() == 3, "first update computes all channels");
+    TEST_ASSERT(pipe.value(sum) == 3.0f && pipe.value(sign) == 1.0f && pipe.value(doubled) == 4.0f,
+                "first update values");
+    TEST_ASSERT(pipe.changed(sum) && pipe.changed(a), "changed() after first update");
+
+    pipe.set(a, 1.0f);
+    TEST_ASSERT(pipe.update() == 0, "same input value -> nothing recomputed");
+    TEST_ASSERT(!pipe.changed(sum) && !pipe.changed(a), "changed() false when unchanged");
+
+    pipe.set(a, 5.0f);
+    TEST_ASSERT(pipe.update() == 2, "a changed -> sum and sign recomputed");
+    TEST_ASSERT(sumCalls == 2 && signCalls == 2 && doubledCalls == 1, "doubled not recomputed");
+    TEST_ASSERT(pipe.value(sum) == 7.0f && !pipe.changed(sign), "sign output unchanged");
+
+    pipe.set(a, 6.0f);
+    pipe.update();
+    TEST_ASSERT(sumCalls == 3 && signCalls == 3, "sign recomputed because sum changed");
+
+    // sum 不变（a+1, b-1），下游 sign 不重算
+    pipe.set(a, 7.0f);
+    pipe.set(b, 1.0f);
+    TEST_ASSERT(pipe.update() == 2, "sum and doubled recomputed");
+    TEST_ASSERT(!pipe.changed(sum) && signCalls == 3, "unchanged derived output stops propagation");
+    TEST_ASSERT(pipe.value(doubled) == 2.0f, "doubled follows b");
+
+    TEST_ASSERT(pipe.update() == 0, "update without samples computes nothing");
+    TEST_ASSERT(pipe.sequence() == 6 && pipe.evaluations() == 9, "sequence and evaluation counters");
+}
+
+// 测试 OnSample：有状态滤波器在相同输入下仍然前进
+void test_on_sample()
+{
+    std::printf("\n=== Testing OnSample Trigger ===\n");
+
+    Pipeline pipe;
+    ChannelId x = pipe.addInput("x");
+    ChannelId smooth = pipe.addDerived("smooth", {x}, derive::ema(0.5f));
+    ChannelId level = pipe.addDerived("level", {smooth}, [](const float *in, float) { return in[0] > 7.0f; });
+
+    pipe.set(x, 0.0f);
+    pipe.update();
+    TEST_ASSERT(pipe.value(smooth) == 0.0f, "ema seeded");
+    float expected[] = {4.0f, 6.0f, 7.0f, 7.5f};
+    bool ok = true;
+    for (float e : expected)
+    {
+        pipe.set(x, 8.0f);
+        pipe.update();
+        ok = ok && pipe.value(smooth) == e;
+    }
+    TEST_ASSERT(ok, "ema keeps converging with repeated input");
+    TEST_ASSERT(pipe.value(level) == 1.0f, "downstream of ema follows");
+
+    TEST_ASSERT(pipe.update() == 0, "no sample -> ema not advanced");
+    TEST_ASSERT(pipe.value(smooth) == 7.5f, "ema value kept");
+}
+
+// 测试传感器数据源与发布
+void test_sources_and_publish()
+{
+    std::printf("\n=== Testing Sensor Sources ===\n");
+
+    Pipeline pipe;
+    DHT11Calibration thCal;
+    thCal.temperature = LinearCalibration(LinearCalibration::UNITY_GAIN, -1000);
+    DHT11Source th = pipe.addSource("dht11", DHT11Converter(thCal));
+    AP3216CSource als = pipe.addSource("ap3216c", AP3216CConverter());
+
+    ChannelId dew = pipe.addDerived("dew_point", {th.temperature, th.humidity}, derive::dewPoint());
+    ChannelId heat = pipe.addDerived("heat_index", {th.temperature, th.humidity}, derive::heatIndex());
+    ChannelId smooth = pipe.addDerived("lux_smooth", {als.lux}, derive::ema(0.25f));
+    ChannelId nearState = pipe.addDerived("proximity", {als.ps}, derive::hysteresis(100.0f, 500.0f));
+    ChannelId brightness = pipe.addDerived("brightness", {smooth, nearState},
+                                           [](const float *in, float) { return in[1] != 0.0f ? 0.0f : in[0]; });
+
+    std::vector<PipelineSample> published;
+    std::vector<float> dewSeen;
+    pipe.setListener([&](const Pipeline &p, const PipelineSample &sample) {
+        published.push_back(sample);
+        dewSeen.push_back(p.value(dew));
+    });
+
+    TEST_ASSERT(pipe.push(th, makeDHT11(60, 26), 1000) == 2, "DHT11 sample recomputes dew point and heat index");
+    TEST_ASSERT(pipe.value(th.temperature) == 25.0f, "source calibration applied");
+    TEST_ASSERT(near(pipe.value(dew), 16.693f, 0.01f), "dew point from pushed sample");
+    TEST_ASSERT(std::isnan(pipe.value(smooth)), "light channels untouched by DHT11 sample");
+    TEST_ASSERT(published.size() == 1 && published[0].source == DeviceType::DHT11, "sample published");
+    TEST_ASSERT(published[0].dht11.humidity_int == 60 && published[0].dht11.temperature_int == 26,
+                "raw sample published alongside");
+    TEST_ASSERT(published[0].timestampNs == 1000 && published[0].sequence == 1, "timestamp and sequence");
+    TEST_ASSERT(near(dewSeen[0], 16.693f, 0.01f), "listener sees derived values");
+
+    TEST_ASSERT(pipe.push(th, makeDHT11(60, 26), 2000) == 0, "repeated DHT11 sample recomputes nothing");
+    TEST_ASSERT(published.size() == 2, "repeated sample still published");
+
+    TEST_ASSERT(pipe.push(als, makeAP3216C(1000, 50)) == 3, "AP3216C sample: smooth, proximity, brightness");
+    TEST_ASSERT(pipe.value(smooth) == 350.0f && pipe.value(brightness) == 350.0f, "far -> brightness is lux");
+    TEST_ASSERT(published.back().source == DeviceType::AP3216C && published.back().ap3216c.als == 1000,
+                "AP3216C raw published");
+
+    pipe.push(als, makeAP3216C(1000, 800));
+    TEST_ASSERT(pipe.value(nearState) == 1.0f && pipe.value(brightness) == 0.0f, "near -> brightness gated");
+    pipe.push(als, makeAP3216C(1000, 300));
+    TEST_ASSERT(pipe.value(nearState) == 1.0f, "proximity hysteresis holds");
+    pipe.push(als, makeAP3216C(0, 20));
+    TEST_ASSERT(pipe.value(nearState) == 0.0f && pipe.value(brightness) == 262.5f, "released -> smoothed lux");
+    TEST_ASSERT(!pipe.changed(dew), "dew point untouched by light samples");
+
+    pipe.setListener(Pipeline::Listener());
+    pipe.push(th, makeDHT11(70, 31));
+    TEST_ASSERT(published.size() == 6, "listener removed");
+    TEST_ASSERT(near(pipe.value(heat), 35.038f, 0.02f), "heat index 30 C / 70 %RH");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Derived Channel Pipeline Test Suite\n");
+    std::printf("========================================\n");
+
+    test_derive_functions();
+    test_declaration();
+    test_incremental();
+    test_on_sample();
+    test_sources_and_publish();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,603 @@
+// 块池 / 对象池 / 区域分配测试，以及库内稳态路径的堆分配计数
+// 本文件替换了全局 operator new，统计进程内（包括库内线程）的所有堆分配
+
+#include "../src/common/event_loop.h"
+#include "../src/common/io_ring.h"
+#include "../src/common/pool.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/key/key.h"
+#include "../src/driver/led/led.h"
+#include "../src/pipeline/sampler.h"
+#include "test_support.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <new>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace bsp;
+
+// ============================================================================
+// 堆分配计数
+// ============================================================================
+
+static std::atomic<long> heapAllocations(0);
+
+void *operator new(std::size_t size)
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = std::malloc(size != 0 ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+    std::free(p);
+}
+
+// 统计构造之后的堆分配次数
+class AllocationCounter
+{
+public:
+    AllocationCounter() : start(heapAllocations.load())
+    {
+    }
+
+    long count() const
+    {
+        return heapAllocations.load() - start;
+    }
+
+private:
+    long start;
+};
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// ============================================================================
+// 池与区域
+// ============================================================================
+
+void test_block_pool()
+{
+    std::printf("\n=== Testing BlockPool ===\n");
+
+    BlockPool pool(10, 4, "test_blocks");
+    TEST_ASSERT(pool.capacity() == 4 && pool.blockSize() % alignof(std::max_align_t) == 0 && pool.blockSize() >= 10,
+                "block size rounded up to alignment");
+
+    void *blocks[4];
+    bool distinct = true;
+    for (int i = 0; i < 4; ++i)
+    {
+        blocks[i] = pool.allocate();
+        distinct = distinct && blocks[i] != nullptr && pool.owns(blocks[i]) &&
+                   reinterpret_cast<uintptr_t>(blocks[i]) % alignof(std::max_align_t) == 0;
+        for (int j = 0; j < i; ++j)
+        {
+            distinct = distinct && blocks[j] != blocks[i];
+        }
+    }
+    TEST_ASSERT(distinct, "blocks distinct, aligned and owned");
+    TEST_ASSERT(pool.allocate() == nullptr, "exhausted pool returns nullptr");
+
+    PoolStats s = pool.stats();
+    TEST_ASSERT(s.inUse == 4 && s.peak == 4 && s.allocations == 4 && s.failures == 1, "stats after exhaustion");
+
+    int local = 0;
+    pool.deallocate(&local);
+    pool.deallocate(static_cast<char *>(blocks[0]) + 1);
+    pool.deallocate(nullptr);
+    TEST_ASSERT(pool.stats().inUse == 4, "foreign and misaligned pointers ignored");
+
+    pool.deallocate(blocks[2]);
+    TEST_ASSERT(pool.allocate() == blocks[2], "freed block reused");
+    for (void *block : blocks)
+    {
+        pool.deallocate(block);
+    }
+    s = pool.stats();
+    TEST_ASSERT(s.inUse == 0 && s.peak == 4, "all blocks returned, peak kept");
+
+    AllocationCounter heap;
+    for (int i = 0; i < 10000; ++i)
+    {
+        void *a = pool.allocate();
+        void *b = pool.allocate();
+        pool.deallocate(a);
+        pool.deallocate(b);
+    }
+    TEST_ASSERT(heap.count() == 0, "allocate/deallocate never touch the heap");
+
+    BlockPool empty(16, 0, "test_empty");
+    TEST_ASSERT(empty.allocate() == nullptr && empty.stats().failures == 1, "zero-capacity pool");
+}
+
+struct Record
+{
+    static std::atomic<int> live;
+    int code;
+    int value;
+    std::array<char, 40> payload;
+
+    Record(int code, int value) : code(code), value(value)
+    {
+        payload.fill(0);
+        ++live;
+    }
+
+    ~Record()
+    {
+        --live;
+    }
+};
+
+std::atomic<int> Record::live(0);
+
+void test_object_pool()
+{
+    std::printf("\n=== Testing ObjectPool ===\n");
+
+    ObjectPool<Record> pool(8, "test_records");
+    Record *r = pool.create(KEY_A, 1);
+    TEST_ASSERT(r != nullptr && r->code == KEY_A && r->value == 1 && Record::live == 1, "create() constructs");
+    pool.destroy(r);
+    TEST_ASSERT(Record::live == 0 && pool.stats().inUse == 0, "destroy() destructs and returns the block");
+
+    {
+        std::vector<ObjectPool<Record>::Ptr> held;
+        held.reserve(16);
+        AllocationCounter heap;
+        for (int i = 0; i < 8; ++i)
+        {
+            held.push_back(pool.make(i, i));
+        }
+        ObjectPool<Record>::Ptr overflow = pool.make(99, 99);
+        TEST_ASSERT(heap.count() == 0, "make() does not touch the heap");
+        TEST_ASSERT(!overflow && pool.stats().failures == 1, "make() on exhausted pool returns empty pointer");
+        TEST_ASSERT(Record::live == 8 && held[7]->code == 7, "pooled records live");
+    }
+    TEST_ASSERT(Record::live == 0 && pool.stats().inUse == 0, "Ptr returns records to the pool");
+
+    // 事件线程产生、消费线程释放
+    const long total = 20000;
+    std::atomic<Record *> slot(nullptr);
+    std::atomic<long> produced(0);
+    long consumed = 0;
+    long sum = 0;
+    std::thread producer([&] {
+        for (long i = 0; i < total; ++i)
+        {
+            Record *rec = nullptr;
+            while ((rec = pool.create(static_cast<int>(i), 1)) == nullptr)
+            {
+                std::this_thread::yield();
+            }
+            Record *expected = nullptr;
+            while (!slot.compare_exchange_weak(expected, rec))
+            {
+                expected = nullptr;
+                std::this_thread::yield();
+            }
+            produced.fetch_add(1);
+        }
+    });
+    while (consumed < total)
+    {
+        Record *rec = slot.exchange(nullptr);
+        if (rec == nullptr)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        sum += rec->value;
+        pool.destroy(rec);
+        ++consumed;
+    }
+    producer.join();
+    TEST_ASSERT(sum == total && pool.stats().inUse == 0 && Record::live == 0, "cross-thread create/destroy");
+}
+
+void test_arena()
+{
+    std::printf("\n=== Testing Arena ===\n");
+
+    Arena arena(256);
+    TEST_ASSERT(arena.capacity() == 256 && arena.used() == 0, "arena capacity");
+
+    char *a = static_cast<char *>(arena.allocate(3, 1));
+    AP3216CData *samples = arena.allocateArray<AP3216CData>(4);
+    uint64_t *wide = arena.allocateArray<uint64_t>(2);
+    TEST_ASSERT(a != nullptr && samples != nullptr && wide != nullptr, "allocations succeed");
+    TEST_ASSERT(reinterpret_cast<uintptr_t>(samples) % alignof(AP3216CData) == 0 &&
+                    reinterpret_cast<uintptr_t>(wide) % alignof(uint64_t) == 0,
+                "allocations aligned");
+    TEST_ASSERT(arena.allocate(1, 3) == nullptr, "non power-of-two alignment rejected");
+    TEST_ASSERT(arena.allocate(1024) == nullptr, "oversized allocation fails");
+
+    ArenaStats s = arena.stats();
+    TEST_ASSERT(s.allocations == 3 && s.failures == 2 && s.used == arena.used() && s.peak == s.used, "arena stats");
+
+    arena.reset();
+    TEST_ASSERT(arena.used() == 0 && arena.stats().resets == 1 && arena.stats().peak == s.peak, "reset() keeps peak");
+    TEST_ASSERT(arena.allocate(1, 1) == a, "reset() reuses space from the start");
+
+    iovec region = arena.region();
+    TEST_ASSERT(region.iov_base == a && region.iov_len == 256, "region() covers the buffer");
+
+    alignas(8) static char storage[64];
+    Arena external(storage + 1, 63);
+    uint32_t *word = external.allocateArray<uint32_t>(1);
+    TEST_ASSERT(word != nullptr && reinterpret_cast<uintptr_t>(word) % 4 == 0 &&
+                    static_cast<void *>(word) >= storage + 1,
+                "caller buffer aligned by address");
+
+    {
+        arena.reset();
+        AllocationCounter heap;
+        std::vector<AP3216CData, ArenaAllocator<AP3216CData>> batch{ArenaAllocator<AP3216CData>(arena)};
+        batch.reserve(16);
+        for (uint16_t i = 0; i < 16; ++i)
+        {
+            AP3216CData d = {i, i, i};
+            batch.push_back(d);
+        }
+        TEST_ASSERT(heap.count() == 0 && batch.size() == 16 && batch[15].ps == 15, "vector backed by arena");
+        TEST_ASSERT(static_cast<void *>(batch.data()) >= region.iov_base &&
+                        static_cast<void *>(batch.data()) < static_cast<char *>(region.iov_base) + region.iov_len,
+                    "vector storage inside the arena");
+    }
+}
+
+// ============================================================================
+// 库内稳态路径零堆分配
+// ============================================================================
+
+void test_async_read_steady_state()
+{
+    std::printf("\n=== Testing readAsync() Steady State ===\n");
+
+    MockDevice mock(DeviceType::AP3216C, "ap3216c-mock");
+    AP3216C sensor(mock.entry);
+    EventLoop loop;
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok && loop.init() == ErrorCode::Ok, "init sensor and loop");
+
+    struct State
+    {
+        AP3216C *sensor;
+        EventLoop *loop;
+        AP3216C::ReadCallback handler;
+        long reads;
+        long errors;
+    } state = {&sensor, &loop, nullptr, 0, 0};
+    // 回调只捕获一个指针，拷贝不申请堆内存；每次完成后再次提交
+    state.handler = [&state](ErrorCode error, const AP3216CData &) {
+        ++state.reads;
+        state.errors += error == ErrorCode::Ok ? 0 : 1;
+        state.sensor->readAsync(*state.loop, state.handler);
+    };
+    TEST_ASSERT(sensor.readAsync(loop, state.handler) == ErrorCode::Ok, "readAsync() submitted");
+    TEST_ASSERT(sensor.readAsync(loop, state.handler) == ErrorCode::InvalidParam, "second pending read rejected");
+
+    AP3216CData sample = {1, 2, 3};
+    for (int i = 0; i < 50; ++i)
+    {
+        mock.feed(sample);
+        loop.runOnce(100);
+    }
+    AllocationCounter heap;
+    for (int i = 0; i < 1000; ++i)
+    {
+        mock.feed(sample);
+        loop.runOnce(100);
+    }
+    long allocations = heap.count();
+    std::printf("  %ld heap allocations over 1000 async reads\n", allocations);
+    TEST_ASSERT(state.reads == 1050 && state.errors == 0, "all async reads completed");
+    TEST_ASSERT(allocations == 0, "readAsync() steady state allocates nothing");
+    loop.cancel(sensor.getFd());
+}
+
+void test_next_event_steady_state()
+{
+    std::printf("\n=== Testing Key::nextEvent() Steady State ===\n");
+
+    MockDevice mock(DeviceType::Key, "key-mock");
+    Key key(mock.entry);
+    EventLoop loop;
+    TEST_ASSERT(key.init() == ErrorCode::Ok && loop.init() == ErrorCode::Ok, "init key and loop");
+
+    struct State
+    {
+        Key *key;
+        EventLoop *loop;
+        Key::EventCallback handler;
+        long events;
+    } state = {&key, &loop, nullptr, 0};
+    state.handler = [&state](ErrorCode error, int, int) {
+        if (error == ErrorCode::Ok)
+        {
+            ++state.events;
+        }
+        state.key->nextEvent(*state.loop, state.handler);
+    };
+    TEST_ASSERT(key.nextEvent(loop, state.handler) == ErrorCode::Ok, "nextEvent() submitted");
+
+    struct input_event frame[2];
+    std::memset(frame, 0, sizeof(frame));
+    frame[0].type = EV_KEY;
+    frame[0].code = KEY_ENTER;
+    frame[1].type = EV_SYN; // 非按键事件：在循环内重新等待
+    auto press = [&](int value) {
+        frame[0].value = value;
+        mock.feed(frame);
+        loop.runOnce(100);
+        loop.runOnce(0);
+    };
+    for (int i = 0; i < 20; ++i)
+    {
+        press((i + 1) % 2);
+    }
+    AllocationCounter heap;
+    for (int i = 0; i < 1000; ++i)
+    {
+        press((i + 1) % 2);
+    }
+    long allocations = heap.count();
+    std::printf("  %ld heap allocations over 1000 key events\n", allocations);
+    TEST_ASSERT(state.events == 1020, "all key events delivered");
+    TEST_ASSERT(allocations == 0, "nextEvent() steady state allocates nothing");
+    loop.cancel(key.getFd());
+}
+
+void test_key_thread_steady_state()
+{
+    std::printf("\n=== Testing Key Event Thread Steady State ===\n");
+
+    MockDevice mock(DeviceType::Key, "key-mock");
+    Key key(mock.entry);
+    std::atomic<long> events(0);
+    key.setCallback([&events](int, int) { events.fetch_add(1); });
+    KeyDebounceConfig debounce;
+    debounce.frameBatching = true;
+    key.setDebounce(debounce);
+    TEST_ASSERT(key.init() == ErrorCode::Ok && key.start() == ErrorCode::Ok, "start event thread");
+
+    struct input_event frame[2];
+    std::memset(frame, 0, sizeof(frame));
+    frame[0].type = EV_KEY;
+    frame[0].code = KEY_ENTER;
+    frame[1].type = EV_SYN;
+    frame[1].code = SYN_REPORT;
+    long expected = 0;
+    auto press = [&](int value) {
+        frame[0].value = value;
+        mock.feed(frame);
+        waitUntil(events, ++expected, 1000);
+    };
+    for (int i = 0; i < 20; ++i)
+    {
+        press((i + 1) % 2);
+    }
+    AllocationCounter heap;
+    for (int i = 0; i < 500; ++i)
+    {
+        press((i + 1) % 2);
+    }
+    long allocations = heap.count();
+    std::printf("  %ld heap allocations over 500 dispatched key events\n", allocations);
+    TEST_ASSERT(events.load() == 520, "all key events dispatched");
+    TEST_ASSERT(allocations == 0, "event thread steady state allocates nothing");
+    key.stop();
+}
+
+void test_sampler_steady_state()
+{
+    std::printf("\n=== Testing AdaptiveSampler Steady State ===\n");
+
+    DeviceEntry entry = makeDeviceEntry(DeviceType::AP3216C, "ap3216c-zero", "/dev/zero");
+    AP3216C sensor(entry);
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok, "init sensor on /dev/zero");
+
+    AdaptiveRateConfig config;
+    config.minIntervalMs = 1;
+    config.maxIntervalMs = 1;
+    AdaptiveSampler<AP3216C> sampler(sensor, AdaptiveRate(config));
+
+    // 捕获较大的状态：std::function 把它放在堆上，拷贝一次就分配一次
+    std::array<char, 64> context;
+    context.fill(1);
+    std::atomic<long> samples(0);
+    int id = sampler.subscribe([context, &samples](ErrorCode, const AP3216CData &) {
+        samples.fetch_add(context[0]);
+    });
+    TEST_ASSERT(id >= 0, "subscribe() starts the sampler");
+    waitUntil(samples, 10, 2000);
+
+    AllocationCounter heap;
+    long start = samples.load();
+    waitUntil(samples, start + 100, 5000);
+    long allocations = heap.count();
+    long observed = samples.load() - start;
+    std::printf("  %ld heap allocations over %ld samples\n", allocations, observed);
+    TEST_ASSERT(observed >= 100, "sampler running");
+    TEST_ASSERT(allocations == 0, "sampler dispatch allocates nothing");
+    sampler.stop();
+}
+
+void test_batch_read_steady_state()
+{
+    std::printf("\n=== Testing Batched Reads Into an Arena ===\n");
+
+    const unsigned batchSize = 8;
+    int fd = open("/dev/zero", O_RDONLY | O_CLOEXEC);
+    IoRing ring;
+    Arena arena(batchSize * sizeof(AP3216CData) + 64);
+    TEST_ASSERT(fd >= 0 && ring.init(batchSize) == ErrorCode::Ok, "init ring");
+    iovec region = arena.region();
+    TEST_ASSERT(ring.registerBuffers(&region, 1) == ErrorCode::Ok, "arena registered as fixed buffer");
+
+    long bad = 0;
+    auto batch = [&]() {
+        arena.reset();
+        AP3216CData *samples = arena.allocateArray<AP3216CData>(batchSize);
+        if (samples == nullptr)
+        {
+            ++bad;
+            return;
+        }
+        for (unsigned i = 0; i < batchSize; ++i)
+        {
+            ring.queueRead(fd, &samples[i], sizeof(AP3216CData), -1, i);
+        }
+        ring.submit(batchSize);
+        IoCompletion done[batchSize];
+        unsigned got = 0;
+        while (got < batchSize)
+        {
+            unsigned n = ring.reap(done + got, batchSize - got);
+            if (n == 0)
+            {
+                ring.submit(1);
+            }
+            got += n;
+        }
+        for (unsigned i = 0; i < got; ++i)
+        {
+            bad += completionResult(done[i], sizeof(AP3216CData)) == ErrorCode::Ok ? 0 : 1;
+        }
+    };
+    for (int i = 0; i < 10; ++i)
+    {
+        batch();
+    }
+    AllocationCounter heap;
+    for (int i = 0; i < 500; ++i)
+    {
+        batch();
+    }
+    long allocations = heap.count();
+    std::printf("  %ld heap allocations over 500 batches (%s backend)\n", allocations,
+                ring.backend() == IoBackend::IoUring ? "io_uring" : "posix");
+    TEST_ASSERT(bad == 0, "all batched reads completed");
+    TEST_ASSERT(allocations == 0 && arena.stats().peak <= arena.capacity(), "batched reads allocate nothing");
+    close(fd);
+}
+
+// 稳态：sysfs LED 的亮度设置和闪烁（属性路径在栈上拼接）
+void test_led_sysfs_steady_state()
+{
+    std::printf("\n=== Testing sysfs LED Steady State ===\n");
+
+    char tmpl[] = "/tmp/bsp-pool-led-XXXXXX";
+    std::string root = mkdtemp(tmpl) ? tmpl : "";
+    std::string dir = root + "/pool";
+    const char *attrs[] = {"brightness", "max_brightness", "trigger", "delay_on", "delay_off"};
+    mkdir(dir.c_str(), 0755);
+    for (const char *attr : attrs)
+    {
+        std::FILE *f = std::fopen((dir + "/" + attr).c_str(), "w");
+        if (f != nullptr)
+        {
+            std::fputs(std::strcmp(attr, "max_brightness") == 0 ? "255\n" : "", f);
+            std::fclose(f);
+        }
+    }
+
+    {
+        Led led = Led::sysfs("pool", root);
+        TEST_ASSERT(led.init() == ErrorCode::Ok, "init sysfs LED");
+        long bad = 0;
+        auto cycle = [&](int i) {
+            bad += led.setBrightness(i % 256) == ErrorCode::Ok ? 0 : 1;
+            bad += led.blink(100 + static_cast<unsigned>(i % 10), 900) == ErrorCode::Ok ? 0 : 1;
+        };
+        cycle(0);
+        AllocationCounter heap;
+        for (int i = 1; i <= 200; ++i)
+        {
+            cycle(i);
+        }
+        long allocations = heap.count();
+        std::printf("  %ld heap allocations over 200 setBrightness()/blink() pairs\n", allocations);
+        TEST_ASSERT(bad == 0, "sysfs writes succeeded");
+        TEST_ASSERT(allocations == 0, "sysfs LED settings allocate nothing");
+    }
+
+    for (const char *attr : attrs)
+    {
+        unlink((dir + "/" + attr).c_str());
+    }
+    rmdir(dir.c_str());
+    rmdir(root.c_str());
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Pool / Arena Test Suite\n");
+    std::printf("========================================\n");
+
+    spdlog::set_level(spdlog::level::off);
+    test_block_pool();
+    test_object_pool();
+    test_arena();
+    test_async_read_steady_state();
+    test_next_event_steady_state();
+    test_key_thread_steady_state();
+    test_sampler_steady_state();
+    test_batch_read_steady_state();
+    test_led_sysfs_steady_state();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+#include "../src/common/metrics.h"
+#include "../src/common/metrics_export.h"
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/dht11/dht11.h"
+#include "../src/driver/key/key.h"
+#include "test_support.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <linux/input.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+void test_error_code()
+{
+    std::printf("\n=== Testing Cancelled Error Code ===\n");
+
+    TEST_ASSERT(static_cast<int>(ErrorCode::Cancelled) == -(ERROR_CODE_COUNT - 1), "Cancelled is the last code");
+    TEST_ASSERT(errorToString(ErrorCode::Cancelled) == "Operation cancelled", "errorToString(Cancelled)");
+    TEST_ASSERT(std::string(errorCodeLabel(ErrorCode::Cancelled)) == "cancelled", "metrics label for Cancelled");
+}
+
+void test_sensor_timeout()
+{
+    std::printf("\n=== Testing Sensor Read Deadline ===\n");
+
+    MockDevice mock(DeviceType::AP3216C, "ap3216c-mock");
+    AP3216C sensor(mock.entry);
+    AP3216CData data = {0, 0, 0};
+    TEST_ASSERT(sensor.readData(data, 10) == ErrorCode::DevNotReady, "timed read before init() fails");
+    TEST_ASSERT(sensor.cancel() == ErrorCode::DevNotReady, "cancel() before init() fails");
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok, "init() on never-readable pipe");
+
+    Clock::time_point start = Clock::now();
+    ErrorCode result = sensor.readData(data, 50);
+    long waited = elapsedMs(start);
+    std::printf("  50 ms deadline returned after %ld ms\n", waited);
+    TEST_ASSERT(result == ErrorCode::Timeout, "read times out");
+    TEST_ASSERT(waited >= 45 && waited < 500, "read returns at the deadline");
+
+    start = Clock::now();
+    TEST_ASSERT(sensor.readData(data, 0) == ErrorCode::Timeout && elapsedMs(start) < 50, "zero deadline polls once");
+
+    AP3216CData sample = {1, 2, 3};
+    mock.feed(sample);
+    TEST_ASSERT(sensor.readData(data, 50) == ErrorCode::Ok && data.ir == 1 && data.als == 2 && data.ps == 3,
+                "data read once the device becomes readable");
+
+    TEST_ASSERT(sensor.readTimeout() < 0, "no default deadline");
+    sensor.setReadTimeout(30);
+    start = Clock::now();
+    TEST_ASSERT(sensor.readData(data) == ErrorCode::Timeout && elapsedMs(start) >= 25,
+                "readData() honours setReadTimeout()");
+
+    if (Metrics::enabled())
+    {
+        MetricsSnapshot snapshot = Metrics::snapshot();
+        const OpStats &stats = snapshot[MetricOp::AP3216CRead];
+        TEST_ASSERT(stats.results[-static_cast<int>(ErrorCode::Timeout)] >= 3, "timeouts counted in metrics");
+    }
+
+    MockDevice dhtMock(DeviceType::DHT11, "dht11-mock");
+    DHT11 dht11(dhtMock.entry);
+    DHT11Data th;
+    TEST_ASSERT(dht11.init() == ErrorCode::Ok && dht11.readData(th, 20) == ErrorCode::Timeout, "DHT11 read times out");
+
+    dhtMock.closeWriter();
+    TEST_ASSERT(dht11.readData(th, 1000) == ErrorCode::DevIo, "hang-up reported as DevIo, not a wait");
+}
+
+void test_cancel()
+{
+    std::printf("\n=== Testing Cancellation ===\n");
+
+    int before = openFdCount();
+    {
+        MockDevice mock(DeviceType::AP3216C, "ap3216c-mock");
+        AP3216C sensor(mock.entry);
+        TEST_ASSERT(sensor.init() == ErrorCode::Ok, "init()");
+        TEST_ASSERT(!sensor.isCancelled(), "not cancelled after init()");
+
+        std::thread canceller([&sensor] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            sensor.cancel();
+        });
+        AP3216CData data;
+        Clock::time_point start = Clock::now();
+        ErrorCode result = sensor.readData(data, -1);
+        long waited = elapsedMs(start);
+        canceller.join();
+        std::printf("  unbounded read cancelled after %ld ms\n", waited);
+        TEST_ASSERT(result == ErrorCode::Cancelled && waited < 500, "cancel() interrupts an unbounded read");
+        TEST_ASSERT(sensor.isCancelled(), "cancellation is sticky");
+
+        AP3216CData sample = {4, 5, 6};
+        mock.feed(sample);
+        TEST_ASSERT(sensor.readData(data, 1000) == ErrorCode::Cancelled, "cancelled device does not read");
+        sensor.clearCancel();
+        TEST_ASSERT(!sensor.isCancelled() && sensor.readData(data, 50) == ErrorCode::Ok && data.ps == 6,
+                    "clearCancel() resumes reads");
+
+        AP3216C moved(std::move(sensor));
+        TEST_ASSERT(moved.cancel() == ErrorCode::Ok && moved.readData(data, 1000) == ErrorCode::Cancelled,
+                    "cancel fd moves with the device");
+        TEST_ASSERT(sensor.cancel() == ErrorCode::DevNotReady, "moved-from device has no cancel fd");
+    }
+    TEST_ASSERT(openFdCount() == before, "cancel fd closed with the device");
+}
+
+void test_key_event()
+{
+    std::printf("\n=== Testing Key::readEvent() ===\n");
+
+    MockDevice mock(DeviceType::Key, "key-mock");
+    Key key(mock.entry);
+    TEST_ASSERT(key.init() == ErrorCode::Ok, "Key init() on pipe");
+
+    int code = -1;
+    int value = -1;
+    Clock::time_point start = Clock::now();
+    TEST_ASSERT(key.readEvent(code, value, 50) == ErrorCode::Timeout && elapsedMs(start) >= 45,
+                "readEvent() times out");
+
+    struct input_event syn;
+    std::memset(&syn, 0, sizeof(syn));
+    syn.type = EV_SYN;
+    mock.feed(syn);
+    start = Clock::now();
+    TEST_ASSERT(key.readEvent(code, value, 50) == ErrorCode::Timeout && elapsedMs(start) >= 45,
+                "non-key events do not extend the deadline");
+
+    struct input_event press = syn;
+    press.type = EV_KEY;
+    press.code = KEY_ENTER;
+    press.value = 1;
+    mock.feed(syn);
+    mock.feed(press);
+    TEST_ASSERT(key.readEvent(code, value, 50) == ErrorCode::Ok && code == KEY_ENTER && value == 1,
+                "EV_KEY event returned");
+    TEST_ASSERT(key.isPressed(KEY_ENTER), "readEvent() updates key state");
+
+    std::thread canceller([&key] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        key.cancel();
+    });
+    start = Clock::now();
+    ErrorCode result = key.readEvent(code, value, -1);
+    canceller.join();
+    TEST_ASSERT(result == ErrorCode::Cancelled && elapsedMs(start) < 500, "cancel() interrupts readEvent()");
+    key.clearCancel();
+
+    TEST_ASSERT(key.start() == ErrorCode::Ok, "start() event thread");
+    TEST_ASSERT(key.readEvent(code, value, 10) == ErrorCode::Unsupported, "readEvent() unavailable while running");
+    key.stop();
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Read Deadline / Cancellation Test Suite\n");
+    std::printf("========================================\n");
+
+    spdlog::set_level(spdlog::level::off);
+    test_error_code();
+    test_sensor_timeout();
+    test_cancel();
+    test_key_event();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,344 @@
+#include "../src/pipeline/sampler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <dirent.h>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 当前进程所有线程的名字（/proc/self/task/<tid>/comm）
+static std::set<std::string> threadNames()
+{
+    std::set<std::string> names;
+    DIR *d = opendir("/proc/self/task");
+    if (d == nullptr)
+    {
+        return names;
+    }
+    while (dirent *entry = readdir(d))
+    {
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        std::ifstream comm(std::string("/proc/self/task/") + entry->d_name + "/comm");
+        std::string name;
+        if (std::getline(comm, name))
+        {
+            names.insert(name);
+        }
+    }
+    closedir(d);
+    return names;
+}
+
+static void sleepMs(int ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// 最长等待 timeoutMs 直到条件成立
+template <typename Pred> static bool waitFor(Pred pred, int timeoutMs)
+{
+    for (int waited = 0; waited < timeoutMs; waited += 2)
+    {
+        if (pred())
+        {
+            return true;
+        }
+        sleepMs(2);
+    }
+    return pred();
+}
+
+// 10 ms ~ 80 ms，间隔每次翻倍，变化后保持 2 个样本，单通道绝对阈值 5
+static AdaptiveRate makeRate()
+{
+    AdaptiveRateConfig config;
+    config.minIntervalMs = 10;
+    config.maxIntervalMs = 80;
+    config.decay = 2.0f;
+    config.holdSamples = 2;
+    AdaptiveRate rate(config);
+    ChannelRateConfig channel;
+    channel.absThreshold = 5.0f;
+    rate.addChannel("value", channel);
+    return rate;
+}
+
+static uint32_t feed(AdaptiveRate &rate, float value)
+{
+    return rate.record(ErrorCode::Ok, &value);
+}
+
+void test_decay()
+{
+    std::printf("\n=== Testing Decay on Stable Readings ===\n");
+
+    AdaptiveRate rate = makeRate();
+    TEST_ASSERT(rate.interval() == 10 && rate.active(), "starts at the fastest rate");
+    TEST_ASSERT(feed(rate, 100) == 10, "first sample only sets the reference");
+    TEST_ASSERT(feed(rate, 101) == 10 && feed(rate, 99) == 10, "held at the fastest rate for holdSamples");
+    TEST_ASSERT(feed(rate, 100) == 20 && feed(rate, 102) == 40, "interval grows by decay on stable readings");
+    TEST_ASSERT(feed(rate, 100) == 80 && feed(rate, 100) == 80, "interval capped at maxIntervalMs");
+    TEST_ASSERT(!rate.active() && rate.changes() == 0, "no change recorded for noise below threshold");
+
+    TEST_ASSERT(rate.record(ErrorCode::DevIo, nullptr) == 80 && rate.samples() == 8,
+                "failed read keeps the interval and is counted");
+}
+
+void test_change()
+{
+    std::printf("\n=== Testing Change Detection ===\n");
+
+    AdaptiveRate rate = makeRate();
+    for (int i = 0; i < 8; ++i)
+    {
+        feed(rate, 100);
+    }
+    TEST_ASSERT(rate.interval() == 80, "stable input reaches the slowest rate");
+    TEST_ASSERT(feed(rate, 106) == 10 && rate.changes() == 1, "step above threshold returns to the fastest rate");
+    TEST_ASSERT(feed(rate, 106) == 10 && feed(rate, 106) == 10 && feed(rate, 106) == 20,
+                "new reference taken after a change");
+
+    // 每次只变 2，与上一次变化时的读数比较，累积到 6 时判定为变化
+    AdaptiveRate drift = makeRate();
+    for (int i = 0; i < 8; ++i)
+    {
+        feed(drift, 100);
+    }
+    TEST_ASSERT(feed(drift, 102) == 80 && feed(drift, 104) == 80, "small steps below threshold ignored");
+    TEST_ASSERT(feed(drift, 106) == 10 && drift.changes() == 1, "slow drift detected once accumulated");
+
+    AdaptiveRateConfig config;
+    config.holdSamples = 0;
+    AdaptiveRate relative(config);
+    ChannelRateConfig channel;
+    channel.absThreshold = 1.0f;
+    channel.relThreshold = 0.1f;
+    relative.addChannel("als", channel);
+    feed(relative, 1000);
+    feed(relative, 1000);
+    TEST_ASSERT(relative.interval() > config.minIntervalMs, "relative channel decays when stable");
+    TEST_ASSERT(feed(relative, 1050) > config.minIntervalMs, "5% change below 10% relative threshold");
+    TEST_ASSERT(feed(relative, 1100) == config.minIntervalMs, "10% change detected");
+
+    AdaptiveRate ignored(config);
+    ignored.addChannel("ignored", ChannelRateConfig());
+    feed(ignored, 0);
+    feed(ignored, 0);
+    TEST_ASSERT(feed(ignored, 1000) > config.minIntervalMs, "channel without thresholds never triggers");
+}
+
+void test_event()
+{
+    std::printf("\n=== Testing Proximity Events ===\n");
+
+    AdaptiveRate rate = AdaptiveRate::forAP3216C();
+    TEST_ASSERT(rate.channelCount() == 3 && rate.channelName(0) == "als" && rate.channelName(1) == "ps" &&
+                    rate.channelName(2) == "ir",
+                "AP3216C preset channels");
+
+    AP3216CData far = {12, 800, 40};
+    for (int i = 0; i < 40; ++i)
+    {
+        rate.record(ErrorCode::Ok, far);
+    }
+    TEST_ASSERT(rate.interval() == rate.rateConfig().maxIntervalMs, "static scene sampled at the slowest rate");
+    TEST_ASSERT(rate.changes() == 0 && rate.events() == 0, "no change or event in a static scene");
+
+    AP3216CData near = {12, 800, 600};
+    TEST_ASSERT(rate.record(ErrorCode::Ok, near) == rate.rateConfig().minIntervalMs, "proximity returns to min");
+    TEST_ASSERT(rate.eventActive(1) && rate.events() == 1, "proximity event raised");
+
+    AP3216CData fading = {12, 800, 450};
+    rate.record(ErrorCode::Ok, fading);
+    TEST_ASSERT(rate.eventActive(1) && rate.events() == 1, "hysteresis keeps the event active");
+    AP3216CData gone = {12, 800, 350};
+    rate.record(ErrorCode::Ok, gone);
+    TEST_ASSERT(!rate.eventActive(1) && rate.events() == 2, "event cleared below level - hysteresis");
+
+    rate.boost();
+    TEST_ASSERT(rate.interval() == rate.rateConfig().minIntervalMs, "boost() returns to the fastest rate");
+    rate.reset();
+    TEST_ASSERT(rate.samples() == 0 && rate.events() == 0 && !rate.eventActive(1), "reset() clears state");
+}
+
+void test_presets_and_config()
+{
+    std::printf("\n=== Testing DHT11 Preset and Config Checks ===\n");
+
+    AdaptiveRate rate = AdaptiveRate::forDHT11();
+    TEST_ASSERT(rate.channelCount() == 2 && rate.rateConfig().minIntervalMs >= 1000,
+                "DHT11 preset respects the 1 s minimum read interval");
+    DHT11Data base = {45, 0, 22, 0};
+    for (int i = 0; i < 20; ++i)
+    {
+        rate.record(ErrorCode::Ok, base);
+    }
+    TEST_ASSERT(rate.interval() == rate.rateConfig().maxIntervalMs, "stable room sampled at the slowest rate");
+    DHT11Data warmer = {45, 0, 22, 6};
+    TEST_ASSERT(rate.record(ErrorCode::Ok, warmer) == rate.rateConfig().minIntervalMs,
+                "0.6 C temperature change detected");
+
+    AdaptiveRateConfig bad;
+    bad.minIntervalMs = 500;
+    bad.maxIntervalMs = 100;
+    AdaptiveRate fixed(bad);
+    TEST_ASSERT(fixed.rateConfig().maxIntervalMs == 500, "max below min clamped to min");
+
+    AdaptiveRate full = makeRate();
+    for (int i = 1; i < static_cast<int>(AdaptiveRate::MAX_CHANNELS); ++i)
+    {
+        full.addChannel("c", ChannelRateConfig());
+    }
+    TEST_ASSERT(full.addChannel("extra", ChannelRateConfig()) == -1, "too many channels rejected");
+}
+
+void test_sampler()
+{
+    std::printf("\n=== Testing AdaptiveSampler ===\n");
+
+    // 管道读端代替设备节点，预先写满恒定样本，读取不会阻塞
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "pipe()");
+    AP3216CData sample = {12, 800, 40};
+    for (int i = 0; i < 4000; ++i)
+    {
+        ssize_t n = write(fds[1], &sample, sizeof(sample));
+        (void)n;
+    }
+    std::string path = "/proc/self/fd/" + std::to_string(fds[0]);
+    DeviceEntry entry = makeDeviceEntry(DeviceType::AP3216C, "ap3216c-pipe", path.c_str());
+    AP3216C sensor(entry);
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok, "AP3216C init() on pipe");
+
+    AdaptiveRateConfig config;
+    config.minIntervalMs = 5;
+    config.maxIntervalMs = 40;
+    config.decay = 2.0f;
+    config.holdSamples = 2;
+    AdaptiveRate rate(config);
+    ChannelRateConfig als;
+    als.absThreshold = 10.0f;
+    rate.addChannel("als", als);
+
+    {
+        AdaptiveSampler<AP3216C> sampler(sensor, rate);
+        TEST_ASSERT(!sampler.isRunning() && sampler.reads() == 0, "no sampling without subscribers");
+
+        std::atomic<int> first(0);
+        std::atomic<int> second(0);
+        std::atomic<bool> valid(true);
+        int a = sampler.subscribe([&](ErrorCode error, const AP3216CData &data) {
+            if (error != ErrorCode::Ok || data.als != 800)
+            {
+                valid = false;
+            }
+            ++first;
+        });
+        TEST_ASSERT(a >= 0 && sampler.isRunning(), "first subscriber starts the sampler");
+        TEST_ASSERT(threadNames().count("bsp-sampler") == 1, "sampler thread named bsp-sampler");
+
+        sleepMs(300);
+        uint64_t reads = sampler.reads();
+        std::printf("  %llu reads in 300 ms (fixed 5 ms would be 60)\n", static_cast<unsigned long long>(reads));
+        TEST_ASSERT(first > 0 && valid, "subscriber receives samples");
+        TEST_ASSERT(reads >= 5 && reads < 30, "stable input sampled well below the maximum rate");
+        TEST_ASSERT(sampler.rate().interval() == 40, "interval decayed to maxIntervalMs");
+
+        int b = sampler.subscribe([&](ErrorCode, const AP3216CData &) { ++second; });
+        TEST_ASSERT(b >= 0 && b != a && sampler.subscriberCount() == 2, "second subscriber added");
+        TEST_ASSERT(waitFor([&] { return second > 0; }, 200), "second subscriber receives samples");
+        sampler.unsubscribe(a);
+        TEST_ASSERT(sampler.isRunning() && sampler.subscriberCount() == 1, "sampler keeps running with subscribers");
+
+        reads = sampler.reads();
+        sampler.boost();
+        TEST_ASSERT(waitFor([&] { return sampler.reads() > reads; }, 20), "boost() samples immediately");
+        TEST_ASSERT(sampler.rate().interval() <= 10, "boost() returns to the fastest rate");
+
+        sampler.unsubscribe(b);
+        TEST_ASSERT(waitFor([&] { return !sampler.isRunning(); }, 200), "sampler stops after the last unsubscribe");
+        reads = sampler.reads();
+        sleepMs(60);
+        TEST_ASSERT(sampler.reads() == reads, "no reads while stopped");
+        TEST_ASSERT(threadNames().count("bsp-sampler") == 0, "sampler thread exited");
+
+        // 在回调中退订自己
+        std::atomic<int> self(-1);
+        std::atomic<int> calls(0);
+        int c = sampler.subscribe([&](ErrorCode, const AP3216CData &) {
+            if (++calls >= 3 && self >= 0)
+            {
+                sampler.unsubscribe(self);
+            }
+        });
+        self = c;
+        TEST_ASSERT(c >= 0 && sampler.isRunning(), "resubscribe restarts the sampler");
+        TEST_ASSERT(waitFor([&] { return !sampler.isRunning(); }, 500), "unsubscribe from the callback stops it");
+
+        ThreadAttr bad;
+        bad.priority = 7;
+        sampler.setThreadAttr(bad);
+        TEST_ASSERT(sampler.subscribe([](ErrorCode, const AP3216CData &) {}) == -1 && !sampler.isRunning() &&
+                        sampler.subscriberCount() == 0,
+                    "invalid thread attributes fail subscribe()");
+
+        sampler.setThreadAttr(ThreadAttr());
+        TEST_ASSERT(sampler.subscribe([](ErrorCode, const AP3216CData &) {}) >= 0, "subscribe before destruction");
+    }
+    TEST_ASSERT(threadNames().count("bsp-sampler") == 0, "destructor stops the sampler");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Adaptive Sampler Test Suite\n");
+    std::printf("========================================\n");
+
+    spdlog::set_level(spdlog::level::warn);
+    test_decay();
+    test_change();
+    test_event();
+    test_presets_and_config();
+    test_sampler();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,331 @@
+#include "../src/ipc/shm_ring.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 每个测试使用独立的共享内存名，避免与正在运行的守护进程冲突
+static std::string ringName(const char *tag)
+{
+    return "/bsp-test-" + std::to_string(getpid()) + "-" + tag;
+}
+
+// 由序号生成可校验的样本内容，用于发现撕裂读
+static AP3216CData patternFor(uint32_t sequence)
+{
+    AP3216CData data;
+    data.ir = static_cast<uint16_t>(sequence);
+    data.als = static_cast<uint16_t>(sequence * 7u);
+    data.ps = static_cast<uint16_t>(~sequence);
+    return data;
+}
+
+static bool matchesPattern(const ShmSample &sample)
+{
+    AP3216CData expect = patternFor(sample.sequence);
+    return sample.type == ShmSampleType::AP3216C && sample.ap3216c.ir == expect.ir &&
+           sample.ap3216c.als == expect.als && sample.ap3216c.ps == expect.ps;
+}
+
+void test_open_errors()
+{
+    std::printf("\n=== Testing Open Errors ===\n");
+
+    ShmSubscriber missing(ringName("missing"));
+    TEST_ASSERT(missing.open() == ErrorCode::DevOpen, "subscriber without publisher -> DevOpen");
+    ShmSample sample;
+    TEST_ASSERT(!missing.tryRead(sample), "tryRead() on closed subscriber");
+    TEST_ASSERT(missing.wait(sample, 0) == ErrorCode::DevNotReady, "wait() on closed subscriber");
+
+    ShmPublisher notPow2(ringName("bad"), 12);
+    TEST_ASSERT(notPow2.open() == ErrorCode::InvalidParam, "non power-of-two slots -> InvalidParam");
+    ShmPublisher nested("/bsp/nested");
+    TEST_ASSERT(nested.open() == ErrorCode::InvalidParam, "name with '/' -> InvalidParam");
+
+    ShmPublisher unopened(ringName("unopened"));
+    TEST_ASSERT(unopened.publish(AP3216CData()) == ErrorCode::DevNotReady, "publish() before open()");
+
+    ShmPublisher plain("bsp-test-" + std::to_string(getpid()) + "-plain");
+    TEST_ASSERT(plain.getName()[0] == '/', "leading '/' added to name");
+}
+
+// 测试单进程发布/读取三种样本
+void test_roundtrip()
+{
+    std::printf("\n=== Testing Publish / Read Roundtrip ===\n");
+
+    std::string name = ringName("roundtrip");
+    ShmPublisher pub(name, 16);
+    TEST_ASSERT(pub.open() == ErrorCode::Ok && pub.isOpen(), "publisher open()");
+    pub.publishKey(114, 1); // 订阅者打开前发布的样本不可见
+
+    ShmSubscriber sub(name);
+    TEST_ASSERT(sub.open() == ErrorCode::Ok && sub.isOpen(), "subscriber open()");
+    ShmSample sample;
+    TEST_ASSERT(!sub.tryRead(sample), "starts after samples published before open()");
+
+    AP3216CData light = {10, 820, 35};
+    DHT11Data climate = {55, 0, 23, 5};
+    TEST_ASSERT(pub.publish(light, 3) == ErrorCode::Ok, "publish(AP3216CData)");
+    TEST_ASSERT(pub.publish(climate) == ErrorCode::Ok, "publish(DHT11Data)");
+    TEST_ASSERT(pub.publishKey(115, 0) == ErrorCode::Ok, "publishKey()");
+    TEST_ASSERT(pub.published() == 4, "published()");
+
+    TEST_ASSERT(sub.tryRead(sample) && sample.type == ShmSampleType::AP3216C && sample.sequence == 1 &&
+                    sample.device == 3 && sample.ap3216c.als == 820 && sample.ap3216c.ps == 35,
+                "AP3216C sample");
+    uint64_t firstTs = sample.timestampNs;
+    TEST_ASSERT(sub.tryRead(sample) && sample.type == ShmSampleType::DHT11 && sample.dht11.humidity_int == 55 &&
+                    sample.dht11.temperature_decimal == 5,
+                "DHT11 sample");
+    TEST_ASSERT(sample.timestampNs >= firstTs && firstTs != 0, "monotonic timestamps");
+    TEST_ASSERT(sub.tryRead(sample) && sample.type == ShmSampleType::Key && sample.key.code == 115 &&
+                    sample.key.value == 0,
+                "key sample");
+    TEST_ASSERT(!sub.tryRead(sample) && sub.received() == 3 && sub.lost() == 0, "drained");
+
+    ShmSample custom;
+    std::memset(&custom, 0, sizeof(custom));
+    custom.type = ShmSampleType::Key;
+    custom.timestampNs = 42;
+    pub.publish(custom);
+    TEST_ASSERT(sub.tryRead(sample) && sample.timestampNs == 42 && sample.sequence == 4, "caller timestamp kept");
+
+    pub.publishKey(1, 1);
+    pub.publishKey(2, 1);
+    sub.skipToLatest();
+    TEST_ASSERT(!sub.tryRead(sample), "skipToLatest() drops unread samples");
+}
+
+// 测试落后超过一圈的订阅者
+void test_overrun()
+{
+    std::printf("\n=== Testing Overrun ===\n");
+
+    std::string name = ringName("overrun");
+    ShmPublisher pub(name, 8);
+    pub.open();
+    ShmSubscriber sub(name);
+    sub.open();
+
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        pub.publish(patternFor(i));
+    }
+    ShmSample sample;
+    TEST_ASSERT(sub.tryRead(sample) && sample.sequence == 13, "oldest readable is head - (slots - 1)");
+    TEST_ASSERT(sub.lost() == 13, "lost() counts overwritten samples");
+    int more = 0;
+    bool intact = matchesPattern(sample);
+    while (sub.tryRead(sample))
+    {
+        intact = intact && matchesPattern(sample);
+        ++more;
+    }
+    TEST_ASSERT(more == 6 && sub.received() == 7 && intact, "remaining samples intact");
+}
+
+// 测试等待超时与发布者关闭
+void test_wait()
+{
+    std::printf("\n=== Testing Wait / Close ===\n");
+
+    std::string name = ringName("wait");
+    ShmPublisher pub(name, 16);
+    pub.open();
+    ShmSubscriber sub(name);
+    sub.open();
+
+    ShmSample sample;
+    auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT(sub.wait(sample, 30) == ErrorCode::Timeout, "wait() timeout");
+    TEST_ASSERT(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(30), "waited full timeout");
+
+    std::thread publisher([&pub]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pub.publishKey(28, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pub.publishKey(28, 0);
+        pub.close();
+    });
+    TEST_ASSERT(sub.wait(sample, 2000) == ErrorCode::Ok && sample.key.value == 1, "futex wakeup on publish");
+    TEST_ASSERT(sub.wait(sample) == ErrorCode::Ok && sample.key.value == 0, "sample published right before close");
+    TEST_ASSERT(sub.wait(sample) == ErrorCode::DevNotReady, "close() wakes waiter with DevNotReady");
+    publisher.join();
+
+    ShmSubscriber late(name);
+    TEST_ASSERT(late.open() == ErrorCode::DevOpen, "name removed after close()");
+}
+
+// 测试跨进程：子进程订阅并校验内容
+void test_cross_process()
+{
+    std::printf("\n=== Testing Cross-Process Subscribers ===\n");
+
+    const int children = 3;
+    const uint32_t total = 2000;
+    std::string name = ringName("fork");
+    ShmPublisher pub(name, 64);
+    TEST_ASSERT(pub.open() == ErrorCode::Ok, "publisher open()");
+
+    int ready[2];
+    TEST_ASSERT(pipe(ready) == 0, "pipe()");
+    pid_t pids[children];
+    for (int c = 0; c < children; ++c)
+    {
+        pids[c] = fork();
+        if (pids[c] == 0)
+        {
+            ShmSubscriber sub(name);
+            int ok = sub.open() == ErrorCode::Ok ? 1 : 0;
+            char byte = 1;
+            if (write(ready[1], &byte, 1) != 1)
+            {
+                _exit(3);
+            }
+            ShmSample sample;
+            uint32_t expect = 0;
+            while (ok && sub.wait(sample, 5000) == ErrorCode::Ok)
+            {
+                // 订阅者可能落后被跳过若干样本，但序号必须递增且内容完整
+                if (!matchesPattern(sample) || sample.sequence < expect)
+                {
+                    _exit(2);
+                }
+                expect = sample.sequence + 1;
+            }
+            _exit(ok && expect == total && sub.received() + sub.lost() == total ? 0 : 1);
+        }
+    }
+    for (int c = 0; c < children; ++c)
+    {
+        char byte;
+        if (read(ready[0], &byte, 1) != 1)
+        {
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; i < total; ++i)
+    {
+        pub.publish(patternFor(i));
+        if (i % 64 == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    pub.close();
+
+    int passed = 0;
+    for (int c = 0; c < children; ++c)
+    {
+        int status = 0;
+        waitpid(pids[c], &status, 0);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+        {
+            ++passed;
+        }
+    }
+    ::close(ready[0]);
+    ::close(ready[1]);
+    TEST_ASSERT(passed == children, "all subscriber processes saw ordered, intact samples until close()");
+}
+
+// 测试并发读写：小环 + 快速发布，读者不得读到撕裂的样本
+void test_concurrent()
+{
+    std::printf("\n=== Testing Seqlock Under Contention ===\n");
+
+    const uint32_t total = 200000;
+    std::string name = ringName("stress");
+    ShmPublisher pub(name, 16);
+    pub.open();
+    ShmSubscriber sub(name);
+    sub.open();
+
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (uint32_t i = 0; i < total; ++i)
+        {
+            pub.publish(patternFor(i));
+        }
+        done.store(true);
+    });
+
+    ShmSample sample;
+    uint64_t torn = 0;
+    uint64_t disorder = 0;
+    int64_t last = -1;
+    for (;;)
+    {
+        bool finished = done.load();
+        while (sub.tryRead(sample))
+        {
+            torn += matchesPattern(sample) ? 0 : 1;
+            disorder += static_cast<int64_t>(sample.sequence) > last ? 0 : 1;
+            last = sample.sequence;
+        }
+        if (finished)
+        {
+            break;
+        }
+    }
+    writer.join();
+
+    std::printf("  received %llu, lost %llu\n", static_cast<unsigned long long>(sub.received()),
+                static_cast<unsigned long long>(sub.lost()));
+    TEST_ASSERT(torn == 0, "no torn reads");
+    TEST_ASSERT(disorder == 0, "sequences strictly increasing");
+    TEST_ASSERT(sub.received() + sub.lost() == total, "received + lost == published");
+    TEST_ASSERT(last == static_cast<int64_t>(total - 1), "last sample read");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Shared-Memory Ring Test Suite\n");
+    std::printf("========================================\n");
+
+    test_open_errors();
+    test_roundtrip();
+    test_overrun();
+    test_wait();
+    test_cross_process();
+    test_concurrent();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+#ifndef BSP_TEST_SUPPORT_H
+#define BSP_TEST_SUPPORT_H
+
+// 驱动测试共用的工具：管道模拟的设备节点、计时、fd 计数与轮询等待
+
+#include "../src/common/device_table.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <dirent.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+// 管道模拟的设备节点：驱动通过 /proc/self/fd/<读端> 打开，测试向写端写入数据
+struct MockDevice
+{
+    int fds[2];
+    std::string path;
+    bsp::DeviceEntry entry;
+
+    MockDevice(bsp::DeviceType type, const char *name)
+    {
+        if (pipe(fds) != 0)
+        {
+            fds[0] = fds[1] = -1;
+        }
+        path = "/proc/self/fd/" + std::to_string(fds[0]);
+        entry = bsp::makeDeviceEntry(type, name, path.c_str());
+    }
+
+    ~MockDevice()
+    {
+        closeWriter();
+        close(fds[0]);
+    }
+
+    MockDevice(const MockDevice &) = delete;
+    MockDevice &operator=(const MockDevice &) = delete;
+
+    void feed(const void *data, std::size_t len)
+    {
+        ssize_t n = write(fds[1], data, len);
+        (void)n;
+    }
+
+    template <typename T> void feed(const T &value)
+    {
+        feed(&value, sizeof(value));
+    }
+
+    // 关闭写端：之后驱动读到 EOF
+    void closeWriter()
+    {
+        if (fds[1] >= 0)
+        {
+            close(fds[1]);
+            fds[1] = -1;
+        }
+    }
+};
+
+inline long elapsedMs(Clock::time_point start)
+{
+    return static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count());
+}
+
+// 当前进程打开的 fd 数，用于检查设备关闭后没有泄漏
+inline int openFdCount()
+{
+    int count = 0;
+    DIR *d = opendir("/proc/self/fd");
+    if (d == nullptr)
+    {
+        return -1;
+    }
+    while (dirent *entry = readdir(d))
+    {
+        if (entry->d_name[0] != '.')
+        {
+            ++count;
+        }
+    }
+    closedir(d);
+    return count;
+}
+
+// 等待 flag 变为 true，超时返回 false
+inline bool waitFor(const std::atomic<bool> &flag, int timeoutMs)
+{
+    Clock::time_point start = Clock::now();
+    while (!flag.load() && elapsedMs(start) < timeoutMs)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return flag.load();
+}
+
+// 等待计数达到 target，超时返回 false
+inline bool waitUntil(const std::atomic<long> &value, long target, int timeoutMs)
+{
+    Clock::time_point start = Clock::now();
+    while (value.load() < target && elapsedMs(start) < timeoutMs)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return value.load() >= target;
+}
+
+#endif // BSP_TEST_SUPPORT_H
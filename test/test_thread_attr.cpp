@@ -0,0 +1,286 @@
+#include "../src/common/thread_attr.h"
+#include "../src/common/thread_pool.h"
+#include "../src/driver/key/key.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <sys/resource.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 当前进程所有线程的名字（/proc/self/task/<tid>/comm）
+static std::set<std::string> threadNames()
+{
+    std::set<std::string> names;
+    DIR *d = opendir("/proc/self/task");
+    if (d == nullptr)
+    {
+        return names;
+    }
+    while (dirent *entry = readdir(d))
+    {
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        std::ifstream comm(std::string("/proc/self/task/") + entry->d_name + "/comm");
+        std::string name;
+        if (std::getline(comm, name))
+        {
+            names.insert(name);
+        }
+    }
+    closedir(d);
+    return names;
+}
+
+// 一直等待到 release 置位的测试线程
+struct Parked
+{
+    std::atomic<bool> release;
+    std::thread thread;
+
+    Parked() : release(false)
+    {
+        thread = std::thread([this] {
+            while (!release)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    ~Parked()
+    {
+        release = true;
+        thread.join();
+    }
+};
+
+void test_validate()
+{
+    std::printf("\n=== Testing validateThreadAttr() ===\n");
+
+    ThreadAttr attr;
+    TEST_ASSERT(validateThreadAttr(attr) == ErrorCode::Ok, "default attributes valid");
+    attr.priority = 5;
+    TEST_ASSERT(validateThreadAttr(attr) == ErrorCode::InvalidParam, "SCHED_OTHER with priority rejected");
+
+    attr.policy = SchedPolicy::Fifo;
+    attr.priority = 0;
+    TEST_ASSERT(validateThreadAttr(attr) == ErrorCode::InvalidParam, "SCHED_FIFO priority 0 rejected");
+    attr.priority = 100;
+    TEST_ASSERT(validateThreadAttr(attr) == ErrorCode::InvalidParam, "SCHED_FIFO priority 100 rejected");
+    attr.priority = 50;
+    TEST_ASSERT(validateThreadAttr(attr) == ErrorCode::Ok, "SCHED_FIFO priority 50 valid");
+
+    ThreadAttr rt = ThreadAttr::realtime(80, 0x2);
+    TEST_ASSERT(rt.policy == SchedPolicy::Fifo && rt.priority == 80 && rt.cpuMask == 0x2 && rt.lockMemory &&
+                    rt.stackPrefaultBytes > 0,
+                "realtime() preset");
+}
+
+void test_apply_name_and_affinity()
+{
+    std::printf("\n=== Testing Name and Affinity ===\n");
+
+    Parked parked;
+    ThreadAttr attr;
+    TEST_ASSERT(applyThreadAttr(parked.thread, attr, "bsp-test-dflt") == ErrorCode::Ok, "apply defaults");
+    char name[32] = {0};
+    pthread_getname_np(parked.thread.native_handle(), name, sizeof(name));
+    TEST_ASSERT(std::strcmp(name, "bsp-test-dflt") == 0, "default name used when attr.name empty");
+
+    attr.name = "a-very-long-thread-name";
+    TEST_ASSERT(applyThreadAttr(parked.thread, attr, "x") == ErrorCode::Ok, "apply long name");
+    pthread_getname_np(parked.thread.native_handle(), name, sizeof(name));
+    TEST_ASSERT(std::strcmp(name, "a-very-long-thr") == 0, "long name truncated to 15 characters");
+
+    // 绑到当前线程可运行的第一个 CPU
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    int cpu = 0;
+    while (cpu < 64 && !CPU_ISSET(cpu, &allowed))
+    {
+        ++cpu;
+    }
+    attr.cpuMask = 1ull << cpu;
+    TEST_ASSERT(applyThreadAttr(parked.thread, attr, "x") == ErrorCode::Ok, "apply affinity");
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    pthread_getaffinity_np(parked.thread.native_handle(), sizeof(set), &set);
+    TEST_ASSERT(CPU_COUNT(&set) == 1 && CPU_ISSET(cpu, &set), "affinity mask applied");
+
+    attr.cpuMask = 1ull << 63;
+    TEST_ASSERT(applyThreadAttr(parked.thread, attr, "x") == ErrorCode::InvalidParam,
+                "mask without online CPUs rejected");
+
+    std::thread notStarted;
+    TEST_ASSERT(applyThreadAttr(notStarted, ThreadAttr(), "x") == ErrorCode::InvalidParam, "non-joinable thread");
+}
+
+void test_apply_fifo()
+{
+    std::printf("\n=== Testing SCHED_FIFO ===\n");
+
+    Parked parked;
+    ThreadAttr attr;
+    attr.policy = SchedPolicy::Fifo;
+    attr.priority = 10;
+    ErrorCode result = applyThreadAttr(parked.thread, attr, "bsp-test-rt");
+    if (result == ErrorCode::Unsupported)
+    {
+        std::printf("[SKIP] no permission for SCHED_FIFO (needs CAP_SYS_NICE or RLIMIT_RTPRIO)\n");
+        return;
+    }
+    TEST_ASSERT(result == ErrorCode::Ok, "apply SCHED_FIFO 10");
+    int policy = -1;
+    sched_param param;
+    pthread_getschedparam(parked.thread.native_handle(), &policy, &param);
+    TEST_ASSERT(policy == SCHED_FIFO && param.sched_priority == 10, "policy and priority applied");
+
+    TEST_ASSERT(applyThreadAttr(parked.thread, ThreadAttr(), "bsp-test-rt") == ErrorCode::Ok, "back to SCHED_OTHER");
+    pthread_getschedparam(parked.thread.native_handle(), &policy, &param);
+    TEST_ASSERT(policy == SCHED_OTHER, "SCHED_OTHER restored");
+}
+
+void test_library_threads()
+{
+    std::printf("\n=== Testing Library-Owned Threads ===\n");
+
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "pipe()");
+    std::string path = "/proc/self/fd/" + std::to_string(fds[0]);
+    DeviceEntry entry = makeDeviceEntry(DeviceType::Key, "key-pipe", path.c_str());
+    Key keyDev(entry);
+    TEST_ASSERT(keyDev.init() == ErrorCode::Ok, "Key init() on pipe");
+
+    ThreadAttr bad;
+    bad.priority = 3;
+    keyDev.setThreadAttr(bad);
+    TEST_ASSERT(keyDev.start() == ErrorCode::InvalidParam && !keyDev.isRunning(), "invalid attributes fail start()");
+
+    TEST_ASSERT(threadNames().count("bsp-key") == 0, "no key thread yet");
+    keyDev.setThreadAttr(ThreadAttr());
+    TEST_ASSERT(keyDev.start() == ErrorCode::Ok, "start() with defaults");
+    TEST_ASSERT(threadNames().count("bsp-key") == 1, "Key event thread named bsp-key");
+    keyDev.stop();
+
+    ThreadAttr named;
+    named.name = "key-power";
+    named.stackPrefaultBytes = 128 * 1024;
+    keyDev.setThreadAttr(named);
+    TEST_ASSERT(keyDev.start() == ErrorCode::Ok, "start() with custom name and stack prefault");
+    TEST_ASSERT(threadNames().count("key-power") == 1, "custom thread name");
+    keyDev.stop();
+    close(fds[0]);
+    close(fds[1]);
+
+    {
+        ThreadPool pool(2);
+        TEST_ASSERT(pool.size() == 0 && threadNames().count("bsp-pool-0") == 0,
+                    "no pool workers before init()");
+        TEST_ASSERT(pool.init() == ErrorCode::Ok && pool.size() == 2, "thread pool init()");
+        std::set<std::string> names = threadNames();
+        TEST_ASSERT(names.count("bsp-pool-0") == 1 && names.count("bsp-pool-1") == 1, "thread pool workers named");
+    }
+}
+
+static long minorFaults()
+{
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_minflt;
+}
+
+void test_prefault_and_lock()
+{
+    std::printf("\n=== Testing Stack Prefault and mlockall ===\n");
+
+    long faults = 0;
+    long again = 0;
+    std::thread worker([&] {
+        long before = minorFaults();
+        prefaultStack(512 * 1024);
+        faults = minorFaults() - before;
+        before = minorFaults();
+        prefaultStack(512 * 1024);
+        again = minorFaults() - before;
+    });
+    worker.join();
+    std::printf("  first prefault: %ld minor faults, second: %ld\n", faults, again);
+    TEST_ASSERT(faults >= 64 && again < 8, "second touch of the same stack does not fault");
+
+    ErrorCode result = lockProcessMemory();
+    if (result != ErrorCode::Ok)
+    {
+        std::printf("[SKIP] mlockall not permitted (RLIMIT_MEMLOCK)\n");
+        return;
+    }
+    TEST_ASSERT(lockProcessMemory() == ErrorCode::Ok, "lockProcessMemory() idempotent");
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    long lockedKb = 0;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 7, "VmLck:\t") == 0)
+        {
+            lockedKb = std::atol(line.c_str() + 7);
+        }
+    }
+    TEST_ASSERT(lockedKb > 0, "VmLck reports locked memory");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Thread Attributes Test Suite\n");
+    std::printf("========================================\n");
+
+    test_validate();
+    test_apply_name_and_affinity();
+    test_apply_fifo();
+    test_library_threads();
+    test_prefault_and_lock();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
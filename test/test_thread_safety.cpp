@@ -0,0 +1,528 @@
+// 驱动并发访问压力测试：多个线程共享同一个驱动实例
+// 用 -DBSP_ENABLE_TSAN=ON 构建时由 ThreadSanitizer 检查数据竞争
+
+#include "../src/driver/ap3216c/ap3216c.h"
+#include "../src/driver/dht11/dht11.h"
+#include "../src/driver/key/key.h"
+#include "../src/driver/led/led.h"
+#include "test_support.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <linux/input.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+static const int THREADS = 8;
+
+// 所有线程就位后同时开始，尽量让调用交叠
+class StartGate
+{
+public:
+    explicit StartGate(int parties) : waiting(parties)
+    {
+    }
+
+    void arrive()
+    {
+        waiting.fetch_sub(1);
+        while (waiting.load() > 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    std::atomic<int> waiting;
+};
+
+void test_concurrent_init()
+{
+    std::printf("\n=== Testing Concurrent init() ===\n");
+
+    MockDevice mock(DeviceType::AP3216C, "ap3216c-mock");
+    int before = openFdCount();
+    {
+        AP3216C sensor(mock.entry);
+        StartGate gate(THREADS);
+        std::atomic<int> ok(0);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < THREADS; ++i)
+        {
+            threads.push_back(std::thread([&] {
+                gate.arrive();
+                if (sensor.init() == ErrorCode::Ok && sensor.isReady())
+                {
+                    ok.fetch_add(1);
+                }
+            }));
+        }
+        for (std::thread &t : threads)
+        {
+            t.join();
+        }
+        TEST_ASSERT(ok.load() == THREADS, "every init() caller sees a ready device");
+        TEST_ASSERT(openFdCount() == before + 2, "device and cancel fd opened once");
+    }
+    TEST_ASSERT(openFdCount() == before, "fds closed with the device");
+}
+
+void test_ready_publication()
+{
+    std::printf("\n=== Testing isReady() Publication ===\n");
+
+    AP3216C sensor(makeDeviceEntry(DeviceType::AP3216C, "ap3216c-zero", "/dev/zero"));
+    std::atomic<int> readErrors(0);
+    std::atomic<long> spins(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREADS; ++i)
+    {
+        threads.push_back(std::thread([&] {
+            // 无锁轮询就绪状态，看到就绪后设备必须立即可读
+            while (!sensor.isReady())
+            {
+                spins.fetch_add(1, std::memory_order_relaxed);
+            }
+            AP3216CData data;
+            if (sensor.getFd() < 0 || sensor.readData(data) != ErrorCode::Ok)
+            {
+                readErrors.fetch_add(1);
+            }
+        }));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ErrorCode result = sensor.init();
+    for (std::thread &t : threads)
+    {
+        t.join();
+    }
+    std::printf("  %ld isReady() polls before init() completed\n", spins.load());
+    TEST_ASSERT(result == ErrorCode::Ok, "init() while other threads poll isReady()");
+    TEST_ASSERT(readErrors.load() == 0, "device readable as soon as isReady() is seen");
+}
+
+void test_shared_reads()
+{
+    std::printf("\n=== Testing Concurrent readData() ===\n");
+
+    const int perThread = 2000;
+    AP3216C sensor(makeDeviceEntry(DeviceType::AP3216C, "ap3216c-zero", "/dev/zero"));
+    DHT11 dht11(makeDeviceEntry(DeviceType::DHT11, "dht11-zero", "/dev/zero"));
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok && dht11.init() == ErrorCode::Ok, "init() on /dev/zero");
+
+    StartGate gate(THREADS);
+    std::atomic<int> failures(0);
+    std::atomic<bool> readersDone(false);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREADS; ++i)
+    {
+        threads.push_back(std::thread([&, i] {
+            gate.arrive();
+            for (int n = 0; n < perThread; ++n)
+            {
+                ErrorCode result;
+                if (i % 2 == 0)
+                {
+                    AP3216CData data;
+                    // 一半的读取带期限，走 poll() 路径
+                    result = n % 2 == 0 ? sensor.readData(data) : sensor.readData(data, 1000);
+                }
+                else
+                {
+                    DHT11Data data;
+                    result = dht11.readData(data);
+                }
+                if (result != ErrorCode::Ok)
+                {
+                    failures.fetch_add(1);
+                }
+            }
+        }));
+    }
+    // 只读查询与读取并发
+    std::atomic<long> checks(0);
+    std::thread observer([&] {
+        while (!readersDone.load())
+        {
+            if (sensor.isReady() && dht11.isReady() && sensor.readTimeout() < 0 && !sensor.isCancelled())
+            {
+                checks.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    for (std::thread &t : threads)
+    {
+        t.join();
+    }
+    readersDone = true;
+    observer.join();
+    TEST_ASSERT(failures.load() == 0, "all concurrent reads succeed");
+    TEST_ASSERT(checks.load() > 0, "isReady() answered during reads");
+
+    // 运行中修改默认期限
+    std::thread setter([&] {
+        for (int n = 0; n < 1000; ++n)
+        {
+            sensor.setReadTimeout(n % 2 == 0 ? 100 : -1);
+        }
+    });
+    int ok = 0;
+    for (int n = 0; n < 1000; ++n)
+    {
+        AP3216CData data;
+        ok += sensor.readData(data) == ErrorCode::Ok ? 1 : 0;
+    }
+    setter.join();
+    TEST_ASSERT(ok == 1000, "setReadTimeout() concurrent with readData()");
+}
+
+void test_no_torn_reads()
+{
+    std::printf("\n=== Testing Record Integrity ===\n");
+
+    const int perThread = 500;
+    MockDevice mock(DeviceType::AP3216C, "ap3216c-mock");
+    AP3216C sensor(mock.entry);
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok, "init() on pipe");
+
+    std::vector<std::vector<uint16_t>> seen(THREADS);
+    std::atomic<int> torn(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREADS; ++i)
+    {
+        threads.push_back(std::thread([&, i] {
+            for (int n = 0; n < perThread; ++n)
+            {
+                AP3216CData data;
+                if (sensor.readData(data, 5000) != ErrorCode::Ok || data.ir != data.als || data.als != data.ps)
+                {
+                    torn.fetch_add(1);
+                    continue;
+                }
+                seen[i].push_back(data.ps);
+            }
+        }));
+    }
+    for (int n = 0; n < THREADS * perThread; ++n)
+    {
+        uint16_t v = static_cast<uint16_t>(n);
+        AP3216CData sample = {v, v, v};
+        mock.feed(sample);
+    }
+    for (std::thread &t : threads)
+    {
+        t.join();
+    }
+
+    std::vector<int> count(THREADS * perThread, 0);
+    for (const std::vector<uint16_t> &values : seen)
+    {
+        for (uint16_t v : values)
+        {
+            ++count[v];
+        }
+    }
+    bool once = true;
+    for (int c : count)
+    {
+        once = once && c == 1;
+    }
+    TEST_ASSERT(torn.load() == 0, "no failed or torn records");
+    TEST_ASSERT(once, "each record delivered to exactly one reader");
+}
+
+void test_serialized_deadline()
+{
+    std::printf("\n=== Testing Deadline While Another Read Holds the Device ===\n");
+
+    MockDevice mock(DeviceType::AP3216C, "ap3216c-mock");
+    AP3216C sensor(mock.entry);
+    TEST_ASSERT(sensor.init() == ErrorCode::Ok, "init() on never-readable pipe");
+
+    ErrorCode blocked = ErrorCode::Ok;
+    std::thread holder([&] {
+        AP3216CData data;
+        blocked = sensor.readData(data, -1);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    AP3216CData data;
+    Clock::time_point start = Clock::now();
+    ErrorCode result = sensor.readData(data, 50);
+    long waited = elapsedMs(start);
+    std::printf("  queued read returned after %ld ms\n", waited);
+    TEST_ASSERT(result == ErrorCode::Timeout && waited >= 45 && waited < 500, "queued read honours its deadline");
+
+    sensor.cancel();
+    holder.join();
+    TEST_ASSERT(blocked == ErrorCode::Cancelled, "cancel() releases the read holding the device");
+}
+
+void test_led_sysfs()
+{
+    std::printf("\n=== Testing Concurrent Led Calls ===\n");
+
+    char tmpl[] = "/tmp/bsp-leds-XXXXXX";
+    std::string root = mkdtemp(tmpl) ? tmpl : "";
+    std::string dir = root + "/mt";
+    mkdir(dir.c_str(), 0755);
+    const char *attrs[] = {"brightness", "max_brightness", "trigger", "delay_on", "delay_off", "invert", "shot"};
+    for (const char *attr : attrs)
+    {
+        std::FILE *f = std::fopen((dir + "/" + attr).c_str(), "w");
+        if (f != nullptr)
+        {
+            std::fputs(std::strcmp(attr, "max_brightness") == 0 ? "255\n" : "", f);
+            std::fclose(f);
+        }
+    }
+
+    {
+        Led led = Led::sysfs("mt", root);
+        TEST_ASSERT(led.init() == ErrorCode::Ok, "sysfs Led init()");
+
+        StartGate gate(THREADS);
+        std::atomic<int> failures(0);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < THREADS; ++i)
+        {
+            threads.push_back(std::thread([&, i] {
+                gate.arrive();
+                for (int n = 0; n < 200; ++n)
+                {
+                    ErrorCode result;
+                    switch ((i + n) % 5)
+                    {
+                    case 0:
+                        result = led.setState(n % 2 == 0);
+                        break;
+                    case 1:
+                        result = led.blink(100, 100);
+                        break;
+                    case 2:
+                        result = led.setOneShot(50, 50);
+                        break;
+                    case 3:
+                        // 其他线程可能已切走 oneshot 触发器
+                        result = led.shot();
+                        result = result == ErrorCode::DevNotReady ? ErrorCode::Ok : result;
+                        break;
+                    default:
+                        result = led.setBrightness(n % 256);
+                        break;
+                    }
+                    if (result != ErrorCode::Ok || !led.isReady())
+                    {
+                        failures.fetch_add(1);
+                    }
+                }
+            }));
+        }
+        for (std::thread &t : threads)
+        {
+            t.join();
+        }
+        TEST_ASSERT(failures.load() == 0, "concurrent setState()/blink()/shot() on one Led");
+        TEST_ASSERT(led.stopTrigger() == ErrorCode::Ok && led.turnOff() == ErrorCode::Ok, "Led usable afterwards");
+    }
+
+    for (const char *attr : attrs)
+    {
+        unlink((dir + "/" + attr).c_str());
+    }
+    rmdir(dir.c_str());
+    rmdir(root.c_str());
+}
+
+static void feedKey(MockDevice &mock, int code, int value)
+{
+    struct input_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.type = EV_KEY;
+    ev.code = static_cast<uint16_t>(code);
+    ev.value = value;
+    mock.feed(ev);
+}
+
+void test_key_stop()
+{
+    std::printf("\n=== Testing Concurrent Key stop() ===\n");
+
+    MockDevice mock(DeviceType::Key, "key-mock");
+    Key key(mock.entry);
+    TEST_ASSERT(key.init() == ErrorCode::Ok, "Key init() on pipe");
+
+    bool allOk = true;
+    for (int round = 0; round < 20; ++round)
+    {
+        if (key.start() != ErrorCode::Ok)
+        {
+            allOk = false;
+            break;
+        }
+        StartGate gate(THREADS);
+        std::atomic<int> failures(0);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < THREADS; ++i)
+        {
+            threads.push_back(std::thread([&, i] {
+                gate.arrive();
+                // 并发 stop() 与 start()：事件线程只启动、回收一次
+                ErrorCode result = i == 0 ? key.start() : key.stop();
+                if (result != ErrorCode::Ok)
+                {
+                    failures.fetch_add(1);
+                }
+            }));
+        }
+        for (std::thread &t : threads)
+        {
+            t.join();
+        }
+        allOk = allOk && failures.load() == 0 && key.stop() == ErrorCode::Ok && !key.isRunning();
+    }
+    TEST_ASSERT(allOk, "concurrent start()/stop() rounds");
+}
+
+void test_key_stop_from_callback()
+{
+    std::printf("\n=== Testing Key stop() From Callback ===\n");
+
+    MockDevice mock(DeviceType::Key, "key-mock");
+    Key key(mock.entry);
+    TEST_ASSERT(key.init() == ErrorCode::Ok, "Key init() on pipe");
+
+    std::atomic<int> calls(0);
+    std::atomic<bool> stopped(false);
+    ErrorCode restart = ErrorCode::Ok;
+    key.setCallback([&](int, int) {
+        calls.fetch_add(1);
+        restart = key.start();
+        key.stop();
+        stopped = true;
+    });
+    TEST_ASSERT(key.start() == ErrorCode::Ok, "start()");
+
+    // 两个按下事件在同一批中到达，stop() 之后的不再派发
+    struct input_event batch[2];
+    std::memset(batch, 0, sizeof(batch));
+    batch[0].type = batch[1].type = EV_KEY;
+    batch[0].code = KEY_A;
+    batch[1].code = KEY_B;
+    batch[0].value = batch[1].value = 1;
+    mock.feed(batch);
+
+    TEST_ASSERT(waitFor(stopped, 2000), "callback called stop() without deadlock");
+    Clock::time_point start = Clock::now();
+    while (key.isRunning() && elapsedMs(start) < 1000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TEST_ASSERT(!key.isRunning() && calls.load() == 1, "no dispatch after stop() in callback");
+    TEST_ASSERT(restart == ErrorCode::Unsupported, "start() from callback rejected");
+
+    // 自行停止的线程由下一次 start() 回收
+    key.setCallback([&](int, int) { calls.fetch_add(1); });
+    TEST_ASSERT(key.start() == ErrorCode::Ok && key.isRunning(), "restart after stop() in callback");
+    feedKey(mock, KEY_C, 1);
+    start = Clock::now();
+    while (calls.load() < 2 && elapsedMs(start) < 2000)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    TEST_ASSERT(calls.load() == 2, "restarted thread dispatches");
+    TEST_ASSERT(key.stop() == ErrorCode::Ok && !key.isRunning(), "stop()");
+}
+
+void test_key_destroy()
+{
+    std::printf("\n=== Testing Key Destruction During Callback ===\n");
+
+    MockDevice mock(DeviceType::Key, "key-mock");
+    std::atomic<bool> entered(false);
+    std::atomic<bool> finished(false);
+    {
+        Key key(mock.entry);
+        key.init();
+        key.setCallback([&](int, int) {
+            entered = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            // 析构线程已在等待事件线程，回调中的 stop() 不能卡住
+            key.stop();
+            finished = true;
+        });
+        key.start();
+        feedKey(mock, KEY_A, 1);
+        waitFor(entered, 2000);
+    }
+    TEST_ASSERT(entered.load() && finished.load(), "destructor waits for the running callback");
+
+    bool clean = true;
+    for (int round = 0; round < 50; ++round)
+    {
+        Key key(mock.entry);
+        key.init();
+        key.start();
+        std::thread stopper([&key] { key.stop(); });
+        // 析构与另一线程的 stop() 交叠：stopper 结束前对象不能销毁，这里只让二者竞争同一事件线程
+        key.stop();
+        stopper.join();
+        clean = clean && !key.isRunning();
+    }
+    TEST_ASSERT(clean, "stop() racing with stop() before destruction");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Driver Thread-Safety Test Suite\n");
+    std::printf("========================================\n");
+
+    spdlog::set_level(spdlog::level::off);
+    test_concurrent_init();
+    test_ready_publication();
+    test_shared_reads();
+    test_no_torn_reads();
+    test_serialized_deadline();
+    test_led_sysfs();
+    test_key_stop();
+    test_key_stop_from_callback();
+    test_key_destroy();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+#include "../src/common/trace.h"
+#include "../src/driver/led/led.h"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+static std::size_t countOf(const std::string &text, const std::string &needle)
+{
+    std::size_t count = 0;
+    for (std::size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1))
+    {
+        ++count;
+    }
+    return count;
+}
+
+// 测试关闭时不记录任何事件
+void test_disabled()
+{
+    std::printf("\n=== Testing Disabled ===\n");
+
+    Trace::disable();
+    Trace::clear();
+    {
+        BSP_TRACE_SCOPE("test::disabled");
+        BSP_TRACE_INSTANT("test::disabled_instant");
+    }
+    std::string json = Trace::toJson();
+    TEST_ASSERT(!Trace::isEnabled(), "tracing disabled by default");
+    TEST_ASSERT(countOf(json, "test::disabled") == 0, "no events recorded while disabled");
+}
+
+// 测试区间与瞬时事件
+void test_spans()
+{
+    std::printf("\n=== Testing Spans ===\n");
+
+    Trace::enable();
+    Trace::clear();
+    {
+        BSP_TRACE_SCOPE("test::outer");
+        {
+            BSP_TRACE_SCOPE("test::inner");
+        }
+        BSP_TRACE_INSTANT("test::tick");
+    }
+
+    std::thread worker([] {
+        BSP_TRACE_SCOPE("test::worker");
+    });
+    worker.join();
+
+    std::string json = Trace::toJson();
+    TEST_ASSERT(json.compare(0, 1, "{") == 0 && json.find("\"traceEvents\":[") != std::string::npos,
+                "chrome trace envelope");
+    TEST_ASSERT(countOf(json, "\"name\":\"test::outer\",\"cat\":\"bsp\",\"ph\":\"B\"") == 1, "outer begin");
+    TEST_ASSERT(countOf(json, "\"name\":\"test::outer\",\"cat\":\"bsp\",\"ph\":\"E\"") == 1, "outer end");
+    TEST_ASSERT(json.find("\"test::inner\"") != std::string::npos, "nested span");
+    TEST_ASSERT(json.find("\"name\":\"test::tick\",\"cat\":\"bsp\",\"ph\":\"i\",\"s\":\"t\"") != std::string::npos,
+                "instant event");
+    TEST_ASSERT(countOf(json, "\"test::worker\"") == 2, "exited thread's events kept");
+    TEST_ASSERT(countOf(json, "\"ph\":\"M\"") >= 2, "thread metadata per thread");
+
+    // 嵌套区间的开始/结束顺序
+    std::size_t outerB = json.find("\"test::outer\",\"cat\":\"bsp\",\"ph\":\"B\"");
+    std::size_t innerB = json.find("\"test::inner\",\"cat\":\"bsp\",\"ph\":\"B\"");
+    std::size_t innerE = json.find("\"test::inner\",\"cat\":\"bsp\",\"ph\":\"E\"");
+    std::size_t outerE = json.find("\"test::outer\",\"cat\":\"bsp\",\"ph\":\"E\"");
+    TEST_ASSERT(outerB < innerB && innerB < innerE && innerE < outerE, "events in order");
+
+    // 开启期间关闭：已开始的区间仍记录结束事件
+    Trace::clear();
+    {
+        BSP_TRACE_SCOPE("test::straddle");
+        Trace::disable();
+    }
+    json = Trace::toJson();
+    TEST_ASSERT(countOf(json, "\"test::straddle\"") == 2, "begin/end stay paired across disable()");
+}
+
+// 测试环形缓冲区覆盖最旧事件
+void test_wraparound()
+{
+    std::printf("\n=== Testing Wraparound ===\n");
+
+    Trace::enable(64);
+    std::thread worker([] {
+        for (int i = 0; i < 1000; ++i)
+        {
+            BSP_TRACE_INSTANT("test::wrap");
+        }
+        BSP_TRACE_INSTANT("test::last");
+    });
+    worker.join();
+
+    std::string json = Trace::toJson();
+    std::size_t wraps = countOf(json, "\"test::wrap\"");
+    TEST_ASSERT(wraps > 0 && wraps < 64, "ring keeps only the newest events");
+    TEST_ASSERT(json.find("\"test::last\"") != std::string::npos, "newest event retained");
+
+    Trace::clear();
+    json = Trace::toJson();
+    TEST_ASSERT(countOf(json, "\"test::wrap\"") == 0, "clear() drops events");
+    Trace::enable();
+}
+
+// 测试线程反复重启时复用已退出线程的缓冲区
+void test_buffer_reuse()
+{
+    std::printf("\n=== Testing Buffer Reuse ===\n");
+
+    Trace::enable();
+    Trace::clear();
+    BSP_TRACE_INSTANT("test::main");
+    std::size_t before = Trace::threadBufferCount();
+
+    for (int i = 0; i < 20; ++i)
+    {
+        std::thread worker([] {
+            BSP_TRACE_SCOPE("test::restart");
+        });
+        worker.join();
+    }
+    TEST_ASSERT(Trace::threadBufferCount() <= before + 1, "restarted threads reuse one buffer");
+
+    std::string json = Trace::toJson();
+    TEST_ASSERT(countOf(json, "\"test::restart\"") == 2, "only the latest thread's events kept");
+    TEST_ASSERT(countOf(json, "\"test::main\"") == 1, "live thread's events untouched");
+    Trace::clear();
+}
+
+// 测试驱动埋点与导出文件
+void test_driver_dump()
+{
+    std::printf("\n=== Testing Driver Instrumentation ===\n");
+
+    Trace::enable();
+    Trace::clear();
+
+    DeviceEntry entry = makeDeviceEntry(DeviceType::Led, "trace-led", "/dev/null");
+
+    Led led(entry);
+    led.init();
+    led.setState(true);
+    led.setState(false);
+
+    std::string path = "/tmp/bsp_trace_test_" + std::to_string(getpid()) + ".json";
+    TEST_ASSERT(Trace::dump(path) == ErrorCode::Ok, "dump()");
+
+    std::ifstream in(path.c_str());
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string json = buffer.str();
+    TEST_ASSERT(countOf(json, "\"Led::init\"") == 2, "Led::init span");
+    TEST_ASSERT(countOf(json, "\"Led::setState\"") == 4, "Led::setState spans");
+    unlink(path.c_str());
+
+    TEST_ASSERT(Trace::dump("/nonexistent-dir/trace.json") == ErrorCode::DevOpen, "dump to bad path fails");
+    Trace::disable();
+}
+
+int main()
+{
+    spdlog::set_level(spdlog::level::off);
+
+    std::printf("========================================\n");
+    std::printf("BSP Trace Test Suite\n");
+    std::printf("========================================\n");
+
+    test_disabled();
+    test_spans();
+    test_wraparound();
+    test_buffer_reuse();
+    test_driver_dump();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+#include "../src/driver/sensor_units.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace bsp;
+
+// 测试结果统计
+static int test_count = 0;
+static int pass_count = 0;
+static int fail_count = 0;
+
+#define TEST_ASSERT(condition, msg)                                                                          \
+    do                                                                                                       \
+    {                                                                                                        \
+        test_count++;                                                                                        \
+        if (condition)                                                                                       \
+        {                                                                                                    \
+            pass_count++;                                                                                    \
+            std::printf("[PASS] %s\n", msg);                                                                 \
+        }                                                                                                    \
+        else                                                                                                 \
+        {                                                                                                    \
+            fail_count++;                                                                                    \
+            std::fprintf(stderr, "[FAIL] %s\n", msg);                                                        \
+        }                                                                                                    \
+    } while (0)
+
+// 原始值换算在编译期即可求值
+static_assert(AP3216CConverter::alsMilliLux(100) == 35000, "0.35 lux per ALS count");
+static_assert(AP3216CConverter::alsMilliLux(65535) == 22937250, "ALS full scale fits int32");
+static_assert(DHT11Converter::humidityMilli(45, 3) == 45300, "humidity 45.3 %RH");
+static_assert(DHT11Converter::temperatureMilli(12, 0x85) == -12500, "sign bit in temperature decimal");
+static_assert(LinearCalibration().apply(12345) == 12345, "identity calibration");
+
+static DHT11Data makeDHT11(uint8_t hInt, uint8_t hDec, uint8_t tInt, uint8_t tDec)
+{
+    DHT11Data data = {hInt, hDec, tInt, tDec};
+    return data;
+}
+
+static AP3216CData makeAP3216C(uint16_t ir, uint16_t als, uint16_t ps)
+{
+    AP3216CData data = {ir, als, ps};
+    return data;
+}
+
+// 测试线性校准
+void test_calibration()
+{
+    std::printf("\n=== Testing LinearCalibration ===\n");
+
+    LinearCalibration identity;
+    TEST_ASSERT(identity.isIdentity(), "default calibration is identity");
+    TEST_ASSERT(identity.apply(-2500) == -2500, "identity keeps negative values");
+
+    // 增益 1.5，偏移 -0.25
+    LinearCalibration cal(98304, -250);
+    TEST_ASSERT(cal.apply(1000) == 1250, "gain 1.5 offset -0.25 on 1.000");
+    TEST_ASSERT(cal.apply(-1000) == -1750, "gain 1.5 offset -0.25 on -1.000");
+    TEST_ASSERT(cal.apply(1) == -248, "half rounds up (1.5 -> 2)");
+    TEST_ASSERT(cal.apply(-1) == -251, "half rounds toward +inf (-1.5 -> -1)");
+    TEST_ASSERT(cal.apply(1.0f) == 1.25f, "float path uses same coefficients");
+
+    LinearCalibration parsed = LinearCalibration::fromFloat(1.5f, -0.25f);
+    TEST_ASSERT(parsed.gainQ16 == 98304 && parsed.offsetMilli == -250, "fromFloat() exact coefficients");
+
+    LinearCalibration rounded = LinearCalibration::fromFloat(0.1f, 0.0005f);
+    TEST_ASSERT(rounded.gainQ16 == 6554, "fromFloat() rounds gain to nearest Q16");
+    TEST_ASSERT(rounded.offsetMilli == 1, "fromFloat() rounds offset to nearest milli");
+    TEST_ASSERT(!rounded.isIdentity(), "non-unity calibration");
+
+    // 大增益下 int64 中间结果不溢出
+    LinearCalibration large(4 * LinearCalibration::UNITY_GAIN, 0);
+    TEST_ASSERT(large.apply(AP3216CConverter::alsMilliLux(65535)) == 91749000, "large gain without overflow");
+}
+
+// 测试 AP3216C 转换
+void test_ap3216c()
+{
+    std::printf("\n=== Testing AP3216C Conversion ===\n");
+
+    AP3216CConverter converter;
+    AP3216CData data = makeAP3216C(12, 1000, 345);
+    AP3216CReading fixed = converter.toFixed(data);
+    TEST_ASSERT(fixed.illuminance.milli == 350000, "1000 counts -> 350.000 lx");
+    TEST_ASSERT(fixed.ps == 345 && fixed.ir == 12, "PS/IR passed through");
+    TEST_ASSERT(fixed.illuminance.toFloat() == 350.0f, "MilliLux::toFloat()");
+
+    AP3216CReadingF real = converter.toFloat(data);
+    TEST_ASSERT(real.lux == 350.0f, "float path 350 lx");
+    TEST_ASSERT(real.ps == 345 && real.ir == 12, "float path PS/IR passed through");
+
+    TEST_ASSERT(converter.toFixed(makeAP3216C(0, 0, 0)).illuminance.milli == 0, "dark -> 0 lx");
+    TEST_ASSERT(converter.toFixed(makeAP3216C(0, 65535, 0)).illuminance.milli == 22937250, "full scale");
+
+    // 每个设备独立校准：增益 0.5，偏移 +2 lx
+    AP3216CCalibration cal;
+    cal.als = LinearCalibration(32768, 2000);
+    AP3216CConverter calibrated(cal);
+    TEST_ASSERT(calibrated.toFixed(data).illuminance.milli == 177000, "calibrated 175 + 2 lx");
+    TEST_ASSERT(calibrated.toFloat(data).lux == 177.0f, "calibrated float 177 lx");
+    TEST_ASSERT(converter.toFixed(data).illuminance.milli == 350000, "other device unaffected");
+    TEST_ASSERT(calibrated.calibration().als.gainQ16 == 32768, "calibration() accessor");
+}
+
+// 测试 DHT11 转换
+void test_dht11()
+{
+    std::printf("\n=== Testing DHT11 Conversion ===\n");
+
+    DHT11Converter converter;
+    DHT11Reading fixed = converter.toFixed(makeDHT11(45, 0, 23, 0));
+    TEST_ASSERT(fixed.humidity.milli == 45000, "45 %RH");
+    TEST_ASSERT(fixed.temperature.milli == 23000, "23 C");
+
+    fixed = converter.toFixed(makeDHT11(60, 5, 21, 7));
+    TEST_ASSERT(fixed.humidity.milli == 60500, "decimal byte is tenths (60.5 %RH)");
+    TEST_ASSERT(fixed.temperature.milli == 21700, "decimal byte is tenths (21.7 C)");
+
+    fixed = converter.toFixed(makeDHT11(30, 0, 5, 0x83));
+    TEST_ASSERT(fixed.temperature.milli == -5300, "sign bit -> -5.3 C");
+    TEST_ASSERT(converter.toFixed(makeDHT11(30, 0, 0, 0x80)).temperature.milli == 0, "-0.0 C -> 0");
+
+    DHT11ReadingF real = converter.toFloat(makeDHT11(60, 5, 21, 5));
+    TEST_ASSERT(real.humidity == 60.5f, "float humidity 60.5");
+    TEST_ASSERT(real.temperature == 21.5f, "float temperature 21.5");
+    TEST_ASSERT(converter.toFloat(makeDHT11(30, 0, 5, 0x85)).temperature == -5.5f, "float negative temperature");
+
+    DHT11Calibration cal;
+    cal.humidity = LinearCalibration(LinearCalibration::UNITY_GAIN, -3000);
+    cal.temperature = LinearCalibration(LinearCalibration::UNITY_GAIN, 500);
+    DHT11Converter calibrated(cal);
+    fixed = calibrated.toFixed(makeDHT11(45, 0, 23, 0));
+    TEST_ASSERT(fixed.humidity.milli == 42000, "humidity offset -3 %RH");
+    TEST_ASSERT(fixed.temperature.milli == 23500, "temperature offset +0.5 C");
+    real = calibrated.toFloat(makeDHT11(45, 0, 23, 0));
+    TEST_ASSERT(real.humidity == 42.0f && real.temperature == 23.5f, "calibrated float path");
+}
+
+// 测试批量转换与单样本转换逐位一致
+void test_batch()
+{
+    std::printf("\n=== Testing Batch Conversion ===\n");
+
+    const std::size_t count = 1031; // 非向量宽度整数倍，覆盖尾部处理
+    std::vector<AP3216CData> light(count);
+    std::vector<DHT11Data> climate(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        light[i] = makeAP3216C(static_cast<uint16_t>(i * 7), static_cast<uint16_t>(i * 63), static_cast<uint16_t>(i));
+        climate[i] = makeDHT11(static_cast<uint8_t>(i % 100), static_cast<uint8_t>(i % 10),
+                               static_cast<uint8_t>(i % 60), static_cast<uint8_t>((i % 10) | ((i & 1) << 7)));
+    }
+
+    AP3216CCalibration lightCal;
+    lightCal.als = LinearCalibration::fromFloat(1.1f, -0.5f);
+    AP3216CConverter lightConverter(lightCal);
+
+    DHT11Calibration climateCal;
+    climateCal.humidity = LinearCalibration::fromFloat(0.98f, 1.2f);
+    climateCal.temperature = LinearCalibration::fromFloat(1.02f, -0.3f);
+    DHT11Converter climateConverter(climateCal);
+
+    std::vector<AP3216CReading> lightFixed(count);
+    std::vector<AP3216CReadingF> lightFloat(count);
+    lightConverter.convert(light.data(), count, lightFixed.data());
+    lightConverter.convert(light.data(), count, lightFloat.data());
+
+    std::vector<DHT11Reading> climateFixed(count);
+    std::vector<DHT11ReadingF> climateFloat(count);
+    climateConverter.convert(climate.data(), count, climateFixed.data());
+    climateConverter.convert(climate.data(), count, climateFloat.data());
+
+    std::size_t lightMismatch = 0;
+    std::size_t climateMismatch = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        AP3216CReading lf = lightConverter.toFixed(light[i]);
+        AP3216CReadingF lr = lightConverter.toFloat(light[i]);
+        if (lightFixed[i].illuminance != lf.illuminance || lightFixed[i].ps != lf.ps || lightFixed[i].ir != lf.ir ||
+            std::memcmp(&lightFloat[i].lux, &lr.lux, sizeof(float)) != 0)
+        {
+            ++lightMismatch;
+        }
+
+        DHT11Reading cf = climateConverter.toFixed(climate[i]);
+        DHT11ReadingF cr = climateConverter.toFloat(climate[i]);
+        if (climateFixed[i].humidity != cf.humidity || climateFixed[i].temperature != cf.temperature ||
+            std::memcmp(&climateFloat[i], &cr, sizeof(cr)) != 0)
+        {
+            ++climateMismatch;
+        }
+    }
+    TEST_ASSERT(lightMismatch == 0, "AP3216C batch == per-sample (fixed and float)");
+    TEST_ASSERT(climateMismatch == 0, "DHT11 batch == per-sample (fixed and float)");
+
+    // 抽查一个样本的精确值：i = 3 -> ALS 189 counts = 66.150 lx，* 1.1 - 0.5 = 72.265 lx
+    TEST_ASSERT(lightCal.als.gainQ16 == 72090, "fromFloat(1.1) gain");
+    TEST_ASSERT(lightFixed[3].illuminance.milli == 72265, "batch fixed exact value");
+
+    // 单位校准走单独的循环，结果同样与单样本一致
+    DHT11Converter plainClimate;
+    AP3216CConverter plainLight;
+    plainClimate.convert(climate.data(), count, climateFixed.data());
+    plainLight.convert(light.data(), count, lightFixed.data());
+    std::size_t plainMismatch = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (climateFixed[i].humidity != plainClimate.toFixed(climate[i]).humidity ||
+            climateFixed[i].temperature != plainClimate.toFixed(climate[i]).temperature ||
+            lightFixed[i].illuminance != plainLight.toFixed(light[i]).illuminance)
+        {
+            ++plainMismatch;
+        }
+    }
+    TEST_ASSERT(plainMismatch == 0, "uncalibrated batch == per-sample");
+
+    // i = 7 -> 湿度 7.7 %RH，温度 -7.7 C
+    TEST_ASSERT(climateFixed[7].humidity.milli == 7700, "batch humidity tenths");
+    TEST_ASSERT(climateFixed[7].temperature.milli == -7700, "batch input sign bit");
+
+    lightConverter.convert(light.data(), 0, lightFixed.data());
+    TEST_ASSERT(true, "convert() with zero count");
+}
+
+int main()
+{
+    std::printf("========================================\n");
+    std::printf("BSP Sensor Unit Conversion Test Suite\n");
+    std::printf("========================================\n");
+
+    test_calibration();
+    test_ap3216c();
+    test_dht11();
+    test_batch();
+
+    std::printf("\n========================================\n");
+    std::printf("Test Summary:\n");
+    std::printf("  Total:  %d\n", test_count);
+    std::printf("  Passed: %d\n", pass_count);
+    std::printf("  Failed: %d\n", fail_count);
+    std::printf("========================================\n");
+
+    return (fail_count == 0) ? 0 : 1;
+}